@@ -0,0 +1,211 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <opendnp3/outstation/EventBuffer.h>
+#include <opendnp3/app/APDUResponse.h>
+
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace openpal;
+using namespace opendnp3;
+
+/**
+* Compares the bytes on the wire needed to report relative time events (g2v3, g4v3) with the
+* default CTO headers and with OutstationParams::packRelativeTimeEvents, for several realistic
+* event timestamp distributions
+*/
+
+const uint32_t NUM_EVENTS = 1000;
+const uint32_t FRAGMENT_SIZE = 2048;
+const uint64_t START_TIME = 1500000000000;
+
+struct Sample
+{
+	bool doubleBit;
+	uint16_t index;
+	uint64_t time;
+};
+
+struct Totals
+{
+	uint32_t fragments;
+	uint32_t bytes;
+};
+
+typedef std::function<vector<Sample> (std::mt19937&)> Generator;
+
+/// one device reporting in order, about one event per second
+vector<Sample> InOrder(std::mt19937& rng)
+{
+	std::exponential_distribution<double> gap(1.0 / 1000);
+	vector<Sample> samples;
+	uint64_t time = START_TIME;
+	for (uint32_t i = 0; i < NUM_EVENTS; ++i)
+	{
+		time += static_cast<uint64_t>(gap(rng));
+		samples.push_back({ false, static_cast<uint16_t>(rng() % 100), time });
+	}
+	return samples;
+}
+
+/// a data concentrator merging four IEDs whose clocks are skewed by up to two seconds
+vector<Sample> SkewedClocks(std::mt19937& rng)
+{
+	const int64_t skew[4] = { -2000, -700, 400, 1900 };
+	std::exponential_distribution<double> gap(1.0 / 250);
+	vector<Sample> samples;
+	uint64_t time = START_TIME;
+	for (uint32_t i = 0; i < NUM_EVENTS; ++i)
+	{
+		time += static_cast<uint64_t>(gap(rng));
+		auto source = rng() % 4;
+		samples.push_back({ false, static_cast<uint16_t>(source * 25 + rng() % 25), static_cast<uint64_t>(time + skew[source]) });
+	}
+	return samples;
+}
+
+/// in order, but 10% of events arrive late from buffered sources with timestamps up to 30 seconds old
+vector<Sample> LateArrivals(std::mt19937& rng)
+{
+	std::exponential_distribution<double> gap(1.0 / 500);
+	std::uniform_int_distribution<uint64_t> age(1000, 30000);
+	vector<Sample> samples;
+	uint64_t time = START_TIME;
+	for (uint32_t i = 0; i < NUM_EVENTS; ++i)
+	{
+		time += static_cast<uint64_t>(gap(rng));
+		const bool late = (rng() % 10) == 0;
+		samples.push_back({ false, static_cast<uint16_t>(rng() % 100), late ? time - age(rng) : time });
+	}
+	return samples;
+}
+
+/// in order, with binary and double bit events interleaved in the SOE
+vector<Sample> MixedTypes(std::mt19937& rng)
+{
+	std::exponential_distribution<double> gap(1.0 / 200);
+	vector<Sample> samples;
+	uint64_t time = START_TIME;
+	for (uint32_t i = 0; i < NUM_EVENTS; ++i)
+	{
+		time += static_cast<uint64_t>(gap(rng));
+		samples.push_back({ (rng() % 2) == 0, static_cast<uint16_t>(rng() % 50), time });
+	}
+	return samples;
+}
+
+/// skewed clocks and interleaved types together
+vector<Sample> SkewedMixed(std::mt19937& rng)
+{
+	auto samples = SkewedClocks(rng);
+	for (auto& sample : samples)
+	{
+		sample.doubleBit = (sample.index % 2) == 0;
+	}
+	return samples;
+}
+
+Totals Report(const vector<Sample>& samples, bool pack)
+{
+	EventBuffer buffer(EventBufferConfig::AllTypes(NUM_EVENTS), pack);
+
+	for (auto& sample : samples)
+	{
+		if (sample.doubleBit)
+		{
+			DoubleBitBinary value(DoubleBit::DETERMINED_ON, 0x01, DNPTime(sample.time));
+			buffer.Update(Event<DoubleBitBinary>(value, sample.index, EventClass::EC1, EventDoubleBinaryVariation::Group4Var3));
+		}
+		else
+		{
+			Binary value(true, 0x01, DNPTime(sample.time));
+			buffer.Update(Event<Binary>(value, sample.index, EventClass::EC1, EventBinaryVariation::Group2Var3));
+		}
+	}
+
+	buffer.SelectAllByClass(ClassField::AllEventClasses());
+
+	Totals totals = { 0, 0 };
+	uint8_t fragment[FRAGMENT_SIZE];
+
+	while (buffer.HasAnySelection())
+	{
+		APDUResponse response(WSlice(fragment, FRAGMENT_SIZE));
+		auto writer = response.GetWriter();
+		buffer.Load(writer);
+
+		++totals.fragments;
+		totals.bytes += response.ToRSlice().Size();
+
+		// as if the master confirmed the fragment
+		buffer.ClearWritten();
+	}
+
+	return totals;
+}
+
+void Compare(const string& name, const Generator& generate)
+{
+	std::mt19937 rng(42);
+	auto samples = generate(rng);
+
+	auto normal = Report(samples, false);
+	auto packed = Report(samples, true);
+
+	// 8N1 at 9600 baud is 10 bits, about 1.04 ms, per byte, before link and transport overhead
+	auto millis = [](uint32_t bytes)
+	{
+		return static_cast<double>(bytes) * 10.0 / 9.6;
+	};
+
+	cout << setw(30) << left << name
+	     << setw(7) << right << normal.bytes
+	     << setw(5) << normal.fragments
+	     << setw(9) << packed.bytes
+	     << setw(5) << packed.fragments
+	     << setw(10) << fixed << setprecision(1) << (100.0 * (normal.bytes - packed.bytes) / normal.bytes) << " %"
+	     << setw(10) << setprecision(0) << (millis(normal.bytes) - millis(packed.bytes)) << " ms" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+	cout << NUM_EVENTS << " events, " << FRAGMENT_SIZE << " byte fragments" << endl << endl;
+
+	cout << setw(30) << left << "distribution"
+	     << setw(12) << right << "CTO bytes/frags"
+	     << setw(14) << "packed"
+	     << setw(12) << "saved"
+	     << setw(13) << "at 9600" << endl;
+
+	Compare("in order, ~1 s apart", InOrder);
+	Compare("4 IEDs, +/- 2 s clock skew", SkewedClocks);
+	Compare("10% late arrivals, <= 30 s", LateArrivals);
+	Compare("g2v3 and g4v3 interleaved", MixedTypes);
+	Compare("skewed and interleaved", SkewedMixed);
+
+	return 0;
+}
@@ -0,0 +1,361 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <asiodnp3/DNP3Manager.h>
+
+#include <openpal/container/Buffer.h>
+
+#include <opendnp3/link/LinkFrame.h>
+#include <opendnp3/link/LinkLayerConstants.h>
+#include <opendnp3/outstation/SimpleCommandHandler.h>
+#include <opendnp3/outstation/IOutstationApplication.h>
+#include <opendnp3/LogLevels.h>
+
+#include <arpa/inet.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace openpal;
+using namespace asiodnp3;
+using namespace opendnp3;
+
+/**
+* Measures what idle sessions cost a server that only exchanges keep-alives with them.
+*
+* A forked child runs a DNP3Manager with one thread and a listener with one outstation per connection,
+* each with a short keep-alive timeout. The parent opens every connection from raw loopback sockets,
+* routes each one with a REQUEST_LINK_STATUS, and from then on only answers the REQUEST_LINK_STATUS
+* the outstations send when their sessions go quiet. The CPU time and the context switches of the child
+* are sampled over the measurement window.
+*
+* usage: keepalivebench [connections] [port] [seconds] [keep-alive ms]
+*/
+
+const uint16_t MASTER_ADDRESS = 1;
+const uint16_t FIRST_OUTSTATION_ADDRESS = 10;
+const uint32_t FRAME_SIZE = 10;
+
+/// Raise the file descriptor limit as far as the hard limit allows
+rlim_t RaiseDescriptorLimit()
+{
+	rlimit limit;
+	if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+	{
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+		getrlimit(RLIMIT_NOFILE, &limit);
+		return limit.rlim_cur;
+	}
+	return 0;
+}
+
+/// User plus system time of every thread of a process in seconds
+double CPUSeconds(pid_t pid)
+{
+	std::ifstream file("/proc/" + std::to_string(pid) + "/stat");
+	std::string stat((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	// the fields after the command name, which may contain spaces, start with the state
+	auto pos = stat.rfind(')');
+	if (pos == std::string::npos)
+	{
+		return 0;
+	}
+
+	std::istringstream fields(stat.substr(pos + 2));
+	std::string field;
+	unsigned long utime = 0;
+	unsigned long stime = 0;
+	for (int i = 3; i <= 15 && (fields >> field); ++i)
+	{
+		if (i == 14) utime = std::stoul(field);
+		if (i == 15) stime = std::stoul(field);
+	}
+	return static_cast<double>(utime + stime) / sysconf(_SC_CLK_TCK);
+}
+
+/// Voluntary context switches of every thread of a process, i.e. how often it went to sleep and woke up again
+uint64_t ContextSwitches(pid_t pid)
+{
+	uint64_t total = 0;
+	auto path = "/proc/" + std::to_string(pid) + "/task";
+	auto dir = opendir(path.c_str());
+	if (!dir)
+	{
+		return 0;
+	}
+
+	while (auto entry = readdir(dir))
+	{
+		if (entry->d_name[0] == '.')
+		{
+			continue;
+		}
+		std::ifstream status(path + "/" + entry->d_name + "/status");
+		std::string line;
+		while (std::getline(status, line))
+		{
+			if (line.compare(0, 24, "voluntary_ctxt_switches:") == 0)
+			{
+				total += std::stoull(line.substr(24));
+			}
+		}
+	}
+	closedir(dir);
+	return total;
+}
+
+/// Body of the forked server process, signals ready on results and runs until control is closed
+int RunServer(int control, int results, uint32_t numConnections, uint16_t port, const TimeDuration& keepAlive)
+{
+	DNP3Manager manager(1);
+
+	auto pListener = manager.AddTCPListener("listener", levels::NOTHING, "127.0.0.1", port);
+	if (!pListener)
+	{
+		return -1;
+	}
+
+	for (uint32_t i = 0; i < numConnections; ++i)
+	{
+		OutstationStackConfig config(DatabaseTemplate::AnalogOnly(1));
+		config.link.LocalAddr = static_cast<uint16_t>(FIRST_OUTSTATION_ADDRESS + i);
+		config.link.RemoteAddr = MASTER_ADDRESS;
+		config.link.KeepAliveTimeout = keepAlive;
+		auto id = "outstation-" + std::to_string(i);
+		pListener->AddOutstation(id.c_str(), SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), config)->Enable();
+	}
+
+	char ready = 0;
+	if (write(results, &ready, 1) != 1)
+	{
+		return -1;
+	}
+
+	char dummy;
+	while (read(control, &dummy, 1) > 0) {}
+	return 0;
+}
+
+/// The raw sockets of the masters, one per outstation
+class Clients
+{
+public:
+
+	Clients(uint32_t numConnections) : epfd(epoll_create1(0)), sockets(numConnections, -1), received(numConnections, 0), buffers(numConnections), requests(numConnections), replies(numConnections)
+	{
+		openpal::Buffer buffer(LPDU_MAX_FRAME_SIZE);
+		for (uint32_t i = 0; i < numConnections; ++i)
+		{
+			auto address = static_cast<uint16_t>(FIRST_OUTSTATION_ADDRESS + i);
+
+			auto output = buffer.GetWSlice();
+			auto request = LinkFrame::FormatRequestLinkStatus(output, true, address, MASTER_ADDRESS, nullptr);
+			requests[i].assign(static_cast<const uint8_t*>(request), static_cast<const uint8_t*>(request) + request.Size());
+
+			output = buffer.GetWSlice();
+			auto reply = LinkFrame::FormatLinkStatus(output, true, false, address, MASTER_ADDRESS, nullptr);
+			replies[i].assign(static_cast<const uint8_t*>(reply), static_cast<const uint8_t*>(reply) + reply.Size());
+
+			buffers[i].resize(FRAME_SIZE);
+		}
+	}
+
+	~Clients()
+	{
+		for (auto fd : sockets)
+		{
+			if (fd >= 0) close(fd);
+		}
+		close(epfd);
+	}
+
+	/// Connect every socket and route it with one blocking round trip
+	bool Connect(uint16_t port)
+	{
+		sockaddr_in address;
+		memset(&address, 0, sizeof(address));
+		address.sin_family = AF_INET;
+		address.sin_port = htons(port);
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+		for (size_t i = 0; i < sockets.size(); ++i)
+		{
+			auto fd = socket(AF_INET, SOCK_STREAM, 0);
+			sockets[i] = fd;
+			int one = 1;
+			setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+			if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+			{
+				return false;
+			}
+
+			uint8_t reply[FRAME_SIZE];
+			if (!Send(fd, requests[i]) || recv(fd, reply, sizeof(reply), MSG_WAITALL) != sizeof(reply) || !IsFunction(reply, LinkFunction::SEC_LINK_STATUS))
+			{
+				return false;
+			}
+
+			fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+			epoll_event event;
+			event.events = EPOLLIN;
+			event.data.u32 = static_cast<uint32_t>(i);
+			epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &event);
+		}
+		return true;
+	}
+
+	/// Answer keep-alives until the deadline passes
+	uint64_t Run(std::chrono::steady_clock::time_point deadline)
+	{
+		uint64_t keepAlives = 0;
+
+		std::vector<epoll_event> events(256);
+		while (std::chrono::steady_clock::now() < deadline)
+		{
+			auto num = epoll_wait(epfd, events.data(), static_cast<int>(events.size()), 100);
+			for (int e = 0; e < num; ++e)
+			{
+				auto i = events[e].data.u32;
+				auto result = recv(sockets[i], buffers[i].data() + received[i], FRAME_SIZE - received[i], 0);
+				if (result <= 0)
+				{
+					continue;
+				}
+				received[i] += static_cast<uint32_t>(result);
+				if (received[i] == FRAME_SIZE)
+				{
+					received[i] = 0;
+					if (IsFunction(buffers[i].data(), LinkFunction::PRI_REQUEST_LINK_STATUS))
+					{
+						++keepAlives;
+						Send(sockets[i], replies[i]);
+					}
+				}
+			}
+		}
+
+		return keepAlives;
+	}
+
+private:
+
+	static bool IsFunction(const uint8_t* frame, LinkFunction function)
+	{
+		return frame[0] == 0x05 && frame[1] == 0x64 && (frame[3] & 0x0F) == (static_cast<uint8_t>(function) & 0x0F);
+	}
+
+	static bool Send(int fd, const std::vector<uint8_t>& frame)
+	{
+		return send(fd, frame.data(), frame.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(frame.size());
+	}
+
+	int epfd;
+	std::vector<int> sockets;
+	std::vector<uint32_t> received;
+	std::vector<std::vector<uint8_t>> buffers;
+	std::vector<std::vector<uint8_t>> requests;
+	std::vector<std::vector<uint8_t>> replies;
+};
+
+int main(int argc, char* argv[])
+{
+	const uint32_t NUM_CONNECTIONS = (argc > 1) ? std::stoul(argv[1]) : 10000;
+	const uint16_t PORT = (argc > 2) ? static_cast<uint16_t>(std::stoul(argv[2])) : 20000;
+	const double SECONDS = (argc > 3) ? std::stod(argv[3]) : 10.0;
+	const auto KEEP_ALIVE = TimeDuration::Milliseconds((argc > 4) ? std::stoul(argv[4]) : 2000);
+
+	auto fdLimit = RaiseDescriptorLimit();
+	if (fdLimit < NUM_CONNECTIONS + 64)
+	{
+		std::cout << "Descriptor limit " << fdLimit << " is too low for " << NUM_CONNECTIONS << " loopback connections" << std::endl;
+		return -1;
+	}
+
+	int control[2];
+	int results[2];
+	if (pipe(control) != 0 || pipe(results) != 0)
+	{
+		return -1;
+	}
+
+	auto child = fork();
+	if (child == 0)
+	{
+		close(control[1]);
+		close(results[0]);
+		exit(RunServer(control[0], results[1], NUM_CONNECTIONS, PORT, KEEP_ALIVE));
+	}
+
+	close(control[0]);
+	close(results[1]);
+
+	int result = -1;
+	char ready;
+	if (read(results[0], &ready, 1) == 1)
+	{
+		Clients clients(NUM_CONNECTIONS);
+		if (clients.Connect(PORT))
+		{
+			auto cpuStart = CPUSeconds(child);
+			auto switchesStart = ContextSwitches(child);
+			auto start = std::chrono::steady_clock::now();
+
+			auto keepAlives = clients.Run(start + std::chrono::milliseconds(static_cast<int64_t>(SECONDS * 1000)));
+
+			auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			auto cpuSeconds = CPUSeconds(child) - cpuStart;
+			auto wakeups = ContextSwitches(child) - switchesStart;
+
+			std::cout << "sessions:             " << NUM_CONNECTIONS << ", keep-alive every " << KEEP_ALIVE.GetMilliseconds() << " ms" << std::endl;
+			std::cout << "keep-alives/sec:      " << static_cast<uint64_t>(keepAlives / seconds) << std::endl;
+			std::cout << "server cpu:           " << 100 * cpuSeconds / seconds << " % ("
+			          << 1e6 * cpuSeconds / keepAlives << " us per keep-alive)" << std::endl;
+			std::cout << "server wakeups/sec:   " << wakeups / seconds << std::endl;
+			result = 0;
+		}
+		else
+		{
+			std::cout << "Unable to connect the clients" << std::endl;
+		}
+	}
+
+	close(control[1]);
+	close(results[0]);
+	waitpid(child, nullptr, 0);
+	return result;
+}
@@ -0,0 +1,339 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <asiodnp3/DNP3Manager.h>
+#include <asiodnp3/DefaultMasterApplication.h>
+#include <asiodnp3/PrintingSOEHandler.h>
+
+#include <openpal/container/Buffer.h>
+
+#include <opendnp3/link/LinkFrame.h>
+#include <opendnp3/link/LinkLayerConstants.h>
+#include <opendnp3/outstation/SimpleCommandHandler.h>
+#include <opendnp3/outstation/IOutstationApplication.h>
+#include <opendnp3/LogLevels.h>
+
+#include <asio.hpp>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace openpal;
+using namespace asiodnp3;
+using namespace opendnp3;
+
+/**
+* Measures the connection routing rate and the memory cost per session of a single TCP listener.
+*
+* One stack is registered on the listener per client. Raw loopback clients, running in a forked child
+* so that each process only holds one end of every connection, then connect and send REQUEST_LINK_STATUS
+* to their own stack, waiting for the LINK_STATUS reply that proves the connection was routed. All sockets
+* stay open and idle while memory is sampled.
+*
+* In outstation mode the clients play masters, in master mode they play outstations and the registered
+* masters are configured to stay quiet on startup. With pooled set the stacks use poolAllFragmentBuffers.
+*
+* usage: listenerbench [sessions] [port] [outstation|master] [pooled 0|1]
+*/
+
+const uint16_t MASTER_ADDRESS = 1;
+const uint16_t FIRST_REMOTE_ADDRESS = 10;
+const uint32_t NUM_CLIENT_THREADS = 4;
+const size_t TARGET_BYTES_PER_SESSION = 16 * 1024;
+
+/// Resident set size of this process in bytes, 0 if not available
+size_t ResidentBytes()
+{
+	std::ifstream statm("/proc/self/statm");
+	size_t size = 0;
+	size_t resident = 0;
+	if (statm >> size >> resident)
+	{
+		return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	}
+	return 0;
+}
+
+/// Raise the file descriptor limit as far as the hard limit allows
+rlim_t RaiseDescriptorLimit()
+{
+	rlimit limit;
+	if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+	{
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+		getrlimit(RLIMIT_NOFILE, &limit);
+		return limit.rlim_cur;
+	}
+	return 0;
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// Connect, request link status from one stack, and wait for the routed reply
+bool ConnectAndRoute(const asio::ip::tcp::endpoint& endpoint, bool isMaster, uint16_t remote, asio::ip::tcp::socket& socket)
+{
+	std::error_code ec;
+	socket.connect(endpoint, ec);
+	if (ec)
+	{
+		return false;
+	}
+
+	// the client plays the opposite role of the registered stacks
+	auto dest = isMaster ? remote : MASTER_ADDRESS;
+	auto src = isMaster ? MASTER_ADDRESS : remote;
+
+	openpal::Buffer buffer(LPDU_MAX_FRAME_SIZE);
+	auto output = buffer.GetWSlice();
+	auto request = LinkFrame::FormatRequestLinkStatus(output, isMaster, dest, src, nullptr);
+	asio::write(socket, asio::buffer(request, request.Size()), ec);
+	if (ec)
+	{
+		return false;
+	}
+
+	// the LINK_STATUS reply is a header-only frame
+	uint8_t reply[10];
+	asio::read(socket, asio::buffer(reply, sizeof(reply)), ec);
+	return !ec && reply[0] == 0x05 && reply[1] == 0x64 && (reply[3] & 0x0F) == static_cast<uint8_t>(LinkFunction::SEC_LINK_STATUS);
+}
+
+struct ClientResult
+{
+	uint32_t failures;
+	double connectMs;
+};
+
+/// Body of the forked client process. Connects every client once the parent says go, reports, and
+/// keeps the sockets open until the parent is done measuring.
+int RunClients(int control, int results, uint32_t numClients, uint16_t port, bool isMaster)
+{
+	char go;
+	if (read(control, &go, 1) != 1)
+	{
+		return -1;
+	}
+
+	asio::io_service service;
+	asio::ip::tcp::endpoint endpoint(asio::ip::address::from_string("127.0.0.1"), port);
+	std::vector<std::unique_ptr<asio::ip::tcp::socket>> sockets;
+	for (uint32_t i = 0; i < numClients; ++i)
+	{
+		sockets.push_back(std::unique_ptr<asio::ip::tcp::socket>(new asio::ip::tcp::socket(service)));
+	}
+
+	// spread over a few threads so the listener sees concurrent accepts
+	std::vector<uint32_t> failures(NUM_CLIENT_THREADS, 0);
+	auto connectStart = std::chrono::steady_clock::now();
+
+	std::vector<std::thread> threads;
+	for (uint32_t t = 0; t < NUM_CLIENT_THREADS; ++t)
+	{
+		auto run = [&, t]()
+		{
+			for (uint32_t i = t; i < numClients; i += NUM_CLIENT_THREADS)
+			{
+				auto remote = static_cast<uint16_t>(FIRST_REMOTE_ADDRESS + i);
+				if (!ConnectAndRoute(endpoint, isMaster, remote, *sockets[i]))
+				{
+					++failures[t];
+				}
+			}
+		};
+		threads.push_back(std::thread(run));
+	}
+
+	for (auto& thread : threads) thread.join();
+
+	ClientResult result = { 0, ElapsedMs(connectStart) };
+	for (auto count : failures) result.failures += count;
+	if (write(results, &result, sizeof(result)) != sizeof(result))
+	{
+		return -1;
+	}
+
+	// hold the connections open and idle until the parent closes the control pipe
+	while (read(control, &go, 1) > 0) {}
+
+	for (auto& socket : sockets)
+	{
+		std::error_code ec;
+		socket->close(ec);
+	}
+
+	return 0;
+}
+
+void AddStack(IListener& listener, bool isOutstation, bool pooled, uint32_t i)
+{
+	auto remote = static_cast<uint16_t>(FIRST_REMOTE_ADDRESS + i);
+
+	if (isOutstation)
+	{
+		OutstationStackConfig config(DatabaseTemplate::AnalogOnly(1));
+		config.outstation.params.poolAllFragmentBuffers = pooled;
+		config.link.LocalAddr = remote;
+		config.link.RemoteAddr = MASTER_ADDRESS;
+		auto id = "outstation-" + std::to_string(i);
+		listener.AddOutstation(id.c_str(), SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), config)->Enable();
+	}
+	else
+	{
+		MasterStackConfig config;
+		config.master.poolAllFragmentBuffers = pooled;
+		config.master.disableUnsolOnStartup = false;
+		config.master.startupIntegrityClassMask = ClassField::None();
+		config.master.unsolClassMask = ClassField::None();
+		config.link.LocalAddr = MASTER_ADDRESS;
+		config.link.RemoteAddr = remote;
+		auto id = "master-" + std::to_string(i);
+		listener.AddMaster(id.c_str(), PrintingSOEHandler::Instance(), DefaultMasterApplication::Instance(), config)->Enable();
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const uint32_t NUM_SESSIONS = (argc > 1) ? std::stoul(argv[1]) : 10000;
+	const uint16_t PORT = (argc > 2) ? static_cast<uint16_t>(std::stoul(argv[2])) : 20000;
+	const bool IS_OUTSTATION = (argc > 3) ? (strcmp(argv[3], "master") != 0) : true;
+	const bool POOLED = (argc > 4) ? (std::stoul(argv[4]) != 0) : true;
+
+	auto fdLimit = RaiseDescriptorLimit();
+	if (fdLimit < NUM_SESSIONS + 64)
+	{
+		std::cout << "Descriptor limit " << fdLimit << " is too low for " << NUM_SESSIONS << " loopback sessions" << std::endl;
+		return -1;
+	}
+
+	// fork before any threads exist, the child only ever uses its own io_service
+	int control[2];
+	int results[2];
+	if (pipe(control) != 0 || pipe(results) != 0)
+	{
+		return -1;
+	}
+
+	auto child = fork();
+	if (child < 0)
+	{
+		return -1;
+	}
+
+	if (child == 0)
+	{
+		close(control[1]);
+		close(results[0]);
+		exit(RunClients(control[0], results[1], NUM_SESSIONS, PORT, IS_OUTSTATION));
+	}
+
+	close(control[0]);
+	close(results[1]);
+
+	ClientResult clients = { NUM_SESSIONS, 0 };
+	ListenerStatistics stats;
+	double registrationMs = 0;
+	double closeMs = 0;
+	size_t rssStart = 0;
+	size_t rssRegistered = 0;
+	size_t rssConnected = 0;
+
+	{
+		DNP3Manager manager(std::thread::hardware_concurrency());
+
+		auto pListener = manager.AddTCPListener("listener", levels::NOTHING, "127.0.0.1", PORT);
+		if (!pListener)
+		{
+			std::cout << "Unable to listen on port " << PORT << std::endl;
+			close(control[1]);
+			waitpid(child, nullptr, 0);
+			return -1;
+		}
+
+		rssStart = ResidentBytes();
+		auto registrationStart = std::chrono::steady_clock::now();
+
+		for (uint32_t i = 0; i < NUM_SESSIONS; ++i)
+		{
+			AddStack(*pListener, IS_OUTSTATION, POOLED, i);
+		}
+
+		registrationMs = ElapsedMs(registrationStart);
+		rssRegistered = ResidentBytes();
+
+		char go = 0;
+		if (write(control[1], &go, 1) != 1 || read(results[0], &clients, sizeof(clients)) != sizeof(clients))
+		{
+			std::cout << "Lost the client process" << std::endl;
+		}
+
+		// let the sessions settle into their idle state before sampling
+		std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		rssConnected = ResidentBytes();
+		stats = pListener->GetStatistics();
+
+		// close the clients and time how long the listener takes to reclaim the connections
+		auto closeStart = std::chrono::steady_clock::now();
+		close(control[1]);
+		while (pListener->GetStatistics().numActive > 0)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		closeMs = ElapsedMs(closeStart);
+	}
+
+	waitpid(child, nullptr, 0);
+
+	auto perSession = [NUM_SESSIONS](size_t after, size_t before)
+	{
+		return (after > before) ? (after - before) / NUM_SESSIONS : 0;
+	};
+
+	auto stackBytes = perSession(rssRegistered, rssStart);
+	auto connectionBytes = perSession(rssConnected, rssRegistered);
+	auto sessionBytes = stackBytes + connectionBytes;
+
+	std::cout << "sessions:                " << NUM_SESSIONS << " " << (IS_OUTSTATION ? "outstations" : "masters") << (POOLED ? " (pooled buffers)" : "") << std::endl;
+	std::cout << "failed:                  " << clients.failures << std::endl;
+	std::cout << "accepted / routed:       " << stats.numAccepted << " / " << stats.numRouted << std::endl;
+	std::cout << "register stacks:         " << registrationMs << " ms" << std::endl;
+	std::cout << "connect and route:       " << clients.connectMs << " ms (" << static_cast<uint32_t>(NUM_SESSIONS * 1000.0 / clients.connectMs) << " connections/sec)" << std::endl;
+	std::cout << "close and reclaim:       " << closeMs << " ms" << std::endl;
+	std::cout << "rss per stack:           " << stackBytes << " bytes" << std::endl;
+	std::cout << "rss per connection:      " << connectionBytes << " bytes" << std::endl;
+	std::cout << "rss per idle session:    " << sessionBytes << " bytes (target " << TARGET_BYTES_PER_SESSION << ")" << std::endl;
+
+	return (clients.failures == 0) ? 0 : -1;
+}
@@ -0,0 +1,760 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <asiodnp3/DNP3Manager.h>
+#include <asiodnp3/ConsoleLogger.h>
+#include <asiodnp3/MeasUpdate.h>
+
+#include <asiopal/UTCTimeSource.h>
+
+#include <opendnp3/master/ISOEHandler.h>
+#include <opendnp3/master/IMasterApplication.h>
+#include <opendnp3/outstation/ICommandHandler.h>
+#include <opendnp3/LogLevels.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace openpal;
+using namespace asiopal;
+using namespace asiodnp3;
+using namespace opendnp3;
+
+/**
+* Load generator used to size hardware for a deployment.
+*
+* Spins up N outstations on M channels and N masters against them (or only the masters
+* against an external endpoint), drives measurement updates, class polls and controls at
+* configurable rates, and periodically reports throughput, latency, and the CPU / memory
+* cost of each session.
+*/
+
+namespace
+{
+
+const int POLL_TASK_ID = 1;
+const int INTEGRITY_TASK_ID = 2;
+
+struct Options
+{
+	uint32_t sessions = 10;
+	uint32_t channels = 1;
+	uint16_t port = 20000;
+	std::string remote;
+	bool memory = false;
+	bool sharded = false;
+	bool pin = false;
+	bool strands = false;
+	bool coalesce = false;
+	bool asyncCommands = false;
+	uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+	uint32_t duration = 30;
+	uint32_t interval = 5;
+	uint16_t points = 100;
+	double updateRate = 10;
+	uint32_t pollMs = 1000;
+	uint32_t integrityMs = 60000;
+	double controlRate = 1;
+	uint32_t latencyMs = 0;
+	uint32_t commandMs = 0;
+};
+
+void PrintUsage()
+{
+	std::cout << "usage: loadgen [options]" << std::endl
+	          << "  --sessions <n>       number of master/outstation sessions (default 10)" << std::endl
+	          << "  --channels <m>       number of TCP ports / channels the sessions are spread across (default 1)" << std::endl
+	          << "  --port <p>           first TCP port, channel i uses port p + i (default 20000)" << std::endl
+	          << "  --remote <host>      only create masters and connect them to an external host" << std::endl
+	          << "  --memory             connect masters and outstations with in-process memory pipes instead of TCP" << std::endl
+	          << "  --threads <t>        size of the manager's thread pool (default: hardware concurrency)" << std::endl
+	          << "  --sharded            run one io_service per thread and assign channels to shards round-robin" << std::endl
+	          << "  --pin                pin each thread pool thread to a core" << std::endl
+	          << "  --strands            keep strands even where a single thread runs the io_service" << std::endl
+	          << "  --duration <s>       length of the run in seconds (default 30)" << std::endl
+	          << "  --interval <s>       reporting interval in seconds (default 5)" << std::endl
+	          << "  --points <n>         analog points per outstation (default 100)" << std::endl
+	          << "  --update-rate <r>    analog updates / sec per outstation (default 10)" << std::endl
+	          << "  --poll-ms <ms>       class 1/2/3 poll period per master (default 1000)" << std::endl
+	          << "  --integrity-ms <ms>  integrity poll period per master (default 60000)" << std::endl
+	          << "  --control-rate <r>   direct operate CROBs / sec per master (default 1)" << std::endl
+	          << "  --coalesce           send direct operates that queue up behind another in a single request" << std::endl
+	          << "  --latency-ms <ms>    one way latency of each memory pipe (default 0)" << std::endl
+	          << "  --command-ms <ms>    time the outstation command handler takes to operate (default 0)" << std::endl
+	          << "  --async-commands     complete operates from a worker thread instead of blocking the outstation" << std::endl
+	          << std::endl
+	          << "Event latency is measured against the outstation timestamp, so clocks must agree when using --remote." << std::endl;
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg(argv[i]);
+
+		if (arg == "--memory")
+		{
+			options.memory = true;
+			continue;
+		}
+
+		if (arg == "--sharded")
+		{
+			options.sharded = true;
+			continue;
+		}
+
+		if (arg == "--pin")
+		{
+			options.pin = true;
+			continue;
+		}
+
+		if (arg == "--strands")
+		{
+			options.strands = true;
+			continue;
+		}
+
+		if (arg == "--coalesce")
+		{
+			options.coalesce = true;
+			continue;
+		}
+
+		if (arg == "--async-commands")
+		{
+			options.asyncCommands = true;
+			continue;
+		}
+
+		if ((i + 1) >= argc)
+		{
+			std::cerr << "missing value for: " << arg << std::endl;
+			return false;
+		}
+
+		const char* value = argv[++i];
+
+		if (arg == "--sessions") options.sessions = std::strtoul(value, nullptr, 10);
+		else if (arg == "--channels") options.channels = std::strtoul(value, nullptr, 10);
+		else if (arg == "--port") options.port = static_cast<uint16_t>(std::strtoul(value, nullptr, 10));
+		else if (arg == "--remote") options.remote = value;
+		else if (arg == "--threads") options.threads = std::strtoul(value, nullptr, 10);
+		else if (arg == "--duration") options.duration = std::strtoul(value, nullptr, 10);
+		else if (arg == "--interval") options.interval = std::strtoul(value, nullptr, 10);
+		else if (arg == "--points") options.points = static_cast<uint16_t>(std::strtoul(value, nullptr, 10));
+		else if (arg == "--update-rate") options.updateRate = std::strtod(value, nullptr);
+		else if (arg == "--poll-ms") options.pollMs = std::strtoul(value, nullptr, 10);
+		else if (arg == "--integrity-ms") options.integrityMs = std::strtoul(value, nullptr, 10);
+		else if (arg == "--control-rate") options.controlRate = std::strtod(value, nullptr);
+		else if (arg == "--latency-ms") options.latencyMs = std::strtoul(value, nullptr, 10);
+		else if (arg == "--command-ms") options.commandMs = std::strtoul(value, nullptr, 10);
+		else
+		{
+			std::cerr << "unknown option: " << arg << std::endl;
+			return false;
+		}
+	}
+
+	if (options.sessions == 0 || options.channels == 0 || options.threads == 0 || options.points == 0 || options.interval == 0)
+	{
+		std::cerr << "sessions, channels, threads, points and interval must be non-zero" << std::endl;
+		return false;
+	}
+
+	if (options.memory && !options.remote.empty())
+	{
+		std::cerr << "--memory and --remote are mutually exclusive" << std::endl;
+		return false;
+	}
+
+	if (options.latencyMs > 0 && !options.memory)
+	{
+		std::cerr << "--latency-ms requires --memory" << std::endl;
+		return false;
+	}
+
+	options.channels = std::min(options.channels, options.sessions);
+
+	return true;
+}
+
+/// Thread-safe collection of latency samples in microseconds
+class LatencyRecorder
+{
+public:
+
+	void Record(int64_t micros)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		samples.push_back(micros < 0 ? 0 : micros);
+	}
+
+	std::vector<int64_t> Drain()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		std::vector<int64_t> ret;
+		ret.swap(samples);
+		return ret;
+	}
+
+private:
+
+	std::mutex mutex;
+	std::vector<int64_t> samples;
+};
+
+int64_t Percentile(std::vector<int64_t>& samples, double fraction)
+{
+	if (samples.empty())
+	{
+		return 0;
+	}
+
+	auto position = static_cast<size_t>(fraction * (samples.size() - 1));
+	std::nth_element(samples.begin(), samples.begin() + position, samples.end());
+	return samples[position];
+}
+
+/// Counts event values and records the age of each event on arrival
+class LoadSOEHandler final : public ISOEHandler
+{
+public:
+
+	std::atomic<uint64_t> events;
+	std::atomic<uint64_t> values;
+	LatencyRecorder latency;
+
+	LoadSOEHandler() : events(0), values(0)
+	{}
+
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<Analog>>& meas) override final
+	{
+		values += meas.Count();
+
+		if (info.isEventVariation)
+		{
+			const auto now = static_cast<int64_t>(UTCTimeSource::Instance().Now().msSinceEpoch);
+
+			auto record = [&](const Indexed<Analog>& item)
+			{
+				latency.Record((now - static_cast<int64_t>(item.value.time.Get())) * 1000);
+			};
+
+			meas.ForeachItem(record);
+			events += meas.Count();
+		}
+	}
+
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<Binary>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<DoubleBitBinary>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<Counter>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<FrozenCounter>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<BinaryOutputStatus>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<AnalogOutputStatus>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<OctetString>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<TimeAndInterval>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<BinaryCommandEvent>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<AnalogCommandEvent>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<SecurityStat>>& meas) override final { values += meas.Count(); }
+
+protected:
+
+	virtual void Start() override final {}
+	virtual void End() override final {}
+};
+
+/// Counts the event and integrity polls that complete and fail across all masters
+class LoadMasterApplication final : public IMasterApplication
+{
+public:
+
+	std::atomic<uint64_t> polls;
+	std::atomic<uint64_t> pollFailures;
+	std::atomic<uint64_t> integrityPolls;
+	std::atomic<uint64_t> integrityFailures;
+
+	LoadMasterApplication() : polls(0), pollFailures(0), integrityPolls(0), integrityFailures(0)
+	{}
+
+	virtual void OnTaskComplete(const TaskInfo& info) override final
+	{
+		if (!info.id.IsDefined())
+		{
+			return;
+		}
+
+		const bool success = (info.result == TaskCompletion::SUCCESS);
+		switch (info.id.GetId())
+		{
+		case(POLL_TASK_ID):
+			Count(success, polls, pollFailures);
+			break;
+		case(INTEGRITY_TASK_ID):
+			Count(success, integrityPolls, integrityFailures);
+			break;
+		default:
+			break;
+		}
+	}
+
+	virtual UTCTimestamp Now() override final
+	{
+		return UTCTimeSource::Instance().Now();
+	}
+
+	virtual void OnStateChange(LinkStatus value) override final {}
+
+private:
+
+	static void Count(bool success, std::atomic<uint64_t>& successes, std::atomic<uint64_t>& failures)
+	{
+		if (success)
+		{
+			++successes;
+		}
+		else
+		{
+			++failures;
+		}
+	}
+};
+
+struct ControlStats
+{
+	ControlStats() : successes(0), failures(0)
+	{}
+
+	std::atomic<uint64_t> successes;
+	std::atomic<uint64_t> failures;
+	LatencyRecorder latency;
+};
+
+/// Simulates output hardware that takes a fixed time to operate.
+/// Synchronously the delay stalls the outstation's thread. Asynchronously a worker completes each operate once its delay expires.
+class SlowCommandHandler final : public ICommandHandler
+{
+public:
+
+	SlowCommandHandler(uint32_t delayMs, bool async) : delay(delayMs), async(async), stopped(false), worker([this]() { this->Run(); })
+	{}
+
+	~SlowCommandHandler()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopped = true;
+		}
+		condition.notify_one();
+		worker.join();
+	}
+
+	virtual CommandStatus Select(const ControlRelayOutputBlock& command, uint16_t index) override final { return CommandStatus::SUCCESS; }
+	virtual CommandStatus Select(const AnalogOutputInt16& command, uint16_t index) override final { return CommandStatus::SUCCESS; }
+	virtual CommandStatus Select(const AnalogOutputInt32& command, uint16_t index) override final { return CommandStatus::SUCCESS; }
+	virtual CommandStatus Select(const AnalogOutputFloat32& command, uint16_t index) override final { return CommandStatus::SUCCESS; }
+	virtual CommandStatus Select(const AnalogOutputDouble64& command, uint16_t index) override final { return CommandStatus::SUCCESS; }
+
+	virtual CommandStatus Operate(const ControlRelayOutputBlock& command, uint16_t index, OperateType opType) override final { return Block(); }
+	virtual CommandStatus Operate(const AnalogOutputInt16& command, uint16_t index, OperateType opType) override final { return Block(); }
+	virtual CommandStatus Operate(const AnalogOutputInt32& command, uint16_t index, OperateType opType) override final { return Block(); }
+	virtual CommandStatus Operate(const AnalogOutputFloat32& command, uint16_t index, OperateType opType) override final { return Block(); }
+	virtual CommandStatus Operate(const AnalogOutputDouble64& command, uint16_t index, OperateType opType) override final { return Block(); }
+
+	virtual bool IsAsync() override final
+	{
+		return async;
+	}
+
+	virtual void BeginOperate(const ControlRelayOutputBlock& command, uint16_t index, OperateType opType, const OperateToken& token) override final { Enqueue(token); }
+	virtual void BeginOperate(const AnalogOutputInt16& command, uint16_t index, OperateType opType, const OperateToken& token) override final { Enqueue(token); }
+	virtual void BeginOperate(const AnalogOutputInt32& command, uint16_t index, OperateType opType, const OperateToken& token) override final { Enqueue(token); }
+	virtual void BeginOperate(const AnalogOutputFloat32& command, uint16_t index, OperateType opType, const OperateToken& token) override final { Enqueue(token); }
+	virtual void BeginOperate(const AnalogOutputDouble64& command, uint16_t index, OperateType opType, const OperateToken& token) override final { Enqueue(token); }
+
+protected:
+
+	virtual void Start() override final {}
+	virtual void End() override final {}
+
+private:
+
+	struct Pending
+	{
+		Pending(const OperateToken& token, std::chrono::steady_clock::time_point deadline) : token(token), deadline(deadline)
+		{}
+
+		OperateToken token;
+		std::chrono::steady_clock::time_point deadline;
+	};
+
+	CommandStatus Block()
+	{
+		std::this_thread::sleep_for(delay);
+		return CommandStatus::SUCCESS;
+	}
+
+	void Enqueue(const OperateToken& token)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			pending.push_back(Pending(token, std::chrono::steady_clock::now() + delay));
+		}
+		condition.notify_one();
+	}
+
+	// every operate has the same delay, so the queue is already ordered by deadline
+	void Run()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		while (!stopped)
+		{
+			if (pending.empty())
+			{
+				condition.wait(lock);
+			}
+			else if (std::chrono::steady_clock::now() < pending.front().deadline)
+			{
+				condition.wait_until(lock, pending.front().deadline);
+			}
+			else
+			{
+				auto token = pending.front().token;
+				pending.pop_front();
+				lock.unlock();
+				token.Complete(CommandStatus::SUCCESS);
+				lock.lock();
+			}
+		}
+	}
+
+	const std::chrono::milliseconds delay;
+	const bool async;
+
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::deque<Pending> pending;
+	bool stopped;
+	std::thread worker;
+};
+
+/// Resident set size of the process in bytes, or 0 if it cannot be determined on this platform
+uint64_t GetResidentBytes()
+{
+#ifdef __linux__
+	std::ifstream statm("/proc/self/statm");
+	uint64_t size = 0;
+	uint64_t resident = 0;
+	if (statm >> size >> resident)
+	{
+		return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+	}
+#endif
+	return 0;
+}
+
+/// Accumulates fractional work per tick so that rates below the tick frequency are honored
+class RateCredit
+{
+public:
+
+	explicit RateCredit(double perSecond) : perSecond(perSecond), credit(0)
+	{}
+
+	uint32_t Next(double seconds)
+	{
+		credit += perSecond * seconds;
+		auto count = static_cast<uint32_t>(credit);
+		credit -= count;
+		return count;
+	}
+
+private:
+
+	double perSecond;
+	double credit;
+};
+
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+
+	if (!ParseOptions(argc, argv, options))
+	{
+		PrintUsage();
+		return -1;
+	}
+
+	// only errors are logged, console output at load would dominate the measurements
+	const uint32_t FILTERS = flags::ERR;
+
+	const bool local = options.remote.empty();
+	const uint16_t OUTSTATION_BASE_ADDR = 1024;
+	const uint16_t MASTER_ADDR = 1;
+
+	// declared before the manager so that they outlive every stack that references them
+	LoadSOEHandler soeHandler;
+	LoadMasterApplication application;
+	ControlStats controls;
+	SlowCommandHandler commandHandler(options.commandMs, options.asyncCommands);
+
+	ThreadPoolSettings poolSettings = options.sharded ? ThreadPoolSettings::Sharded(options.pin) : ThreadPoolSettings();
+	poolSettings.pinThreads = options.pin;
+	poolSettings.strandFree = !options.strands;
+
+	DNP3Manager manager(options.threads, ConsoleLogger::Create(), []() {}, []() {}, poolSettings);
+
+	std::vector<IChannel*> masterChannels;
+	std::vector<IChannel*> outstationChannels;
+
+	const auto baselineBytes = GetResidentBytes();
+
+	for (uint32_t i = 0; i < options.channels; ++i)
+	{
+		const auto port = static_cast<uint16_t>(options.port + i);
+		const std::string clientId = "client" + std::to_string(i);
+		const std::string serverId = "server" + std::to_string(i);
+
+		if (options.memory)
+		{
+			MemoryPipeSettings pipeSettings;
+			pipeSettings.latency = TimeDuration::Milliseconds(options.latencyMs);
+			auto pair = manager.AddMemoryPair(clientId.c_str(), serverId.c_str(), FILTERS, ChannelRetry::Default(), pipeSettings);
+			masterChannels.push_back(pair.first);
+			outstationChannels.push_back(pair.second);
+		}
+		else
+		{
+			if (local)
+			{
+				outstationChannels.push_back(manager.AddTCPServer(serverId.c_str(), FILTERS, ChannelRetry::Default(), "127.0.0.1", port));
+			}
+			masterChannels.push_back(manager.AddTCPClient(clientId.c_str(), FILTERS, ChannelRetry::Default(), local ? "127.0.0.1" : options.remote, "0.0.0.0", port));
+		}
+	}
+
+	// keep enough event space for several missed polls at the configured update rate
+	const auto eventsPerPoll = static_cast<uint16_t>(std::min(65535.0, std::max(100.0, 4 * options.updateRate * options.pollMs / 1000.0)));
+
+	std::vector<IOutstation*> outstations;
+	std::vector<IMaster*> masters;
+
+	for (uint32_t i = 0; i < options.sessions; ++i)
+	{
+		// sessions are spread round-robin across the channels and multi-dropped by link address
+		const auto channel = i % options.channels;
+		const auto outstationAddr = static_cast<uint16_t>(OUTSTATION_BASE_ADDR + (i / options.channels));
+
+		if (local)
+		{
+			OutstationStackConfig config;
+			config.dbTemplate = DatabaseTemplate::AllTypes(options.points);
+			config.outstation.eventBufferConfig = EventBufferConfig::AllTypes(eventsPerPoll);
+			config.link.LocalAddr = outstationAddr;
+			config.link.RemoteAddr = MASTER_ADDR;
+
+			auto outstation = outstationChannels[channel]->AddOutstation(("outstation" + std::to_string(i)).c_str(), commandHandler, DefaultOutstationApplication::Instance(), config);
+
+			// report analog events with time so that the master can measure their age
+			auto view = outstation->GetConfigView();
+			for (uint16_t j = 0; j < view.analogs.Size(); ++j)
+			{
+				view.analogs[j].metadata.clazz = PointClass::Class1;
+				view.analogs[j].metadata.variation = EventAnalogVariation::Group32Var3;
+			}
+
+			outstations.push_back(outstation);
+		}
+
+		MasterStackConfig config;
+		config.master.disableUnsolOnStartup = true;
+		config.master.coalesceDirectOperate = options.coalesce;
+		config.link.LocalAddr = MASTER_ADDR;
+		config.link.RemoteAddr = outstationAddr;
+
+		auto master = masterChannels[channel]->AddMaster(("master" + std::to_string(i)).c_str(), soeHandler, application, config);
+
+		const TaskConfig pollConfig(TaskId::Defined(POLL_TASK_ID), nullptr);
+		const TaskConfig integrityConfig(TaskId::Defined(INTEGRITY_TASK_ID), nullptr);
+		master->AddClassScan(ClassField::AllEventClasses(), TimeDuration::Milliseconds(options.pollMs), pollConfig);
+		master->AddClassScan(ClassField::AllClasses(), TimeDuration::Milliseconds(options.integrityMs), integrityConfig);
+
+		masters.push_back(master);
+	}
+
+	const auto sessionBytes = GetResidentBytes();
+
+	for (auto outstation : outstations)
+	{
+		outstation->Enable();
+	}
+
+	for (auto master : masters)
+	{
+		master->Enable();
+	}
+
+	std::cout << "sessions: " << options.sessions << " channels: " << options.channels << " threads: " << options.threads
+	          << " pool: " << (options.sharded ? "sharded" : "shared") << (options.pin ? " (pinned)" : "") << (options.strands ? " (strands)" : "")
+	          << " transport: " << (options.memory ? "memory" : (local ? "tcp (local)" : "tcp (" + options.remote + ")"))
+	          << " commands: " << options.commandMs << " ms" << (options.asyncCommands ? " (async)" : "") << std::endl;
+
+	const auto TICK = std::chrono::milliseconds(10);
+	const double TICK_SECONDS = 0.010;
+
+	std::vector<RateCredit> updateCredits(outstations.size(), RateCredit(options.updateRate));
+	std::vector<RateCredit> controlCredits(masters.size(), RateCredit(options.controlRate));
+	std::vector<uint16_t> nextPoint(outstations.size(), 0);
+	double value = 0;
+	uint64_t updates = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	const auto end = start + std::chrono::seconds(options.duration);
+	auto nextTick = start;
+	auto lastReport = start;
+	auto lastCpu = std::clock();
+	uint64_t lastEvents = 0;
+	uint64_t lastPolls = 0;
+	uint64_t lastIntegrityPolls = 0;
+	uint64_t lastControls = 0;
+	uint64_t lastUpdates = 0;
+
+	std::cout << std::fixed << std::setprecision(1);
+
+	while (nextTick < end)
+	{
+		nextTick += TICK;
+		std::this_thread::sleep_until(nextTick);
+
+		for (size_t i = 0; i < outstations.size(); ++i)
+		{
+			auto count = updateCredits[i].Next(TICK_SECONDS);
+			if (count > 0)
+			{
+				MeasUpdate tx(outstations[i], UTCTimeSource::Instance().Now());
+				for (uint32_t j = 0; j < count; ++j)
+				{
+					tx.Update(Analog(++value), nextPoint[i]);
+					nextPoint[i] = (nextPoint[i] + 1) % options.points;
+				}
+				updates += count;
+			}
+		}
+
+		for (size_t i = 0; i < masters.size(); ++i)
+		{
+			auto count = controlCredits[i].Next(TICK_SECONDS);
+			for (uint32_t j = 0; j < count; ++j)
+			{
+				const auto sent = std::chrono::steady_clock::now();
+				auto callback = [&controls, sent](const ICommandTaskResult & result)
+				{
+					if (result.summary == TaskCompletion::SUCCESS)
+					{
+						++controls.successes;
+						controls.latency.Record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sent).count());
+					}
+					else
+					{
+						++controls.failures;
+					}
+				};
+				masters[i]->DirectOperate(ControlRelayOutputBlock(ControlCode::LATCH_ON), 0, callback);
+			}
+		}
+
+		const auto now = std::chrono::steady_clock::now();
+		if ((now - lastReport) >= std::chrono::seconds(options.interval) || nextTick >= end)
+		{
+			const double seconds = std::chrono::duration<double>(now - lastReport).count();
+			const auto cpu = std::clock();
+			const double cpuPercent = 100.0 * (static_cast<double>(cpu - lastCpu) / CLOCKS_PER_SEC) / seconds;
+
+			const uint64_t events = soeHandler.events;
+			const uint64_t polls = application.polls;
+			const uint64_t integrityPolls = application.integrityPolls;
+			const uint64_t controlCount = controls.successes;
+
+			auto eventLatency = soeHandler.latency.Drain();
+			auto controlLatency = controls.latency.Drain();
+
+			std::cout << "[" << std::chrono::duration<double>(now - start).count() << "s]"
+			          << " updates/s: " << (updates - lastUpdates) / seconds
+			          << " events/s: " << (events - lastEvents) / seconds
+			          << " polls/s: " << (polls - lastPolls) / seconds
+			          << " integrity/s: " << (integrityPolls - lastIntegrityPolls) / seconds
+			          << " controls/s: " << (controlCount - lastControls) / seconds
+			          << " event p50/p99 ms: " << Percentile(eventLatency, 0.50) / 1000.0 << "/" << Percentile(eventLatency, 0.99) / 1000.0
+			          << " control p50/p99 ms: " << Percentile(controlLatency, 0.50) / 1000.0 << "/" << Percentile(controlLatency, 0.99) / 1000.0
+			          << " cpu/session %: " << std::setprecision(3) << cpuPercent / options.sessions << std::setprecision(1)
+			          << std::endl;
+
+			lastReport = now;
+			lastCpu = cpu;
+			lastEvents = events;
+			lastPolls = polls;
+			lastIntegrityPolls = integrityPolls;
+			lastControls = controlCount;
+			lastUpdates = updates;
+		}
+	}
+
+	const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "---- summary ----" << std::endl;
+	std::cout << "events/s: " << soeHandler.events / elapsed << " polls/s: " << application.polls / elapsed
+	          << " integrity/s: " << application.integrityPolls / elapsed << " controls/s: " << controls.successes / elapsed << std::endl;
+	std::cout << "poll failures: " << application.pollFailures << " integrity failures: " << application.integrityFailures
+	          << " control failures: " << controls.failures << std::endl;
+
+	if (sessionBytes > 0)
+	{
+		const auto finalBytes = GetResidentBytes();
+		std::cout << "memory/session KB: setup " << (sessionBytes - baselineBytes) / 1024.0 / options.sessions
+		          << ", after run " << (finalBytes - baselineBytes) / 1024.0 / options.sessions << std::endl;
+	}
+	else
+	{
+		std::cout << "memory/session: not available on this platform" << std::endl;
+	}
+
+	return 0;
+}
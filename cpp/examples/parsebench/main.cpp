@@ -0,0 +1,527 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <opendnp3/app/parsing/APDUParser.h>
+#include <opendnp3/app/GroupVariationRecord.h>
+#include <opendnp3/app/BitfieldRangeWriteIterator.h>
+#include <opendnp3/app/parsing/BitReader.h>
+#include <opendnp3/app/parsing/BitfieldCollection.h>
+#include <opendnp3/app/parsing/BufferedCollection.h>
+#include <openpal/serialization/Serialization.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace openpal;
+using namespace opendnp3;
+
+/**
+* Compares the single pass (indexed) and two pass parsing modes of APDUParser on
+* large measurement responses, and the per value cost of copying measurements out
+* of a collection with a visitor versus ICollection::ReadInto, and the cost of resolving
+* an object header's group/variation with the enum switch versus the dense table, and
+* bit at a time versus word at a time packing and unpacking of 64K point bitfields
+*/
+
+/// sums every analog value so that the objects are decoded just like the master would
+class AnalogSumHandler final : public IAPDUHandler
+{
+public:
+
+	AnalogSumHandler() : sum(0), count(0)
+	{}
+
+	virtual bool IsAllowed(uint32_t headerCount, GroupVariation gv, QualifierCode qc) override
+	{
+		return true;
+	}
+
+	double sum;
+	uint32_t count;
+
+private:
+
+	virtual IINField ProcessHeader(const RangeHeader& header, const ICollection<Indexed<Analog>>& values) override
+	{
+		return Sum(values);
+	}
+
+	virtual IINField ProcessHeader(const PrefixHeader& header, const ICollection<Indexed<Analog>>& values) override
+	{
+		return Sum(values);
+	}
+
+	IINField Sum(const ICollection<Indexed<Analog>>& values)
+	{
+		auto add = [this](const Indexed<Analog>& item)
+		{
+			sum += item.value.value;
+			++count;
+		};
+		values.ForeachItem(add);
+		return IINField::Empty();
+	}
+};
+
+/// copies every analog into contiguous storage, the way an application SOE handler would
+class AnalogCopyHandler final : public IAPDUHandler
+{
+public:
+
+	static const uint32_t MAX_VALUES = 512;
+
+	explicit AnalogCopyHandler(bool batch_) : batch(batch_), count(0)
+	{}
+
+	virtual bool IsAllowed(uint32_t headerCount, GroupVariation gv, QualifierCode qc) override
+	{
+		return true;
+	}
+
+	const bool batch;
+	uint32_t count;
+	Indexed<Analog> storage[MAX_VALUES];
+
+private:
+
+	virtual IINField ProcessHeader(const RangeHeader& header, const ICollection<Indexed<Analog>>& values) override
+	{
+		return Copy(values);
+	}
+
+	virtual IINField ProcessHeader(const PrefixHeader& header, const ICollection<Indexed<Analog>>& values) override
+	{
+		return Copy(values);
+	}
+
+	IINField Copy(const ICollection<Indexed<Analog>>& values)
+	{
+		if (batch)
+		{
+			count = values.ReadInto(storage, MAX_VALUES);
+		}
+		else
+		{
+			count = 0;
+			auto copy = [this](const Indexed<Analog>& item)
+			{
+				if (count < MAX_VALUES)
+				{
+					storage[count] = item;
+					++count;
+				}
+			};
+			values.ForeachItem(copy);
+		}
+		return IINField::Empty();
+	}
+};
+
+void WriteAnalog(vector<uint8_t>& buffer, int32_t value)
+{
+	buffer.push_back(0x01); // ONLINE
+	for (int i = 0; i < 4; ++i)
+	{
+		buffer.push_back(static_cast<uint8_t>((value >> (8 * i)) & 0xFF));
+	}
+}
+
+/// a single g32v1 header with 2-byte count and index prefixes, like an event response
+vector<uint8_t> BuildEventResponse(uint16_t numEvents)
+{
+	vector<uint8_t> buffer = { 0x20, 0x01, 0x28, static_cast<uint8_t>(numEvents & 0xFF), static_cast<uint8_t>(numEvents >> 8) };
+	for (uint16_t i = 0; i < numEvents; ++i)
+	{
+		buffer.push_back(static_cast<uint8_t>(i & 0xFF));
+		buffer.push_back(static_cast<uint8_t>(i >> 8));
+		WriteAnalog(buffer, i);
+	}
+	return buffer;
+}
+
+/// many g30v1 headers with 2-byte start/stop, like a static response over sparse ranges
+vector<uint8_t> BuildStaticResponse(uint16_t numHeaders, uint16_t pointsPerHeader)
+{
+	vector<uint8_t> buffer;
+	uint16_t start = 0;
+	for (uint16_t h = 0; h < numHeaders; ++h)
+	{
+		const uint16_t stop = start + pointsPerHeader - 1;
+		buffer.insert(buffer.end(),
+		{
+			0x1E, 0x01, 0x01,
+			static_cast<uint8_t>(start & 0xFF), static_cast<uint8_t>(start >> 8),
+			static_cast<uint8_t>(stop & 0xFF), static_cast<uint8_t>(stop >> 8)
+		});
+		for (uint16_t i = start; i <= stop; ++i)
+		{
+			WriteAnalog(buffer, i);
+		}
+		start = stop + 2;
+	}
+	return buffer;
+}
+
+typedef std::function<ParseResult (const RSlice&, IAPDUHandler&)> ParseFun;
+
+double MeasureNanosPerParse(const vector<uint8_t>& fragment, uint32_t iterations, const ParseFun& parse)
+{
+	RSlice slice(fragment.data(), static_cast<uint32_t>(fragment.size()));
+	AnalogSumHandler handler;
+
+	auto start = chrono::steady_clock::now();
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		if (parse(slice, handler) != ParseResult::OK)
+		{
+			cerr << "parse failed" << endl;
+			exit(-1);
+		}
+	}
+	auto elapsed = chrono::steady_clock::now() - start;
+
+	return static_cast<double>(chrono::duration_cast<chrono::nanoseconds>(elapsed).count()) / iterations;
+}
+
+void Compare(const string& name, const vector<uint8_t>& fragment, uint32_t iterations)
+{
+	auto singlePass = [](const RSlice & buffer, IAPDUHandler & handler)
+	{
+		return APDUParser::Parse(buffer, handler, nullptr);
+	};
+
+	auto twoPass = [](const RSlice & buffer, IAPDUHandler & handler)
+	{
+		return APDUParser::ParseTwoPass(buffer, handler, nullptr);
+	};
+
+	// warm up caches and branch predictors before timing either mode
+	MeasureNanosPerParse(fragment, iterations / 10, twoPass);
+
+	auto twoPassNanos = MeasureNanosPerParse(fragment, iterations, twoPass);
+	auto singlePassNanos = MeasureNanosPerParse(fragment, iterations, singlePass);
+
+	cout << setw(28) << left << name
+	     << setw(8) << right << fragment.size() << " bytes"
+	     << setw(12) << fixed << setprecision(0) << twoPassNanos << " ns"
+	     << setw(12) << singlePassNanos << " ns"
+	     << setw(10) << setprecision(1) << (100.0 * (twoPassNanos - singlePassNanos) / twoPassNanos) << " %" << endl;
+}
+
+double MeasureNanosPerValue(const vector<uint8_t>& fragment, uint32_t numValues, uint32_t iterations, bool batch)
+{
+	RSlice slice(fragment.data(), static_cast<uint32_t>(fragment.size()));
+	std::unique_ptr<AnalogCopyHandler> handler(new AnalogCopyHandler(batch));
+
+	auto start = chrono::steady_clock::now();
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		if (APDUParser::Parse(slice, *handler, nullptr) != ParseResult::OK)
+		{
+			cerr << "parse failed" << endl;
+			exit(-1);
+		}
+	}
+	auto elapsed = chrono::steady_clock::now() - start;
+
+	return static_cast<double>(chrono::duration_cast<chrono::nanoseconds>(elapsed).count()) / (static_cast<double>(iterations) * numValues);
+}
+
+void CompareCopy(const string& name, const vector<uint8_t>& fragment, uint32_t numValues, uint32_t iterations)
+{
+	MeasureNanosPerValue(fragment, numValues, iterations / 10, false);
+
+	auto visitorNanos = MeasureNanosPerValue(fragment, numValues, iterations, false);
+	auto batchNanos = MeasureNanosPerValue(fragment, numValues, iterations, true);
+
+	cout << setw(28) << left << name
+	     << setw(8) << right << numValues << " values"
+	     << setw(11) << fixed << setprecision(2) << visitorNanos << " ns"
+	     << setw(12) << batchNanos << " ns"
+	     << setw(10) << setprecision(1) << (100.0 * (visitorNanos - batchNanos) / visitorNanos) << " %" << endl;
+}
+
+/// every supported group/variation in a fixed random order so that neither lookup benefits from branch prediction
+vector<uint16_t> ShuffledGroupVariations()
+{
+	vector<uint16_t> ids;
+	for (uint32_t id = 0; id <= 0xFFFF; ++id)
+	{
+		if (GroupVariationFromType(static_cast<uint16_t>(id)) != GroupVariation::UNKNOWN)
+		{
+			ids.push_back(static_cast<uint16_t>(id));
+		}
+	}
+	std::mt19937 rng(42);
+	std::shuffle(ids.begin(), ids.end(), rng);
+	return ids;
+}
+
+double MeasureNanosPerLookup(const vector<uint16_t>& ids, uint32_t iterations, bool table)
+{
+	uint32_t checksum = 0;
+
+	auto start = chrono::steady_clock::now();
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		for (auto id : ids)
+		{
+			auto gv = table ?
+			          GroupVariationRecord::GetEnumAndType(static_cast<uint8_t>(id >> 8), static_cast<uint8_t>(id & 0xFF)).enumeration :
+			          GroupVariationFromType(id);
+			checksum += static_cast<uint16_t>(gv);
+		}
+	}
+	auto elapsed = chrono::steady_clock::now() - start;
+
+	if (checksum == 0)
+	{
+		cerr << "unexpected checksum" << endl;
+	}
+
+	return static_cast<double>(chrono::duration_cast<chrono::nanoseconds>(elapsed).count()) / (static_cast<double>(iterations) * ids.size());
+}
+
+void CompareLookup(uint32_t iterations)
+{
+	auto ids = ShuffledGroupVariations();
+
+	MeasureNanosPerLookup(ids, iterations / 10, false);
+
+	auto switchNanos = MeasureNanosPerLookup(ids, iterations, false);
+	auto tableNanos = MeasureNanosPerLookup(ids, iterations, true);
+
+	cout << setw(28) << left << "all group/variations"
+	     << setw(8) << right << ids.size() << " ids   "
+	     << setw(11) << fixed << setprecision(2) << switchNanos << " ns"
+	     << setw(12) << tableNanos << " ns"
+	     << setw(10) << setprecision(1) << (100.0 * (switchNanos - tableNanos) / switchNanos) << " %" << endl;
+}
+
+/// 64K points, the largest range a 2-byte start/stop bitfield iterator can count
+const uint32_t NUM_BITFIELD_POINTS = 65535;
+
+vector<uint8_t> BitfieldStates(uint8_t bits)
+{
+	vector<uint8_t> states(NUM_BITFIELD_POINTS);
+	std::mt19937 rng(42);
+	for (auto& state : states)
+	{
+		state = static_cast<uint8_t>(rng() & ((1u << bits) - 1));
+	}
+	return states;
+}
+
+/// the original packing loop, a read-modify-write of the output byte for every bit
+void PackBitAtATime(const vector<uint8_t>& states, uint8_t* dest)
+{
+	for (uint32_t count = 0; count < states.size(); ++count)
+	{
+		auto byte = count / 8;
+		auto bit = count % 8;
+
+		if (bit == 0)
+		{
+			dest[byte] = 0;
+		}
+
+		if (states[count])
+		{
+			dest[byte] = (dest[byte] | (1 << bit));
+		}
+	}
+}
+
+void PackWordAtATime(const vector<uint8_t>& states, uint8_t* dest)
+{
+	WSlice position(dest, NUM_BITFIELD_POINTS / 8 + 5);
+	BitfieldRangeWriteIterator<UInt16> iter(0, position);
+	for (auto state : states)
+	{
+		iter.Write(state != 0);
+	}
+}
+
+template <class Fun>
+double MeasureNanosPerPoint(uint32_t iterations, const Fun& fun)
+{
+	auto start = chrono::steady_clock::now();
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		fun();
+	}
+	auto elapsed = chrono::steady_clock::now() - start;
+
+	return static_cast<double>(chrono::duration_cast<chrono::nanoseconds>(elapsed).count()) / (static_cast<double>(iterations) * NUM_BITFIELD_POINTS);
+}
+
+void PrintBitfieldResult(const string& name, double bitNanos, double wordNanos)
+{
+	cout << setw(28) << left << name
+	     << setw(8) << right << NUM_BITFIELD_POINTS << " points"
+	     << setw(11) << fixed << setprecision(2) << bitNanos << " ns"
+	     << setw(12) << wordNanos << " ns"
+	     << setw(10) << setprecision(1) << (100.0 * (bitNanos - wordNanos) / bitNanos) << " %" << endl;
+}
+
+void ComparePacking(uint32_t iterations)
+{
+	auto states = BitfieldStates(1);
+	vector<uint8_t> bitBuffer(NUM_BITFIELD_POINTS / 8 + 1);
+	vector<uint8_t> wordBuffer(NUM_BITFIELD_POINTS / 8 + 5);
+
+	auto bit = [&]()
+	{
+		PackBitAtATime(states, bitBuffer.data());
+	};
+	auto word = [&]()
+	{
+		PackWordAtATime(states, wordBuffer.data());
+	};
+
+	MeasureNanosPerPoint(iterations / 10, bit);
+
+	auto bitNanos = MeasureNanosPerPoint(iterations, bit);
+	auto wordNanos = MeasureNanosPerPoint(iterations, word);
+
+	if (!std::equal(bitBuffer.begin(), bitBuffer.end(), wordBuffer.begin() + 4))
+	{
+		cerr << "packed bitfields differ" << endl;
+		exit(-1);
+	}
+
+	PrintBitfieldResult("g1v1 pack", bitNanos, wordNanos);
+}
+
+vector<uint8_t> Pack(const vector<uint8_t>& states, uint8_t bits)
+{
+	vector<uint8_t> packed((states.size() * bits + 7) / 8, 0);
+	for (uint32_t i = 0; i < states.size(); ++i)
+	{
+		packed[(i * bits) / 8] |= static_cast<uint8_t>(states[i] << ((i * bits) % 8));
+	}
+	return packed;
+}
+
+template <class T, uint8_t BITS, class Read>
+void CompareUnpacking(const string& name, uint32_t iterations, const Read& read)
+{
+	const auto packed = Pack(BitfieldStates(BITS), BITS);
+	const RSlice slice(packed.data(), static_cast<uint32_t>(packed.size()));
+
+	vector<Indexed<T>> bitValues(NUM_BITFIELD_POINTS);
+	vector<Indexed<T>> wordValues(NUM_BITFIELD_POINTS);
+
+	// the collection the range parser used before, invoking the read function for every point
+	auto reference = CreateBufferedCollection<Indexed<T>>(slice, NUM_BITFIELD_POINTS, read);
+	BitfieldCollection<T, BITS> collection(slice, 0, NUM_BITFIELD_POINTS);
+
+	auto bit = [&]()
+	{
+		reference.ReadInto(bitValues.data(), NUM_BITFIELD_POINTS);
+	};
+	auto word = [&]()
+	{
+		collection.ReadInto(wordValues.data(), NUM_BITFIELD_POINTS);
+	};
+
+	MeasureNanosPerPoint(iterations / 10, bit);
+
+	auto bitNanos = MeasureNanosPerPoint(iterations, bit);
+	auto wordNanos = MeasureNanosPerPoint(iterations, word);
+
+	for (uint32_t i = 0; i < NUM_BITFIELD_POINTS; ++i)
+	{
+		if (!(bitValues[i].index == wordValues[i].index && bitValues[i].value.value == wordValues[i].value.value))
+		{
+			cerr << "unpacked bitfields differ" << endl;
+			exit(-1);
+		}
+	}
+
+	PrintBitfieldResult(name, bitNanos, wordNanos);
+}
+
+void CompareBitfields(uint32_t iterations)
+{
+	ComparePacking(iterations);
+
+	CompareUnpacking<Binary, 1>("g1v1 unpack", iterations, [](openpal::RSlice & buffer, uint32_t pos)
+	{
+		return WithIndex(Binary(GetBit(buffer, pos)), static_cast<uint16_t>(pos));
+	});
+
+	CompareUnpacking<DoubleBitBinary, 2>("g3v1 unpack", iterations, [](openpal::RSlice & buffer, uint32_t pos)
+	{
+		return WithIndex(DoubleBitBinary(GetDoubleBit(buffer, pos)), static_cast<uint16_t>(pos));
+	});
+}
+
+int main(int argc, char* argv[])
+{
+	const uint32_t ITERATIONS = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : 100000;
+
+	cout << setw(28) << left << "fragment"
+	     << setw(14) << right << "size"
+	     << setw(15) << "two pass"
+	     << setw(15) << "single pass"
+	     << setw(12) << "gain" << endl;
+
+	Compare("g32v1 events, 1 header", BuildEventResponse(290), ITERATIONS);
+	Compare("g30v1 static, 8 headers", BuildStaticResponse(8, 48), ITERATIONS);
+	Compare("g30v1 static, 30 headers", BuildStaticResponse(30, 8), ITERATIONS);
+	Compare("g30v1 static, 60 headers", BuildStaticResponse(60, 4), ITERATIONS);
+
+	cout << endl << setw(28) << left << "per value copy"
+	     << setw(15) << right << "count"
+	     << setw(14) << "visitor"
+	     << setw(15) << "ReadInto"
+	     << setw(12) << "gain" << endl;
+
+	CompareCopy("g32v1 events, 1 header", BuildEventResponse(290), 290, ITERATIONS);
+	CompareCopy("g30v1 static, 1 header", BuildStaticResponse(1, 400), 400, ITERATIONS);
+
+	cout << endl << setw(28) << left << "header lookup"
+	     << setw(15) << right << "count"
+	     << setw(14) << "switch"
+	     << setw(15) << "table"
+	     << setw(12) << "gain" << endl;
+
+	CompareLookup(ITERATIONS / 10);
+
+	cout << endl << setw(28) << left << "bitfield"
+	     << setw(15) << right << "count"
+	     << setw(14) << "bit"
+	     << setw(15) << "word"
+	     << setw(12) << "gain" << endl;
+
+	CompareBitfields(ITERATIONS / 1000);
+
+	return 0;
+}
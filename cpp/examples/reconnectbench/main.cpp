@@ -0,0 +1,562 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <asiodnp3/DNP3Manager.h>
+#include <asiodnp3/DefaultMasterApplication.h>
+#include <asiodnp3/PrintingSOEHandler.h>
+
+#include <opendnp3/LogLevels.h>
+
+#include <asio.hpp>
+
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace openpal;
+using namespace asiodnp3;
+using namespace opendnp3;
+
+/**
+* Simulates a head-end restart against the tcp client channels of one manager.
+*
+* A forked child plays the head-end. It listens with a small accept backlog and spends a fixed amount of
+* CPU on each accepted connection, standing in for a handshake. Once it has accepted every channel it
+* drops all of its connections and refuses new ones for a while, so every channel backs off in lock step
+* and then reconnects at the same instant. A burst like that overflows the backlog: dropped SYNs are only
+* retransmitted after a second or more, and with syncookies a client may even believe it is connected
+* when the head-end never accepted it, which is only noticed when the link keep-alive fails.
+*
+* The head-end times its accepts, so the results count a channel as back once the head-end has it. The
+* restart is run once without limits and once with the manager's open admission control. One channel in a
+* hundred has a higher ChannelRetry::priority, its reconnect time is measured on the client side.
+*
+* usage: reconnectbench [channels] [port] [max concurrent opens] [opens per second] [accept cost us] [backlog] [down ms]
+*/
+
+const uint16_t MASTER_ADDRESS = 1;
+const uint16_t FIRST_REMOTE_ADDRESS = 10;
+const uint32_t PRIORITY_INTERVAL = 100;
+const uint8_t HIGH_PRIORITY = 10;
+const int REPORT_TIMEOUT_MS = 150000;
+
+// commands from the parent to the head-end
+const char COUNT_ACCEPTS = 'c';
+const char RESTART = 'r';
+const char REPORT_NOW = 'q';
+
+/// Raise the file descriptor limit as far as the hard limit allows
+rlim_t RaiseDescriptorLimit()
+{
+	rlimit limit;
+	if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+	{
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+		getrlimit(RLIMIT_NOFILE, &limit);
+		return limit.rlim_cur;
+	}
+	return 0;
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+* The simulated remote side. Holds every accepted connection until the peer closes it or the head-end
+* restarts, and reports the times of the accepts since the last command once it has the expected number.
+*/
+class HeadEnd
+{
+public:
+
+	HeadEnd(asio::io_service& service, uint16_t port, int backlog, uint32_t acceptCostUs, uint32_t expected, int results) :
+		endpoint(asio::ip::address::from_string("127.0.0.1"), port),
+		acceptor(service),
+		socket(service),
+		timer(service),
+		backlog(backlog),
+		acceptCostUs(acceptCostUs),
+		expected(expected),
+		results(results),
+		reported(true)
+	{
+		this->Listen();
+	}
+
+	void CountAccepts()
+	{
+		acceptTimes.clear();
+		since = std::chrono::steady_clock::now();
+		reported = false;
+	}
+
+	/// Drop every connection and stop listening for a while
+	void Restart(uint32_t downMs)
+	{
+		this->CountAccepts();
+
+		std::error_code ec;
+		acceptor.close(ec);
+		for (auto& connection : connections)
+		{
+			// reset rather than linger in TIME_WAIT, all the clients share one address and reuse its ports quickly
+			connection->socket.set_option(asio::socket_base::linger(true, 0), ec);
+			connection->socket.close(ec);
+		}
+		connections.clear();
+
+		timer.expires_from_now(std::chrono::milliseconds(downMs));
+		timer.async_wait([this](const std::error_code & ec)
+		{
+			if (!ec)
+			{
+				this->Listen();
+			}
+		});
+	}
+
+	void Report()
+	{
+		if (reported)
+		{
+			return;
+		}
+
+		reported = true;
+		uint32_t count = static_cast<uint32_t>(acceptTimes.size());
+		if (write(results, &count, sizeof(count)) != sizeof(count) || write(results, acceptTimes.data(), count * sizeof(double)) != static_cast<ssize_t>(count * sizeof(double)))
+		{
+			std::cout << "Unable to report to the parent" << std::endl;
+		}
+	}
+
+private:
+
+	struct Connection
+	{
+		Connection(asio::ip::tcp::socket socket) : socket(std::move(socket)) {}
+
+		asio::ip::tcp::socket socket;
+		uint8_t buffer[256];
+	};
+
+	void Listen()
+	{
+		acceptor.open(endpoint.protocol());
+		acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true));
+		acceptor.bind(endpoint);
+		acceptor.listen(backlog);
+		this->Accept();
+	}
+
+	void Accept()
+	{
+		acceptor.async_accept(socket, [this](const std::error_code & ec)
+		{
+			if (ec)
+			{
+				return;
+			}
+
+			// the head-end restarted after this connection was accepted
+			if (!acceptor.is_open())
+			{
+				std::error_code ignored;
+				socket.close(ignored);
+				return;
+			}
+
+			// stands in for the per-connection work of the remote side, i.e. a handshake
+			auto start = std::chrono::steady_clock::now();
+			while (std::chrono::steady_clock::now() - start < std::chrono::microseconds(acceptCostUs)) {}
+
+			auto connection = std::make_shared<Connection>(std::move(socket));
+			connections.push_back(connection);
+			this->Read(connection);
+
+			if (!reported)
+			{
+				acceptTimes.push_back(ElapsedMs(since));
+				if (acceptTimes.size() == expected)
+				{
+					this->Report();
+				}
+			}
+
+			this->Accept();
+		});
+	}
+
+	void Read(std::shared_ptr<Connection> connection)
+	{
+		connection->socket.async_read_some(asio::buffer(connection->buffer), [this, connection](const std::error_code & ec, std::size_t)
+		{
+			if (!ec)
+			{
+				this->Read(connection);
+			}
+		});
+	}
+
+	asio::ip::tcp::endpoint endpoint;
+	asio::ip::tcp::acceptor acceptor;
+	asio::ip::tcp::socket socket;
+	asio::steady_timer timer;
+	int backlog;
+	uint32_t acceptCostUs;
+	uint32_t expected;
+	int results;
+
+	bool reported;
+	std::chrono::steady_clock::time_point since;
+	std::vector<double> acceptTimes;
+	std::vector<std::shared_ptr<Connection>> connections;
+};
+
+/// Body of the forked head-end process, runs the commands of the parent until the control pipe closes
+int RunHeadEnd(int control, int results, uint16_t port, int backlog, uint32_t acceptCostUs, uint32_t downMs, uint32_t expected)
+{
+	asio::io_service service;
+	std::unique_ptr<HeadEnd> headend;
+
+	try
+	{
+		headend.reset(new HeadEnd(service, port, backlog, acceptCostUs, expected, results));
+	}
+	catch (const std::exception& ex)
+	{
+		std::cout << "Unable to listen on port " << port << ": " << ex.what() << std::endl;
+		return -1;
+	}
+
+	std::thread thread([&service]()
+	{
+		asio::io_service::work work(service);
+		service.run();
+	});
+
+	auto pHeadEnd = headend.get();
+	char command = 0;
+	while (read(control, &command, 1) > 0)
+	{
+		service.post([pHeadEnd, command, downMs]()
+		{
+			switch (command)
+			{
+			case(COUNT_ACCEPTS):
+				pHeadEnd->CountAccepts();
+				break;
+			case(RESTART):
+				pHeadEnd->Restart(downMs);
+				break;
+			default:
+				pHeadEnd->Report();
+				break;
+			}
+		});
+	}
+
+	service.stop();
+	thread.join();
+	return 0;
+}
+
+/// The parent's end of the pipes to the head-end
+class HeadEndControl
+{
+public:
+
+	HeadEndControl(int control, int results) : control(control), results(results)
+	{}
+
+	bool Send(char command)
+	{
+		return write(control, &command, 1) == 1;
+	}
+
+	/// Wait for the head-end to accept everyone, or ask for what it has after the timeout
+	std::vector<double> WaitForAccepts()
+	{
+		pollfd fd = { results, POLLIN, 0 };
+		if (poll(&fd, 1, REPORT_TIMEOUT_MS) <= 0)
+		{
+			this->Send(REPORT_NOW);
+		}
+
+		uint32_t count = 0;
+		if (!this->Read(&count, sizeof(count)))
+		{
+			return std::vector<double>();
+		}
+
+		std::vector<double> times(count);
+		this->Read(times.data(), count * sizeof(double));
+		return times;
+	}
+
+private:
+
+	bool Read(void* data, size_t size)
+	{
+		auto pos = static_cast<uint8_t*>(data);
+		while (size > 0)
+		{
+			auto num = read(results, pos, size);
+			if (num <= 0)
+			{
+				return false;
+			}
+			pos += num;
+			size -= num;
+		}
+		return true;
+	}
+
+	int control;
+	int results;
+};
+
+struct Result
+{
+	Result() : numOpenFail(0), numAdmitted(0), totalWaitMs(0), totalOpenMs(0) {}
+
+	uint32_t numOpenFail;
+	std::vector<double> accepts;
+	std::vector<double> priority;
+
+	// admission counters of the restart alone
+	uint32_t numAdmitted;
+	uint64_t totalWaitMs;
+	uint64_t totalOpenMs;
+};
+
+Result RunRestart(uint32_t numChannels, uint16_t port, HeadEndControl& headend, const OpenAdmissionSettings& settings)
+{
+	Result result;
+
+	DNP3Manager manager(std::thread::hardware_concurrency());
+
+	// connect everyone gently to begin with, so that the head-end really has all of them
+	OpenAdmissionSettings gentle;
+	gentle.maxConcurrentOpens = 16;
+	gentle.opensPerSecond = 1000;
+	manager.SetOpenAdmission(gentle);
+
+	std::vector<double> onlineMs(numChannels, 0);
+	std::atomic<bool> restarted(false);
+	std::chrono::steady_clock::time_point start;
+
+	std::vector<IChannel*> channels;
+	std::vector<IMaster*> masters;
+
+	for (uint32_t i = 0; i < numChannels; ++i)
+	{
+		ChannelRetry retry(TimeDuration::Milliseconds(100), TimeDuration::Seconds(5));
+		retry.priority = (i % PRIORITY_INTERVAL == 0) ? HIGH_PRIORITY : 0;
+
+		auto id = "client-" + std::to_string(i);
+		auto channel = manager.AddTCPClient(id.c_str(), levels::NOTHING, retry, "127.0.0.1", "0.0.0.0", port);
+
+		auto slot = &onlineMs[i];
+		auto pStart = &start;
+		auto pRestarted = &restarted;
+		channel->AddStateListener([slot, pStart, pRestarted](ChannelState state)
+		{
+			if (state == ChannelState::OPEN && *pRestarted && *slot == 0)
+			{
+				*slot = ElapsedMs(*pStart);
+			}
+		});
+
+		// a quiet master that never initiates anything
+		MasterStackConfig config;
+		config.master.disableUnsolOnStartup = false;
+		config.master.startupIntegrityClassMask = ClassField::None();
+		config.master.unsolClassMask = ClassField::None();
+		config.link.LocalAddr = MASTER_ADDRESS;
+		config.link.RemoteAddr = static_cast<uint16_t>(FIRST_REMOTE_ADDRESS + i);
+
+		channels.push_back(channel);
+		masters.push_back(channel->AddMaster(id.c_str(), PrintingSOEHandler::Instance(), DefaultMasterApplication::Instance(), config));
+	}
+
+	headend.Send(COUNT_ACCEPTS);
+	for (auto master : masters)
+	{
+		master->Enable();
+	}
+
+	if (headend.WaitForAccepts().size() != numChannels)
+	{
+		std::cout << "The head-end did not accept every channel during setup" << std::endl;
+		return result;
+	}
+
+	// only the opens caused by the restart are of interest
+	manager.SetOpenAdmission(settings);
+	for (auto channel : channels)
+	{
+		result.numOpenFail -= channel->GetChannelStatistics().numOpenFail;
+	}
+
+	auto before = manager.GetOpenAdmissionStatistics();
+
+	start = std::chrono::steady_clock::now();
+	restarted = true;
+	headend.Send(RESTART);
+
+	result.accepts = headend.WaitForAccepts();
+
+	auto after = manager.GetOpenAdmissionStatistics();
+	result.numAdmitted = after.numAdmitted - before.numAdmitted;
+	result.totalWaitMs = after.totalWaitMs - before.totalWaitMs;
+	result.totalOpenMs = after.totalOpenMs - before.totalOpenMs;
+
+	for (auto channel : channels)
+	{
+		result.numOpenFail += channel->GetChannelStatistics().numOpenFail;
+	}
+
+	// no more state callbacks once the channels are gone
+	manager.Shutdown();
+
+	for (uint32_t i = 0; i < numChannels; i += PRIORITY_INTERVAL)
+	{
+		if (onlineMs[i] > 0)
+		{
+			result.priority.push_back(onlineMs[i]);
+		}
+	}
+
+	return result;
+}
+
+double Percentile(std::vector<double> values, double fraction)
+{
+	if (values.empty())
+	{
+		return 0;
+	}
+	std::sort(values.begin(), values.end());
+	auto index = static_cast<size_t>(fraction * (values.size() - 1));
+	return values[index];
+}
+
+void Print(const char* name, uint32_t numChannels, const Result& result)
+{
+	auto print = [](const char* label, const std::vector<double>& values)
+	{
+		std::cout << "  " << label << " p50 / p99 / max:  "
+		          << static_cast<uint32_t>(Percentile(values, 0.50)) << " / "
+		          << static_cast<uint32_t>(Percentile(values, 0.99)) << " / "
+		          << static_cast<uint32_t>(Percentile(values, 1.0)) << " ms" << std::endl;
+	};
+
+	std::cout << name << std::endl;
+	std::cout << "  accepted by the head-end:    " << result.accepts.size() << " of " << numChannels << std::endl;
+	std::cout << "  failed opens:                " << result.numOpenFail << std::endl;
+	print("accepted", result.accepts);
+	print("priority", result.priority);
+
+	if (result.numAdmitted)
+	{
+		std::cout << "  admission wait avg:          " << result.totalWaitMs / result.numAdmitted << " ms" << std::endl;
+		std::cout << "  attempt avg:                 " << result.totalOpenMs / result.numAdmitted << " ms" << std::endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const uint32_t NUM_CHANNELS = (argc > 1) ? std::stoul(argv[1]) : 5000;
+	const uint16_t PORT = (argc > 2) ? static_cast<uint16_t>(std::stoul(argv[2])) : 20000;
+	const uint32_t MAX_CONCURRENT = (argc > 3) ? std::stoul(argv[3]) : 64;
+	const uint32_t OPENS_PER_SECOND = (argc > 4) ? std::stoul(argv[4]) : 2500;
+	const uint32_t ACCEPT_COST_US = (argc > 5) ? std::stoul(argv[5]) : 200;
+	const int BACKLOG = (argc > 6) ? std::stoi(argv[6]) : 128;
+	const uint32_t DOWN_MS = (argc > 7) ? std::stoul(argv[7]) : 500;
+
+	auto fdLimit = RaiseDescriptorLimit();
+	if (fdLimit < 2 * NUM_CHANNELS + 64)
+	{
+		std::cout << "Descriptor limit " << fdLimit << " is too low for " << NUM_CHANNELS << " channels" << std::endl;
+		return -1;
+	}
+
+	// fork before any threads exist, the child only ever uses its own io_service
+	int control[2];
+	int results[2];
+	if (pipe(control) != 0 || pipe(results) != 0)
+	{
+		return -1;
+	}
+
+	auto child = fork();
+	if (child < 0)
+	{
+		return -1;
+	}
+
+	if (child == 0)
+	{
+		close(control[1]);
+		close(results[0]);
+		exit(RunHeadEnd(control[0], results[1], PORT, BACKLOG, ACCEPT_COST_US, DOWN_MS, NUM_CHANNELS));
+	}
+
+	close(control[0]);
+	close(results[1]);
+
+	HeadEndControl headend(control[1], results[0]);
+
+	std::cout << "channels: " << NUM_CHANNELS << ", accept cost: " << ACCEPT_COST_US << " us, backlog: " << BACKLOG << ", head-end down for: " << DOWN_MS << " ms" << std::endl;
+
+	auto unlimited = RunRestart(NUM_CHANNELS, PORT, headend, OpenAdmissionSettings());
+	Print("no admission control", NUM_CHANNELS, unlimited);
+
+	OpenAdmissionSettings settings;
+	settings.maxConcurrentOpens = MAX_CONCURRENT;
+	settings.opensPerSecond = OPENS_PER_SECOND;
+	settings.openBurst = MAX_CONCURRENT;
+	settings.fullJitter = true;
+
+	auto limited = RunRestart(NUM_CHANNELS, PORT, headend, settings);
+	std::cout << "max concurrent opens: " << MAX_CONCURRENT << ", opens per second: " << OPENS_PER_SECOND << ", full jitter" << std::endl;
+	Print("admission control", NUM_CHANNELS, limited);
+
+	close(control[1]);
+	waitpid(child, nullptr, 0);
+
+	return (unlimited.accepts.size() == NUM_CHANNELS && limited.accepts.size() == NUM_CHANNELS) ? 0 : -1;
+}
@@ -0,0 +1,266 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <asiopal/PhysicalLayerSerial.h>
+
+#include <openpal/channel/IPhysicalLayerCallbacks.h>
+#include <openpal/logging/LogRoot.h>
+
+#include <asio.hpp>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace openpal;
+using namespace asiopal;
+
+/**
+* Measures the serial read path against a pseudo terminal.
+*
+* A writer thread plays a remote device on the master side of the pty. It sends each request one byte per
+* character time at the configured baud rate, the way a UART without a receive FIFO would hand them over,
+* then waits for the response. The serial layer reads the slave side and answers each complete request.
+*
+* The run is repeated with the default read path, with inter-character batching and with batching plus an
+* RS-485 turnaround delay. For each it reports the wakeups of the read path per request and the turnaround
+* time, from the last request byte leaving the writer until the response is readable on the master side.
+*
+* usage: serialbench [frames] [frame size] [baud] [turnaround ms]
+*/
+
+const uint32_t RESPONSE_SIZE = 16;
+const uint32_t READ_SIZE = 292;
+const int FRAME_GAP_MS = 10;
+
+struct Result
+{
+	uint32_t reads;
+	uint32_t interCharWakeups;
+	vector<double> turnaroundMs;
+};
+
+/// Answers every request of frameSize bytes with a fixed response
+class Responder final : public IPhysicalLayerCallbacks
+{
+public:
+
+	Responder(asio::io_service& service, IPhysicalLayer& layer, uint32_t frameSize) :
+		service(service),
+		layer(layer),
+		frameSize(frameSize),
+		numReceived(0),
+		response(RESPONSE_SIZE, 0x55)
+	{
+		layer.SetHandler(this);
+	}
+
+	void OnLowerLayerUp() override
+	{
+		this->Read();
+	}
+
+	void OnLowerLayerDown() override
+	{
+		service.stop();
+	}
+
+	void OnOpenFailure() override
+	{
+		cerr << "unable to open the pty slave" << endl;
+		service.stop();
+	}
+
+	void OnReceive(const RSlice& data) override
+	{
+		numReceived += data.Size();
+		if (numReceived >= frameSize)
+		{
+			numReceived -= frameSize;
+			layer.BeginWrite(RSlice(response.data(), static_cast<uint32_t>(response.size())));
+		}
+		this->Read();
+	}
+
+	void OnSendResult(bool) override {}
+
+private:
+
+	void Read()
+	{
+		WSlice dest(buffer, READ_SIZE);
+		layer.BeginRead(dest);
+	}
+
+	asio::io_service& service;
+	IPhysicalLayer& layer;
+	uint32_t frameSize;
+	uint32_t numReceived;
+	vector<uint8_t> response;
+	uint8_t buffer[READ_SIZE];
+};
+
+/// Plays the remote device on the master side of the pty, returns the turnaround of each request
+vector<double> RunDevice(int master, uint32_t frames, uint32_t frameSize, uint32_t baud)
+{
+	// 10 bits per character: start, 8 data, stop
+	const auto charTime = chrono::nanoseconds(10000000000LL / baud);
+	vector<double> turnarounds;
+	vector<uint8_t> request(frameSize, 0xAA);
+	uint8_t response[RESPONSE_SIZE * 4];
+
+	for (uint32_t i = 0; i < frames; ++i)
+	{
+		auto next = chrono::steady_clock::now();
+		for (auto byte : request)
+		{
+			this_thread::sleep_until(next);
+			if (write(master, &byte, 1) != 1)
+			{
+				return turnarounds;
+			}
+			next += charTime;
+		}
+
+		auto sent = chrono::steady_clock::now();
+		pollfd fd = { master, POLLIN, 0 };
+		if (poll(&fd, 1, 1000) <= 0)
+		{
+			cerr << "no response to request " << i << endl;
+			return turnarounds;
+		}
+		turnarounds.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - sent).count());
+
+		// drain the whole response before the next request
+		uint32_t numRead = 0;
+		while (numRead < RESPONSE_SIZE && poll(&fd, 1, 1000) > 0)
+		{
+			auto num = read(master, response, sizeof(response));
+			if (num <= 0)
+			{
+				break;
+			}
+			numRead += static_cast<uint32_t>(num);
+		}
+
+		this_thread::sleep_for(chrono::milliseconds(FRAME_GAP_MS));
+	}
+
+	return turnarounds;
+}
+
+Result Run(const SerialSettings& base, uint32_t frames, uint32_t frameSize, uint32_t baud)
+{
+	Result result = { 0, 0, {} };
+
+	int master = posix_openpt(O_RDWR | O_NOCTTY);
+	if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0)
+	{
+		cerr << "unable to allocate a pty" << endl;
+		return result;
+	}
+
+	SerialSettings settings(base);
+	settings.deviceName = ptsname(master);
+	settings.baud = baud;
+	settings.asyncOpenDelay = TimeDuration::Zero();
+
+	asio::io_service service;
+	LogRoot root(nullptr, "serial", 0);
+	ChannelStatistics statistics;
+	PhysicalLayerSerial layer(root, service, settings);
+	layer.SetChannelStatistics(&statistics);
+	Responder responder(service, layer, frameSize);
+
+	thread device([&]()
+	{
+		// give the layer a moment to configure the port before the first request
+		this_thread::sleep_for(chrono::milliseconds(100));
+		result.turnaroundMs = RunDevice(master, frames, frameSize, baud);
+		IPhysicalLayer* pLayer = &layer;
+		service.post([pLayer]()
+		{
+			pLayer->BeginClose();
+		});
+	});
+
+	layer.BeginOpen();
+	service.run();
+	device.join();
+	close(master);
+
+	result.reads = statistics.numReads;
+	result.interCharWakeups = statistics.numInterCharWakeups;
+	return result;
+}
+
+void Report(const string& name, const Result& result, uint32_t frames)
+{
+	auto turnarounds = result.turnaroundMs;
+	sort(turnarounds.begin(), turnarounds.end());
+	auto median = turnarounds.empty() ? 0.0 : turnarounds[turnarounds.size() / 2];
+	auto max = turnarounds.empty() ? 0.0 : turnarounds.back();
+
+	cout << name << endl;
+	cout << "  requests answered:   " << turnarounds.size() << " / " << frames << endl;
+	cout << "  reads:               " << result.reads << endl;
+	cout << "  inter-char wakeups:  " << result.interCharWakeups << endl;
+	cout << "  wakeups per request: " << static_cast<double>(result.reads + result.interCharWakeups) / frames << endl;
+	cout << "  turnaround median:   " << median << " ms" << endl;
+	cout << "  turnaround max:      " << max << " ms" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+	uint32_t frames = (argc > 1) ? atoi(argv[1]) : 100;
+	uint32_t frameSize = (argc > 2) ? atoi(argv[2]) : 64;
+	uint32_t baud = (argc > 3) ? atoi(argv[3]) : 19200;
+	int turnaroundMs = (argc > 4) ? atoi(argv[4]) : 5;
+
+	// the usual modbus style gap of 3.5 character times, but at least a millisecond
+	auto charTimeUs = 10000000 / baud;
+	auto interChar = TimeDuration::Milliseconds(std::max<int64_t>(1, (35 * charTimeUs / 10 + 999) / 1000));
+
+	cout << frames << " requests of " << frameSize << " bytes at " << baud << " baud, inter-character timeout "
+	     << interChar.GetMilliseconds() << " ms" << endl << endl;
+
+	SerialSettings plain;
+	Report("default read path", Run(plain, frames, frameSize, baud), frames);
+
+	SerialSettings batching;
+	batching.interCharTimeout = interChar;
+	Report("inter-character batching", Run(batching, frames, frameSize, baud), frames);
+
+	SerialSettings turnaround(batching);
+	turnaround.turnaroundDelay = TimeDuration::Milliseconds(turnaroundMs);
+	Report("batching with turnaround delay", Run(turnaround, frames, frameSize, baud), frames);
+
+	return 0;
+}
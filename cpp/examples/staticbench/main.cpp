@@ -0,0 +1,236 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <opendnp3/outstation/DatabaseBuffers.h>
+#include <opendnp3/app/APDUResponse.h>
+#include <opendnp3/app/parsing/APDUParser.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace openpal;
+using namespace opendnp3;
+
+/**
+* Compares static responses built with start/stop range headers only and with
+* OutstationParams::planStaticQualifiers, on discontiguous index maps and partial
+* selections of analog values. Reports fragments, bytes, and the time to build
+* every fragment of the response.
+*/
+
+const uint32_t FRAGMENT_SIZE = 2048;
+
+struct Totals
+{
+	uint32_t fragments;
+	uint32_t bytes;
+	uint32_t values;
+	double micros;
+};
+
+/// counts the analogs in a response to check that the planned headers decode to the same values
+class AnalogCounter final : public IAPDUHandler
+{
+public:
+
+	uint32_t count = 0;
+
+	virtual bool IsAllowed(uint32_t headerCount, GroupVariation gv, QualifierCode qc) override
+	{
+		return true;
+	}
+
+private:
+
+	virtual IINField ProcessHeader(const RangeHeader& header, const ICollection<Indexed<Analog>>& values) override
+	{
+		count += values.Count();
+		return IINField::Empty();
+	}
+
+	virtual IINField ProcessHeader(const PrefixHeader& header, const ICollection<Indexed<Analog>>& values) override
+	{
+		count += values.Count();
+		return IINField::Empty();
+	}
+};
+
+/// the database indices and a function that selects values to report
+struct Scenario
+{
+	string name;
+	vector<uint16_t> indices;
+	std::function<void(IStaticSelector&)> select;
+};
+
+void SelectAll(IStaticSelector& selector)
+{
+	selector.SelectAll(GroupVariation::Group30Var1);
+}
+
+Totals Respond(const Scenario& scenario, bool plan, uint32_t iterations)
+{
+	const auto NUM = static_cast<uint16_t>(scenario.indices.size());
+	DatabaseBuffers db(DatabaseTemplate::AnalogOnly(NUM), StaticTypeBitField::AllTypes(), IndexMode::Discontiguous, plan);
+
+	auto view = db.buffers.GetView();
+	for (uint16_t i = 0; i < NUM; ++i)
+	{
+		view.analogs[i].vIndex = scenario.indices[i];
+		view.analogs[i].value = Analog(i, 0x01);
+	}
+
+	Totals totals = { 0, 0, 0, 0 };
+	vector<uint8_t> fragment(FRAGMENT_SIZE);
+	AnalogCounter counter;
+
+	std::chrono::steady_clock::duration elapsed(0);
+
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		const bool first = (i == 0);
+
+		scenario.select(db);
+
+		while (db.HasAnySelection())
+		{
+			auto start = std::chrono::steady_clock::now();
+
+			APDUResponse response(WSlice(fragment.data(), FRAGMENT_SIZE));
+			auto writer = response.GetWriter();
+			db.Load(writer);
+
+			elapsed += std::chrono::steady_clock::now() - start;
+
+			if (first)
+			{
+				auto objects = response.ToRSlice().Skip(4);
+				++totals.fragments;
+				totals.bytes += response.ToRSlice().Size();
+				if (APDUParser::Parse(objects, counter, nullptr) != ParseResult::OK)
+				{
+					cerr << "response did not parse" << endl;
+					exit(-1);
+				}
+			}
+		}
+	}
+
+	totals.values = counter.count;
+	totals.micros = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / (1000.0 * iterations);
+	return totals;
+}
+
+vector<uint16_t> Indices(uint32_t count, const std::function<uint16_t (uint32_t)>& index)
+{
+	vector<uint16_t> indices;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		indices.push_back(index(i));
+	}
+	return indices;
+}
+
+vector<uint16_t> RandomIndices(uint32_t count, uint32_t max)
+{
+	std::mt19937 rng(42);
+	vector<bool> used(max, false);
+	vector<uint16_t> indices;
+	while (indices.size() < count)
+	{
+		auto index = rng() % max;
+		if (!used[index])
+		{
+			used[index] = true;
+			indices.push_back(static_cast<uint16_t>(index));
+		}
+	}
+	std::sort(indices.begin(), indices.end());
+	return indices;
+}
+
+void Compare(const Scenario& scenario, uint32_t iterations)
+{
+	auto ranges = Respond(scenario, false, iterations);
+	auto planned = Respond(scenario, true, iterations);
+
+	if (ranges.values != planned.values)
+	{
+		cerr << "planned response has " << planned.values << " values instead of " << ranges.values << endl;
+		exit(-1);
+	}
+
+	cout << setw(34) << left << scenario.name
+	     << setw(6) << right << ranges.values
+	     << setw(8) << ranges.bytes
+	     << setw(4) << ranges.fragments
+	     << setw(8) << fixed << setprecision(1) << ranges.micros
+	     << setw(8) << planned.bytes
+	     << setw(4) << planned.fragments
+	     << setw(8) << planned.micros
+	     << setw(9) << (100.0 * (ranges.bytes - planned.bytes) / ranges.bytes) << " %" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+	const uint32_t ITERATIONS = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : 1000;
+
+	cout << "g30v1 analogs, " << FRAGMENT_SIZE << " byte fragments, build time in us per response" << endl << endl;
+
+	cout << setw(34) << left << "index map / selection"
+	     << setw(6) << right << "values"
+	     << setw(20) << "ranges: bytes/frags/us"
+	     << setw(18) << "planned"
+	     << setw(11) << "saved" << endl;
+
+	vector<Scenario> scenarios =
+	{
+		{ "contiguous 0..999", Indices(1000, [](uint32_t i) { return static_cast<uint16_t>(i); }), SelectAll },
+		{ "every other index", Indices(1000, [](uint32_t i) { return static_cast<uint16_t>(2 * i); }), SelectAll },
+		{ "runs of 3, gaps of 10", Indices(999, [](uint32_t i) { return static_cast<uint16_t>((i / 3) * 13 + (i % 3)); }), SelectAll },
+		{ "runs of 8, gaps of 8", Indices(1000, [](uint32_t i) { return static_cast<uint16_t>((i / 8) * 16 + (i % 8)); }), SelectAll },
+		{ "random 1000 of 0..9999", RandomIndices(1000, 10000), SelectAll },
+		{ "random 200 of 0..255", RandomIndices(200, 256), SelectAll },
+		{
+			"contiguous, 100 ranges of 2", Indices(1000, [](uint32_t i) { return static_cast<uint16_t>(i); }), [](IStaticSelector & selector)
+			{
+				for (uint16_t i = 0; i < 100; ++i)
+				{
+					selector.SelectRange(GroupVariation::Group30Var1, Range::From(i * 10, i * 10 + 1));
+				}
+			}
+		}
+	};
+
+	for (auto& scenario : scenarios)
+	{
+		Compare(scenario, ITERATIONS);
+	}
+
+	return 0;
+}
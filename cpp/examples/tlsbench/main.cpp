@@ -0,0 +1,290 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <asiodnp3/DNP3Manager.h>
+#include <asiodnp3/ConsoleLogger.h>
+#include <asiodnp3/DefaultMasterApplication.h>
+#include <asiodnp3/PrintingSOEHandler.h>
+
+#include <opendnp3/outstation/SimpleCommandHandler.h>
+#include <opendnp3/outstation/IOutstationApplication.h>
+#include <opendnp3/LogLevels.h>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace openpal;
+using namespace asiopal;
+using namespace asiodnp3;
+using namespace opendnp3;
+
+/**
+* Measures the cost of creating many TLS channels, and of a reconnect storm over TLS loopback connections.
+*
+* Startup adds client and server channels that all use the same TLSConfig without opening them, and then
+* reloads their certificates.
+*
+* For the reconnect storm, a client manager holds one master channel per outstation channel of a server
+* manager. Once every master is online, the certificates of both managers are reloaded, which must not
+* drop any connection. Then all of the outstation channels are shut down and added again, so every master
+* reconnects through ChannelRetry at the same time. The wall time and the CPU time of that reconnect
+* are reported with session resumption disabled, resuming with session IDs, and resuming with tickets.
+*
+* The certificate file must hold both the certificate and its private key, and is also used to verify
+* the peer, i.e. a self-signed certificate.
+*
+* usage: tlsbench <certificate> [channels] [port] [startup channels]
+*/
+
+struct Mode
+{
+	const char* name;
+	bool resume;
+	bool tickets;
+};
+
+const Mode MODES[] = { { "full", false, false }, { "ids", true, false }, { "tickets", true, true } };
+
+struct Result
+{
+	double connectMs;
+	double reconnectMs;
+	double reconnectCpuMs;
+	TLSSessionStatistics stats;
+	bool ok;
+};
+
+/// Resident set size of this process in bytes, 0 if not available
+size_t ResidentBytes()
+{
+	std::ifstream statm("/proc/self/statm");
+	size_t size = 0;
+	size_t resident = 0;
+	if (statm >> size >> resident)
+	{
+		return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	}
+	return 0;
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// User + system CPU time of the process, which runs both sides of every handshake
+double CpuMs()
+{
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0 + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+}
+
+bool WaitFor(const std::atomic<uint32_t>& count, uint32_t target)
+{
+	auto start = std::chrono::steady_clock::now();
+	while (count < target)
+	{
+		if (ElapsedMs(start) > 120000)
+		{
+			return false;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return true;
+}
+
+std::vector<IChannel*> AddOutstations(DNP3Manager& manager, const TLSConfig& config, uint32_t channels, uint16_t port)
+{
+	std::vector<IChannel*> servers;
+	for (uint32_t i = 0; i < channels; ++i)
+	{
+		auto id = "server" + std::to_string(i);
+		auto server = manager.AddTLSServer(id.c_str(), flags::ERR, ChannelRetry::Default(), "127.0.0.1", static_cast<uint16_t>(port + i), config);
+		auto outstation = server->AddOutstation("outstation", SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), OutstationStackConfig());
+		outstation->Enable();
+		servers.push_back(server);
+	}
+	return servers;
+}
+
+/// Time and memory to add the channels, which is dominated by building their TLS contexts
+void RunStartup(const std::string& certificate, uint32_t channels, uint16_t port)
+{
+	TLSConfig config(certificate, certificate, certificate);
+
+	DNP3Manager manager(1, ConsoleLogger::Create());
+
+	auto residentStart = ResidentBytes();
+	auto start = std::chrono::steady_clock::now();
+
+	for (uint32_t i = 0; i < channels; ++i)
+	{
+		auto id = "client" + std::to_string(i);
+		manager.AddTLSClient(id.c_str(), flags::ERR, ChannelRetry::Default(), "127.0.0.1", "0.0.0.0", static_cast<uint16_t>(port + i), config);
+	}
+
+	for (uint32_t i = 0; i < channels; ++i)
+	{
+		auto id = "server" + std::to_string(i);
+		manager.AddTLSServer(id.c_str(), flags::ERR, ChannelRetry::Default(), "127.0.0.1", static_cast<uint16_t>(port + i), config);
+	}
+
+	auto elapsed = ElapsedMs(start);
+	auto resident = ResidentBytes() - residentStart;
+
+	start = std::chrono::steady_clock::now();
+	auto reloaded = manager.ReloadTLSCertificates();
+	auto reloadMs = ElapsedMs(start);
+
+	std::cout << "startup of " << channels << " client and " << channels << " server channels: " << std::fixed << std::setprecision(1)
+	          << elapsed << " ms, " << (resident / 1024) << " KB resident" << std::endl;
+	std::cout << "certificate reload: " << reloadMs << " ms" << (reloaded ? "" : " (failed)") << std::endl << std::endl;
+
+	manager.Shutdown();
+}
+
+Result Run(const std::string& certificate, const Mode& mode, uint32_t channels, uint16_t port)
+{
+	TLSConfig config(certificate, certificate, certificate);
+	config.allowSessionResumption = mode.resume;
+	config.useSessionTickets = mode.tickets;
+
+	Result result;
+	std::atomic<uint32_t> numOpen(0);
+
+	DNP3Manager serverManager(1, ConsoleLogger::Create());
+	DNP3Manager clientManager(1, ConsoleLogger::Create());
+
+	auto servers = AddOutstations(serverManager, config, channels, port);
+
+	// retry quickly so that the reconnect time is dominated by the handshakes
+	const ChannelRetry retry(TimeDuration::Milliseconds(10), TimeDuration::Milliseconds(100));
+
+	MasterStackConfig masterConfig;
+	masterConfig.master.disableUnsolOnStartup = true;
+	masterConfig.master.startupIntegrityClassMask = ClassField::None();
+
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < channels; ++i)
+	{
+		auto id = "client" + std::to_string(i);
+		// the outstations going away is expected, so don't log it
+		auto client = clientManager.AddTLSClient(id.c_str(), levels::NOTHING, retry, "127.0.0.1", "0.0.0.0", static_cast<uint16_t>(port + i), config);
+		client->AddStateListener([&numOpen](ChannelState state)
+		{
+			if (state == ChannelState::OPEN)
+			{
+				++numOpen;
+			}
+		});
+		client->AddMaster("master", PrintingSOEHandler::Instance(), DefaultMasterApplication::Instance(), masterConfig)->Enable();
+	}
+
+	result.ok = WaitFor(numOpen, channels);
+	result.connectMs = ElapsedMs(start);
+
+	// let TLS 1.3 session tickets, which arrive after the handshake, reach the clients
+	std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+	for (auto server : servers)
+	{
+		server->Shutdown();
+	}
+
+	auto before = clientManager.GetTLSSessionStatistics();
+	auto cpuStart = CpuMs();
+	start = std::chrono::steady_clock::now();
+
+	servers = AddOutstations(serverManager, config, channels, port);
+
+	result.ok = WaitFor(numOpen, 2 * channels) && result.ok;
+	result.reconnectMs = ElapsedMs(start);
+	result.reconnectCpuMs = CpuMs() - cpuStart;
+
+	auto after = clientManager.GetTLSSessionStatistics();
+	result.stats.numFullHandshakes = after.numFullHandshakes - before.numFullHandshakes;
+	result.stats.numResumedHandshakes = after.numResumedHandshakes - before.numResumedHandshakes;
+	result.stats.numCachedSessions = after.numCachedSessions;
+
+	// rotating certificates forgets the sessions, so check it after the reconnect, and that it doesn't drop the open connections
+	result.ok = clientManager.ReloadTLSCertificates() && serverManager.ReloadTLSCertificates() && result.ok;
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	result.ok = (numOpen == 2 * channels) && result.ok;
+
+	clientManager.Shutdown();
+	serverManager.Shutdown();
+	return result;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cout << "usage: tlsbench <certificate> [channels] [port]" << std::endl;
+		return -1;
+	}
+
+	const std::string certificate(argv[1]);
+	const uint32_t channels = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 200;
+	const uint16_t port = (argc > 3) ? static_cast<uint16_t>(std::strtoul(argv[3], nullptr, 10)) : 30000;
+	const uint32_t startupChannels = (argc > 4) ? std::strtoul(argv[4], nullptr, 10) : 1000;
+
+	RunStartup(certificate, startupChannels, port);
+
+	std::cout << channels << " TLS channels" << std::endl << std::endl;
+	std::cout << std::left << std::setw(10) << "mode"
+	          << std::right << std::setw(14) << "connect ms"
+	          << std::setw(14) << "reconnect ms"
+	          << std::setw(16) << "reconnect cpu"
+	          << std::setw(10) << "full"
+	          << std::setw(10) << "resumed" << std::endl;
+
+	for (auto& mode : MODES)
+	{
+		auto result = Run(certificate, mode, channels, port);
+		if (!result.ok)
+		{
+			std::cout << mode.name << ": not every channel came online" << std::endl;
+			return -1;
+		}
+
+		std::cout << std::left << std::setw(10) << mode.name << std::right << std::fixed << std::setprecision(1)
+		          << std::setw(14) << result.connectMs
+		          << std::setw(14) << result.reconnectMs
+		          << std::setw(16) << result.reconnectCpuMs
+		          << std::setw(10) << result.stats.numFullHandshakes
+		          << std::setw(10) << result.stats.numResumedHandshakes << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,273 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <asiodnp3/DNP3Manager.h>
+
+#include <openpal/container/Buffer.h>
+
+#include <opendnp3/link/LinkFrame.h>
+#include <opendnp3/link/LinkLayerConstants.h>
+#include <opendnp3/outstation/SimpleCommandHandler.h>
+#include <opendnp3/outstation/IOutstationApplication.h>
+#include <opendnp3/LogLevels.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace openpal;
+using namespace asiodnp3;
+using namespace opendnp3;
+
+/**
+* Measures how many datagrams a single UDP socket shared by many outstations handles on loopback.
+*
+* Every outstation is a UDP channel of one DNP3Manager on the same local port. Each plays against its
+* own raw loopback socket, standing in for a master, which keeps one REQUEST_LINK_STATUS in flight and
+* sends the next as soon as the LINK_STATUS reply arrives. The run is repeated with the shared socket
+* moving one datagram per system call and with recvmmsg/sendmmsg batches.
+*
+* usage: udpbench [outstations] [port] [seconds] [max batch]
+*/
+
+const uint16_t MASTER_ADDRESS = 1;
+const uint16_t OUTSTATION_ADDRESS = 10;
+const int RESEND_MS = 200;
+
+/// Raise the file descriptor limit as far as the hard limit allows
+rlim_t RaiseDescriptorLimit()
+{
+	rlimit limit;
+	if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+	{
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+		getrlimit(RLIMIT_NOFILE, &limit);
+		return limit.rlim_cur;
+	}
+	return 0;
+}
+
+/// The raw sockets of the masters, one per outstation
+class Masters
+{
+public:
+
+	Masters(uint32_t count, uint16_t serverPort) : epoll(epoll_create1(0)), request(LPDU_MAX_FRAME_SIZE)
+	{
+		memset(&server, 0, sizeof(server));
+		server.sin_family = AF_INET;
+		server.sin_port = htons(serverPort);
+		server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+		auto output = request.GetWSlice();
+		frame = LinkFrame::FormatRequestLinkStatus(output, true, OUTSTATION_ADDRESS, MASTER_ADDRESS, nullptr);
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			auto fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+			sockaddr_in local = server;
+			local.sin_port = 0;
+			if (fd < 0 || bind(fd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0)
+			{
+				break;
+			}
+
+			socklen_t length = sizeof(local);
+			getsockname(fd, reinterpret_cast<sockaddr*>(&local), &length);
+
+			epoll_event event;
+			event.events = EPOLLIN;
+			event.data.u32 = i;
+			epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event);
+
+			sockets.push_back(fd);
+			ports.push_back(ntohs(local.sin_port));
+			lastSend.push_back(chrono::steady_clock::time_point());
+		}
+	}
+
+	~Masters()
+	{
+		for (auto fd : sockets)
+		{
+			close(fd);
+		}
+		close(epoll);
+	}
+
+	/// Keep one request per outstation in flight for the duration, returning the number of replies
+	uint64_t Run(chrono::steady_clock::duration duration, uint64_t& resent)
+	{
+		uint64_t replies = 0;
+		auto start = chrono::steady_clock::now();
+
+		for (uint32_t i = 0; i < sockets.size(); ++i)
+		{
+			this->Send(i);
+		}
+
+		vector<epoll_event> events(256);
+		uint8_t reply[LPDU_MAX_FRAME_SIZE];
+		auto lastSweep = start;
+
+		while (chrono::steady_clock::now() - start < duration)
+		{
+			auto num = epoll_wait(epoll, events.data(), static_cast<int>(events.size()), 10);
+			for (int e = 0; e < num; ++e)
+			{
+				auto i = events[e].data.u32;
+				bool answered = false;
+				while (recv(sockets[i], reply, sizeof(reply), 0) > 0)
+				{
+					// the LINK_STATUS reply is a header-only frame
+					if (reply[0] == 0x05 && reply[1] == 0x64 && (reply[3] & 0x0F) == static_cast<uint8_t>(LinkFunction::SEC_LINK_STATUS))
+					{
+						++replies;
+						answered = true;
+					}
+				}
+				if (answered)
+				{
+					this->Send(i);
+				}
+			}
+
+			// a datagram may be dropped anywhere along the way, so requests without a reply are sent again
+			auto now = chrono::steady_clock::now();
+			if (now - lastSweep > chrono::milliseconds(RESEND_MS))
+			{
+				lastSweep = now;
+				for (uint32_t i = 0; i < sockets.size(); ++i)
+				{
+					if (now - lastSend[i] > chrono::milliseconds(RESEND_MS))
+					{
+						++resent;
+						this->Send(i);
+					}
+				}
+			}
+		}
+
+		return replies;
+	}
+
+	vector<uint16_t> ports;
+
+private:
+
+	void Send(uint32_t i)
+	{
+		lastSend[i] = chrono::steady_clock::now();
+		sendto(sockets[i], frame, frame.Size(), 0, reinterpret_cast<sockaddr*>(&server), sizeof(server));
+	}
+
+	int epoll;
+	sockaddr_in server;
+	openpal::Buffer request;
+	RSlice frame;
+	vector<int> sockets;
+	vector<chrono::steady_clock::time_point> lastSend;
+};
+
+void Run(Masters& masters, uint16_t port, int seconds, uint32_t maxBatch)
+{
+	DNP3Manager manager(1);
+
+	asiopal::UDPSettings udp;
+	udp.maxBatch = maxBatch;
+	// every outstation may have a request waiting at once
+	udp.receiveBufferSize = 4 * 1024 * 1024;
+
+	for (uint32_t i = 0; i < masters.ports.size(); ++i)
+	{
+		auto id = "outstation-" + to_string(i);
+		auto channel = manager.AddUDPChannel(id.c_str(), levels::NOTHING, ChannelRetry::Default(), "127.0.0.1", port, "127.0.0.1", masters.ports[i], udp);
+
+		OutstationStackConfig config(DatabaseTemplate::AnalogOnly(1));
+		config.link.LocalAddr = OUTSTATION_ADDRESS;
+		config.link.RemoteAddr = MASTER_ADDRESS;
+		channel->AddOutstation(id.c_str(), SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), config)->Enable();
+	}
+
+	// let every channel attach to the socket
+	this_thread::sleep_for(chrono::milliseconds(500));
+
+	auto before = manager.GetUDPStatistics();
+	auto start = chrono::steady_clock::now();
+	uint64_t resent = 0;
+	auto replies = masters.Run(chrono::seconds(seconds), resent);
+	auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	auto after = manager.GetUDPStatistics();
+
+	auto rx = after.numRx - before.numRx;
+	auto tx = after.numTx - before.numTx;
+	auto receiveCalls = after.numReceiveCalls - before.numReceiveCalls;
+	auto sendCalls = after.numSendCalls - before.numSendCalls;
+
+	cout << "max batch " << maxBatch << endl;
+	cout << "  round trips/sec:      " << static_cast<uint64_t>(replies / elapsed) << endl;
+	cout << "  datagrams/sec:        " << static_cast<uint64_t>((rx + tx) / elapsed) << " (" << static_cast<uint64_t>(rx / elapsed) << " in, " << static_cast<uint64_t>(tx / elapsed) << " out)" << endl;
+	cout << "  datagrams per recv:   " << (receiveCalls ? static_cast<double>(rx) / receiveCalls : 0.0) << endl;
+	cout << "  datagrams per send:   " << (sendCalls ? static_cast<double>(tx) / sendCalls : 0.0) << endl;
+	cout << "  unrouted / dropped:   " << (after.numUnrouted - before.numUnrouted) << " / " << (after.numDropped - before.numDropped) << endl;
+	cout << "  requests resent:      " << resent << endl;
+}
+
+int main(int argc, char* argv[])
+{
+	uint32_t outstations = (argc > 1) ? atoi(argv[1]) : 2000;
+	uint16_t port = (argc > 2) ? static_cast<uint16_t>(atoi(argv[2])) : 20000;
+	int seconds = (argc > 3) ? atoi(argv[3]) : 5;
+	uint32_t maxBatch = (argc > 4) ? atoi(argv[4]) : 0;
+
+	auto limit = RaiseDescriptorLimit();
+	if (limit < outstations + 64)
+	{
+		outstations = static_cast<uint32_t>(limit - 64);
+	}
+
+	Masters masters(outstations, port);
+	cout << masters.ports.size() << " outstations sharing 127.0.0.1:" << port << ", " << seconds << " s per run" << endl << endl;
+
+	if (maxBatch > 0)
+	{
+		Run(masters, port, seconds, maxBatch);
+	}
+	else
+	{
+		Run(masters, port, seconds, 1);
+		Run(masters, port, seconds, asiopal::UDPSettings().maxBatch);
+	}
+
+	return 0;
+}
@@ -0,0 +1,539 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <asiodnp3/DNP3Manager.h>
+
+#include <openpal/container/Buffer.h>
+
+#include <opendnp3/link/LinkFrame.h>
+#include <opendnp3/link/LinkLayerConstants.h>
+#include <opendnp3/outstation/SimpleCommandHandler.h>
+#include <opendnp3/outstation/IOutstationApplication.h>
+#include <opendnp3/LogLevels.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/ptrace.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace openpal;
+using namespace asiodnp3;
+using namespace opendnp3;
+
+/**
+* Compares the system calls and CPU time of the tcp physical layer on the asio reactor and on io_uring.
+*
+* A forked child runs a DNP3Manager with one thread and a listener with one outstation registered per
+* connection. The parent opens every connection from raw loopback sockets, routes each one with a
+* REQUEST_LINK_STATUS, and then keeps a fixed number of requests in flight on randomly chosen connections,
+* sending the next as soon as a LINK_STATUS reply arrives. Throughput and the CPU time of the child are
+* measured first. The child is then run again under ptrace to count its system calls per round trip, which
+* is too slow to measure the rate at the same time.
+*
+* usage: uringbench [connections] [port] [seconds] [in flight]
+*/
+
+const uint16_t MASTER_ADDRESS = 1;
+const uint16_t FIRST_OUTSTATION_ADDRESS = 10;
+const uint32_t TRACED_ROUND_TRIPS = 20000;
+
+/// Raise the file descriptor limit as far as the hard limit allows
+rlim_t RaiseDescriptorLimit()
+{
+	rlimit limit;
+	if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+	{
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+		getrlimit(RLIMIT_NOFILE, &limit);
+		return limit.rlim_cur;
+	}
+	return 0;
+}
+
+/// User plus system time of every thread of a process in seconds
+double CPUSeconds(pid_t pid)
+{
+	std::ifstream file("/proc/" + std::to_string(pid) + "/stat");
+	std::string stat((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	// the fields after the command name, which may contain spaces, start with the state
+	auto pos = stat.rfind(')');
+	if (pos == std::string::npos)
+	{
+		return 0;
+	}
+
+	std::istringstream fields(stat.substr(pos + 2));
+	std::string field;
+	unsigned long utime = 0;
+	unsigned long stime = 0;
+	for (int i = 3; i <= 15 && (fields >> field); ++i)
+	{
+		if (i == 14) utime = std::stoul(field);
+		if (i == 15) stime = std::stoul(field);
+	}
+	return static_cast<double>(utime + stime) / sysconf(_SC_CLK_TCK);
+}
+
+/// What the child reports once it is told to stop
+struct ServerResult
+{
+	bool isRingEnabled;
+	asiopal::IOUringStatistics ring;
+};
+
+/// Body of the forked server process, signals ready on results and runs until control is closed
+int RunServer(int control, int results, uint32_t numConnections, uint16_t port, bool useRing)
+{
+	ServerResult result;
+	result.isRingEnabled = false;
+
+	{
+		DNP3Manager manager(1);
+		if (useRing)
+		{
+			result.isRingEnabled = manager.EnableIOUring();
+		}
+
+		auto pListener = manager.AddTCPListener("listener", levels::NOTHING, "127.0.0.1", port);
+		if (!pListener)
+		{
+			return -1;
+		}
+
+		for (uint32_t i = 0; i < numConnections; ++i)
+		{
+			OutstationStackConfig config(DatabaseTemplate::AnalogOnly(1));
+			config.link.LocalAddr = static_cast<uint16_t>(FIRST_OUTSTATION_ADDRESS + i);
+			config.link.RemoteAddr = MASTER_ADDRESS;
+			auto id = "outstation-" + std::to_string(i);
+			pListener->AddOutstation(id.c_str(), SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), config)->Enable();
+		}
+
+		char ready = 0;
+		if (write(results, &ready, 1) != 1)
+		{
+			return -1;
+		}
+
+		char dummy;
+		while (read(control, &dummy, 1) > 0) {}
+
+		result.ring = manager.GetIOUringStatistics();
+	}
+
+	return (write(results, &result, sizeof(result)) == sizeof(result)) ? 0 : -1;
+}
+
+/// The raw sockets of the masters, one per outstation
+class Clients
+{
+public:
+
+	Clients(uint32_t numConnections) : epfd(epoll_create1(0)), sockets(numConnections, -1), received(numConnections, 0), isBusy(numConnections, false), requests(numConnections)
+	{
+		openpal::Buffer buffer(LPDU_MAX_FRAME_SIZE);
+		for (uint32_t i = 0; i < numConnections; ++i)
+		{
+			auto output = buffer.GetWSlice();
+			auto request = LinkFrame::FormatRequestLinkStatus(output, true, static_cast<uint16_t>(FIRST_OUTSTATION_ADDRESS + i), MASTER_ADDRESS, nullptr);
+			requests[i].assign(static_cast<const uint8_t*>(request), static_cast<const uint8_t*>(request) + request.Size());
+		}
+	}
+
+	~Clients()
+	{
+		for (auto fd : sockets)
+		{
+			if (fd >= 0) close(fd);
+		}
+		close(epfd);
+	}
+
+	/// Connect every socket and route it with one blocking round trip
+	bool Connect(uint16_t port)
+	{
+		sockaddr_in address;
+		memset(&address, 0, sizeof(address));
+		address.sin_family = AF_INET;
+		address.sin_port = htons(port);
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+		for (size_t i = 0; i < sockets.size(); ++i)
+		{
+			auto fd = socket(AF_INET, SOCK_STREAM, 0);
+			sockets[i] = fd;
+			int one = 1;
+			setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+			if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+			{
+				return false;
+			}
+
+			uint8_t reply[10];
+			if (!this->Send(i) || recv(fd, reply, sizeof(reply), MSG_WAITALL) != sizeof(reply) || !IsLinkStatus(reply))
+			{
+				return false;
+			}
+
+			fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+			epoll_event event;
+			event.events = EPOLLIN;
+			event.data.u32 = static_cast<uint32_t>(i);
+			epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &event);
+		}
+		return true;
+	}
+
+	/// Keep a number of requests in flight until the deadline passes or the count is reached
+	uint64_t Run(uint32_t inFlight, std::chrono::steady_clock::time_point deadline, uint64_t maxRoundTrips)
+	{
+		uint64_t roundTrips = 0;
+		uint32_t outstanding = 0;
+
+		while (outstanding < inFlight && outstanding < sockets.size())
+		{
+			if (this->SendRandom())
+			{
+				++outstanding;
+			}
+		}
+
+		std::vector<epoll_event> events(256);
+		while (roundTrips < maxRoundTrips && std::chrono::steady_clock::now() < deadline)
+		{
+			auto num = epoll_wait(epfd, events.data(), static_cast<int>(events.size()), 100);
+			for (int e = 0; e < num; ++e)
+			{
+				auto i = events[e].data.u32;
+				uint8_t reply[10];
+				auto result = recv(sockets[i], reply + received[i], sizeof(reply) - received[i], 0);
+				if (result <= 0)
+				{
+					continue;
+				}
+				received[i] += static_cast<uint32_t>(result);
+				if (received[i] == sizeof(reply))
+				{
+					received[i] = 0;
+					isBusy[i] = false;
+					++roundTrips;
+					while (!this->SendRandom()) {}
+				}
+			}
+		}
+
+		// let the requests still in flight drain so that the next run starts clean
+		auto drainDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+		while (std::chrono::steady_clock::now() < drainDeadline)
+		{
+			bool isIdle = true;
+			for (size_t i = 0; i < sockets.size(); ++i)
+			{
+				if (!isBusy[i]) continue;
+				uint8_t reply[10];
+				auto result = recv(sockets[i], reply, sizeof(reply) - received[i], 0);
+				if (result > 0) received[i] += static_cast<uint32_t>(result);
+				if (received[i] == sizeof(reply))
+				{
+					received[i] = 0;
+					isBusy[i] = false;
+				}
+				else
+				{
+					isIdle = false;
+				}
+			}
+			if (isIdle) break;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		return roundTrips;
+	}
+
+private:
+
+	static bool IsLinkStatus(const uint8_t* reply)
+	{
+		return reply[0] == 0x05 && reply[1] == 0x64 && (reply[3] & 0x0F) == static_cast<uint8_t>(LinkFunction::SEC_LINK_STATUS);
+	}
+
+	bool Send(size_t i)
+	{
+		auto& request = requests[i];
+		return send(sockets[i], request.data(), request.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(request.size());
+	}
+
+	bool SendRandom()
+	{
+		auto i = std::uniform_int_distribution<size_t>(0, sockets.size() - 1)(random);
+		if (isBusy[i])
+		{
+			return false;
+		}
+		isBusy[i] = true;
+		return this->Send(i);
+	}
+
+	int epfd;
+	std::vector<int> sockets;
+	std::vector<uint32_t> received;
+	std::vector<bool> isBusy;
+	std::vector<std::vector<uint8_t>> requests;
+	std::mt19937 random;
+};
+
+struct RunResult
+{
+	bool isValid;
+	bool isRingEnabled;
+	uint64_t roundTrips;
+	double seconds;
+	double cpuSeconds;
+	uint64_t syscalls;
+	asiopal::IOUringStatistics ring;
+};
+
+/// Counts the system call stops of a traced child and all of its threads
+class Tracer
+{
+public:
+
+	Tracer() : isCounting(false), numStops(0) {}
+
+	/// Fork the child under trace, the child stops itself until the tracer has set its options
+	template <class Fn>
+	pid_t ForkAndTrace(Fn child)
+	{
+		auto pid = fork();
+		if (pid == 0)
+		{
+			ptrace(PTRACE_TRACEME, 0, nullptr, nullptr);
+			raise(SIGSTOP);
+			exit(child());
+		}
+
+		int status = 0;
+		waitpid(pid, &status, __WALL);
+		ptrace(PTRACE_SETOPTIONS, pid, nullptr, reinterpret_cast<void*>(PTRACE_O_TRACESYSGOOD | PTRACE_O_TRACECLONE | PTRACE_O_EXITKILL));
+		ptrace(PTRACE_SYSCALL, pid, nullptr, nullptr);
+		return pid;
+	}
+
+	/// Resume every stop until the traced process exits, call on the thread that forked it
+	void Run(pid_t pid)
+	{
+		for (;;)
+		{
+			int status = 0;
+			auto tid = waitpid(-1, &status, __WALL);
+			if (tid < 0)
+			{
+				return;
+			}
+			if (WIFEXITED(status) || WIFSIGNALED(status))
+			{
+				if (tid == pid) return;
+				continue;
+			}
+
+			auto signal = WSTOPSIG(status);
+			if (signal == (SIGTRAP | 0x80))
+			{
+				if (isCounting) ++numStops;
+				signal = 0;
+			}
+			else if (signal == SIGTRAP || signal == SIGSTOP)
+			{
+				// clone events and the initial stop of new threads
+				signal = 0;
+			}
+			ptrace(PTRACE_SYSCALL, tid, nullptr, reinterpret_cast<void*>(static_cast<intptr_t>(signal)));
+		}
+	}
+
+	/// Each system call stops on the way in and on the way out
+	uint64_t NumSyscalls() const
+	{
+		return numStops / 2;
+	}
+
+	std::atomic<bool> isCounting;
+	std::atomic<uint64_t> numStops;
+};
+
+RunResult Measure(uint32_t numConnections, uint16_t port, uint32_t inFlight, double seconds, bool useRing, bool traced)
+{
+	RunResult measurement{};
+
+	int control[2];
+	int results[2];
+	if (pipe(control) != 0 || pipe(results) != 0)
+	{
+		return measurement;
+	}
+
+	auto server = [&]()
+	{
+		close(control[1]);
+		close(results[0]);
+		return RunServer(control[0], results[1], numConnections, port, useRing);
+	};
+
+	// a tracer has to be the thread that forked the child
+	Tracer tracer;
+	std::atomic<pid_t> child(0);
+	std::thread tracerThread;
+	if (traced)
+	{
+		tracerThread = std::thread([&]()
+		{
+			auto pid = tracer.ForkAndTrace(server);
+			child = pid;
+			tracer.Run(pid);
+		});
+		while (child == 0) std::this_thread::yield();
+	}
+	else
+	{
+		auto pid = fork();
+		if (pid == 0)
+		{
+			exit(server());
+		}
+		child = pid;
+	}
+
+	close(control[0]);
+	close(results[1]);
+
+	char ready;
+	if (read(results[0], &ready, 1) == 1)
+	{
+		Clients clients(numConnections);
+		if (clients.Connect(port))
+		{
+			auto cpuStart = CPUSeconds(child);
+			auto start = std::chrono::steady_clock::now();
+			tracer.isCounting = true;
+
+			auto deadline = start + std::chrono::milliseconds(static_cast<int64_t>(traced ? 600000 : seconds * 1000));
+			measurement.roundTrips = clients.Run(inFlight, deadline, traced ? TRACED_ROUND_TRIPS : UINT64_MAX);
+
+			tracer.isCounting = false;
+			measurement.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			measurement.cpuSeconds = CPUSeconds(child) - cpuStart;
+			measurement.syscalls = tracer.NumSyscalls();
+			measurement.isValid = true;
+		}
+	}
+
+	close(control[1]);
+	ServerResult result;
+	if (read(results[0], &result, sizeof(result)) == sizeof(result))
+	{
+		measurement.isRingEnabled = result.isRingEnabled;
+		measurement.ring = result.ring;
+	}
+	close(results[0]);
+
+	if (traced)
+	{
+		tracerThread.join();
+	}
+	else
+	{
+		waitpid(child, nullptr, 0);
+	}
+
+	return measurement;
+}
+
+int main(int argc, char* argv[])
+{
+	const uint32_t NUM_CONNECTIONS = (argc > 1) ? std::stoul(argv[1]) : 5000;
+	const uint16_t PORT = (argc > 2) ? static_cast<uint16_t>(std::stoul(argv[2])) : 20000;
+	const double SECONDS = (argc > 3) ? std::stod(argv[3]) : 5.0;
+	const uint32_t IN_FLIGHT = (argc > 4) ? std::stoul(argv[4]) : 64;
+
+	auto fdLimit = RaiseDescriptorLimit();
+	if (fdLimit < NUM_CONNECTIONS + 64)
+	{
+		std::cout << "Descriptor limit " << fdLimit << " is too low for " << NUM_CONNECTIONS << " loopback connections" << std::endl;
+		return -1;
+	}
+
+	std::cout << "connections:          " << NUM_CONNECTIONS << ", " << IN_FLIGHT << " requests in flight" << std::endl;
+
+	for (auto useRing : { false, true })
+	{
+		auto run = Measure(NUM_CONNECTIONS, PORT, IN_FLIGHT, SECONDS, useRing, false);
+		auto traced = Measure(NUM_CONNECTIONS, PORT, IN_FLIGHT, SECONDS, useRing, true);
+
+		if (!run.isValid || !traced.isValid)
+		{
+			std::cout << "Unable to connect the clients" << std::endl;
+			return -1;
+		}
+		if (useRing && !run.isRingEnabled)
+		{
+			std::cout << "io_uring is not supported here" << std::endl;
+			break;
+		}
+
+		auto rate = run.roundTrips / run.seconds;
+		auto syscallsPerRoundTrip = static_cast<double>(traced.syscalls) / traced.roundTrips;
+
+		std::cout << std::endl << (useRing ? "io_uring" : "asio reactor") << std::endl;
+		std::cout << "  round trips/sec:    " << static_cast<uint64_t>(rate) << std::endl;
+		std::cout << "  server cpu:         " << static_cast<uint32_t>(100 * run.cpuSeconds / run.seconds) << " % ("
+		          << 1e6 * run.cpuSeconds / run.roundTrips << " us per round trip)" << std::endl;
+		std::cout << "  syscalls/round trip " << syscallsPerRoundTrip << std::endl;
+		std::cout << "  syscalls/sec:       " << static_cast<uint64_t>(syscallsPerRoundTrip * rate) << std::endl;
+		if (useRing)
+		{
+			std::cout << "  io_uring_enter:     " << run.ring.numEnter << " submitting " << run.ring.numSubmitted << " entries, "
+			          << run.ring.numCompletions << " completions, " << run.ring.numBufferShortages << " buffer shortages" << std::endl;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,288 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <asiodnp3/DNP3Manager.h>
+#include <asiodnp3/ConsoleLogger.h>
+
+#include <asiopal/UTCTimeSource.h>
+
+#include <opendnp3/master/ISOEHandler.h>
+#include <opendnp3/master/IMasterApplication.h>
+#include <opendnp3/master/ITaskCallback.h>
+#include <opendnp3/outstation/SimpleCommandHandler.h>
+#include <opendnp3/LogLevels.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace std;
+using namespace openpal;
+using namespace asiopal;
+using namespace asiodnp3;
+using namespace opendnp3;
+
+/**
+* Measures how many socket writes and TCP segments an outstation needs per response fragment when
+* answering integrity polls over TCP loopback, with and without TCP_NODELAY.
+*
+* Each write is a single send() call unless the socket buffer is full. Segments are read from the
+* system wide Tcp OutSegs counter, so they include the master's requests and ACKs and the machine
+* should otherwise be idle.
+*
+* usage: writebench [points] [polls]
+*/
+
+const uint32_t FRAGMENT_SIZES[] = { 2048, 4096 };
+
+/// Counts the static values received
+class CountingSOEHandler final : public ISOEHandler
+{
+public:
+
+	std::atomic<uint64_t> values;
+
+	CountingSOEHandler() : values(0)
+	{}
+
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<Binary>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<DoubleBitBinary>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<Analog>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<Counter>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<FrozenCounter>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<BinaryOutputStatus>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<AnalogOutputStatus>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<OctetString>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<TimeAndInterval>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<BinaryCommandEvent>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<AnalogCommandEvent>>& meas) override final { values += meas.Count(); }
+	virtual void Process(const HeaderInfo& info, const ICollection<Indexed<SecurityStat>>& meas) override final { values += meas.Count(); }
+
+protected:
+
+	virtual void Start() override final {}
+	virtual void End() override final {}
+};
+
+/// Lets the benchmark wait for a single poll to complete
+class PollCallback final : public ITaskCallback
+{
+public:
+
+	void Reset()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		complete = false;
+	}
+
+	bool Wait(TaskCompletion& result)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		auto done = cv.wait_for(lock, std::chrono::seconds(10), [this]()
+		{
+			return complete;
+		});
+		result = this->result;
+		return done;
+	}
+
+	virtual void OnStart() override final {}
+
+	virtual void OnComplete(TaskCompletion result_) override final
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		result = result_;
+		complete = true;
+		cv.notify_all();
+	}
+
+	virtual void OnDestroyed() override final {}
+
+private:
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool complete = false;
+	TaskCompletion result = TaskCompletion::FAILURE_NO_COMMS;
+};
+
+class BenchMasterApplication final : public IMasterApplication
+{
+public:
+
+	virtual UTCTimestamp Now() override final
+	{
+		return UTCTimeSource::Instance().Now();
+	}
+
+	virtual void OnStateChange(LinkStatus value) override final {}
+};
+
+/// System wide count of TCP segments sent, 0 if not available
+uint64_t TCPSegmentsSent()
+{
+	std::ifstream snmp("/proc/net/snmp");
+	std::string names;
+	std::string values;
+	while (std::getline(snmp, names) && std::getline(snmp, values))
+	{
+		if (names.compare(0, 4, "Tcp:") != 0)
+		{
+			continue;
+		}
+
+		std::istringstream n(names);
+		std::istringstream v(values);
+		std::string name;
+		std::string value;
+		while (n >> name && v >> value)
+		{
+			if (name == "OutSegs")
+			{
+				return std::stoull(value);
+			}
+		}
+	}
+	return 0;
+}
+
+struct Result
+{
+	double fragments;
+	double frames;
+	double writes;
+	double segments;
+	bool ok;
+};
+
+Result RunPolls(uint32_t fragmentSize, bool noDelay, uint16_t points, uint32_t polls, uint16_t port)
+{
+	CountingSOEHandler soeHandler;
+	BenchMasterApplication application;
+	PollCallback callback;
+
+	TCPSettings tcp;
+	tcp.noDelay = noDelay;
+
+	DNP3Manager manager(1, ConsoleLogger::Create());
+
+	auto server = manager.AddTCPServer("server", flags::ERR, ChannelRetry::Default(), "127.0.0.1", port, tcp);
+	// polls are retried until the connection is up, so don't log the master going offline
+	auto client = manager.AddTCPClient("client", levels::NOTHING, ChannelRetry::Default(), "127.0.0.1", "0.0.0.0", port, tcp);
+
+	OutstationStackConfig outstationConfig;
+	outstationConfig.dbTemplate = DatabaseTemplate::AnalogOnly(points);
+	outstationConfig.outstation.params.maxTxFragSize = fragmentSize;
+	auto outstation = server->AddOutstation("outstation", SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), outstationConfig);
+
+	MasterStackConfig masterConfig;
+	masterConfig.master.disableUnsolOnStartup = true;
+	masterConfig.master.startupIntegrityClassMask = ClassField::None();
+	masterConfig.master.maxRxFragSize = fragmentSize;
+	auto master = client->AddMaster("master", soeHandler, application, masterConfig);
+
+	outstation->Enable();
+	master->Enable();
+
+	// warm up once the connection is established
+	TaskCompletion completion = TaskCompletion::FAILURE_NO_COMMS;
+	for (uint32_t attempt = 0; attempt < 100 && completion != TaskCompletion::SUCCESS; ++attempt)
+	{
+		callback.Reset();
+		master->ScanClasses(ClassField::AllClasses(), TaskConfig::With(callback));
+		if (!callback.Wait(completion) || completion != TaskCompletion::SUCCESS)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		}
+	}
+
+	auto channelStart = server->GetChannelStatistics();
+	auto masterStart = master->GetStackStatistics();
+	auto segmentsStart = TCPSegmentsSent();
+
+	for (uint32_t i = 0; i < polls && completion == TaskCompletion::SUCCESS; ++i)
+	{
+		callback.Reset();
+		master->ScanClasses(ClassField::AllClasses(), TaskConfig::With(callback));
+		if (!callback.Wait(completion))
+		{
+			break;
+		}
+	}
+
+	auto channelEnd = server->GetChannelStatistics();
+	auto masterEnd = master->GetStackStatistics();
+	auto segmentsEnd = TCPSegmentsSent();
+
+	// the master sends the request and then confirms every fragment but the last, so it sends one segment per response fragment
+	double fragments = masterEnd.numTransportTx - masterStart.numTransportTx;
+
+	Result result;
+	result.ok = (completion == TaskCompletion::SUCCESS) && (fragments > 0);
+	result.fragments = fragments / polls;
+	result.frames = (channelEnd.numLinkFrameTx - channelStart.numLinkFrameTx) / fragments;
+	result.writes = (channelEnd.numWrites - channelStart.numWrites) / fragments;
+	result.segments = (segmentsEnd - segmentsStart) / fragments;
+
+	manager.Shutdown();
+	return result;
+}
+
+int main(int argc, char* argv[])
+{
+	const uint16_t points = (argc > 1) ? static_cast<uint16_t>(std::strtoul(argv[1], nullptr, 10)) : 2000;
+	const uint32_t polls = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 200;
+
+	std::cout << "integrity poll of " << points << " analogs (g30v1) over TCP loopback, " << polls << " polls per row, values per response fragment" << std::endl << std::endl;
+	std::cout << std::setw(10) << "frag size" << std::setw(10) << "nodelay" << std::setw(12) << "frags/poll"
+	          << std::setw(10) << "frames" << std::setw(10) << "writes" << std::setw(12) << "segments" << std::endl;
+
+	uint16_t port = 20000;
+	for (auto size : FRAGMENT_SIZES)
+	{
+		for (auto noDelay : { false, true })
+		{
+			auto result = RunPolls(size, noDelay, points, polls, port++);
+			if (!result.ok)
+			{
+				std::cout << std::setw(10) << size << std::setw(10) << noDelay << "  poll failed" << std::endl;
+				continue;
+			}
+
+			std::cout << std::fixed << std::setprecision(2)
+			          << std::setw(10) << size
+			          << std::setw(10) << noDelay
+			          << std::setw(12) << result.fragments
+			          << std::setw(10) << result.frames
+			          << std::setw(10) << result.writes
+			          << std::setw(12) << result.segments << std::endl;
+		}
+	}
+
+	return 0;
+}
@@ -28,14 +28,26 @@
 #include <opendnp3/link/ChannelRetry.h>
 
 #include <asiodnp3/IChannel.h>
+#include <asiodnp3/IListener.h>
+#include <asiodnp3/OpenAdmissionSettings.h>
+#include <asiodnp3/OpenAdmissionStatistics.h>
 
 #include <asiopal/SerialTypes.h>
+#include <asiopal/MemoryPipeSettings.h>
+#include <asiopal/ThreadPoolSettings.h>
+#include <asiopal/TCPSettings.h>
+#include <asiopal/UDPSettings.h>
+#include <asiopal/DatagramStatistics.h>
+#include <asiopal/IOUringSettings.h>
+#include <asiopal/IOUringStatistics.h>
 
 #ifdef OPENDNP3_USE_TLS
 #include <asiopal/tls/TLSConfig.h>
+#include <asiopal/tls/TLSSessionStatistics.h>
 #endif
 
 #include <memory>
+#include <utility>
 
 namespace asiodnp3
 {
@@ -58,12 +70,14 @@ public:
 	*	@param handler Callback interface for log messages
 	*	@param onThreadStart Action to run when a thread pool thread starts
 	*	@param onThreadExit Action to run just before a thread pool thread exits
+	*	@param settings Controls whether threads share one io_service or each run their own shard
 	*/
 	DNP3Manager(
 	    uint32_t concurrencyHint,
 	    std::shared_ptr<openpal::ILogHandler> handler = std::shared_ptr<openpal::ILogHandler>(),
 	std::function<void()> onThreadStart = []() {},
-	std::function<void()> onThreadExit = []() {}
+	std::function<void()> onThreadExit = []() {},
+	const asiopal::ThreadPoolSettings& settings = asiopal::ThreadPoolSettings()
 	);
 
 	~DNP3Manager();
@@ -83,6 +97,7 @@ public:
 	* @param host IP address of remote outstation (i.e. 127.0.0.1 or www.google.com)
 	* @param local adapter address on which to attempt the connection (use 0.0.0.0 for all adapters)
 	* @param port Port of remote outstation is listening on
+	* @param tcp Socket options applied once connected
 	* @return A channel interface
 	*/
 	IChannel* AddTCPClient(
@@ -91,7 +106,8 @@ public:
 	    const opendnp3::ChannelRetry& retry,
 	    const std::string& host,
 	    const std::string& local,
-	    uint16_t port);
+	    uint16_t port,
+	    const asiopal::TCPSettings& tcp = asiopal::TCPSettings());
 
 	/**
 	* Add a tcp server channel
@@ -101,6 +117,7 @@ public:
 	* @param retry Retry parameters for failed channels
 	* @param endpoint Network adapter to listen on, i.e. 127.0.0.1 or 0.0.0.0
 	* @param port Port to listen on
+	* @param tcp Socket options applied to each accepted connection
 	* @return A channel interface
 	*/
 	IChannel* AddTCPServer(
@@ -108,7 +125,27 @@ public:
 	    uint32_t levels,
 	    const opendnp3::ChannelRetry& retry,
 	    const std::string& endpoint,
-	    uint16_t port);
+	    uint16_t port,
+	    const asiopal::TCPSettings& tcp = asiopal::TCPSettings());
+
+	/**
+	* Add a tcp listener that accepts many concurrent connections on one endpoint. Each
+	* connection is routed to the master or outstation registered on the listener whose
+	* link addresses match the first frame received on it.
+	*
+	* @param id Alias that will be used for logging purposes with this listener
+	* @param levels Bitfield that describes the logging level for this listener, its connections, and sessions
+	* @param endpoint Network adapter to listen on, i.e. 127.0.0.1 or 0.0.0.0
+	* @param port Port to listen on
+	* @param routeTimeout How long a connection may stay open without presenting a registered route
+	* @return A listener interface, or nullptr if the endpoint could not be bound
+	*/
+	IListener* AddTCPListener(
+	    char const* id,
+	    uint32_t levels,
+	    const std::string& endpoint,
+	    uint16_t port,
+	    const openpal::TimeDuration& routeTimeout = openpal::TimeDuration::Seconds(30));
 
 	/**
 	* Add a serial channel
@@ -125,11 +162,91 @@ public:
 	    const opendnp3::ChannelRetry& retry,
 	    asiopal::SerialSettings settings);
 
+	/**
+	* Add a pair of channels connected to each other by an in-process memory pipe
+	*
+	* @param idA Alias that will be used for logging purposes with the first channel
+	* @param idB Alias that will be used for logging purposes with the second channel
+	* @param levels Bitfield that describes the logging level for both channels and associated sessions
+	* @param retry Retry parameters for failed channels
+	* @param settings settings object that describes the latency, bandwidth, and error rate of the pipe
+	* @return Both channel interfaces, in the order of their aliases
+	*/
+	std::pair<IChannel*, IChannel*> AddMemoryPair(
+	    char const* idA,
+	    char const* idB,
+	    uint32_t levels,
+	    const opendnp3::ChannelRetry& retry,
+	    const asiopal::MemoryPipeSettings& settings = asiopal::MemoryPipeSettings());
+
+	/**
+	* Add a UDP channel that exchanges datagrams with one peer
+	*
+	* All of the UDP channels of the manager with the same local endpoint share one socket, datagrams
+	* are routed to the channel whose peer sent them. The first of those channels decides the socket options.
+	*
+	* @param id Alias that will be used for logging purposes with this channel
+	* @param levels Bitfield that describes the logging level for this channel and associated sessions
+	* @param retry Retry parameters for failed channels
+	* @param localAddress Network adapter to bind, i.e. 127.0.0.1 or 0.0.0.0
+	* @param localPort Port to bind, i.e. 20000
+	* @param remoteAddress IP address of the peer
+	* @param remotePort Port of the peer
+	* @param udp Options of the shared socket
+	* @return A channel interface
+	*/
+	IChannel* AddUDPChannel(
+	    char const* id,
+	    uint32_t levels,
+	    const opendnp3::ChannelRetry& retry,
+	    const std::string& localAddress,
+	    uint16_t localPort,
+	    const std::string& remoteAddress,
+	    uint16_t remotePort,
+	    const asiopal::UDPSettings& udp = asiopal::UDPSettings());
+
+	/**
+	* Datagram and system call counts of the sockets used by the UDP channels of this manager
+	*/
+	asiopal::DatagramStatistics GetUDPStatistics();
+
+	/**
+	* Carry the reads and writes of the tcp client, server, and listener channels added afterwards over
+	* io_uring instead of the asio reactor. Each io_service of the thread pool gets a ring of its own.
+	*
+	* Linux 6.0 or later only, TLS channels are not affected.
+	*
+	* @param settings Sizes of the rings and their receive buffer pools
+	* @return false if the platform or kernel doesn't support it, the channels use the reactor as before
+	*/
+	bool EnableIOUring(const asiopal::IOUringSettings& settings = asiopal::IOUringSettings());
+
+	/**
+	* System call and completion counts of the rings of this manager
+	*/
+	asiopal::IOUringStatistics GetIOUringStatistics();
+
+	/**
+	* Limit how quickly the tcp and TLS client channels of this manager may attempt to connect. Channels
+	* waiting to connect are admitted in order of ChannelRetry::priority, highest first.
+	*
+	* By default there are no limits.
+	*/
+	void SetOpenAdmission(const OpenAdmissionSettings& settings);
+
+	/**
+	* Wait times and durations of the connection attempts of the client channels of this manager
+	*/
+	OpenAdmissionStatistics GetOpenAdmissionStatistics();
+
 #ifdef OPENDNP3_USE_TLS
 
 	/**
 	* Add a TLS client channel
 	*
+	* Channels with identical configurations share one TLS context, so the certificates are only loaded once.
+	* The channel offers the session it negotiated last when it reconnects, see TLSConfig::allowSessionResumption
+	*
 	* @throw std::system_error Throws underlying ASIO exception of TLS configuration is invalid
 	*
 	* @param id Alias that will be used for logging purposes with this channel
@@ -153,6 +270,9 @@ public:
 	/**
 	* Add a TLS server channel
 	*
+	* Channels with identical configurations share one TLS context, so the certificates are only loaded once.
+	* Ticket keys and session IDs are shared with the other TLS server channels of this manager
+	*
 	* @throw std::system_error Throws underlying ASIO exception of TLS configuration is invalid
 	*
 	* @param id Alias that will be used for logging purposes with this channel
@@ -171,6 +291,21 @@ public:
 	    uint16_t port,
 	    const asiopal::TLSConfig& config);
 
+	/**
+	* Full vs resumed handshakes of all the TLS channels of this manager
+	*/
+	asiopal::TLSSessionStatistics GetTLSSessionStatistics();
+
+	/**
+	* Reload the certificates and private keys of all the TLS channels from the files named in their configurations.
+	*
+	* Connections opened afterwards use the new certificates, established sessions are not interrupted.
+	* Cached TLS sessions are forgotten, so the next connection of each channel does a full handshake.
+	*
+	* @return false if any of the files failed to load, the channels using them keep their current certificates
+	*/
+	bool ReloadTLSCertificates();
+
 #endif
 
 private:
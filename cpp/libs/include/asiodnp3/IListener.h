@@ -0,0 +1,130 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIODNP3_ILISTENER_H
+#define ASIODNP3_ILISTENER_H
+
+#include <opendnp3/master/MasterStackConfig.h>
+#include <opendnp3/master/ISOEHandler.h>
+#include <opendnp3/master/IMasterApplication.h>
+
+#include <opendnp3/outstation/OutstationStackConfig.h>
+#include <opendnp3/outstation/ICommandHandler.h>
+#include <opendnp3/outstation/IOutstationApplication.h>
+
+#include <openpal/logging/LogFilters.h>
+
+#include "IMaster.h"
+#include "IOutstation.h"
+#include "DestructorHook.h"
+#include "ListenerStatistics.h"
+
+#include <functional>
+#include <string>
+
+namespace asiodnp3
+{
+
+/**
+* Decides whether a new connection may take over a route that is bound to another open connection
+*
+* @param boundAddress Remote address of the connection the route is bound to
+* @param newAddress Remote address of the connection that presented the route
+* @return true to move the route to the new connection
+*/
+typedef std::function<bool (const std::string& boundAddress, const std::string& newAddress)> RouteTakeoverHandlerT;
+
+/**
+* A single TCP endpoint that accepts many concurrent connections.
+*
+* Masters and outstations are registered up front by their link addresses. Each accepted
+* connection is routed to the registered stack whose remote/local address pair matches the
+* source/destination of the first frame it receives. A route is freed when its connection
+* closes. A newer connection that presents a route still bound to an open connection is refused,
+* unless a route takeover handler allows it.
+*/
+class IListener : public DestructorHook
+{
+public:
+
+	virtual ~IListener() {}
+
+	/**
+	* Synchronously read the listener statistics
+	*/
+	virtual ListenerStatistics GetStatistics() = 0;
+
+	/**
+	* Synchronously shutdown the listener, all of its connections, and all of its stacks
+	*/
+	virtual void Shutdown() = 0;
+
+	/**
+	*  @return The current logger settings for this listener
+	*/
+	virtual openpal::LogFilters GetLogFilters() const = 0;
+
+	/**
+	*  @param filters Adjust the filters to this value
+	*/
+	virtual void SetLogFilters(const openpal::LogFilters& filters) = 0;
+
+	/**
+	* Allow some connections to take over a route that is still bound to an open connection, i.e.
+	* a master that reconnected before its old connection was detected as closed. The handler runs
+	* on the listener's executor. Takeovers are refused until a handler is set.
+	*/
+	virtual void SetRouteTakeoverHandler(const RouteTakeoverHandlerT& handler) = 0;
+
+	/**
+	* Register a master that is routed to the connection that presents its link addresses
+	*
+	* @param id An ID that gets used for logging
+	* @param SOEHandler Callback object for all received measurements
+	* @param application The master application bound to the master session
+	* @param config Configuration object that controls how the master behaves
+	*
+	* @return interface representing the running master, nullptr if the route is already registered
+	*/
+	virtual IMaster* AddMaster(		char const* id,
+	                                opendnp3::ISOEHandler& SOEHandler,
+	                                opendnp3::IMasterApplication& application,
+	                                const opendnp3::MasterStackConfig& config) = 0;
+
+	/**
+	* Register an outstation that is routed to the connection that presents its link addresses
+	*
+	* @param id An ID that gets used for logging
+	* @param commandHandler Callback object for handling command requests
+	* @param application Callback object for user code
+	* @param config Configuration object that controls how the outstation behaves
+	*
+	* @return interface representing the running outstation, nullptr if the route is already registered
+	*/
+	virtual IOutstation* AddOutstation( char const* id,
+	                                    opendnp3::ICommandHandler& commandHandler,
+	                                    opendnp3::IOutstationApplication& application,
+	                                    const opendnp3::OutstationStackConfig& config) = 0;
+
+};
+
+}
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIODNP3_LISTENERSTATISTICS_H
+#define ASIODNP3_LISTENERSTATISTICS_H
+
+#include <cstdint>
+
+namespace asiodnp3
+{
+
+/**
+* Counters for a listener that accepts many connections on one endpoint
+*/
+struct ListenerStatistics
+{
+	ListenerStatistics() : numAccepted(0), numAcceptErrors(0), numRouted(0), numReplaced(0), numRefused(0), numUnrouted(0), numTimedOut(0), numActive(0)
+	{}
+
+	/// Number of connections accepted
+	uint32_t numAccepted;
+
+	/// Number of errors returned by the acceptor
+	uint32_t numAcceptErrors;
+
+	/// Number of times a connection was bound to a registered stack
+	uint32_t numRouted;
+
+	/// Number of times a binding moved from an older connection to a newer one
+	uint32_t numReplaced;
+
+	/// Number of frames received for a route bound to another open connection that wasn't taken over
+	uint32_t numRefused;
+
+	/// Number of frames received for a route with no enabled registration
+	uint32_t numUnrouted;
+
+	/// Number of connections closed because no frame routed them in time
+	uint32_t numTimedOut;
+
+	/// Number of connections currently open
+	uint32_t numActive;
+};
+
+}
+
+#endif
@@ -0,0 +1,53 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIODNP3_OPENADMISSIONSETTINGS_H
+#define ASIODNP3_OPENADMISSIONSETTINGS_H
+
+#include <cstdint>
+
+namespace asiodnp3
+{
+
+/**
+* Settings that limit how quickly the client channels of a manager may open connections. They
+* keep a large number of channels from all connecting at the same instant after an outage.
+*/
+struct OpenAdmissionSettings
+{
+	OpenAdmissionSettings() : maxConcurrentOpens(0), opensPerSecond(0), openBurst(1), fullJitter(false)
+	{}
+
+	/// Maximum number of connection attempts that may be in progress at once, 0 == unlimited
+	uint32_t maxConcurrentOpens;
+
+	/// Rate at which new connection attempts may begin, 0 == unlimited
+	uint32_t opensPerSecond;
+
+	/// Number of attempts that may begin back to back before the rate applies
+	uint32_t openBurst;
+
+	/// If true, each retry waits a random time between zero and the delay given by the retry strategy
+	bool fullJitter;
+};
+
+}
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIODNP3_OPENADMISSIONSTATISTICS_H
+#define ASIODNP3_OPENADMISSIONSTATISTICS_H
+
+#include <cstdint>
+
+namespace asiodnp3
+{
+
+/**
+* Counters for the connection attempts of the client channels of a manager
+*/
+struct OpenAdmissionStatistics
+{
+	OpenAdmissionStatistics() :
+		numWaiting(0), numOpening(0), numAdmitted(0), numOpenSuccess(0), numOpenFailure(0),
+		totalWaitMs(0), maxWaitMs(0), totalOpenMs(0), maxOpenMs(0)
+	{}
+
+	/// Number of channels currently waiting to begin an attempt
+	uint32_t numWaiting;
+
+	/// Number of attempts currently in progress
+	uint32_t numOpening;
+
+	/// Number of attempts that have been allowed to begin
+	uint32_t numAdmitted;
+
+	/// Number of attempts that ended with the channel online
+	uint32_t numOpenSuccess;
+
+	/// Number of attempts that failed or were abandoned
+	uint32_t numOpenFailure;
+
+	/// Sum of the times channels waited before their attempts began
+	uint64_t totalWaitMs;
+
+	/// Longest time a channel waited before its attempt began
+	uint64_t maxWaitMs;
+
+	/// Sum of the durations of the attempts that ended
+	uint64_t totalOpenMs;
+
+	/// Longest duration of an attempt that ended
+	uint64_t maxOpenMs;
+};
+
+}
+
+#endif
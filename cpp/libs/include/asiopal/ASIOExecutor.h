@@ -25,11 +25,12 @@
 
 #include "Synchronized.h"
 #include "SteadyClock.h"
+#include "ExecutorStrand.h"
+#include "HandlerArena.h"
 
 #include <asio.hpp>
 #include <functional>
-#include <queue>
-#include <set>
+#include <vector>
 
 namespace asiopal
 {
@@ -62,7 +63,7 @@ public:
 	void BlockFor(const std::function<void()>& action);
 
 	// access to the underlying strand is provided for wrapping callbacks
-	asio::strand strand;
+	ExecutorStrand strand;
 
 private:
 
@@ -78,12 +79,14 @@ private:
 
 	void StartTimer(TimerASIO*, const openpal::Action0& runnable);
 
-	typedef std::deque<TimerASIO*> TimerQueue;
-	typedef std::set<TimerASIO*> TimerMap;
+	// vectors never give back their capacity, so reusing timers doesn't allocate
+	typedef std::vector<TimerASIO*> TimerStack;
 
-	TimerQueue allTimers;
-	TimerQueue idleTimers;
-	TimerMap activeTimers;
+	TimerStack allTimers;
+	TimerStack idleTimers;
+	uint32_t numActiveTimers;
+
+	std::shared_ptr<HandlerArena> postArena;
 
 	void OnTimerCallback(const std::error_code&, TimerASIO*, const openpal::Action0& runnable);
 };
@@ -32,6 +32,18 @@ namespace asiopal
 // Serial port configuration functions "free" to keep the classes simple.
 bool Configure(SerialSettings& arSettings, asio::serial_port& arPort, std::error_code& ec);
 
+/// Wake reads only once this many bytes are waiting (termios VMIN)
+bool SetReadMinimum(uint8_t minBytes, asio::serial_port& port, std::error_code& ec);
+
+/// Hand RS-485 direction control to the driver with the RTS delays of the settings
+bool SetRS485(const SerialSettings& settings, asio::serial_port& port, std::error_code& ec);
+
+/// Set ASYNC_LOW_LATENCY on the port, not every driver supports it
+bool SetLowLatency(asio::serial_port& port, std::error_code& ec);
+
+/// Number of received bytes waiting in the driver
+uint32_t BytesAvailable(asio::serial_port& port, std::error_code& ec);
+
 }
 
 #endif
@@ -0,0 +1,167 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIOPAL_DATAGRAMSOCKET_H
+#define ASIOPAL_DATAGRAMSOCKET_H
+
+#include "asiopal/UDPSettings.h"
+#include "asiopal/DatagramStatistics.h"
+
+#include <openpal/container/RSlice.h>
+#include <openpal/container/WSlice.h>
+#include <openpal/util/Uncopyable.h>
+
+#include <asio/io_service.hpp>
+#include <asio/ip/udp.hpp>
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace asiopal
+{
+
+class PhysicalLayerUDP;
+
+/**
+* One UDP socket shared by any number of PhysicalLayerUDP sessions.
+*
+* Each session is bound to the endpoint of its peer. Received datagrams are routed to the session of
+* the endpoint they came from, the session reads them one datagram at a time. Sessions queue their
+* writes here and they are sent together, so on Linux a whole batch of datagrams costs one recvmmsg or
+* sendmmsg call.
+*
+* The socket is bound when the first session attaches and closed when the last one detaches. Every
+* use of the socket and the session table happens under one mutex, and the results are posted to the
+* executors of the sessions.
+*/
+class DatagramSocket final : public std::enable_shared_from_this<DatagramSocket>, private openpal::Uncopyable
+{
+	struct Session
+	{
+		Session() :
+			pLayer(nullptr),
+			pRead(nullptr),
+			readSize(0),
+			queuedOffset(0),
+			isWriting(false)
+		{}
+
+		PhysicalLayerUDP* pLayer;
+
+		// outstanding read
+		uint8_t* pRead;
+		uint32_t readSize;
+
+		// datagrams that arrived while no read was outstanding
+		std::deque<std::vector<uint8_t>> queued;
+		uint32_t queuedOffset;
+
+		// outstanding write, waits in the transmit queue
+		bool isWriting;
+		openpal::RSlice write;
+	};
+
+public:
+
+	DatagramSocket(asio::io_service& service, const std::string& address, uint16_t port, const UDPSettings& settings);
+
+	~DatagramSocket();
+
+	/**
+	* Route the datagrams of a peer to a session, binding the socket if it's the first session
+	*
+	* @return an error if the socket can't be bound or another session already has the peer
+	*/
+	std::error_code Attach(PhysicalLayerUDP* pLayer, const asio::ip::udp::endpoint& remote);
+
+	/// Stop routing to a session, its outstanding read and write complete as aborted
+	void Detach(PhysicalLayerUDP* pLayer, const asio::ip::udp::endpoint& remote);
+
+	/// Read the next datagram from the peer, or as much of it as fits into the buffer
+	void Read(const asio::ip::udp::endpoint& remote, openpal::WSlice& buffer);
+
+	/// Send the buffer to the peer as one datagram
+	void Write(const asio::ip::udp::endpoint& remote, const openpal::RSlice& buffer);
+
+	DatagramStatistics GetStatistics();
+
+	/// The port the socket is bound to, 0 while it's closed
+	uint16_t GetLocalPort();
+
+private:
+
+	// ------- all of the following are called with the mutex held --------
+
+	std::error_code Bind();
+	void Close();
+	void StartReceive();
+	void StartFlush();
+
+	// receive into the batch, returning the number of datagrams
+	uint32_t ReceiveBatch(std::error_code& ec);
+
+	// send the writes of the first sessions in the transmit queue, returning the number sent
+	uint32_t SendBatch(uint32_t count, std::error_code& ec);
+
+	void Route(const asio::ip::udp::endpoint& sender, const uint8_t* pData, uint32_t size);
+	void CompleteRead(Session& session);
+	void PostRead(Session& session, uint32_t num);
+	void CompleteWrite(Session& session, const std::error_code& ec);
+
+	// ------- handlers, these lock the mutex --------
+
+	void OnReadable(const std::error_code& ec, uint32_t generation);
+	void OnWritable(const std::error_code& ec, uint32_t generation);
+	void Flush();
+
+	const std::string address;
+	const uint16_t port;
+	const UDPSettings settings;
+
+	asio::io_service& service;
+
+	std::mutex mutex;
+	asio::ip::udp::socket socket;
+
+	// incremented whenever the socket is bound, so the handlers of a closed socket do nothing
+	uint32_t generation;
+	bool isFlushPosted;
+	bool isWaitingWritable;
+
+	std::map<asio::ip::udp::endpoint, Session> sessions;
+
+	// peers of the sessions waiting to send, in the order they wrote
+	std::deque<asio::ip::udp::endpoint> transmitQueue;
+
+	// the message headers and buffers of one batch, allocated when the socket is first bound
+	struct Batch;
+	std::unique_ptr<Batch> batch;
+
+	DatagramStatistics statistics;
+};
+
+}
+
+#endif
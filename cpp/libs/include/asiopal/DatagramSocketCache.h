@@ -0,0 +1,61 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIOPAL_DATAGRAMSOCKETCACHE_H
+#define ASIOPAL_DATAGRAMSOCKETCACHE_H
+
+#include "asiopal/DatagramSocket.h"
+
+#include <openpal/util/Uncopyable.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace asiopal
+{
+
+/**
+* The datagram sockets shared by the UDP channels of a DNP3Manager, one per local endpoint. A socket
+* lives as long as the last channel that uses it.
+*/
+class DatagramSocketCache : private openpal::Uncopyable
+{
+public:
+
+	/// Get the socket of a local endpoint, creating it if no channel uses it yet
+	std::shared_ptr<DatagramSocket> Get(asio::io_service& service, const std::string& address, uint16_t port, const UDPSettings& settings);
+
+	/// The number of distinct sockets in use
+	uint32_t NumSockets();
+
+	/// The sum of the counters of every socket in use
+	DatagramStatistics GetStatistics();
+
+private:
+
+	std::mutex mutex;
+	std::map<std::string, std::weak_ptr<DatagramSocket>> sockets;
+};
+
+}
+
+#endif
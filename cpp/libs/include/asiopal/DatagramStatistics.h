@@ -0,0 +1,80 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIOPAL_DATAGRAMSTATISTICS_H
+#define ASIOPAL_DATAGRAMSTATISTICS_H
+
+#include <cstdint>
+
+namespace asiopal
+{
+
+/**
+* Counters of the datagram sockets shared by UDP channels
+*/
+struct DatagramStatistics
+{
+	DatagramStatistics() :
+		numRx(0),
+		numTx(0),
+		numReceiveCalls(0),
+		numSendCalls(0),
+		numUnrouted(0),
+		numDropped(0),
+		numTruncated(0)
+	{}
+
+	DatagramStatistics& operator+=(const DatagramStatistics& rhs)
+	{
+		numRx += rhs.numRx;
+		numTx += rhs.numTx;
+		numReceiveCalls += rhs.numReceiveCalls;
+		numSendCalls += rhs.numSendCalls;
+		numUnrouted += rhs.numUnrouted;
+		numDropped += rhs.numDropped;
+		numTruncated += rhs.numTruncated;
+		return *this;
+	}
+
+	/// Datagrams received
+	uint64_t numRx;
+
+	/// Datagrams sent
+	uint64_t numTx;
+
+	/// System calls that received datagrams, numRx / numReceiveCalls is the average batch
+	uint64_t numReceiveCalls;
+
+	/// System calls that sent datagrams
+	uint64_t numSendCalls;
+
+	/// Datagrams from an endpoint that no channel is open for
+	uint64_t numUnrouted;
+
+	/// Datagrams dropped because their channel already had maxQueuedDatagrams waiting
+	uint64_t numDropped;
+
+	/// Datagrams dropped because they were larger than maxDatagramSize
+	uint64_t numTruncated;
+};
+
+}
+
+#endif
@@ -0,0 +1,201 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIOPAL_EXECUTORSTRAND_H
+#define ASIOPAL_EXECUTORSTRAND_H
+
+#include <openpal/util/Uncopyable.h>
+
+#include <asio.hpp>
+
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace asiopal
+{
+
+class ExecutorStrand;
+
+/**
+* A completion handler that is invoked through an ExecutorStrand. Equivalent to asio::strand::wrap
+*/
+template <class Handler>
+class StrandHandler
+{
+public:
+
+	StrandHandler(ExecutorStrand& strand, const Handler& handler) : pStrand(&strand), handler(handler)
+	{}
+
+	template <class... Args>
+	void operator()(const Args& ... args);
+
+	ExecutorStrand* pStrand;
+	Handler handler;
+};
+
+/**
+* Serializes the callbacks of an executor.
+*
+* Uses an asio::strand unless the io_service has been marked as run by a single thread
+* (see SingleThreadService). In that case callbacks are already serialized, so handlers
+* are posted directly to the io_service and wrapped handlers are invoked in place.
+*/
+class ExecutorStrand : private openpal::Uncopyable
+{
+public:
+
+	explicit ExecutorStrand(asio::io_service& service);
+
+	template <class Handler>
+	void post(const Handler& handler)
+	{
+		if (pStrand)
+		{
+			pStrand->post(handler);
+		}
+		else
+		{
+			service.post(handler);
+		}
+	}
+
+	template <class Handler>
+	StrandHandler<Handler> wrap(const Handler& handler)
+	{
+		return StrandHandler<Handler>(*this, handler);
+	}
+
+	bool running_in_this_thread() const
+	{
+		return pStrand ? pStrand->running_in_this_thread() : (std::this_thread::get_id() == threadId);
+	}
+
+	asio::io_service& get_io_service()
+	{
+		return service;
+	}
+
+	/// @return true if callbacks bypass the strand
+	bool IsStrandFree() const
+	{
+		return !pStrand;
+	}
+
+	// access to the underlying strand, null if strand free
+	asio::strand* GetStrand()
+	{
+		return pStrand.get();
+	}
+
+private:
+
+	asio::io_service& service;
+	const std::thread::id threadId;
+	std::unique_ptr<asio::strand> pStrand;
+};
+
+template <class Handler>
+template <class... Args>
+void StrandHandler<Handler>::operator()(const Args& ... args)
+{
+	if (pStrand->IsStrandFree())
+	{
+		handler(args...);
+	}
+	else
+	{
+		pStrand->GetStrand()->dispatch(std::bind(handler, args...));
+	}
+}
+
+// asio handler hooks so that the intermediate handlers of composed operations are also serialized
+
+/**
+* Invokes a function without forwarding the invocation hook back to the StrandHandler that it came from.
+* Memory is still requested from the function, so the dispatch reuses the block its operation just released.
+*/
+template <class Function>
+class StrandFunction
+{
+public:
+
+	explicit StrandFunction(const Function& function) : function(function)
+	{}
+
+	void operator()()
+	{
+		function();
+	}
+
+	Function function;
+};
+
+template <class Function>
+inline void* asio_handler_allocate(std::size_t size, StrandFunction<Function>* context)
+{
+	using asio::asio_handler_allocate;
+	return asio_handler_allocate(size, &context->function);
+}
+
+template <class Function>
+inline void asio_handler_deallocate(void* pointer, std::size_t size, StrandFunction<Function>* context)
+{
+	using asio::asio_handler_deallocate;
+	asio_handler_deallocate(pointer, size, &context->function);
+}
+
+template <class Function, class Handler>
+inline void asio_handler_invoke(Function& function, StrandHandler<Handler>* context)
+{
+	if (context->pStrand->IsStrandFree())
+	{
+		function();
+	}
+	else
+	{
+		context->pStrand->GetStrand()->dispatch(StrandFunction<Function>(function));
+	}
+}
+
+template <class Function, class Handler>
+inline void asio_handler_invoke(const Function& function, StrandHandler<Handler>* context)
+{
+	if (context->pStrand->IsStrandFree())
+	{
+		Function copy(function);
+		copy();
+	}
+	else
+	{
+		context->pStrand->GetStrand()->dispatch(StrandFunction<Function>(function));
+	}
+}
+
+template <class Handler>
+inline bool asio_handler_is_continuation(StrandHandler<Handler>* context)
+{
+	return context->pStrand->running_in_this_thread();
+}
+
+}
+
+#endif
@@ -0,0 +1,159 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIOPAL_HANDLERARENA_H
+#define ASIOPAL_HANDLERARENA_H
+
+#include <openpal/util/Uncopyable.h>
+
+#include <asio.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace asiopal
+{
+
+class HandlerArena;
+
+/**
+* A completion handler whose operation memory comes from a HandlerArena
+*/
+template <class Handler>
+class ArenaHandler
+{
+public:
+
+	ArenaHandler(const std::shared_ptr<HandlerArena>& arena, const Handler& handler) : pArena(arena), handler(handler)
+	{}
+
+	ArenaHandler(const ArenaHandler& other) : pArena(other.pArena), handler(other.handler)
+	{}
+
+	ArenaHandler(ArenaHandler&& other) : pArena(std::move(other.pArena)), handler(std::move(other.handler))
+	{}
+
+	template <class... Args>
+	void operator()(const Args& ... args)
+	{
+		handler(args...);
+	}
+
+	// shared so that the arena outlives operations that are destroyed after their owner
+	std::shared_ptr<HandlerArena> pArena;
+	Handler handler;
+};
+
+/**
+* A small-block arena that recycles the memory asio allocates for completion handlers.
+*
+* Each physical layer keeps one arena per kind of operation (read, write) and the executor keeps
+* one per timer and one for posts, so steady-state operations never touch the heap. Requests
+* larger than a block, or made while every block is in use, fall back to the heap.
+*/
+class HandlerArena : public std::enable_shared_from_this<HandlerArena>, private openpal::Uncopyable
+{
+public:
+
+	static const std::size_t BLOCK_SIZE = 512;
+
+	static std::shared_ptr<HandlerArena> Create(uint32_t numBlocks = 1)
+	{
+		return std::shared_ptr<HandlerArena>(new HandlerArena(numBlocks));
+	}
+
+	void* Allocate(std::size_t size);
+
+	/// Return memory from Allocate, to the arena it came from or to the heap
+	static void Deallocate(void* pointer);
+
+	template <class Handler>
+	ArenaHandler<Handler> Wrap(const Handler& handler)
+	{
+		return ArenaHandler<Handler>(shared_from_this(), handler);
+	}
+
+private:
+
+	explicit HandlerArena(uint32_t numBlocks);
+
+	// precedes every allocation, so memory can be returned without the handler that requested it
+	union Header
+	{
+		HandlerArena* pOwner;
+		std::max_align_t align;
+	};
+
+	union Block
+	{
+		Block* pNext;
+		std::aligned_storage<sizeof(Header) + BLOCK_SIZE, std::alignment_of<std::max_align_t>::value>::type storage;
+	};
+
+	void Release(Block* pBlock);
+
+	std::mutex mutex;
+	const uint32_t numBlocks;
+	std::unique_ptr<Block[]> blocks;
+	Block* pFree;
+};
+
+// asio handler hooks that take memory from the arena and forward everything else to the wrapped handler
+
+template <class Handler>
+inline void* asio_handler_allocate(std::size_t size, ArenaHandler<Handler>* context)
+{
+	return context->pArena->Allocate(size);
+}
+
+template <class Handler>
+inline void asio_handler_deallocate(void* pointer, std::size_t size, ArenaHandler<Handler>* context)
+{
+	// the arena is found from the memory itself, the copy of the handler asio passes here isn't always one the compiler can prove initialised
+	HandlerArena::Deallocate(pointer);
+}
+
+template <class Function, class Handler>
+inline void asio_handler_invoke(Function& function, ArenaHandler<Handler>* context)
+{
+	using asio::asio_handler_invoke;
+	asio_handler_invoke(function, &context->handler);
+}
+
+template <class Function, class Handler>
+inline void asio_handler_invoke(const Function& function, ArenaHandler<Handler>* context)
+{
+	using asio::asio_handler_invoke;
+	asio_handler_invoke(function, &context->handler);
+}
+
+template <class Handler>
+inline bool asio_handler_is_continuation(ArenaHandler<Handler>* context)
+{
+	using asio::asio_handler_is_continuation;
+	return asio_handler_is_continuation(&context->handler);
+}
+
+}
+
+#endif
@@ -25,16 +25,23 @@
 
 #include <asio.hpp>
 
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <string>
 #include <thread>
 
 #include <asiopal/SteadyClock.h>
+#include <asiopal/ThreadPoolSettings.h>
 
 namespace asiopal
 {
 
 /**
 *	A thread pool that calls asio::io_service::run
+*
+*	In SHARED mode all threads run one io_service. In SHARDED mode each thread runs its own
+*	io_service so that everything assigned to a shard stays on one thread.
 */
 class IOServiceThreadPool
 {
@@ -45,13 +52,20 @@ public:
 	    uint32_t levels,
 	    uint32_t aConcurrency,
 	std::function<void()> onThreadStart = []() {},
-	std::function<void()> onThreadExit = []() {}
+	std::function<void()> onThreadExit = []() {},
+	const ThreadPoolSettings& settings = ThreadPoolSettings()
 	);
 
 	~IOServiceThreadPool();
 
+	/// @return the io_service of the first shard
 	asio::io_service& GetIOService();
 
+	/// @return the io_service of the shard assigned to a new channel with the specified id
+	asio::io_service& GetIOService(const std::string& id);
+
+	uint32_t NumShards() const;
+
 	void Shutdown();
 
 private:
@@ -63,11 +77,22 @@ private:
 	std::function<void ()> onThreadExit;
 
 	bool isShutdown;
+	ShardSelectorT selector;
+	std::atomic<uint32_t> nextShard;
+
+	struct Shard
+	{
+		Shard();
+
+		asio::io_service ioservice;
+		asio::basic_waitable_timer< asiopal::asiopal_steady_clock > infiniteTimer;
+	};
+
+	void Run(Shard& shard);
 
-	void Run();
+	void PinToCore(std::thread& thread, uint32_t index);
 
-	asio::io_service ioservice;
-	asio::basic_waitable_timer< asiopal::asiopal_steady_clock > infiniteTimer;
+	std::vector<std::unique_ptr<Shard>> shards;
 	std::vector<std::thread*> threads;
 };
 
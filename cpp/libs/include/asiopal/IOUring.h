@@ -0,0 +1,99 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIOPAL_IOURING_H
+#define ASIOPAL_IOURING_H
+
+#include "asiopal/IOUringSettings.h"
+#include "asiopal/IOUringStatistics.h"
+
+#include <openpal/container/RSlice.h>
+#include <openpal/container/WSlice.h>
+#include <openpal/util/Uncopyable.h>
+
+#include <asio/io_service.hpp>
+
+#include <memory>
+#include <system_error>
+
+namespace asiopal
+{
+
+class PhysicalLayerBaseTCP;
+
+/**
+* An io_uring that carries the reads and writes of tcp physical layers instead of the asio reactor.
+*
+* Each connection has one multishot receive that fills buffers from a pool shared by all connections,
+* the layer's reads are copied out of them. Writes are sent with sendmsg straight from the layer's
+* buffers. Entries are queued by every layer and submitted together by one io_uring_enter per pass
+* of the io_service, which also waits on the ring to reap completions. The results are posted to the
+* executors of the layers.
+*
+* Only available on Linux 6.0 or later, connections are still established by asio.
+*/
+class IOUring final : private openpal::Uncopyable
+{
+public:
+
+	class Impl;
+
+	/// Per connection state, owned by the ring
+	class Socket;
+
+	/**
+	* Set up a ring on the io_service
+	*
+	* @return nullptr if the platform or kernel doesn't support it, with the reason in ec
+	*/
+	static std::shared_ptr<IOUring> Create(asio::io_service& service, const IOUringSettings& settings, std::error_code& ec);
+
+	~IOUring();
+
+	/// Start receiving on a connected socket
+	Socket* Attach(PhysicalLayerBaseTCP* pLayer, int fd);
+
+	/**
+	* Stop receiving before the socket is closed. An outstanding read completes as aborted right away,
+	* an outstanding write once the kernel has finished with its buffers.
+	*/
+	void Detach(Socket* pSocket);
+
+	/// Read whatever has been received, or wait for the next data
+	void Read(Socket* pSocket, openpal::WSlice& buffer);
+
+	/// Send all of the buffers, back to back
+	void Write(Socket* pSocket, const openpal::RSlice* buffers, uint32_t count);
+
+	IOUringStatistics GetStatistics();
+
+	/// Stop waiting on the ring, call once every socket is detached
+	void Shutdown();
+
+private:
+
+	IOUring(const std::shared_ptr<Impl>& impl);
+
+	std::shared_ptr<Impl> impl;
+};
+
+}
+
+#endif
@@ -0,0 +1,52 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIOPAL_IOURINGSETTINGS_H
+#define ASIOPAL_IOURINGSETTINGS_H
+
+#include <cstdint>
+
+namespace asiopal
+{
+
+/**
+* Sizes of the io_uring shared by the tcp channels of a DNP3Manager
+*/
+struct IOUringSettings
+{
+	IOUringSettings() :
+		entries(1024),
+		bufferCount(1024),
+		bufferSize(1024)
+	{}
+
+	/// Submission queue entries, rounded up to a power of 2 by the kernel. The completion queue is 4 times larger
+	uint32_t entries;
+
+	/// Receive buffers in the pool shared by every connection, a power of 2 of at most 32768
+	uint32_t bufferCount;
+
+	/// Size of each receive buffer
+	uint32_t bufferSize;
+};
+
+}
+
+#endif
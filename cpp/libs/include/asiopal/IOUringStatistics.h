@@ -0,0 +1,70 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIOPAL_IOURINGSTATISTICS_H
+#define ASIOPAL_IOURINGSTATISTICS_H
+
+#include <cstdint>
+
+namespace asiopal
+{
+
+/**
+* Counters of the io_uring shared by the tcp channels of a DNP3Manager
+*/
+struct IOUringStatistics
+{
+	IOUringStatistics() :
+		numEnter(0),
+		numSubmitted(0),
+		numCompletions(0),
+		numWakeups(0),
+		numBufferShortages(0)
+	{}
+
+	IOUringStatistics& operator+=(const IOUringStatistics& rhs)
+	{
+		numEnter += rhs.numEnter;
+		numSubmitted += rhs.numSubmitted;
+		numCompletions += rhs.numCompletions;
+		numWakeups += rhs.numWakeups;
+		numBufferShortages += rhs.numBufferShortages;
+		return *this;
+	}
+
+	/// io_uring_enter system calls, each one submits every entry queued since the last
+	uint64_t numEnter;
+
+	/// Submission queue entries
+	uint64_t numSubmitted;
+
+	/// Completion queue entries, a multishot receive produces one per chunk of received data
+	uint64_t numCompletions;
+
+	/// Times the io_service woke up to reap completions
+	uint64_t numWakeups;
+
+	/// Multishot receives stopped because every buffer of the pool was in use
+	uint64_t numBufferShortages;
+};
+
+}
+
+#endif
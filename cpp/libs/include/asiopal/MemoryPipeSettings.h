@@ -0,0 +1,58 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIOPAL_MEMORYPIPESETTINGS_H
+#define ASIOPAL_MEMORYPIPESETTINGS_H
+
+#include <openpal/executor/TimeDuration.h>
+
+#include <cstdint>
+
+namespace asiopal
+{
+
+/// Settings structure for an in-process memory pipe
+struct MemoryPipeSettings
+{
+
+	/// Defaults to an ideal link: no latency, unlimited bandwidth, and no bit errors
+	MemoryPipeSettings() :
+		latency(openpal::TimeDuration::Zero()),
+		bandwidth(0),
+		bitErrorRate(0.0),
+		seed(0)
+	{}
+
+	/// One-way delay applied to every buffer before it reaches the other end
+	openpal::TimeDuration latency;
+
+	/// Maximum throughput of each direction in bytes per second, 0 means unlimited
+	uint32_t bandwidth;
+
+	/// Probability in the range [0, 1] that any single transferred bit is inverted
+	double bitErrorRate;
+
+	/// Seed for the random number generator used for bit-error injection
+	uint32_t seed;
+};
+
+}
+
+#endif
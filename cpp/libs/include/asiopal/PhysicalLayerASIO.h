@@ -24,6 +24,9 @@
 #include "PhysicalLayerBase.h"
 
 #include "ASIOExecutor.h"
+#include "HandlerArena.h"
+
+#include <memory>
 
 namespace asio
 {
@@ -43,14 +46,39 @@ public:
 
 	PhysicalLayerASIO(openpal::LogRoot& root, asio::io_service& service) :
 		PhysicalLayerBase(root),
-		executor(service)
+		ownedExecutor(new ASIOExecutor(service)),
+		executor(*ownedExecutor),
+		readArena(HandlerArena::Create()),
+		writeArena(HandlerArena::Create())
+	{
+		this->SetExecutor(executor);
+	}
+
+	/// Run on an executor shared with other layers, i.e. the connections accepted by a listener
+	PhysicalLayerASIO(openpal::LogRoot& root, ASIOExecutor& sharedExecutor) :
+		PhysicalLayerBase(root),
+		executor(sharedExecutor),
+		readArena(HandlerArena::Create()),
+		writeArena(HandlerArena::Create())
 	{
 		this->SetExecutor(executor);
 	}
 
 	virtual ~PhysicalLayerASIO() {}
 
-	ASIOExecutor executor;
+private:
+
+	std::unique_ptr<ASIOExecutor> ownedExecutor;
+
+public:
+
+	ASIOExecutor& executor;
+
+protected:
+
+	// only one read and one write may be outstanding, so each gets a single recycled block
+	std::shared_ptr<HandlerArena> readArena;
+	std::shared_ptr<HandlerArena> writeArena;
 };
 
 }
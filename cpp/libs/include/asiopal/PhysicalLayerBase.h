@@ -23,6 +23,7 @@
 
 #include <openpal/executor/IExecutor.h>
 #include <openpal/channel/IPhysicalLayer.h>
+#include <openpal/container/Buffer.h>
 #include <openpal/logging/LogRoot.h>
 
 #include <system_error>
@@ -122,6 +123,7 @@ public:
 	virtual void BeginOpen() override final;
 	virtual void BeginClose() override final;
 	virtual void BeginWrite(const  openpal::RSlice&) override final;
+	virtual void BeginWriteBatch(const openpal::RSlice* buffers, uint32_t count) override final;
 	virtual void BeginRead(openpal::WSlice&) override final;
 
 	// Not an event delegated to the states
@@ -141,6 +143,9 @@ public:
 	virtual void DoRead(openpal::WSlice&) = 0;
 	virtual void DoWrite(const  openpal::RSlice&) = 0;
 
+	// By default a batch is copied into one contiguous buffer, layers that can gather override this
+	virtual void DoWriteBatch(const openpal::RSlice* buffers, uint32_t count);
+
 	// These can be optionally overriden to do something more interesting, i.e. specific logging
 	virtual void DoOpenCallback() {}
 	virtual void DoOpenSuccess() {}
@@ -175,6 +180,9 @@ protected:
 private:
 
 	void StartClose();
+
+	// only allocated the first time a batch is copied
+	openpal::Buffer batchBuffer;
 };
 
 inline void PhysicalLayerBase::SetHandler(openpal::IPhysicalLayerCallbacks* apHandler)
@@ -22,6 +22,7 @@
 #define ASIOPAL_PHYSICAL_LAYER_BASE_TCP_H
 
 #include "PhysicalLayerASIO.h"
+#include "IOUring.h"
 
 #include <asio.hpp>
 #include <asio/ip/tcp.hpp>
@@ -36,17 +37,25 @@ Common socket object and some shared implementations for server/client.
 */
 class PhysicalLayerBaseTCP : public PhysicalLayerASIO
 {
+	friend class IOUring::Impl;
+
 public:
 	PhysicalLayerBaseTCP(openpal::LogRoot& root, asio::io_service& service);
 
+	PhysicalLayerBaseTCP(openpal::LogRoot& root, ASIOExecutor& sharedExecutor);
+
 	virtual ~PhysicalLayerBaseTCP() {}
 
 	/* Implement the shared client/server actions */
 	void DoClose();
 	void DoRead(openpal::WSlice&);
 	void DoWrite(const openpal::RSlice&);
+	void DoWriteBatch(const openpal::RSlice* buffers, uint32_t count) override;
 	void DoOpenFailure();
 
+	/// Carry the reads and writes of each connection over a ring instead of the reactor, set before the layer is opened
+	void SetIOUring(IOUring* pRing);
+
 protected:
 
 	asio::ip::tcp::socket socket;
@@ -55,6 +64,12 @@ protected:
 private:
 	void ShutdownSocket();
 
+	/// Attach the connected socket to the ring on its first read or write
+	IOUring::Socket* RingSocket();
+
+	IOUring* pRing;
+	IOUring::Socket* pRingSocket;
+
 };
 }
 
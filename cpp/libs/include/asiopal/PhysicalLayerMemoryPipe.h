@@ -0,0 +1,75 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIOPAL_PHYSICALLAYERMEMORYPIPE_H
+#define ASIOPAL_PHYSICALLAYERMEMORYPIPE_H
+
+#include "PhysicalLayerASIO.h"
+#include "MemoryPipeSettings.h"
+
+#include <memory>
+#include <utility>
+
+namespace asiopal
+{
+
+class MemoryPipe;
+
+/**
+* One end of an in-process, bidirectional pipe. Bytes written to one end are read by the other
+* without any system calls. When no latency is configured, the reading end copies directly out of
+* the writer's buffer and the write only completes once all of it has been consumed.
+*
+* Each end has its own executor, so the two ends may be driven by different channels.
+*/
+class PhysicalLayerMemoryPipe final : public PhysicalLayerASIO
+{
+	friend class MemoryPipe;
+
+public:
+
+	/**
+	* Create both ends of a pipe. The caller takes ownership of the returned layers.
+	*/
+	static std::pair<PhysicalLayerMemoryPipe*, PhysicalLayerMemoryPipe*> CreatePair(
+	    openpal::LogRoot& rootA,
+	    openpal::LogRoot& rootB,
+	    asio::io_service& service,
+	    const MemoryPipeSettings& settings);
+
+	~PhysicalLayerMemoryPipe();
+
+	void DoOpen() override;
+	void DoClose() override;
+	void DoOpeningClose() override;
+	void DoRead(openpal::WSlice&) override;
+	void DoWrite(const openpal::RSlice&) override;
+
+private:
+
+	PhysicalLayerMemoryPipe(openpal::LogRoot& root, asio::io_service& service, const std::shared_ptr<MemoryPipe>& pipe, uint8_t side);
+
+	std::shared_ptr<MemoryPipe> pipe;
+	const uint8_t side;
+};
+
+}
+
+#endif
@@ -52,6 +52,24 @@ protected:
 
 	SerialSettings settings;
 	asio::basic_serial_port<> port;
+
+private:
+
+	bool IsBatching() const;
+	void OnReadSome(const std::error_code& ec, uint32_t numRead);
+	void OnInterCharTimeout();
+	void StartWrite(const openpal::RSlice& buffer);
+
+	// the read in progress, which may be filled by several reads of the port when batching
+	uint8_t* pReadBuffer;
+	uint32_t readCapacity;
+	uint32_t numBatched;
+	openpal::ITimer* pInterCharTimer;
+
+	// a write held back until the turnaround delay has passed
+	openpal::RSlice pendingWrite;
+	openpal::ITimer* pTurnaroundTimer;
+	openpal::MonotonicTimestamp lastRxTime;
 };
 }
 
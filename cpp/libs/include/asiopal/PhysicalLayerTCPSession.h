@@ -0,0 +1,56 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIOPAL_PHYSICAL_LAYER_TCP_SESSION_H
+#define ASIOPAL_PHYSICAL_LAYER_TCP_SESSION_H
+
+#include "PhysicalLayerBaseTCP.h"
+
+#include <asio.hpp>
+#include <asio/ip/tcp.hpp>
+
+namespace asiopal
+{
+
+/**
+* Wraps a single socket that has already been accepted by a listener.
+*
+* The first open succeeds immediately. Once the session is closed it cannot be reopened,
+* the remote is expected to reconnect to the listener instead.
+*/
+class PhysicalLayerTCPSession final : public PhysicalLayerBaseTCP
+{
+public:
+	PhysicalLayerTCPSession(
+	    openpal::LogRoot& root,
+	    ASIOExecutor& executor,
+	    asio::ip::tcp::socket&& accepted
+	);
+
+	void DoOpen() override;
+	void DoOpeningClose() override;
+
+private:
+
+	bool opened;
+};
+}
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIOPAL_PHYSICALLAYERUDP_H
+#define ASIOPAL_PHYSICALLAYERUDP_H
+
+#include "PhysicalLayerASIO.h"
+#include "DatagramSocket.h"
+
+#include <memory>
+#include <string>
+
+namespace asiopal
+{
+
+/**
+* A UDP session with one peer on a DatagramSocket that may be shared with many other sessions.
+*
+* Opening only attaches the session to the socket, there is no connection to establish. Each write is
+* sent as one datagram, each read returns at most one datagram.
+*/
+class PhysicalLayerUDP final : public PhysicalLayerASIO
+{
+	friend class DatagramSocket;
+
+public:
+
+	PhysicalLayerUDP(
+	    openpal::LogRoot& root,
+	    asio::io_service& service,
+	    const std::shared_ptr<DatagramSocket>& socket,
+	    const std::string& remoteAddress,
+	    uint16_t remotePort);
+
+	void DoOpen() override;
+	void DoClose() override;
+	void DoOpeningClose() override;
+	void DoRead(openpal::WSlice&) override;
+	void DoWrite(const openpal::RSlice&) override;
+	void DoOpenSuccess() override;
+
+private:
+
+	std::shared_ptr<DatagramSocket> socket;
+	const std::string remoteAddress;
+	const uint16_t remotePort;
+	asio::ip::udp::endpoint remote;
+};
+
+}
+
+#endif
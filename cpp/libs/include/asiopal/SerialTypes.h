@@ -22,6 +22,7 @@
 #define ASIOPAL_SERIALTYPES_H
 
 #include <string>
+#include <cstdint>
 
 #include <openpal/executor/TimeDuration.h>
 
@@ -67,7 +68,14 @@ struct SerialSettings
 		stopBits(StopBits::ONE),
 		parity(ParityType::NONE),
 		flowType(FlowType::NONE),
-		asyncOpenDelay(openpal::TimeDuration::Milliseconds(500))
+		asyncOpenDelay(openpal::TimeDuration::Milliseconds(500)),
+		readMinBytes(1),
+		interCharTimeout(openpal::TimeDuration::Zero()),
+		lowLatency(false),
+		turnaroundDelay(openpal::TimeDuration::Zero()),
+		rs485(false),
+		rtsDelayBeforeSend(openpal::TimeDuration::Zero()),
+		rtsDelayAfterSend(openpal::TimeDuration::Zero())
 	{}
 
 	/// name of the port, i.e. "COM1" or "/dev/tty0"
@@ -90,6 +98,39 @@ struct SerialSettings
 
 	/// Some physical layers need time to "settle" so that the first tx isn't lost
 	openpal::TimeDuration asyncOpenDelay;
+
+	/**
+	* Number of bytes that must be waiting before the first read of a batch wakes up, like termios VMIN.
+	* Reads aren't aligned to frames, so this only applies when interCharTimeout is set, which collects
+	* the rest of a frame however short it is. The tail of a frame can still be held back until more
+	* traffic arrives if the line goes quiet within the frame for longer than interCharTimeout. POSIX only.
+	*/
+	uint8_t readMinBytes;
+
+	/**
+	* When non-zero, a read that has received some bytes keeps collecting until the line has been idle for
+	* this long or the read buffer is full, like termios VTIME. A frame then arrives in one or a few reads
+	* instead of one per UART interrupt. POSIX only.
+	*/
+	openpal::TimeDuration interCharTimeout;
+
+	/// Ask the driver to push received bytes without its usual buffering delay (ASYNC_LOW_LATENCY). Linux only.
+	bool lowLatency;
+
+	/**
+	* Minimum quiet time between the last received byte and the start of a transmission, giving the other
+	* devices on a half-duplex RS-485 bus time to release the line
+	*/
+	openpal::TimeDuration turnaroundDelay;
+
+	/// Let the driver switch the RS-485 transceiver direction with RTS (TIOCSRS485). Linux only.
+	bool rs485;
+
+	/// Time RTS is asserted before the first bit of a transmission when rs485 is enabled
+	openpal::TimeDuration rtsDelayBeforeSend;
+
+	/// Time RTS stays asserted after the last bit of a transmission when rs485 is enabled
+	openpal::TimeDuration rtsDelayAfterSend;
 };
 
 }
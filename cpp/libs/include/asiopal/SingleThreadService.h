@@ -0,0 +1,66 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIOPAL_SINGLETHREADSERVICE_H
+#define ASIOPAL_SINGLETHREADSERVICE_H
+
+#include <asio.hpp>
+
+#include <thread>
+
+namespace asiopal
+{
+
+/**
+*	An asio service that marks an io_service as being run by exactly one thread.
+*
+*	Executors created on a marked io_service don't need a strand to serialize their callbacks.
+*/
+class SingleThreadService final : public asio::io_service::service
+{
+public:
+
+	static asio::io_service::id id;
+
+	/// Only present so that asio::use_service compiles, leaves the service unmarked
+	template <class Owner>
+	explicit SingleThreadService(Owner& owner) :
+		asio::io_service::service(owner),
+		threadId()
+	{}
+
+	SingleThreadService(asio::io_service& service, std::thread::id threadId);
+
+	/// Mark the io_service as run only by the specified thread
+	static void Mark(asio::io_service& service, std::thread::id threadId);
+
+	/// @return the id of the thread that runs the io_service, or a default id if it is not marked
+	static std::thread::id GetThreadId(asio::io_service& service);
+
+	const std::thread::id threadId;
+
+private:
+
+	virtual void shutdown_service() override {}
+};
+
+}
+
+#endif
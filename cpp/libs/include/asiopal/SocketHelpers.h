@@ -22,8 +22,14 @@
 #ifndef ASIOPAL_SOCKET_HELPERS_H
 #define ASIOPAL_SOCKET_HELPERS_H
 
+#include "asiopal/TCPSettings.h"
+
 #include <openpal/util/Uncopyable.h>
+#include <openpal/logging/Logger.h>
+#include <openpal/logging/LogMacros.h>
+#include <openpal/logging/LogLevels.h>
 
+#include <functional>
 #include <system_error>
 #include <asio.hpp>
 
@@ -51,9 +57,57 @@ public:
 			}
 		}
 	}
+
+	/**
+	* Enable or disable Nagle's algorithm on a connected socket
+	*/
+	static void SetNoDelay(asio::ip::tcp::socket& socket, bool enabled, std::error_code& ec)
+	{
+		socket.set_option(asio::ip::tcp::no_delay(enabled), ec);
+	}
+
+	/**
+	* Enable or disable TCP_CORK on a connected socket. Fails with operation_not_supported where the option doesn't exist.
+	*/
+	static void SetCork(asio::ip::tcp::socket& socket, bool enabled, std::error_code& ec)
+	{
+#ifdef TCP_CORK
+		typedef asio::detail::socket_option::boolean<IPPROTO_TCP, TCP_CORK> cork;
+		socket.set_option(cork(enabled), ec);
+#else
+		ec = asio::error::operation_not_supported;
+#endif
+	}
+
+	/**
+	* Build a configure callback for the TCP physical layers that applies the settings, logging any option that can't be set
+	*/
+	static std::function<void (asio::ip::tcp::socket&)> Configure(const TCPSettings& settings, openpal::Logger logger)
+	{
+		return [settings, logger](asio::ip::tcp::socket & socket) mutable
+		{
+			std::error_code ec;
+			if (settings.noDelay)
+			{
+				SetNoDelay(socket, true, ec);
+				if (ec)
+				{
+					FORMAT_LOG_BLOCK(logger, openpal::logflags::WARN, "Unable to set TCP_NODELAY: %s", ec.message().c_str());
+				}
+			}
+
+			if (settings.cork)
+			{
+				SetCork(socket, true, ec);
+				if (ec)
+				{
+					FORMAT_LOG_BLOCK(logger, openpal::logflags::WARN, "Unable to set TCP_CORK: %s", ec.message().c_str());
+				}
+			}
+		};
+	}
 };
 
 }
 
 #endif
-
@@ -0,0 +1,79 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIOPAL_THREADPOOLSETTINGS_H
+#define ASIOPAL_THREADPOOLSETTINGS_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace asiopal
+{
+
+/// Enumeration for how a thread pool maps threads onto io_service instances
+enum class ThreadPoolMode
+{
+    /// all threads run a single shared io_service
+    SHARED,
+    /// each thread runs its own io_service (shard), channels are assigned to a shard when created
+    SHARDED
+};
+
+/// Maps a channel id onto a shard. The result is taken modulo the number of shards.
+typedef std::function<uint32_t (const std::string& id)> ShardSelectorT;
+
+/// Settings structure for IOServiceThreadPool
+struct ThreadPoolSettings
+{
+	/// Defaults to a single io_service shared by all threads, which is the classic behavior
+	ThreadPoolSettings() :
+		mode(ThreadPoolMode::SHARED),
+		pinThreads(false),
+		strandFree(true)
+	{}
+
+	/// One io_service per thread. If no selector is supplied, channels are assigned to shards round-robin.
+	static ThreadPoolSettings Sharded(bool pinThreads = false, const ShardSelectorT& selector = ShardSelectorT())
+	{
+		ThreadPoolSettings settings;
+		settings.mode = ThreadPoolMode::SHARDED;
+		settings.pinThreads = pinThreads;
+		settings.selector = selector;
+		return settings;
+	}
+
+	/// How threads are mapped onto io_service instances
+	ThreadPoolMode mode;
+
+	/// If true, thread i is pinned to core (i % number of cores). Only supported on Linux and Windows.
+	bool pinThreads;
+
+	/// Optional channel to shard assignment, only used in SHARDED mode
+	ShardSelectorT selector;
+
+	/// If true, io_services run by exactly one thread (every shard, or a SHARED pool with one thread)
+	/// are marked so that executors created on them skip the strand
+	bool strandFree;
+};
+
+}
+
+#endif
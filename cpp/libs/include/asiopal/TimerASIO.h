@@ -28,6 +28,7 @@
 #include <openpal/executor/IExecutor.h>
 
 #include <asiopal/SteadyClock.h>
+#include <asiopal/HandlerArena.h>
 
 namespace asiopal
 {
@@ -51,7 +52,7 @@ class TimerASIO : public openpal::ITimer
 	friend class ASIOExecutor;
 
 public:
-	TimerASIO(asio::strand& strand);
+	TimerASIO(asio::io_service& service);
 
 	// Implement ITimer
 	void Cancel();
@@ -66,6 +67,9 @@ private:
 	bool canceled;
 
 	asio::basic_waitable_timer< asiopal::asiopal_steady_clock > timer;
+
+	// a timer has at most one outstanding wait
+	std::shared_ptr<HandlerArena> arena;
 };
 
 }
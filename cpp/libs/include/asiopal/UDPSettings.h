@@ -0,0 +1,61 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIOPAL_UDPSETTINGS_H
+#define ASIOPAL_UDPSETTINGS_H
+
+#include <cstdint>
+
+namespace asiopal
+{
+
+/**
+* Options of a datagram socket shared by UDP channels. The channel that first uses a local endpoint
+* decides them, later channels on the same endpoint share the existing socket.
+*/
+struct UDPSettings
+{
+	UDPSettings() :
+		maxBatch(32),
+		maxDatagramSize(2048),
+		maxQueuedDatagrams(16),
+		receiveBufferSize(0),
+		sendBufferSize(0)
+	{}
+
+	/// The most datagrams moved by one recvmmsg or sendmmsg call. 1 receives and sends them one at a time
+	uint32_t maxBatch;
+
+	/// Larger datagrams are truncated by the kernel and dropped
+	uint32_t maxDatagramSize;
+
+	/// Datagrams kept for a channel that isn't reading when they arrive, any more are dropped
+	uint32_t maxQueuedDatagrams;
+
+	/// SO_RCVBUF of the socket, 0 keeps the system default
+	uint32_t receiveBufferSize;
+
+	/// SO_SNDBUF of the socket, 0 keeps the system default
+	uint32_t sendBufferSize;
+};
+
+}
+
+#endif
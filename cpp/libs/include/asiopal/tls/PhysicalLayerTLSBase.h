@@ -24,7 +24,7 @@
 
 #include <asiopal/PhysicalLayerASIO.h>
 
-#include "asiopal/tls/TLSConfig.h"
+#include "asiopal/tls/TLSContext.h"
 
 #include <asio.hpp>
 #include <asio/ip/tcp.hpp>
@@ -43,8 +43,7 @@ public:
 	PhysicalLayerTLSBase(
 	    openpal::LogRoot& root,
 	    asio::io_service& service,
-	    const TLSConfig& config,
-	    asio::ssl::context_base::method method
+	    std::shared_ptr<TLSContext> context
 	);
 
 	virtual ~PhysicalLayerTLSBase() {}
@@ -60,8 +59,23 @@ protected:
 
 	bool LogPeerCertificateInfo(bool preverified, asio::ssl::verify_context& ctx);
 
-	asio::ssl::context ctx;
+	/// Start each connection with a fresh stream on the current context, so a cached session can be attached to it
+	void ResetStream();
 
+	/// Record whether the handshake resumed a session before completing the open
+	void OnHandshakeResult(const std::error_code& ec);
+
+	asio::io_service& service;
+
+	std::shared_ptr<TLSContext> context;
+
+	// the context the current stream was created from, which a reload may have replaced since
+	std::shared_ptr<asio::ssl::context> streamContext;
+
+	// shared by the channels of a manager, nullptr otherwise
+	TLSSessionCache* pSessionCache;
+
+	// created by ResetStream() when the layer opens, so idle channels hold no SSL object
 	std::unique_ptr<asio::ssl::stream<asio::ip::tcp::socket>> stream;
 
 	void ShutdownTLSStream();
@@ -23,8 +23,6 @@
 
 #include "asiopal/tls/PhysicalLayerTLSBase.h"
 
-#include "asiopal/tls/TLSConfig.h"
-
 #include "asiopal/LoggingConnectionCondition.h"
 
 #include <openpal/logging/LogMacros.h>
@@ -46,7 +44,7 @@ public:
 	    const std::string& host,
 	    const std::string& localAddress,
 	    uint16_t port,
-	    const TLSConfig& config
+	    std::shared_ptr<TLSContext> context
 	);
 
 	// ---- Implement the remaining actions ----
@@ -66,6 +64,7 @@ private:
 	asio::ip::tcp::endpoint remoteEndpoint;
 	asio::ip::tcp::endpoint localEndpoint;
 	asio::ip::tcp::resolver resolver;
+	const std::string sessionKey;
 	std::function<void (asio::ip::tcp::socket&)> configure;
 };
 
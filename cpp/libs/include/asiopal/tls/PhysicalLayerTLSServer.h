@@ -23,8 +23,6 @@
 
 #include "asiopal/tls/PhysicalLayerTLSBase.h"
 
-#include "asiopal/tls/TLSConfig.h"
-
 namespace asiopal
 {
 
@@ -39,7 +37,7 @@ public:
 	    asio::io_service& service,
 	    const std::string& endpoint,
 	    uint16_t port,
-	    const TLSConfig& config
+	    std::shared_ptr<TLSContext> context
 	);
 
 	// --- Implement the remainging actions ---
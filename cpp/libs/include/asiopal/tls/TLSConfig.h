@@ -23,6 +23,7 @@
 #define ASIOPAL_TLS_CONFIG_H
 
 #include <string>
+#include <cstdint>
 
 namespace asiopal
 {
@@ -67,6 +68,15 @@ public:
 	/// Allow TLS version 1.2 (default true)
 	bool allowTLSv12;
 
+	/// Resume sessions from the manager's session cache when reconnecting (default true)
+	bool allowSessionResumption;
+
+	/// Use session tickets for resumption, otherwise servers keep session IDs in the shared cache (default true)
+	bool useSessionTickets;
+
+	/// Lifetime of a resumable session in seconds (default 7200)
+	uint32_t sessionLifetimeSeconds;
+
 };
 
 }
@@ -0,0 +1,80 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+
+#ifndef ASIOPAL_TLS_CONTEXT_H
+#define ASIOPAL_TLS_CONTEXT_H
+
+#include "asiopal/tls/TLSConfig.h"
+#include "asiopal/tls/TLSSessionCache.h"
+
+#include <openpal/util/Uncopyable.h>
+
+#include <asio/ssl.hpp>
+
+#include <memory>
+#include <mutex>
+
+namespace asiopal
+{
+
+/**
+* An ssl::context built from a TLSConfig that any number of channels can share.
+*
+* Each connection takes the current context when it opens. Reload() builds a new one from the
+* files named in the configuration, so rotated certificates apply to the next connections while
+* the open ones keep the context they started with.
+*/
+class TLSContext : private openpal::Uncopyable
+{
+public:
+
+	/**
+	* @throw std::system_error if the certificates or private key can't be loaded
+	*/
+	TLSContext(const TLSConfig& config, bool server, TLSSessionCache* pSessionCache);
+
+	/// The context for the next connection
+	std::shared_ptr<asio::ssl::context> Get();
+
+	/**
+	* Reload the certificates and private key
+	*
+	* @throw std::system_error if they can't be loaded, in which case the current context is kept
+	*/
+	void Reload();
+
+	const TLSConfig config;
+	const bool server;
+
+	// sessions are shared with every other context of a manager, nullptr otherwise
+	TLSSessionCache* const pSessionCache;
+
+private:
+
+	std::shared_ptr<asio::ssl::context> Build() const;
+
+	std::mutex mutex;
+	std::shared_ptr<asio::ssl::context> current;
+};
+
+}
+
+#endif
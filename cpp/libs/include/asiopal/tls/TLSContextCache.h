@@ -0,0 +1,82 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+
+#ifndef ASIOPAL_TLS_CONTEXT_CACHE_H
+#define ASIOPAL_TLS_CONTEXT_CACHE_H
+
+#include "asiopal/tls/TLSContext.h"
+#include "asiopal/tls/TLSSessionCache.h"
+
+#include <openpal/util/Uncopyable.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace asiopal
+{
+
+/**
+* The TLS state shared by the channels of a DNP3Manager.
+*
+* Channels with identical configurations share one TLSContext, so the certificates and private key
+* are loaded and parsed once. A context lives as long as the last channel that uses it. All of the
+* contexts share one TLSSessionCache.
+*/
+class TLSContextCache : private openpal::Uncopyable
+{
+public:
+
+	/**
+	* Get the context for a configuration, building it if no channel uses it yet
+	*
+	* @throw std::system_error if the certificates or private key can't be loaded
+	*/
+	std::shared_ptr<TLSContext> Get(const TLSConfig& config, bool server);
+
+	/**
+	* Reload the certificates and private keys of every context in use, and forget the sessions
+	* negotiated with the old ones
+	*
+	* @return false if any of them failed to load, those contexts keep their current certificates
+	* but don't resume sessions until a later reload succeeds
+	*/
+	bool Reload();
+
+	/// The number of distinct contexts in use
+	uint32_t NumContexts();
+
+	TLSSessionStatistics GetSessionStatistics();
+
+private:
+
+	static std::string Key(const TLSConfig& config, bool server);
+
+	TLSSessionCache sessions;
+
+	std::mutex mutex;
+	std::map<std::string, std::weak_ptr<TLSContext>> contexts;
+};
+
+}
+
+#endif
@@ -28,6 +28,8 @@
 
 #include <asio/ssl.hpp>
 
+#include <string>
+
 namespace asiopal
 {
 
@@ -40,6 +42,9 @@ public:
 
 	/// Configure an ssl context using the settings in a TLSConfig struct
 	static void ApplyConfig(const TLSConfig&, asio::ssl::context& context);
+
+	/// Digest of the settings that decide whether a peer is trusted, sessions only resume between matching configurations
+	static std::string SessionContextId(const TLSConfig&);
 };
 
 }
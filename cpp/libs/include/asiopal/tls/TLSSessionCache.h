@@ -0,0 +1,148 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+
+#ifndef ASIOPAL_TLS_SESSION_CACHE_H
+#define ASIOPAL_TLS_SESSION_CACHE_H
+
+#include "asiopal/tls/TLSConfig.h"
+#include "asiopal/tls/TLSSessionStatistics.h"
+
+#include <openpal/util/Uncopyable.h>
+
+#include <asio/ssl.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace asiopal
+{
+
+/**
+* Process-wide TLS session store shared by the channels of a DNP3Manager.
+*
+* Clients keep the last session for each peer and offer it when ChannelRetry reconnects.
+* Servers share one set of ticket keys, and their session IDs when tickets are disabled,
+* so a peer can resume against any server channel that uses the same TLSConfig.
+*/
+class TLSSessionCache : private openpal::Uncopyable
+{
+public:
+
+	static const uint32_t DEFAULT_MAX_SESSIONS = 4096;
+
+	TLSSessionCache(uint32_t maxSessions = DEFAULT_MAX_SESSIONS);
+
+	~TLSSessionCache();
+
+	/// Store the sessions negotiated on a client context in this cache
+	void ConfigureClient(const TLSConfig& config, asio::ssl::context& context);
+
+	/// Share ticket keys and session IDs between all the server contexts of this cache
+	void ConfigureServer(const TLSConfig& config, asio::ssl::context& context);
+
+	/// Offer the session cached for this key, and cache the session the handshake produces under it
+	void PrepareClient(SSL* ssl, const std::string& key);
+
+	/// Forget the client session for this key, i.e. after a failed handshake
+	void Remove(const std::string& key);
+
+	/**
+	* Forget every session and replace the ticket keys, i.e. after the certificates have been reloaded.
+	*
+	* Contexts configured before this call no longer store or offer sessions, so nothing negotiated
+	* under the old certificates is resumed.
+	*/
+	void Invalidate();
+
+	void RecordHandshake(bool resumed);
+
+	TLSSessionStatistics GetStatistics();
+
+	/// A key that identifies both the remote peer and the configuration used to verify it
+	static std::string ClientKey(const TLSConfig& config, const std::string& host, uint16_t port);
+
+	/**
+	* Cache a session under a key, replacing any session already there. When the cache is full
+	* the least recently used session is evicted.
+	*
+	* Takes ownership of the caller's reference.
+	*/
+	void Store(const std::string& key, SSL_SESSION* session);
+
+	/**
+	* Look up the session for a key and mark it as recently used. Sessions that have expired or
+	* can no longer be resumed are dropped.
+	*
+	* @return a new reference that the caller must free, or nullptr
+	*/
+	SSL_SESSION* Find(const std::string& key);
+
+private:
+
+	struct Entry
+	{
+		SSL_SESSION* session;
+		std::list<std::string>::iterator position;
+	};
+
+	static int ContextIndex();
+	static int GenerationIndex();
+	static int KeyIndex();
+
+	static int OnNewClientSession(SSL* ssl, SSL_SESSION* session);
+	static int OnNewServerSession(SSL* ssl, SSL_SESSION* session);
+	static SSL_SESSION* OnGetServerSession(SSL* ssl, const unsigned char* id, int length, int* copy);
+	static void OnRemoveServerSession(SSL_CTX* ctx, SSL_SESSION* session);
+
+	static TLSSessionCache* GetCache(SSL_CTX* ctx);
+	static std::string ServerKey(const unsigned char* id, unsigned int length);
+
+	// as Store and Find, but only for contexts configured since the last Invalidate()
+	bool StoreFrom(SSL_CTX* ctx, const std::string& key, SSL_SESSION* session);
+	SSL_SESSION* FindFrom(SSL_CTX* ctx, const std::string& key);
+
+	// the caller holds the lock for all of these
+	void SetGeneration(SSL_CTX* ctx);
+	bool IsCurrent(SSL_CTX* ctx) const;
+	void Insert(const std::string& key, SSL_SESSION* session);
+	SSL_SESSION* Lookup(const std::string& key);
+	void Erase(std::map<std::string, Entry>::iterator entry);
+
+	const uint32_t maxSessions;
+
+	uintptr_t generation;
+	uint8_t ticketKeys[80];
+
+	std::atomic<uint64_t> numFullHandshakes;
+	std::atomic<uint64_t> numResumedHandshakes;
+
+	std::mutex mutex;
+	std::map<std::string, Entry> sessions;
+	std::list<std::string> order;
+};
+
+}
+
+#endif
@@ -42,6 +42,12 @@ public:
 	OctetString(const openpal::RSlice& buffer) : OctetData(buffer)
 	{}
 
+	OctetString& operator=(const OctetString& other)
+	{
+		OctetData::operator=(other);
+		return *this;
+	}
+
 };
 
 }
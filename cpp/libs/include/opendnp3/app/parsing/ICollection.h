@@ -77,6 +77,31 @@ public:
 	*/
 	virtual void Foreach(IVisitor<T>& visitor) const = 0;
 
+	/**
+	* Decode the first elements of the collection into a contiguous array.
+	*
+	* Implementations decode in a tight loop without a virtual call per element,
+	* so this is the fastest way to copy a large collection into application storage.
+	*
+	* @param values array with room for at least max elements
+	* @param max maximum number of elements to read
+	* @return the number of elements written, the lesser of max and Count()
+	*/
+	virtual uint32_t ReadInto(T* values, uint32_t max) const
+	{
+		uint32_t num = 0;
+		auto copy = [values, max, &num](const T & item)
+		{
+			if (num < max)
+			{
+				values[num] = item;
+				++num;
+			}
+		};
+		this->ForeachItem(copy);
+		return num;
+	}
+
 	/**
 		visit all of the elements of a collection
 	*/
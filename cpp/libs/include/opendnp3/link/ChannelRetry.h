@@ -23,6 +23,8 @@
 
 #include <openpal/executor/TimeDuration.h>
 
+#include <cstdint>
+
 #include <opendnp3/link/IOpenDelayStrategy.h>
 
 
@@ -56,6 +58,8 @@ public:
 	openpal::TimeDuration maxOpenRetry;
 	//// Strategy to use (default to exponential backoff)
 	IOpenDelayStrategy& strategy;
+	/// when the manager limits connection attempts, channels with a higher priority are admitted first (default 0)
+	uint8_t priority;
 
 };
 
@@ -22,13 +22,14 @@
 #define OPENDNP3_COMMAND_SET_H
 
 #include "opendnp3/master/ICommandCollection.h"
+#include "opendnp3/master/InlineVector.h"
 
 #include "opendnp3/app/ControlRelayOutputBlock.h"
 #include "opendnp3/app/AnalogOutput.h"
 #include "opendnp3/app/Indexed.h"
 
-#include <vector>
 #include <initializer_list>
+#include <type_traits>
 
 namespace opendnp3
 {
@@ -37,6 +38,10 @@ class ICommandHeader;
 
 /**
 * Provides a mechanism for building a set of one or more command headers
+*
+* The first INLINE_HEADERS headers share a single block that the set allocates when the first header
+* is started. Headers never move, so the references returned by StartHeader remain valid after the
+* set itself is moved.
 */
 class CommandSet final
 {
@@ -45,10 +50,17 @@ class CommandSet final
 
 public:
 
-	typedef std::vector<ICommandHeader*> HeaderVector;
+	/// Number of headers stored in the shared block before each is allocated on its own
+	static const uint32_t INLINE_HEADERS = 4;
+
+	/// Size in bytes of the storage reserved for each header in the block
+	static const uint32_t HEADER_SLOT_SIZE = 192;
+
+	typedef InlineVector<ICommandHeader*, INLINE_HEADERS> HeaderVector;
 
 	/// Contrsuct an empty command set
-	CommandSet() {}
+	CommandSet() : m_block(nullptr)
+	{}
 
 	/// Construct a new command set and take ownership of the headers in argument
 	CommandSet(CommandSet&& other);
@@ -92,6 +104,16 @@ private:
 	template <class T>
 	void AddAny(std::initializer_list<Indexed<T>> items);
 
+	/// Storage for the next header, or nullptr if it must be heap allocated
+	void* NextSlot();
+
+	typedef std::aligned_storage<HEADER_SLOT_SIZE>::type HeaderSlot;
+
+	struct HeaderBlock
+	{
+		HeaderSlot slots[INLINE_HEADERS];
+	};
+
 	ICommandCollection<ControlRelayOutputBlock>& StartHeaderCROB();
 	ICommandCollection<AnalogOutputInt32>& StartHeaderAOInt32();
 	ICommandCollection<AnalogOutputInt16>& StartHeaderAOInt16();
@@ -102,6 +124,7 @@ private:
 	CommandSet& operator= (const CommandSet& other) = delete;
 
 	HeaderVector m_headers;
+	HeaderBlock* m_block;
 };
 
 template <>
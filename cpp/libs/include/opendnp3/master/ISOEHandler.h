@@ -45,6 +45,9 @@ namespace opendnp3
 * A call is made to the appropriate member method for every measurement value in an ASDU.
 * The HeaderInfo class provides information about the object header associated with the value.
 *
+* Handlers that copy values into their own storage should prefer ICollection::ReadInto, which
+* decodes the whole collection into a contiguous array without a virtual call per value.
+*
 */
 class ISOEHandler : public ITransactable
 {
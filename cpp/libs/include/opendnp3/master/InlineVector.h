@@ -0,0 +1,202 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef OPENDNP3_INLINEVECTOR_H
+#define OPENDNP3_INLINEVECTOR_H
+
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace opendnp3
+{
+
+/**
+* A contiguous, growable sequence that keeps its first N elements inside the object
+* and only moves to the heap when more are added. Move-only.
+*/
+template <class T, uint32_t N>
+class InlineVector final
+{
+	static_assert(N > 0, "inline capacity must be at least 1");
+
+public:
+
+	InlineVector() : elements(InlineElements()), count(0), capacity(N)
+	{}
+
+	InlineVector(InlineVector&& other) : elements(InlineElements()), count(0), capacity(N)
+	{
+		if (other.IsInline())
+		{
+			for (uint32_t i = 0; i < other.count; ++i)
+			{
+				new (&elements[i]) T(std::move(other.elements[i]));
+			}
+			count = other.count;
+			other.Clear();
+		}
+		else
+		{
+			// steal the heap storage
+			elements = other.elements;
+			count = other.count;
+			capacity = other.capacity;
+			other.elements = other.InlineElements();
+			other.count = 0;
+			other.capacity = N;
+		}
+	}
+
+	~InlineVector()
+	{
+		this->Clear();
+		this->Release();
+	}
+
+	void push_back(T&& value)
+	{
+		this->Reserve(count + 1);
+		new (&elements[count]) T(std::move(value));
+		++count;
+	}
+
+	void push_back(const T& value)
+	{
+		this->Reserve(count + 1);
+		new (&elements[count]) T(value);
+		++count;
+	}
+
+	/// Destroy every element, keeping any heap storage for reuse
+	void Clear()
+	{
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			elements[i].~T();
+		}
+		count = 0;
+	}
+
+	uint32_t size() const
+	{
+		return count;
+	}
+
+	bool empty() const
+	{
+		return count == 0;
+	}
+
+	/// True while the elements are stored inside the object
+	bool IsInline() const
+	{
+		return capacity == N;
+	}
+
+	T& operator[](uint32_t i)
+	{
+		return elements[i];
+	}
+
+	const T& operator[](uint32_t i) const
+	{
+		return elements[i];
+	}
+
+	T& back()
+	{
+		return elements[count - 1];
+	}
+
+	T* begin()
+	{
+		return elements;
+	}
+
+	T* end()
+	{
+		return elements + count;
+	}
+
+	const T* begin() const
+	{
+		return elements;
+	}
+
+	const T* end() const
+	{
+		return elements + count;
+	}
+
+private:
+
+	typedef typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type Storage;
+
+	T* InlineElements()
+	{
+		return reinterpret_cast<T*>(storage);
+	}
+
+	void Reserve(uint32_t required)
+	{
+		if (required <= capacity)
+		{
+			return;
+		}
+
+		auto newCapacity = 2 * capacity;
+		auto newElements = reinterpret_cast<T*>(new Storage[newCapacity]);
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			new (&newElements[i]) T(std::move(elements[i]));
+			elements[i].~T();
+		}
+
+		this->Release();
+		elements = newElements;
+		capacity = newCapacity;
+	}
+
+	void Release()
+	{
+		if (!IsInline())
+		{
+			delete[] reinterpret_cast<Storage*>(elements);
+			elements = InlineElements();
+			capacity = N;
+		}
+	}
+
+	InlineVector(const InlineVector&) = delete;
+	InlineVector& operator=(const InlineVector&) = delete;
+	InlineVector& operator=(InlineVector&&) = delete;
+
+	Storage storage[N];
+	T* elements;
+	uint32_t count;
+	uint32_t capacity;
+};
+
+}
+
+#endif
@@ -65,11 +65,27 @@ struct MasterParams
 	/// Time delay before failing a non-recurring task (e.g. commands) that cannot start
 	openpal::TimeDuration taskStartTimeout;
 
-	/// maximum APDU tx size in bytes
+	/// maximum APDU tx size in bytes, up to 65536. Space above the default size is leased from a shared pool only
+	/// while a request is being sent.
 	uint32_t maxTxFragSize;
 
-	/// maximum APDU rx size in bytes
+	/// maximum APDU rx size in bytes, up to 65536. Space above the default size is leased from a shared pool only
+	/// while a large fragment is being received.
 	uint32_t maxRxFragSize;
+
+	/// If true, default sized fragment buffers are leased from the shared pool as well, and only while a request is
+	/// being sent or a response received, so an idle master holds no fragment storage. Suited to head-ends with
+	/// thousands of sessions. Defaults to false.
+	bool poolAllFragmentBuffers;
+
+	/// If true, a DirectOperate call made while the last queued one-shot task is a DirectOperate that is waiting
+	/// to start is sent in the same request, up to maxTxFragSize and maxControlsPerRequest. Commands still reach
+	/// the outstation in the order they were issued. Each caller's callback still receives only its own results.
+	/// Calls with a TaskConfig callback or id are never coalesced.
+	bool coalesceDirectOperate;
+
+	/// The most command objects the outstation accepts in a single request, limits coalesced DirectOperate requests
+	uint8_t maxControlsPerRequest;
 };
 
 }
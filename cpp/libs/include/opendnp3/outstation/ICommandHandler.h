@@ -25,6 +25,7 @@
 #include "opendnp3/app/AnalogOutput.h"
 #include "opendnp3/app/ITransactable.h"
 #include "opendnp3/gen/OperateType.h"
+#include "opendnp3/outstation/OperateToken.h"
 
 namespace opendnp3
 {
@@ -33,6 +34,10 @@ namespace opendnp3
 * Interface used to dispatch SELECT / OPERATE / DIRECT OPERATE (Binary/Analog output) from the outstation to application code.
 *
 * The ITransactable sub-interface is used to determine the start and end of an ASDU containing commands.
+*
+* Handlers that return true from IsAsync() receive OPERATE and DIRECT_OPERATE commands through the
+* BeginOperate methods instead of Operate. The outstation keeps servicing its other work while the
+* commands are in progress, and responds once each command's OperateToken has been completed.
 */
 class ICommandHandler : public ITransactable
 {
@@ -136,6 +141,53 @@ public:
 	*/
 	virtual CommandStatus Operate(const AnalogOutputDouble64& command, uint16_t index, OperateType opType) = 0;
 
+	/**
+	* Ask if operates should be dispatched through BeginOperate. SELECT is always synchronous.
+	*
+	* @return true to receive operates asynchronously, defaults to false
+	*/
+	virtual bool IsAsync()
+	{
+		return false;
+	}
+
+	/**
+	* Begin operating a ControlRelayOutputBlock - group 12 variation 1. Only called when IsAsync() returns true.
+	*
+	* @param command command to operate
+	* @param index index of the command
+	* @param opType the operation type the outstation received.
+	* @param token completed from any thread with the result of the command
+	*/
+	virtual void BeginOperate(const ControlRelayOutputBlock& command, uint16_t index, OperateType opType, const OperateToken& token)
+	{
+		token.Complete(this->Operate(command, index, opType));
+	}
+
+	/// Begin operating a 16 bit analog output - group 41 variation 2. Only called when IsAsync() returns true.
+	virtual void BeginOperate(const AnalogOutputInt16& command, uint16_t index, OperateType opType, const OperateToken& token)
+	{
+		token.Complete(this->Operate(command, index, opType));
+	}
+
+	/// Begin operating a 32 bit analog output - group 41 variation 1. Only called when IsAsync() returns true.
+	virtual void BeginOperate(const AnalogOutputInt32& command, uint16_t index, OperateType opType, const OperateToken& token)
+	{
+		token.Complete(this->Operate(command, index, opType));
+	}
+
+	/// Begin operating a single precision, floating point analog output - group 41 variation 3. Only called when IsAsync() returns true.
+	virtual void BeginOperate(const AnalogOutputFloat32& command, uint16_t index, OperateType opType, const OperateToken& token)
+	{
+		token.Complete(this->Operate(command, index, opType));
+	}
+
+	/// Begin operating a double precision, floating point analog output - group 41 variation 4. Only called when IsAsync() returns true.
+	virtual void BeginOperate(const AnalogOutputDouble64& command, uint16_t index, OperateType opType, const OperateToken& token)
+	{
+		token.Complete(this->Operate(command, index, opType));
+	}
+
 };
 
 }
@@ -0,0 +1,62 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef OPENDNP3_OPERATETOKEN_H
+#define OPENDNP3_OPERATETOKEN_H
+
+#include "opendnp3/gen/CommandStatus.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace opendnp3
+{
+
+class PendingOperate;
+
+/**
+* Handle to a single command that an asynchronous ICommandHandler has accepted but not yet completed.
+*
+* Tokens are cheap to copy and may be completed from any thread. The outstation responds once every
+* command in the request has been completed or the asyncOperateTimeout expires.
+*/
+class OperateToken
+{
+public:
+
+	OperateToken(const std::shared_ptr<PendingOperate>& operation, uint32_t ordinal);
+
+	/**
+	* Report the result of the command. Only the first call for a token has any effect, and calls made
+	* after the request has timed out or the outstation has gone offline are ignored.
+	*
+	* @param status the status to echo back to the master for this command
+	*/
+	void Complete(CommandStatus status) const;
+
+private:
+
+	std::shared_ptr<PendingOperate> operation;
+	uint32_t ordinal;
+};
+
+}
+
+#endif
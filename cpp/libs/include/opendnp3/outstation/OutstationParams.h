@@ -48,6 +48,10 @@ struct OutstationParams
 	/// How long the outstation will allow an operate to proceed after a prior select
 	openpal::TimeDuration selectTimeout;
 
+	/// How long the outstation waits for an asynchronous command handler to complete an operate.
+	/// Commands still outstanding are then reported with CommandStatus::TIMEOUT. Keep this below the master's response timeout.
+	openpal::TimeDuration asyncOperateTimeout;
+
 	/// Timeout for solicited confirms
 	openpal::TimeDuration solConfirmTimeout;
 
@@ -57,18 +61,36 @@ struct OutstationParams
 	/// Timeout for unsolicited retries
 	openpal::TimeDuration unsolRetryTimeout;
 
-	/// The maximum fragment size the outstation will use for fragments it sends
+	/// The maximum fragment size the outstation will use for fragments it sends. Sizes up to 65536 are supported.
+	/// Responses are built in a buffer of the default size and only move to a shared pool of larger buffers when they
+	/// don't fit, so a large setting costs no memory until a large response is actually sent.
 	uint32_t maxTxFragSize;
 
-	/// The maximum fragment size the outstation will be able to receive
+	/// The maximum fragment size the outstation will be able to receive. Like maxTxFragSize, space above the default
+	/// size is leased from the shared pool only while a large fragment is being received or deferred.
 	uint32_t maxRxFragSize;
 
+	/// If true, default sized fragment buffers are leased from the shared pool as well, and only while a fragment is
+	/// being built, received or deferred, so an idle outstation holds no fragment storage. Suited to processes hosting
+	/// thousands of sessions that are mostly idle. Defaults to false.
+	bool poolAllFragmentBuffers;
+
 	/// Global enabled / disable for unsolicted messages. If false, the NULL unsolicited message is not even sent
 	bool allowUnsolicited;
 
 	/// Global enable / disable for responding repeat read requests. If true, repeat reads are ignored
 	bool ignoreRepeatReads;
 
+	/// If true, relative time events (g2v3, g4v3) are grouped into CTO windows. Each header takes events in order
+	/// until the next would stretch it past 65535 ms or overflow the fragment, with the earliest time as its CTO, and events of other types may be written after
+	/// the header instead of splitting it. Order within each event type is preserved. Defaults to false.
+	bool packRelativeTimeEvents;
+
+	/// If true, each static header uses either a start/stop range (0x00/0x01) or a count and index prefix (0x17/0x28),
+	/// whichever encodes the selected values in fewer bytes. Sparse or partially selected ranges in discontiguous
+	/// databases then need fewer headers. Defaults to false. Only enable it when the masters accept prefixed static objects.
+	bool planStaticQualifiers;
+
 	/// A bitmask type that specifies the types allowed in a class 0 reponse
 	StaticTypeBitField typesAllowedInClass0;
 
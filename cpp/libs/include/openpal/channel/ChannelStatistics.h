@@ -48,7 +48,7 @@ namespace openpal
 {
 struct ChannelStatistics
 {
-	ChannelStatistics() : numOpen(0), numOpenFail(0), numClose(0), numBytesRx(0), numBytesTx(0)
+	ChannelStatistics() : numOpen(0), numOpenFail(0), numClose(0), numBytesRx(0), numBytesTx(0), numWrites(0), numReads(0), numInterCharWakeups(0), numFullHandshakes(0), numResumedHandshakes(0)
 	{}
 
 	/// The number of times the channel has successfully opened
@@ -65,6 +65,21 @@ struct ChannelStatistics
 
 	/// The number of bytes transmitted
 	uint32_t numBytesTx;
+
+	/// The number of write operations, each of which may carry several link frames
+	uint32_t numWrites;
+
+	/// The number of reads that delivered bytes to the link layer
+	uint32_t numReads;
+
+	/// The number of times a batched read woke up to collect more bytes (serial channels only)
+	uint32_t numInterCharWakeups;
+
+	/// The number of full TLS handshakes (TLS channels only)
+	uint32_t numFullHandshakes;
+
+	/// The number of TLS handshakes that resumed a cached session (TLS channels only)
+	uint32_t numResumedHandshakes;
 };
 }
 
@@ -115,6 +115,24 @@ public:
 	 */
 	virtual void BeginWrite(const RSlice& arBuffer) = 0;
 
+	/**
+	 * Starts a single send operation for several buffers that are
+	 * written back to back, as if they were one contiguous buffer.
+	 *
+	 * Callback is a single IHandler::OnSendSuccess for the whole batch
+	 * or a failure will result in the layer closing.
+	 *
+	 * @param buffers		Array of at most MAX_WRITE_BATCH buffers. The array
+	 *						itself is only read during the call, but the
+	 *						underlying buffers must remain available until the
+	 *						write callback or close occurs.
+	 * @param count			Number of buffers in the array
+	 */
+	virtual void BeginWriteBatch(const RSlice* buffers, uint32_t count) = 0;
+
+	/// The most buffers that may be passed to BeginWriteBatch
+	static const uint32_t MAX_WRITE_BATCH = 8;
+
 	/**
 	 * Starts a read operation.
 	 *
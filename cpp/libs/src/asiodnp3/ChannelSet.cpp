@@ -21,6 +21,7 @@
 #include "ChannelSet.h"
 
 #include "DNP3Channel.h"
+#include "DNP3Listener.h"
 
 #include <asiopal/PhysicalLayerBase.h>
 
@@ -38,6 +39,14 @@ ChannelSet::~ChannelSet()
 
 void ChannelSet::Shutdown()
 {
+	std::vector<DNP3Listener*> listenerscopy;
+
+	for (auto pListener : listeners) listenerscopy.push_back(pListener);
+
+	for (auto pListener : listenerscopy) pListener->Shutdown();
+
+	assert(listeners.empty());
+
 	std::vector<DNP3Channel*> channelscopy;
 
 	for (auto pChannel : channels) channelscopy.push_back(pChannel);
@@ -51,9 +60,10 @@ IChannel* ChannelSet::CreateChannel(
     openpal::LogRoot* pLogRoot,
     asiopal::ASIOExecutor& executor,
     const ChannelRetry& retry,
-    PhysicalLayerBase* apPhys)
+    PhysicalLayerBase* apPhys,
+    OpenAdmissionScheduler* pAdmission)
 {
-	auto pChannel = new DNP3Channel(pLogRoot, executor, retry, apPhys);
+	auto pChannel = new DNP3Channel(pLogRoot, executor, retry, apPhys, pAdmission);
 	auto onShutdown = [this, pChannel]()
 	{
 		this->OnShutdown(pChannel);
@@ -63,12 +73,30 @@ IChannel* ChannelSet::CreateChannel(
 	return pChannel;
 }
 
+IListener* ChannelSet::AddListener(DNP3Listener* pListener)
+{
+	auto onShutdown = [this, pListener]()
+	{
+		this->OnShutdown(pListener);
+	};
+	pListener->SetShutdownHandler(Action0::Bind(onShutdown));
+	listeners.insert(pListener);
+	pListener->Start();
+	return pListener;
+}
+
 void ChannelSet::OnShutdown(DNP3Channel* pChannel)
 {
 	channels.erase(pChannel);
 	delete pChannel;
 }
 
+void ChannelSet::OnShutdown(DNP3Listener* pListener)
+{
+	listeners.erase(pListener);
+	delete pListener;
+}
+
 
 
 }
@@ -42,6 +42,9 @@ namespace asiodnp3
 
 class IChannel;
 class DNP3Channel;
+class IListener;
+class DNP3Listener;
+class OpenAdmissionScheduler;
 
 class ChannelSet
 {
@@ -53,16 +56,22 @@ public:
 	IChannel* CreateChannel(    openpal::LogRoot* pRoot,
 	                            asiopal::ASIOExecutor& executor,
 	                            const opendnp3::ChannelRetry& retry,
-	                            asiopal::PhysicalLayerBase* pPhys);
+	                            asiopal::PhysicalLayerBase* pPhys,
+	                            OpenAdmissionScheduler* pAdmission = nullptr);
 
-	/// Synchronously shutdown all channels. Block until complete.
+	/// Take ownership of a bound listener and start accepting connections
+	IListener* AddListener(DNP3Listener* pListener);
+
+	/// Synchronously shutdown all listeners and channels. Block until complete.
 	void Shutdown();
 
 private:
 
 	std::set<DNP3Channel*> channels;
+	std::set<DNP3Listener*> listeners;
 
 	void OnShutdown(DNP3Channel* pChannel);
+	void OnShutdown(DNP3Listener* pListener);
 };
 
 }
@@ -38,7 +38,8 @@ DNP3Channel::DNP3Channel(
     LogRoot* pLogRoot_,
     asiopal::ASIOExecutor& executor,
     const ChannelRetry& retry,
-    openpal::IPhysicalLayer* pPhys_) :
+    openpal::IPhysicalLayer* pPhys_,
+    OpenAdmissionScheduler* pAdmission) :
 
 	pPhys(pPhys_),
 	pLogRoot(pLogRoot_),
@@ -46,7 +47,8 @@ DNP3Channel::DNP3Channel(
 	logger(pLogRoot->GetLogger()),
 	pShutdownHandler(nullptr),
 	channelState(ChannelState::CLOSED),
-	router(*pLogRoot, executor, pPhys.get(), retry, this, &statistics),
+	keepAlives(executor, LinkKeepAliveScheduler::DEFAULT_RESOLUTION),
+	router(*pLogRoot, executor, pPhys.get(), retry, this, &statistics, pAdmission),
 	stacks(router, executor)
 {
 	pPhys->SetChannelStatistics(&statistics);
@@ -190,7 +192,7 @@ T* DNP3Channel::AddStack(const opendnp3::LinkConfig& link, const std::function<T
 	{
 		auto pStack = factory();
 		stacks.Add(pStack);
-		pStack->SetLinkRouter(router);
+		pStack->SetLinkRouter(router, keepAlives);
 		router.AddContext(&pStack->GetLinkContext(), route);
 		return pStack;
 	}
@@ -26,6 +26,7 @@
 #include <opendnp3/outstation/OutstationStackConfig.h>
 #include <opendnp3/link/LinkChannelStatistics.h>
 #include <opendnp3/link/ChannelRetry.h>
+#include <opendnp3/link/LinkKeepAliveScheduler.h>
 
 #include <asiopal/ASIOExecutor.h>
 #include <asiopal/Synchronized.h>
@@ -63,7 +64,8 @@ public:
 	    openpal::LogRoot* pLogRoot_,
 	    asiopal::ASIOExecutor& executor,
 	    const opendnp3::ChannelRetry& retry,
-	    openpal::IPhysicalLayer* pPhys
+	    openpal::IPhysicalLayer* pPhys,
+	    OpenAdmissionScheduler* pAdmission = nullptr
 	);
 
 	// ----------------------- Implement IChannel -----------------------
@@ -120,6 +122,9 @@ private:
 	opendnp3::ChannelState channelState;
 	std::vector<std::function<void(opendnp3::ChannelState)>> callbacks;
 
+	// one timer for the keep-alives of every session, outlives the stacks
+	opendnp3::LinkKeepAliveScheduler keepAlives;
+
 	LinkLayerRouter router;
 	StackLifecycle stacks;
 
@@ -0,0 +1,476 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include "DNP3Listener.h"
+
+#include <openpal/logging/LogMacros.h>
+
+#include <opendnp3/LogLevels.h>
+#include <opendnp3/master/ITaskLock.h>
+
+#include "MasterStack.h"
+#include "OutstationStack.h"
+#include "ListenerConnection.h"
+
+#include <vector>
+
+using namespace openpal;
+using namespace opendnp3;
+
+namespace asiodnp3
+{
+
+const TimeDuration DNP3Listener::ACCEPT_RETRY_DELAY = TimeDuration::Seconds(1);
+
+DNP3Listener::DNP3Listener(
+    std::unique_ptr<openpal::LogRoot> root,
+    const std::string& id_,
+    asio::io_service& service,
+    const openpal::TimeDuration& routeTimeout_,
+    asiopal::IOUring* pRing_) :
+
+	pLogRoot(std::move(root)),
+	id(id_),
+	logger(pLogRoot->GetLogger()),
+	executor(service),
+	routeTimeout(routeTimeout_),
+	pRing(pRing_),
+	keepAlives(executor, LinkKeepAliveScheduler::DEFAULT_RESOLUTION),
+	acceptor(service),
+	acceptRetryTimer(executor),
+	isAccepting(false),
+	isShutdown(false),
+	nextConnectionId(0),
+	pShutdownSignal(nullptr)
+{
+
+}
+
+DNP3Listener::~DNP3Listener()
+{
+
+}
+
+bool DNP3Listener::Bind(const std::string& endpoint, uint16_t port)
+{
+	std::error_code ec;
+	auto address = asio::ip::address::from_string(endpoint, ec);
+	asio::ip::tcp::endpoint localEndpoint(address, port);
+
+	if (!ec) acceptor.open(localEndpoint.protocol(), ec);
+	if (!ec) acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true), ec);
+	if (!ec) acceptor.bind(localEndpoint, ec);
+	if (!ec) acceptor.listen(asio::socket_base::max_connections, ec);
+
+	if (ec)
+	{
+		FORMAT_LOG_BLOCK(logger, flags::ERR, "Unable to listen on %s:%u - %s", endpoint.c_str(), port, ec.message().c_str());
+		std::error_code ignored;
+		acceptor.close(ignored);
+		return false;
+	}
+
+	return true;
+}
+
+void DNP3Listener::Start()
+{
+	auto start = [this]()
+	{
+		this->BeginAccept();
+	};
+	executor.strand.post(start);
+}
+
+ListenerStatistics DNP3Listener::GetStatistics()
+{
+	auto get = [this]()
+	{
+		auto stats = statistics;
+		stats.numActive = static_cast<uint32_t>(connections.size());
+		return stats;
+	};
+	return executor.ReturnBlockFor<ListenerStatistics>(get);
+}
+
+void DNP3Listener::Shutdown()
+{
+	this->ShutdownAllStacks();
+
+	// close the acceptor and all of the connections
+	asiopal::Synchronized<bool> blocking;
+	auto initiate = [this, &blocking]()
+	{
+		this->InitiateShutdown(blocking);
+	};
+	executor.strand.post(initiate);
+	blocking.WaitForValue();
+
+	// With the connections gone, wait for any remaining timers
+	executor.WaitForShutdown();
+
+	shutdownHandler.Apply();
+}
+
+openpal::LogFilters DNP3Listener::GetLogFilters() const
+{
+	auto get = [this]()
+	{
+		return pLogRoot->GetFilters();
+	};
+	return executor.ReturnBlockFor<LogFilters>(get);
+}
+
+void DNP3Listener::SetLogFilters(const openpal::LogFilters& filters)
+{
+	auto set = [this, filters]()
+	{
+		this->pLogRoot->SetFilters(filters);
+	};
+	executor.BlockFor(set);
+}
+
+void DNP3Listener::SetRouteTakeoverHandler(const RouteTakeoverHandlerT& handler)
+{
+	auto set = [this, handler]()
+	{
+		this->takeoverHandler = handler;
+	};
+	executor.BlockFor(set);
+}
+
+IMaster* DNP3Listener::AddMaster(char const* id, ISOEHandler& SOEHandler, IMasterApplication& application, const MasterStackConfig& config)
+{
+	auto add = [&]() -> IMaster*
+	{
+		auto factory = [&]() -> MasterStack*
+		{
+			auto root = std::unique_ptr<openpal::LogRoot>(new openpal::LogRoot(*pLogRoot, id));
+			// each master owns its connection, so there is no multi-drop arbitration
+			return new MasterStack(std::move(root), executor, SOEHandler, application, config, *this, NullTaskLock::Instance());
+		};
+
+		return this->AddStack<MasterStack>(config.link, factory);
+	};
+
+	return executor.ReturnBlockFor<IMaster*>(add);
+}
+
+IOutstation* DNP3Listener::AddOutstation(char const* id, ICommandHandler& commandHandler, IOutstationApplication& application, const OutstationStackConfig& config)
+{
+	auto add = [&]() -> IOutstation*
+	{
+		auto factory = [&]() -> OutstationStack*
+		{
+			auto root = std::unique_ptr<openpal::LogRoot>(new openpal::LogRoot(*pLogRoot, id));
+			return new OutstationStack(std::move(root), executor, commandHandler, application, config, *this);
+		};
+
+		return this->AddStack<OutstationStack>(config.link, factory);
+	};
+
+	return executor.ReturnBlockFor<IOutstation*>(add);
+}
+
+void DNP3Listener::SetShutdownHandler(const openpal::Action0& action)
+{
+	shutdownHandler = action;
+}
+
+template <class T>
+T* DNP3Listener::AddStack(const opendnp3::LinkConfig& link, const std::function<T* ()>& factory)
+{
+	Route route(link.RemoteAddr, link.LocalAddr);
+
+	if (isShutdown)
+	{
+		SIMPLE_LOG_BLOCK(logger, flags::ERR, "Listener is shutdown");
+		return nullptr;
+	}
+
+	if (routes.count(Key(route)))
+	{
+		FORMAT_LOG_BLOCK(logger, flags::ERR, "Route already in use: %i -> %i", route.source, route.destination);
+		return nullptr;
+	}
+
+	auto pStack = factory();
+	pStack->SetLinkRouter(*this, keepAlives);
+	auto pSession = &pStack->GetLinkContext();
+	registrations.insert(std::make_pair(pSession, Registration(pStack, route)));
+	routes[Key(route)] = pSession;
+	return pStack;
+}
+
+void DNP3Listener::ShutdownAllStacks()
+{
+	auto get = [this]()
+	{
+		std::vector<IStack*> stacks;
+		for (auto& reg : registrations) stacks.push_back(reg.second.pStack);
+		return stacks;
+	};
+
+	for (auto pStack : executor.ReturnBlockFor<std::vector<IStack*>>(get))
+	{
+		pStack->Shutdown();
+	}
+}
+
+bool DNP3Listener::EnableRoute(opendnp3::ILinkSession* pContext)
+{
+	auto enable = [this, pContext]()
+	{
+		auto iter = registrations.find(pContext);
+		if (iter == registrations.end())
+		{
+			return false;
+		}
+
+		// the stack comes online when a connection presents its route
+		iter->second.enabled = true;
+		return true;
+	};
+	return executor.ReturnBlockFor<bool>(enable);
+}
+
+bool DNP3Listener::DisableRoute(opendnp3::ILinkSession* pContext)
+{
+	auto disable = [this, pContext]()
+	{
+		auto iter = registrations.find(pContext);
+		if (iter == registrations.end())
+		{
+			return false;
+		}
+
+		auto& reg = iter->second;
+		reg.enabled = false;
+		if (reg.pConnection)
+		{
+			reg.pConnection->Unbind(*pContext);
+			reg.pConnection = nullptr;
+		}
+		return true;
+	};
+	return executor.ReturnBlockFor<bool>(disable);
+}
+
+void DNP3Listener::Shutdown(opendnp3::ILinkSession* pContext, IStack* pStack)
+{
+	// synchronously remove the stack from the running strand
+	auto action = [this, pContext]()
+	{
+		auto iter = registrations.find(pContext);
+		if (iter != registrations.end())
+		{
+			if (iter->second.pConnection)
+			{
+				iter->second.pConnection->Unbind(*pContext);
+			}
+			routes.erase(Key(iter->second.route));
+			registrations.erase(iter);
+		}
+	};
+	executor.BlockFor(action);
+
+	// post the deletion of the stack to the strand
+	auto deleteStack = [pStack]()
+	{
+		delete pStack;
+	};
+	executor.strand.post(deleteStack);
+}
+
+void DNP3Listener::BeginTransmit(const openpal::RSlice& buffer, opendnp3::ILinkSession* pContext)
+{
+	auto iter = registrations.find(pContext);
+	if (iter != registrations.end() && iter->second.pConnection)
+	{
+		iter->second.pConnection->BeginTransmit(buffer, pContext);
+	}
+	else
+	{
+		SIMPLE_LOG_BLOCK(logger, flags::ERR, "Listener received transmit request for a session with no connection");
+	}
+}
+
+bool DNP3Listener::Resolve(ListenerConnection& connection, const opendnp3::Route& route)
+{
+	auto iter = routes.find(Key(route));
+	if (iter == routes.end())
+	{
+		++statistics.numUnrouted;
+		return false;
+	}
+
+	auto pSession = iter->second;
+	auto& reg = registrations.at(pSession);
+
+	if (!reg.enabled || reg.pConnection == &connection)
+	{
+		++statistics.numUnrouted;
+		return false;
+	}
+
+	if (reg.pConnection)
+	{
+		// anyone who knows the link addresses could otherwise take the session from a live connection
+		const bool ALLOWED = takeoverHandler && takeoverHandler(reg.pConnection->RemoteAddress(), connection.RemoteAddress());
+		if (!ALLOWED)
+		{
+			FORMAT_LOG_BLOCK(logger, flags::WARN, "Route %i -> %i is bound to an open connection from %s, refusing %s",
+			                 route.source, route.destination, reg.pConnection->RemoteAddress().c_str(), connection.RemoteAddress().c_str());
+			++statistics.numRefused;
+			return false;
+		}
+
+		// the remote reconnected before the old connection was detected as closed
+		FORMAT_LOG_BLOCK(logger, flags::INFO, "Route %i -> %i moved to a newer connection", route.source, route.destination);
+		++statistics.numReplaced;
+		reg.pConnection->Unbind(*pSession);
+		reg.pConnection = nullptr;
+	}
+
+	if (!connection.Bind(*pSession, route))
+	{
+		return false;
+	}
+
+	reg.pConnection = &connection;
+	++statistics.numRouted;
+	return true;
+}
+
+void DNP3Listener::OnRouteTimeout(ListenerConnection& connection)
+{
+	SIMPLE_LOG_BLOCK(logger, flags::WARN, "Closing connection that did not present a registered route");
+	++statistics.numTimedOut;
+	this->CloseConnection(connection);
+}
+
+void DNP3Listener::CloseConnection(ListenerConnection& connection)
+{
+	auto sessions = connection.Sessions();
+	for (auto pSession : sessions)
+	{
+		auto iter = registrations.find(pSession);
+		if (iter != registrations.end())
+		{
+			iter->second.pConnection = nullptr;
+		}
+		connection.Unbind(*pSession);
+	}
+
+	connection.Shutdown();
+}
+
+void DNP3Listener::OnConnectionShutdown(ListenerConnection* pConnection)
+{
+	// defer the deletion until the router has unwound
+	auto destroy = [this, pConnection]()
+	{
+		connections.erase(pConnection);
+		delete pConnection;
+		this->CheckForFinalShutdown();
+	};
+	executor.strand.post(destroy);
+}
+
+void DNP3Listener::BeginAccept()
+{
+	if (isShutdown)
+	{
+		return;
+	}
+
+	// a moved-from socket isn't reliably reusable, so each accept gets its own
+	pSocket.reset(new asio::ip::tcp::socket(executor.strand.get_io_service()));
+
+	isAccepting = true;
+	auto callback = [this](const std::error_code & ec)
+	{
+		this->OnAccept(ec);
+	};
+	acceptor.async_accept(*pSocket, remoteEndpoint, executor.strand.wrap(callback));
+}
+
+void DNP3Listener::OnAccept(const std::error_code& ec)
+{
+	isAccepting = false;
+
+	if (isShutdown)
+	{
+		pSocket.reset();
+		this->CheckForFinalShutdown();
+		return;
+	}
+
+	if (ec)
+	{
+		FORMAT_LOG_BLOCK(logger, flags::WARN, "Error accepting connection: %s", ec.message().c_str());
+		++statistics.numAcceptErrors;
+		auto retry = [this]()
+		{
+			this->BeginAccept();
+		};
+		acceptRetryTimer.Start(ACCEPT_RETRY_DELAY, retry);
+		return;
+	}
+
+	++statistics.numAccepted;
+	FORMAT_LOG_BLOCK(logger, flags::INFO, "Accepted connection from: %s", remoteEndpoint.address().to_string().c_str());
+
+	auto alias = id + "-" + std::to_string(++nextConnectionId);
+	auto pConnection = new ListenerConnection(*this, *pLogRoot, alias.c_str(), executor, std::move(*pSocket), remoteEndpoint.address().to_string());
+	connections.insert(pConnection);
+	pConnection->Start(routeTimeout);
+
+	this->BeginAccept();
+}
+
+void DNP3Listener::InitiateShutdown(asiopal::Synchronized<bool>& handler)
+{
+	pShutdownSignal = &handler;
+	isShutdown = true;
+	acceptRetryTimer.Cancel();
+
+	std::error_code ec;
+	acceptor.close(ec);
+
+	std::vector<ListenerConnection*> copy(connections.begin(), connections.end());
+	for (auto pConnection : copy)
+	{
+		this->CloseConnection(*pConnection);
+	}
+
+	this->CheckForFinalShutdown();
+}
+
+void DNP3Listener::CheckForFinalShutdown()
+{
+	if (pShutdownSignal && !isAccepting && connections.empty())
+	{
+		pShutdownSignal->SetValue(true);
+		pShutdownSignal = nullptr;
+	}
+}
+
+}
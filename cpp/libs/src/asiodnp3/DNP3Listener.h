@@ -0,0 +1,202 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIODNP3_DNP3LISTENER_H
+#define ASIODNP3_DNP3LISTENER_H
+
+#include <openpal/logging/LogRoot.h>
+#include <openpal/executor/TimerRef.h>
+
+#include <opendnp3/Route.h>
+#include <opendnp3/link/ILinkRouter.h>
+#include <opendnp3/link/LinkKeepAliveScheduler.h>
+
+#include <asiopal/ASIOExecutor.h>
+#include <asiopal/IOUring.h>
+#include <asiopal/Synchronized.h>
+
+#include "asiodnp3/IListener.h"
+#include "asiodnp3/IStackLifecycle.h"
+
+#include <asio.hpp>
+#include <asio/ip/tcp.hpp>
+
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace asiodnp3
+{
+
+class ListenerConnection;
+
+/**
+* Accepts many connections on one endpoint and routes each of them to a pre-registered stack.
+*
+* The listener is the link router for all of its stacks, and forwards each transmission to the
+* connection the stack is currently bound to. Everything runs on a single executor.
+*/
+class DNP3Listener final : public IListener, private IStackLifecycle, private opendnp3::ILinkRouter
+{
+	friend class ListenerConnection;
+
+public:
+
+	DNP3Listener(
+	    std::unique_ptr<openpal::LogRoot> root,
+	    const std::string& id,
+	    asio::io_service& service,
+	    const openpal::TimeDuration& routeTimeout,
+	    asiopal::IOUring* pRing = nullptr
+	);
+
+	~DNP3Listener();
+
+	/// Synchronously bind and listen on the endpoint. Logs and returns false on failure.
+	bool Bind(const std::string& endpoint, uint16_t port);
+
+	/// Begin accepting connections
+	void Start();
+
+	// ----------------------- Implement IListener -----------------------
+
+	virtual ListenerStatistics GetStatistics() override final;
+
+	virtual void Shutdown() override final;
+
+	virtual openpal::LogFilters GetLogFilters() const override final;
+
+	virtual void SetLogFilters(const openpal::LogFilters& filters) override final;
+
+	virtual void SetRouteTakeoverHandler(const RouteTakeoverHandlerT& handler) override final;
+
+	virtual IMaster* AddMaster(char const* id,
+	                           opendnp3::ISOEHandler& SOEHandler,
+	                           opendnp3::IMasterApplication& application,
+	                           const opendnp3::MasterStackConfig& config) override final;
+
+	virtual IOutstation* AddOutstation(char const* id,
+	                                   opendnp3::ICommandHandler& commandHandler,
+	                                   opendnp3::IOutstationApplication& application,
+	                                   const opendnp3::OutstationStackConfig& config) override final;
+
+	// -----------------------------------------------------------------------
+
+	// Helper functions only available inside DNP3Manager
+	void SetShutdownHandler(const openpal::Action0& action);
+
+private:
+
+	static const openpal::TimeDuration ACCEPT_RETRY_DELAY;
+
+	struct Registration
+	{
+		Registration(IStack* pStack_, const opendnp3::Route& route_) :
+			pStack(pStack_),
+			route(route_),
+			enabled(false),
+			pConnection(nullptr)
+		{}
+
+		IStack* pStack;
+		opendnp3::Route route;
+		bool enabled;
+		ListenerConnection* pConnection;
+	};
+
+	static uint32_t Key(const opendnp3::Route& route)
+	{
+		return (static_cast<uint32_t>(route.destination) << 16) | route.source;
+	}
+
+	// ----- implement IStackLifecycle ------
+
+	virtual asiopal::ASIOExecutor& GetExecutor() override
+	{
+		return executor;
+	}
+
+	virtual bool EnableRoute(opendnp3::ILinkSession* pContext) override;
+
+	virtual bool DisableRoute(opendnp3::ILinkSession* pContext) override;
+
+	virtual void Shutdown(opendnp3::ILinkSession* pContext, IStack* pStack) override;
+
+	// ----- implement ILinkRouter ------
+
+	virtual void BeginTransmit(const openpal::RSlice& buffer, opendnp3::ILinkSession* pContext) override;
+
+	// ----- callbacks from the connections ------
+
+	bool Resolve(ListenerConnection& connection, const opendnp3::Route& route);
+
+	void OnRouteTimeout(ListenerConnection& connection);
+
+	void CloseConnection(ListenerConnection& connection);
+
+	void OnConnectionShutdown(ListenerConnection* pConnection);
+
+	// ----- helpers ------
+
+	template <class T>
+	T* AddStack(const opendnp3::LinkConfig& link, const std::function<T* ()>& factory);
+
+	void ShutdownAllStacks();
+
+	void BeginAccept();
+
+	void OnAccept(const std::error_code& ec);
+
+	void InitiateShutdown(asiopal::Synchronized<bool>& handler);
+
+	void CheckForFinalShutdown();
+
+	std::unique_ptr<openpal::LogRoot> pLogRoot;
+	std::string id;
+	openpal::Logger logger;
+	mutable asiopal::ASIOExecutor executor;
+	openpal::TimeDuration routeTimeout;
+	asiopal::IOUring* pRing;
+
+	// one timer for the keep-alives of every session of every connection, outlives the stacks
+	opendnp3::LinkKeepAliveScheduler keepAlives;
+
+	asio::ip::tcp::acceptor acceptor;
+	std::unique_ptr<asio::ip::tcp::socket> pSocket;
+	asio::ip::tcp::endpoint remoteEndpoint;
+	openpal::TimerRef acceptRetryTimer;
+
+	bool isAccepting;
+	bool isShutdown;
+	uint32_t nextConnectionId;
+	asiopal::Synchronized<bool>* pShutdownSignal;
+	openpal::Action0 shutdownHandler;
+	RouteTakeoverHandlerT takeoverHandler;
+
+	ListenerStatistics statistics;
+	std::unordered_map<opendnp3::ILinkSession*, Registration> registrations;
+	std::unordered_map<uint32_t, opendnp3::ILinkSession*> routes;
+	std::set<ListenerConnection*> connections;
+};
+
+}
+
+#endif
@@ -26,6 +26,9 @@
 #include <asiopal/PhysicalLayerSerial.h>
 #include <asiopal/PhysicalLayerTCPClient.h>
 #include <asiopal/PhysicalLayerTCPServer.h>
+#include <asiopal/PhysicalLayerMemoryPipe.h>
+#include <asiopal/PhysicalLayerUDP.h>
+#include <asiopal/SocketHelpers.h>
 
 #ifdef OPENDNP3_USE_TLS
 #include <asiopal/tls/PhysicalLayerTLSClient.h>
@@ -33,6 +36,7 @@
 #endif
 
 #include "asiodnp3/ManagerImpl.h"
+#include "asiodnp3/DNP3Listener.h"
 
 using namespace openpal;
 
@@ -44,8 +48,9 @@ DNP3Manager::DNP3Manager(
     uint32_t concurrencyHint,
     std::shared_ptr<openpal::ILogHandler> handler,
     std::function<void()> onThreadStart,
-    std::function<void()> onThreadExit) :
-	impl(new ManagerImpl(concurrencyHint, handler, onThreadStart, onThreadExit))
+    std::function<void()> onThreadExit,
+    const asiopal::ThreadPoolSettings& settings) :
+	impl(new ManagerImpl(concurrencyHint, handler, onThreadStart, onThreadExit, settings))
 {
 
 }
@@ -67,11 +72,15 @@ IChannel* DNP3Manager::AddTCPClient(
     const opendnp3::ChannelRetry& retry,
     const std::string& host,
     const std::string& local,
-    uint16_t port)
+    uint16_t port,
+    const asiopal::TCPSettings& tcp)
 {
 	auto pRoot = new LogRoot(impl->handler.get(), id, levels);
-	auto pPhys = new asiopal::PhysicalLayerTCPClient(*pRoot, impl->threadpool.GetIOService(), host, local, port);
-	return impl->channels.CreateChannel(pRoot, pPhys->executor, retry, pPhys);
+	auto configure = asiopal::SocketHelpers::Configure(tcp, pRoot->GetLogger());
+	auto& service = impl->threadpool.GetIOService(id);
+	auto pPhys = new asiopal::PhysicalLayerTCPClient(*pRoot, service, host, local, port, configure);
+	pPhys->SetIOUring(impl->GetIOUring(service));
+	return impl->channels.CreateChannel(pRoot, pPhys->executor, retry, pPhys, &impl->admission);
 }
 
 IChannel* DNP3Manager::AddTCPServer(
@@ -79,13 +88,35 @@ IChannel* DNP3Manager::AddTCPServer(
     uint32_t levels,
     const opendnp3::ChannelRetry& retry,
     const std::string& endpoint,
-    uint16_t port)
+    uint16_t port,
+    const asiopal::TCPSettings& tcp)
 {
 	auto pRoot = new LogRoot(impl->handler.get(), id, levels);
-	auto pPhys = new asiopal::PhysicalLayerTCPServer(*pRoot, impl->threadpool.GetIOService(), endpoint, port);
+	auto configure = asiopal::SocketHelpers::Configure(tcp, pRoot->GetLogger());
+	auto& service = impl->threadpool.GetIOService(id);
+	auto pPhys = new asiopal::PhysicalLayerTCPServer(*pRoot, service, endpoint, port, configure);
+	pPhys->SetIOUring(impl->GetIOUring(service));
 	return impl->channels.CreateChannel(pRoot, pPhys->executor, retry, pPhys);
 }
 
+IListener* DNP3Manager::AddTCPListener(
+    char const* id,
+    uint32_t levels,
+    const std::string& endpoint,
+    uint16_t port,
+    const openpal::TimeDuration& routeTimeout)
+{
+	auto pRoot = std::unique_ptr<LogRoot>(new LogRoot(impl->handler.get(), id, levels));
+	auto& service = impl->threadpool.GetIOService(id);
+	auto pListener = new DNP3Listener(std::move(pRoot), id, service, routeTimeout, impl->GetIOUring(service));
+	if (!pListener->Bind(endpoint, port))
+	{
+		delete pListener;
+		return nullptr;
+	}
+	return impl->channels.AddListener(pListener);
+}
+
 IChannel* DNP3Manager::AddSerial(
     char const* id,
     uint32_t levels,
@@ -93,10 +124,66 @@ IChannel* DNP3Manager::AddSerial(
     asiopal::SerialSettings settings)
 {
 	auto pRoot = new LogRoot(impl->handler.get(), id, levels);
-	auto pPhys = new asiopal::PhysicalLayerSerial(*pRoot, impl->threadpool.GetIOService(), settings);
+	auto pPhys = new asiopal::PhysicalLayerSerial(*pRoot, impl->threadpool.GetIOService(id), settings);
+	return impl->channels.CreateChannel(pRoot, pPhys->executor, retry, pPhys);
+}
+
+std::pair<IChannel*, IChannel*> DNP3Manager::AddMemoryPair(
+    char const* idA,
+    char const* idB,
+    uint32_t levels,
+    const opendnp3::ChannelRetry& retry,
+    const asiopal::MemoryPipeSettings& settings)
+{
+	auto pRootA = new LogRoot(impl->handler.get(), idA, levels);
+	auto pRootB = new LogRoot(impl->handler.get(), idB, levels);
+	auto phys = asiopal::PhysicalLayerMemoryPipe::CreatePair(*pRootA, *pRootB, impl->threadpool.GetIOService(idA), settings);
+	auto pChannelA = impl->channels.CreateChannel(pRootA, phys.first->executor, retry, phys.first);
+	auto pChannelB = impl->channels.CreateChannel(pRootB, phys.second->executor, retry, phys.second);
+	return std::make_pair(pChannelA, pChannelB);
+}
+
+IChannel* DNP3Manager::AddUDPChannel(
+    char const* id,
+    uint32_t levels,
+    const opendnp3::ChannelRetry& retry,
+    const std::string& localAddress,
+    uint16_t localPort,
+    const std::string& remoteAddress,
+    uint16_t remotePort,
+    const asiopal::UDPSettings& udp)
+{
+	auto socket = impl->udpSockets.Get(impl->threadpool.GetIOService(), localAddress, localPort, udp);
+	auto pRoot = new LogRoot(impl->handler.get(), id, levels);
+	auto pPhys = new asiopal::PhysicalLayerUDP(*pRoot, impl->threadpool.GetIOService(id), socket, remoteAddress, remotePort);
 	return impl->channels.CreateChannel(pRoot, pPhys->executor, retry, pPhys);
 }
 
+asiopal::DatagramStatistics DNP3Manager::GetUDPStatistics()
+{
+	return impl->udpSockets.GetStatistics();
+}
+
+bool DNP3Manager::EnableIOUring(const asiopal::IOUringSettings& settings)
+{
+	return impl->EnableIOUring(settings);
+}
+
+asiopal::IOUringStatistics DNP3Manager::GetIOUringStatistics()
+{
+	return impl->GetIOUringStatistics();
+}
+
+void DNP3Manager::SetOpenAdmission(const OpenAdmissionSettings& settings)
+{
+	impl->admission.Configure(settings);
+}
+
+OpenAdmissionStatistics DNP3Manager::GetOpenAdmissionStatistics()
+{
+	return impl->admission.GetStatistics();
+}
+
 #ifdef OPENDNP3_USE_TLS
 
 IChannel* DNP3Manager::AddTLSClient(
@@ -108,9 +195,11 @@ IChannel* DNP3Manager::AddTLSClient(
     uint16_t port,
     const asiopal::TLSConfig& config)
 {
+	// throws before anything is allocated if the configuration can't be loaded
+	auto context = impl->tlsContexts.Get(config, false);
 	auto pRoot = new LogRoot(impl->handler.get(), id, levels);
-	auto pPhys = new asiopal::PhysicalLayerTLSClient(*pRoot, impl->threadpool.GetIOService(), host, local, port, config);
-	return impl->channels.CreateChannel(pRoot, pPhys->executor, retry, pPhys);
+	auto pPhys = new asiopal::PhysicalLayerTLSClient(*pRoot, impl->threadpool.GetIOService(id), host, local, port, context);
+	return impl->channels.CreateChannel(pRoot, pPhys->executor, retry, pPhys, &impl->admission);
 }
 
 IChannel* DNP3Manager::AddTLSServer(
@@ -121,11 +210,23 @@ IChannel* DNP3Manager::AddTLSServer(
     uint16_t port,
     const asiopal::TLSConfig& config)
 {
+	// throws before anything is allocated if the configuration can't be loaded
+	auto context = impl->tlsContexts.Get(config, true);
 	auto pRoot = new LogRoot(impl->handler.get(), id, levels);
-	auto pPhys = new asiopal::PhysicalLayerTLSServer(*pRoot, impl->threadpool.GetIOService(), endpoint, port, config);
+	auto pPhys = new asiopal::PhysicalLayerTLSServer(*pRoot, impl->threadpool.GetIOService(id), endpoint, port, context);
 	return impl->channels.CreateChannel(pRoot, pPhys->executor, retry, pPhys);
 }
 
+asiopal::TLSSessionStatistics DNP3Manager::GetTLSSessionStatistics()
+{
+	return impl->tlsContexts.GetSessionStatistics();
+}
+
+bool DNP3Manager::ReloadTLSCertificates()
+{
+	return impl->tlsContexts.Reload();
+}
+
 #endif
 
 
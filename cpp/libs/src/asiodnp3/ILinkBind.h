@@ -23,6 +23,7 @@
 
 #include <opendnp3/link/ILinkRouter.h>
 #include <opendnp3/link/ILinkSession.h>
+#include <opendnp3/link/LinkKeepAliveScheduler.h>
 
 namespace asiodnp3
 {
@@ -34,7 +35,7 @@ class ILinkBind
 {
 public:
 
-	virtual void SetLinkRouter(opendnp3::ILinkRouter& router) = 0;
+	virtual void SetLinkRouter(opendnp3::ILinkRouter& router, opendnp3::LinkKeepAliveScheduler& keepAlives) = 0;
 
 	virtual opendnp3::ILinkSession& GetLinkContext() = 0;
 
@@ -20,10 +20,13 @@
  */
 #include "LinkLayerRouter.h"
 
+#include "IRouteResolver.h"
+
 #include <assert.h>
 
 #include <openpal/logging/LogMacros.h>
 #include <openpal/channel/IPhysicalLayer.h>
+#include <openpal/util/Comparisons.h>
 
 #include <opendnp3/LogLevels.h>
 #include <opendnp3/link/ILinkSession.h>
@@ -43,13 +46,16 @@ LinkLayerRouter::LinkLayerRouter(	openpal::LogRoot& root,
                                     IPhysicalLayer* pPhys,
                                     const ChannelRetry& retry,
                                     IChannelStateListener* pStateHandler_,
-                                    LinkChannelStatistics* pStatistics_) :
+                                    LinkChannelStatistics* pStatistics_,
+                                    OpenAdmissionScheduler* pAdmission) :
 
-	PhysicalLayerMonitor(root, executor, pPhys, retry),
+	PhysicalLayerMonitor(root, executor, pPhys, retry, pAdmission),
 	pStateHandler(pStateHandler_),
+	pResolver(nullptr),
 	pStatistics(pStatistics_),
 	parser(logger, pStatistics_),
-	isTransmitting(false)
+	isTransmitting(false),
+	numInFlight(0)
 {}
 
 void LinkLayerRouter::SetShutdownHandler(const Action0& action)
@@ -57,6 +63,11 @@ void LinkLayerRouter::SetShutdownHandler(const Action0& action)
 	this->shutdownHandler = action;
 }
 
+void LinkLayerRouter::SetRouteResolver(IRouteResolver* pResolver_)
+{
+	this->pResolver = pResolver_;
+}
+
 bool LinkLayerRouter::IsRouteInUse(const Route& route)
 {
 	auto matches = [route](const Record & record)
@@ -178,7 +189,7 @@ bool LinkLayerRouter::Remove(ILinkSession* pContext)
 
 	if(iter != records.end())
 	{
-		if (this->GetState() == ChannelState::OPEN && iter->enabled)
+		if (this->IsOnline() && iter->enabled)
 		{
 			iter->pContext->OnLowerLayerDown();
 		}
@@ -223,6 +234,11 @@ ILinkSession* LinkLayerRouter::GetDestination(uint16_t dest, uint16_t src)
 
 	ILinkSession* pDest = GetEnabledContext(route);
 
+	if (pDest == nullptr && pResolver && pResolver->Resolve(*this, route))
+	{
+		pDest = GetEnabledContext(route);
+	}
+
 	if(pDest == nullptr)
 	{
 		FORMAT_LOG_BLOCK_WITH_CODE(logger, flags::WARN, DLERR_UNKNOWN_ROUTE, "Frame w/ unknown route, source: %i, dest %i", route.source, route.destination);
@@ -300,13 +316,26 @@ bool LinkLayerRouter::HasEnabledContext()
 
 void LinkLayerRouter::OnSendResult(bool result)
 {
-	assert(!transmitQueue.empty());
+	assert(transmitQueue.size() >= numInFlight);
 	assert(isTransmitting);
-	isTransmitting = false;
 
-	auto pTx = transmitQueue.front();
-	transmitQueue.pop_front();
-	pTx.pContext->OnTransmitResult(result);
+	opendnp3::ILinkSession* contexts[IPhysicalLayer::MAX_WRITE_BATCH];
+	auto count = numInFlight;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		contexts[i] = transmitQueue.front().pContext;
+		transmitQueue.pop_front();
+	}
+	numInFlight = 0;
+
+	// frames queued by these callbacks are held back so that they coalesce into the next write,
+	// and the loop stops early if a callback closes the router
+	for (uint32_t i = 0; i < count && isTransmitting; ++i)
+	{
+		contexts[i]->OnTransmitResult(result);
+	}
+
+	isTransmitting = false;
 	this->CheckForSend();
 }
 
@@ -314,10 +343,18 @@ void LinkLayerRouter::CheckForSend()
 {
 	if (!transmitQueue.empty() && !isTransmitting && pPhys->CanWrite())
 	{
-		if (pStatistics) ++pStatistics->numLinkFrameTx;
-		auto tx = transmitQueue.front();
+		// everything queued while the last write was in flight goes out in one write
+		RSlice batch[IPhysicalLayer::MAX_WRITE_BATCH];
+		auto count = openpal::Min<uint32_t>(static_cast<uint32_t>(transmitQueue.size()), IPhysicalLayer::MAX_WRITE_BATCH);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			batch[i] = transmitQueue[i].buffer;
+			if (pStatistics) pStatistics->numLinkFrameTx += LinkFrame::CountFrames(batch[i]);
+		}
+
 		isTransmitting = true;
-		pPhys->BeginWrite(tx.buffer);
+		numInFlight = count;
+		pPhys->BeginWriteBatch(batch, count);
 	}
 }
 
@@ -347,6 +384,7 @@ void LinkLayerRouter::OnPhysicalLayerCloseCallback()
 
 	// Drop frames queued for transmit and tell the contexts that the router has closed
 	isTransmitting = false;
+	numInFlight = 0;
 	transmitQueue.clear();
 
 	taskLock.SetOffline();
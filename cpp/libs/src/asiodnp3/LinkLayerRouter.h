@@ -50,6 +50,8 @@ class LinkFrame;
 namespace asiodnp3
 {
 
+class IRouteResolver;
+
 // Implements the parsing and de-multiplexing portion of
 // of DNP 3 Data Link Layer. PhysicalLayerMonitor inherits
 // from IHandler, which inherits from IUpperLayer
@@ -62,7 +64,8 @@ public:
 	                openpal::IPhysicalLayer*,
 	                const opendnp3::ChannelRetry& retry,
 	                opendnp3::IChannelStateListener* pStateHandler = nullptr,
-	                opendnp3::LinkChannelStatistics* pStatistics = nullptr);
+	                opendnp3::LinkChannelStatistics* pStatistics = nullptr,
+	                OpenAdmissionScheduler* pAdmission = nullptr);
 
 	opendnp3::ITaskLock& GetTaskLock()
 	{
@@ -72,6 +75,9 @@ public:
 	// called when the router shuts down
 	void SetShutdownHandler(const openpal::Action0& action);
 
+	// consulted when a frame arrives for a route with no enabled context
+	void SetRouteResolver(IRouteResolver* pResolver);
+
 	// Query to see if a route is in use
 	bool IsRouteInUse(const opendnp3::Route& route);
 
@@ -153,6 +159,7 @@ private:
 
 	opendnp3::MultidropTaskLock taskLock;
 	opendnp3::IChannelStateListener* pStateHandler;
+	IRouteResolver* pResolver;
 	openpal::Action0 shutdownHandler;
 
 	std::vector<Record> records;
@@ -163,6 +170,7 @@ private:
 	opendnp3::LinkChannelStatistics* pStatistics;
 	opendnp3::LinkLayerParser parser;
 	bool isTransmitting;
+	uint32_t numInFlight;
 
 	// Implement virtual PhysLayerMonitor
 	void OnPhysicalLayerOpenSuccessCallback() override;
@@ -0,0 +1,126 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include "ListenerConnection.h"
+
+#include "DNP3Listener.h"
+
+#include <algorithm>
+
+using namespace openpal;
+using namespace opendnp3;
+
+namespace asiodnp3
+{
+
+ListenerConnection::ListenerConnection(
+    DNP3Listener& listener,
+    const openpal::LogRoot& parent,
+    char const* id,
+    asiopal::ASIOExecutor& executor,
+    asio::ip::tcp::socket&& socket,
+    const std::string& remoteAddress_) :
+
+	pListener(&listener),
+	remoteAddress(remoteAddress_),
+	root(parent, id),
+	pExecutor(&executor),
+	phys(root, executor, std::move(socket)),
+	router(root, executor, &phys, ChannelRetry::Default(), this),
+	routeTimer(executor),
+	isClosing(false)
+{
+	router.SetRouteResolver(this);
+	phys.SetIOUring(listener.pRing);
+
+	auto onShutdown = [this]()
+	{
+		this->pListener->OnConnectionShutdown(this);
+	};
+	router.SetShutdownHandler(Action0::Bind(onShutdown));
+}
+
+void ListenerConnection::Start(const openpal::TimeDuration& routeTimeout)
+{
+	auto timeout = [this]()
+	{
+		this->pListener->OnRouteTimeout(*this);
+	};
+	routeTimer.Start(routeTimeout, timeout);
+
+	router.StartOne();
+}
+
+bool ListenerConnection::Bind(opendnp3::ILinkSession& session, const Route& route)
+{
+	if (!router.AddContext(&session, route))
+	{
+		return false;
+	}
+
+	routeTimer.Cancel();
+	sessions.push_back(&session);
+	return router.Enable(&session);
+}
+
+bool ListenerConnection::Unbind(opendnp3::ILinkSession& session)
+{
+	auto iter = std::find(sessions.begin(), sessions.end(), &session);
+	if (iter == sessions.end())
+	{
+		return false;
+	}
+
+	sessions.erase(iter);
+	return router.Remove(&session);
+}
+
+void ListenerConnection::Shutdown()
+{
+	isClosing = true;
+	routeTimer.Cancel();
+	router.Shutdown();
+}
+
+void ListenerConnection::BeginTransmit(const openpal::RSlice& buffer, opendnp3::ILinkSession* pSession)
+{
+	router.BeginTransmit(buffer, pSession);
+}
+
+void ListenerConnection::OnStateChange(ChannelState state)
+{
+	// a session cannot be reopened, so any transition away from open ends the connection
+	if (!isClosing && (state == ChannelState::CLOSED || state == ChannelState::WAITING))
+	{
+		isClosing = true;
+		auto close = [this]()
+		{
+			this->pListener->CloseConnection(*this);
+		};
+		pExecutor->PostLambda(close);
+	}
+}
+
+bool ListenerConnection::Resolve(LinkLayerRouter&, const Route& route)
+{
+	return isClosing ? false : pListener->Resolve(*this, route);
+}
+
+}
@@ -0,0 +1,101 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIODNP3_LISTENERCONNECTION_H
+#define ASIODNP3_LISTENERCONNECTION_H
+
+#include <openpal/logging/LogRoot.h>
+#include <openpal/executor/TimerRef.h>
+
+#include <asiopal/PhysicalLayerTCPSession.h>
+
+#include "asiodnp3/LinkLayerRouter.h"
+#include "asiodnp3/IRouteResolver.h"
+
+#include <string>
+#include <vector>
+
+namespace asiodnp3
+{
+
+class DNP3Listener;
+
+/**
+* A single connection accepted by a DNP3Listener. Owns just the socket, the parser, and the
+* transmit queue. The sessions routed to it are owned by the listener.
+*/
+class ListenerConnection final : private opendnp3::IChannelStateListener, private IRouteResolver
+{
+
+public:
+
+	ListenerConnection(
+	    DNP3Listener& listener,
+	    const openpal::LogRoot& parent,
+	    char const* id,
+	    asiopal::ASIOExecutor& executor,
+	    asio::ip::tcp::socket&& socket,
+	    const std::string& remoteAddress
+	);
+
+	/// Open the connection and give the remote a limited time to present a registered route
+	void Start(const openpal::TimeDuration& routeTimeout);
+
+	/// Attach a session to this connection and bring it online
+	bool Bind(opendnp3::ILinkSession& session, const opendnp3::Route& route);
+
+	/// Detach a session, taking it offline if the connection is open
+	bool Unbind(opendnp3::ILinkSession& session);
+
+	/// Close the connection permanently, the listener is notified once it may be deleted
+	void Shutdown();
+
+	void BeginTransmit(const openpal::RSlice& buffer, opendnp3::ILinkSession* pSession);
+
+	const std::vector<opendnp3::ILinkSession*>& Sessions() const
+	{
+		return sessions;
+	}
+
+	const std::string& RemoteAddress() const
+	{
+		return remoteAddress;
+	}
+
+private:
+
+	virtual void OnStateChange(opendnp3::ChannelState state) override;
+
+	virtual bool Resolve(LinkLayerRouter& router, const opendnp3::Route& route) override;
+
+	DNP3Listener* pListener;
+	const std::string remoteAddress;
+	openpal::LogRoot root;
+	asiopal::ASIOExecutor* pExecutor;
+	asiopal::PhysicalLayerTCPSession phys;
+	LinkLayerRouter router;
+	openpal::TimerRef routeTimer;
+	bool isClosing;
+	std::vector<opendnp3::ILinkSession*> sessions;
+};
+
+}
+
+#endif
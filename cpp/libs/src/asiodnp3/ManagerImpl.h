@@ -27,10 +27,21 @@
 #include <openpal/util/Uncopyable.h>
 
 #include <asiopal/IOServiceThreadPool.h>
+#include <asiopal/ASIOExecutor.h>
+#include <asiopal/DatagramSocketCache.h>
+#include <asiopal/IOUring.h>
+
+#ifdef OPENDNP3_USE_TLS
+#include <asiopal/tls/TLSContextCache.h>
+#endif
 
 #include <opendnp3/LogLevels.h>
 
 #include "asiodnp3/ChannelSet.h"
+#include "asiodnp3/OpenAdmissionScheduler.h"
+
+#include <map>
+#include <mutex>
 
 namespace asiodnp3
 {
@@ -44,16 +55,93 @@ public:
 	    uint32_t concurrencyHint,
 	    std::shared_ptr<openpal::ILogHandler> handler,
 	    std::function<void()> onThreadStart,
-	    std::function<void()> onThreadExit
+	    std::function<void()> onThreadExit,
+	    const asiopal::ThreadPoolSettings& settings
 	) :
 		handler(handler),
-		threadpool(handler.get(), opendnp3::flags::INFO, concurrencyHint, onThreadStart, onThreadExit),
+		threadpool(handler.get(), opendnp3::flags::INFO, concurrencyHint, onThreadStart, onThreadExit, settings),
+		admissionExecutor(threadpool.GetIOService()),
+		admission(admissionExecutor),
+		isRingEnabled(false),
 		channels()
 	{}
 
+	~ManagerImpl()
+	{
+		// channels post to the scheduler's executor, so they go first
+		channels.Shutdown();
+		admissionExecutor.BlockFor([this]()
+		{
+			admission.Shutdown();
+		});
+		admissionExecutor.WaitForShutdown();
+	}
+
+	bool EnableIOUring(const asiopal::IOUringSettings& settings)
+	{
+		std::lock_guard<std::mutex> lock(ringMutex);
+		ringSettings = settings;
+		isRingEnabled = true;
+		if (!this->CreateRing(threadpool.GetIOService()))
+		{
+			isRingEnabled = false;
+		}
+		return isRingEnabled;
+	}
+
+	/// The ring of the io_service a tcp channel runs on, or nullptr if they aren't enabled
+	asiopal::IOUring* GetIOUring(asio::io_service& service)
+	{
+		std::lock_guard<std::mutex> lock(ringMutex);
+		if (!isRingEnabled)
+		{
+			return nullptr;
+		}
+		auto iter = rings.find(&service);
+		return (iter == rings.end()) ? this->CreateRing(service) : iter->second.get();
+	}
+
+	asiopal::IOUringStatistics GetIOUringStatistics()
+	{
+		std::lock_guard<std::mutex> lock(ringMutex);
+		asiopal::IOUringStatistics statistics;
+		for (auto& pair : rings)
+		{
+			statistics += pair.second->GetStatistics();
+		}
+		return statistics;
+	}
+
 	std::shared_ptr<openpal::ILogHandler> handler;
+#ifdef OPENDNP3_USE_TLS
+	// declared before the channels so it outlives every TLS context that refers to it
+	asiopal::TLSContextCache tlsContexts;
+#endif
 	asiopal::IOServiceThreadPool threadpool;
+	asiopal::DatagramSocketCache udpSockets;
+	asiopal::ASIOExecutor admissionExecutor;
+	OpenAdmissionScheduler admission;
+
+	// one ring per io_service so that the shards of the pool don't contend on it, declared before the channels that use them
+	std::mutex ringMutex;
+	bool isRingEnabled;
+	asiopal::IOUringSettings ringSettings;
+	std::map<asio::io_service*, std::shared_ptr<asiopal::IOUring>> rings;
+
 	ChannelSet channels;
+
+private:
+
+	asiopal::IOUring* CreateRing(asio::io_service& service)
+	{
+		std::error_code ec;
+		auto ring = asiopal::IOUring::Create(service, ringSettings, ec);
+		if (ring)
+		{
+			rings[&service] = ring;
+		}
+		return ring.get();
+	}
 };
 
 }
@@ -53,7 +53,7 @@ public:
 	) :
 		root(std::move(root)),
 		pLifecycle(&lifecycle),
-		stack(this->root->GetLogger(), executor, listener, config.master.maxRxFragSize, &statistics, config.link),
+		stack(this->root->GetLogger(), executor, listener, config.master.maxRxFragSize, &statistics, config.link, config.master.poolAllFragmentBuffers),
 		pASIOExecutor(&executor),
 		pContext(nullptr)
 	{
@@ -206,9 +206,10 @@ public:
 
 	// ------- implement ILinkBind ---------
 
-	virtual void SetLinkRouter(opendnp3::ILinkRouter& router) override final
+	virtual void SetLinkRouter(opendnp3::ILinkRouter& router, opendnp3::LinkKeepAliveScheduler& keepAlives) override final
 	{
 		stack.link.SetRouter(router);
+		stack.link.SetKeepAliveScheduler(keepAlives);
 	}
 
 	virtual opendnp3::ILinkSession& GetLinkContext() override final
@@ -0,0 +1,271 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include "OpenAdmissionScheduler.h"
+
+#include "PhysicalLayerMonitor.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace openpal;
+
+namespace asiodnp3
+{
+
+OpenAdmissionScheduler::OpenAdmissionScheduler(openpal::IExecutor& executor) :
+	pExecutor(&executor),
+	nextSequence(0),
+	nextId(0),
+	tokens(0),
+	lastRefill(clock_t::now()),
+	isShutdown(false),
+	refillPending(false),
+	pRefillTimer(nullptr),
+	random(std::random_device()())
+{
+
+}
+
+void OpenAdmissionScheduler::Configure(const OpenAdmissionSettings& settings_)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	settings = settings_;
+	tokens = std::max<uint32_t>(settings.openBurst, 1);
+	lastRefill = clock_t::now();
+	this->Dispatch(nullptr);
+}
+
+bool OpenAdmissionScheduler::Request(PhysicalLayerMonitor& monitor, uint8_t priority, uint32_t& id)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto existing = entries.find(&monitor);
+	if (existing != entries.end())
+	{
+		this->Release(existing, false);
+	}
+
+	Entry entry;
+	entry.opening = false;
+	entry.id = ++nextId;
+	entry.waiter.priority = priority;
+	entry.waiter.sequence = ++nextSequence;
+	entry.waiter.pMonitor = &monitor;
+	entry.timestamp = clock_t::now();
+
+	id = entry.id;
+	entries[&monitor] = entry;
+	waiters.insert(entry.waiter);
+	++statistics.numWaiting;
+
+	return this->Dispatch(&monitor);
+}
+
+void OpenAdmissionScheduler::Complete(PhysicalLayerMonitor& monitor, bool success)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	auto iter = entries.find(&monitor);
+	if (iter != entries.end() && iter->second.opening)
+	{
+		this->Release(iter, success);
+		this->Dispatch(nullptr);
+	}
+}
+
+void OpenAdmissionScheduler::Cancel(PhysicalLayerMonitor& monitor)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	auto iter = entries.find(&monitor);
+	if (iter != entries.end())
+	{
+		this->Release(iter, false);
+		this->Dispatch(nullptr);
+	}
+}
+
+openpal::TimeDuration OpenAdmissionScheduler::RetryDelay(const openpal::TimeDuration& nominal)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (!settings.fullJitter || nominal.GetMilliseconds() <= 0)
+	{
+		return nominal;
+	}
+
+	std::uniform_int_distribution<int64_t> distribution(0, nominal.GetMilliseconds());
+	return TimeDuration::Milliseconds(distribution(random));
+}
+
+OpenAdmissionStatistics OpenAdmissionScheduler::GetStatistics()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return statistics;
+}
+
+void OpenAdmissionScheduler::Shutdown()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	isShutdown = true;
+	if (pRefillTimer)
+	{
+		pRefillTimer->Cancel();
+		pRefillTimer = nullptr;
+	}
+}
+
+bool OpenAdmissionScheduler::Dispatch(PhysicalLayerMonitor* pRequester)
+{
+	const auto now = clock_t::now();
+	this->Refill(now);
+
+	bool admitted = false;
+
+	while (!waiters.empty() && this->HasConcurrency() && (settings.opensPerSecond == 0 || tokens >= 1.0))
+	{
+		auto pMonitor = waiters.begin()->pMonitor;
+		auto& entry = entries[pMonitor];
+		this->Admit(entry, now);
+
+		if (pMonitor == pRequester)
+		{
+			admitted = true;
+		}
+		else
+		{
+			auto id = entry.id;
+			auto callback = [pMonitor, id]()
+			{
+				pMonitor->OnOpenAdmitted(id);
+			};
+			pMonitor->pExecutor->Post(Action0::Bind(callback));
+		}
+	}
+
+	// only blocked by the rate, so wake up when the next token arrives
+	if (!waiters.empty() && this->HasConcurrency() && !refillPending && !isShutdown)
+	{
+		refillPending = true;
+		auto start = [this]()
+		{
+			this->StartRefillTimer();
+		};
+		pExecutor->Post(Action0::Bind(start));
+	}
+
+	return admitted;
+}
+
+void OpenAdmissionScheduler::Admit(Entry& entry, const clock_t::time_point& now)
+{
+	waiters.erase(entry.waiter);
+	entry.opening = true;
+
+	if (settings.opensPerSecond)
+	{
+		tokens -= 1.0;
+	}
+
+	const uint64_t waitMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - entry.timestamp).count();
+	entry.timestamp = now;
+
+	--statistics.numWaiting;
+	++statistics.numOpening;
+	++statistics.numAdmitted;
+	statistics.totalWaitMs += waitMs;
+	statistics.maxWaitMs = std::max(statistics.maxWaitMs, waitMs);
+}
+
+void OpenAdmissionScheduler::Release(EntryMap::iterator iter, bool success)
+{
+	auto& entry = iter->second;
+	if (entry.opening)
+	{
+		const uint64_t openMs = std::chrono::duration_cast<std::chrono::milliseconds>(clock_t::now() - entry.timestamp).count();
+
+		--statistics.numOpening;
+		if (success)
+		{
+			++statistics.numOpenSuccess;
+		}
+		else
+		{
+			++statistics.numOpenFailure;
+		}
+		statistics.totalOpenMs += openMs;
+		statistics.maxOpenMs = std::max(statistics.maxOpenMs, openMs);
+	}
+	else
+	{
+		waiters.erase(entry.waiter);
+		--statistics.numWaiting;
+	}
+
+	entries.erase(iter);
+}
+
+void OpenAdmissionScheduler::Refill(const clock_t::time_point& now)
+{
+	if (settings.opensPerSecond)
+	{
+		const double seconds = std::chrono::duration<double>(now - lastRefill).count();
+		tokens = std::min<double>(tokens + seconds * settings.opensPerSecond, std::max<uint32_t>(settings.openBurst, 1));
+	}
+
+	lastRefill = now;
+}
+
+bool OpenAdmissionScheduler::HasConcurrency() const
+{
+	return (settings.maxConcurrentOpens == 0) || (statistics.numOpening < settings.maxConcurrentOpens);
+}
+
+void OpenAdmissionScheduler::StartRefillTimer()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (isShutdown || pRefillTimer)
+	{
+		return;
+	}
+
+	this->Refill(clock_t::now());
+
+	const double deficit = (settings.opensPerSecond == 0) ? 0.0 : std::max(1.0 - tokens, 0.0);
+	const auto delayMs = static_cast<int64_t>(std::ceil(1000.0 * deficit / std::max<uint32_t>(settings.opensPerSecond, 1)));
+
+	auto timeout = [this]()
+	{
+		this->OnRefillTimeout();
+	};
+	pRefillTimer = pExecutor->Start(TimeDuration::Milliseconds(std::max<int64_t>(delayMs, 1)), Action0::Bind(timeout));
+}
+
+void OpenAdmissionScheduler::OnRefillTimeout()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	pRefillTimer = nullptr;
+	refillPending = false;
+	if (!isShutdown)
+	{
+		this->Dispatch(nullptr);
+	}
+}
+
+}
@@ -0,0 +1,138 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef ASIODNP3_OPENADMISSIONSCHEDULER_H
+#define ASIODNP3_OPENADMISSIONSCHEDULER_H
+
+#include <openpal/executor/IExecutor.h>
+#include <openpal/util/Uncopyable.h>
+
+#include "asiodnp3/OpenAdmissionSettings.h"
+#include "asiodnp3/OpenAdmissionStatistics.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <random>
+#include <set>
+
+namespace asiodnp3
+{
+
+class PhysicalLayerMonitor;
+
+/**
+* Decides when the monitors of a manager may begin opening their physical layers. Waiting monitors are
+* admitted highest priority first, subject to a limit on concurrent attempts and a token bucket on the rate
+* at which attempts begin.
+*
+* Thread-safe. Admissions of other monitors are posted to their own executors.
+*/
+class OpenAdmissionScheduler : private openpal::Uncopyable
+{
+	typedef std::chrono::steady_clock clock_t;
+
+public:
+
+	/// The executor is used for the timer that refills the token bucket
+	OpenAdmissionScheduler(openpal::IExecutor& executor);
+
+	void Configure(const OpenAdmissionSettings& settings);
+
+	/**
+	* Queue an attempt to open on behalf of a monitor
+	*
+	* @param id is set to the identifier that will be passed to PhysicalLayerMonitor::OnOpenAdmitted()
+	* @return true if the attempt may begin now, otherwise the admission is posted to the monitor's executor later
+	*/
+	bool Request(PhysicalLayerMonitor& monitor, uint8_t priority, uint32_t& id);
+
+	/// The attempt of an admitted monitor ended
+	void Complete(PhysicalLayerMonitor& monitor, bool success);
+
+	/// Withdraw the monitor's request or release its attempt if it was already admitted
+	void Cancel(PhysicalLayerMonitor& monitor);
+
+	/// Delay before the next retry, given the delay computed by the channel's retry strategy
+	openpal::TimeDuration RetryDelay(const openpal::TimeDuration& nominal);
+
+	OpenAdmissionStatistics GetStatistics();
+
+	/// Cancel the refill timer. Must be called on the executor.
+	void Shutdown();
+
+private:
+
+	struct Waiter
+	{
+		uint8_t priority;
+		uint64_t sequence;
+		PhysicalLayerMonitor* pMonitor;
+
+		bool operator<(const Waiter& rhs) const
+		{
+			return (priority != rhs.priority) ? (priority > rhs.priority) : (sequence < rhs.sequence);
+		}
+	};
+
+	struct Entry
+	{
+		bool opening;
+		uint32_t id;
+		Waiter waiter;
+		clock_t::time_point timestamp;
+	};
+
+	typedef std::map<PhysicalLayerMonitor*, Entry> EntryMap;
+
+	// admit as many waiters as the limits allow, returns true if pRequester was among them
+	bool Dispatch(PhysicalLayerMonitor* pRequester);
+	void Admit(Entry& entry, const clock_t::time_point& now);
+	void Release(EntryMap::iterator entry, bool success);
+	void Refill(const clock_t::time_point& now);
+	bool HasConcurrency() const;
+	void StartRefillTimer();
+	void OnRefillTimeout();
+
+	openpal::IExecutor* pExecutor;
+
+	std::mutex mutex;
+	OpenAdmissionSettings settings;
+	OpenAdmissionStatistics statistics;
+
+	EntryMap entries;
+	std::set<Waiter> waiters;
+
+	uint64_t nextSequence;
+	uint32_t nextId;
+
+	double tokens;
+	clock_t::time_point lastRefill;
+
+	bool isShutdown;
+	bool refillPending;
+	openpal::ITimer* pRefillTimer;
+
+	std::mt19937 random;
+};
+
+}
+
+#endif
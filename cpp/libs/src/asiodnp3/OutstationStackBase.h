@@ -54,7 +54,7 @@ public:
 	) :
 		root(std::move(root)),
 		pLifecycle(&lifecycle),
-		stack(this->root->GetLogger(), executor, listener, config.outstation.params.maxRxFragSize, &statistics, config.link),
+		stack(this->root->GetLogger(), executor, listener, config.outstation.params.maxRxFragSize, &statistics, config.link, config.outstation.params.poolAllFragmentBuffers),
 		pContext(nullptr)
 	{}
 
@@ -111,9 +111,10 @@ public:
 
 	// ------- implement ILinkBind ---------
 
-	virtual void SetLinkRouter(opendnp3::ILinkRouter& router) override final
+	virtual void SetLinkRouter(opendnp3::ILinkRouter& router, opendnp3::LinkKeepAliveScheduler& keepAlives) override final
 	{
 		stack.link.SetRouter(router);
+		stack.link.SetKeepAliveScheduler(keepAlives);
 	}
 
 	virtual opendnp3::ILinkSession& GetLinkContext() override final
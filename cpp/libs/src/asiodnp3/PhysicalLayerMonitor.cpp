@@ -21,6 +21,7 @@
 #include "PhysicalLayerMonitor.h"
 
 #include "PhysicalLayerMonitorStates.h"
+#include "OpenAdmissionScheduler.h"
 
 #include "opendnp3/LogLevels.h"
 
@@ -39,7 +40,8 @@ PhysicalLayerMonitor::PhysicalLayerMonitor(
     openpal::LogRoot& root,
     openpal::IExecutor& executor,
     IPhysicalLayer* pPhys_,
-    const opendnp3::ChannelRetry& retry_
+    const opendnp3::ChannelRetry& retry_,
+    OpenAdmissionScheduler* pAdmission_
 ) :
 	logger(root.GetLogger()),
 	pPhys(pPhys_),
@@ -49,7 +51,11 @@ PhysicalLayerMonitor::PhysicalLayerMonitor(
 	mpState(&MonitorStateInit::Instance()),
 	mFinalShutdown(false),
 	retry(retry_),
-	currentRetry(retry_.minOpenRetry)
+	currentRetry(retry_.minOpenRetry),
+	pAdmission(pAdmission_),
+	awaitingAdmission(false),
+	admitted(false),
+	admissionId(0)
 {
 	assert(pPhys != nullptr);
 	pPhys->SetHandler(this);
@@ -73,6 +79,13 @@ void PhysicalLayerMonitor::ChangeState(IMonitorState& state)
 
 	if (mpState->GetState() == ChannelState::SHUTDOWN)
 	{
+		if (pAdmission)
+		{
+			// no admission may be posted to this monitor once it has shut down
+			awaitingAdmission = false;
+			admitted = false;
+			pAdmission->Cancel(*this);
+		}
 		this->OnShutdown();
 	}
 }
@@ -82,6 +95,12 @@ void PhysicalLayerMonitor::ChangeState(IMonitorState& state)
 
 void PhysicalLayerMonitor::OnOpenFailure()
 {
+	if (admitted)
+	{
+		admitted = false;
+		pAdmission->Complete(*this, false);
+	}
+
 	if (mpState->OnOpenFailure(*this))
 	{
 		this->OnPhysicalLayerOpenFailureCallback();
@@ -91,6 +110,12 @@ void PhysicalLayerMonitor::OnOpenFailure()
 
 void PhysicalLayerMonitor::OnLowerLayerUp()
 {
+	if (admitted)
+	{
+		admitted = false;
+		pAdmission->Complete(*this, true);
+	}
+
 	if (mpState->OnLayerOpen(*this))
 	{
 		isOnline = true;
@@ -155,7 +180,8 @@ void PhysicalLayerMonitor::StartOpenTimer()
 	{
 		this->OnOpenTimerExpiration();
 	};
-	mpOpenTimer = pExecutor->Start(currentRetry, Action0::Bind(lambda));
+	auto delay = pAdmission ? pAdmission->RetryDelay(currentRetry) : currentRetry;
+	mpOpenTimer = pExecutor->Start(delay, Action0::Bind(lambda));
 }
 
 void PhysicalLayerMonitor::CancelOpenTimer()
@@ -165,4 +191,53 @@ void PhysicalLayerMonitor::CancelOpenTimer()
 	mpOpenTimer = nullptr;
 }
 
+void PhysicalLayerMonitor::BeginOpen()
+{
+	if (pAdmission)
+	{
+		if (pAdmission->Request(*this, retry.priority, admissionId))
+		{
+			admitted = true;
+			pPhys->BeginOpen();
+		}
+		else
+		{
+			awaitingAdmission = true;
+		}
+	}
+	else
+	{
+		pPhys->BeginOpen();
+	}
+}
+
+void PhysicalLayerMonitor::BeginClose()
+{
+	if (awaitingAdmission)
+	{
+		// the physical layer was never asked to open, so fail the open as it would have
+		awaitingAdmission = false;
+		pAdmission->Cancel(*this);
+		auto failure = [this]()
+		{
+			this->OnOpenFailure();
+		};
+		pExecutor->Post(Action0::Bind(failure));
+	}
+	else
+	{
+		pPhys->BeginClose();
+	}
+}
+
+void PhysicalLayerMonitor::OnOpenAdmitted(uint32_t id)
+{
+	if (awaitingAdmission && id == admissionId)
+	{
+		awaitingAdmission = false;
+		admitted = true;
+		pPhys->BeginOpen();
+	}
+}
+
 }
@@ -38,19 +38,22 @@ namespace asiodnp3
 {
 
 class IMonitorState;
+class OpenAdmissionScheduler;
 
 /** Manages the lifecycle of a physical layer
   */
 class PhysicalLayerMonitor : public openpal::IPhysicalLayerCallbacks
 {
 	friend class MonitorStateActions;
+	friend class OpenAdmissionScheduler;
 
 public:
 
 	PhysicalLayerMonitor(	openpal::LogRoot& root,
 	                        openpal::IExecutor& executor,
 	                        openpal::IPhysicalLayer*,
-	                        const opendnp3::ChannelRetry& retry);
+	                        const opendnp3::ChannelRetry& retry,
+	                        OpenAdmissionScheduler* pAdmission = nullptr);
 
 	/** Begin monitor execution, retry indefinitely on failure - Idempotent*/
 	void Start();
@@ -122,6 +125,15 @@ private:
 	/// Cancels the open timer
 	void CancelOpenTimer();
 
+	/// Opens the physical layer, or waits until the admission scheduler allows it
+	void BeginOpen();
+
+	/// Closes the physical layer, or abandons an open that is still waiting for admission
+	void BeginClose();
+
+	/// Posted by the admission scheduler when a waiting open may begin
+	void OnOpenAdmitted(uint32_t id);
+
 	/* --- Internal helper functions --- */
 
 	void DoFinalShutdown();
@@ -129,6 +141,11 @@ private:
 	opendnp3::ChannelRetry retry;
 
 	openpal::TimeDuration currentRetry;
+
+	OpenAdmissionScheduler* pAdmission;
+	bool awaitingAdmission;
+	bool admitted;
+	uint32_t admissionId;
 };
 
 }
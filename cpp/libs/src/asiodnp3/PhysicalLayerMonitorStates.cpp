@@ -50,12 +50,12 @@ void MonitorStateActions::CancelOpenTimer(PhysicalLayerMonitor& context)
 
 void MonitorStateActions::Close(PhysicalLayerMonitor& context)
 {
-	context.pPhys->BeginClose();
+	context.BeginClose();
 }
 
 void MonitorStateActions::Open(PhysicalLayerMonitor& context)
 {
-	context.pPhys->BeginOpen();
+	context.BeginOpen();
 }
 
 /* --- ExceptsOnLayerOpen --- */
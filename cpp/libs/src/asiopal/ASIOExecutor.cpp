@@ -31,9 +31,14 @@ using namespace std;
 namespace asiopal
 {
 
+// posts may pile up faster than they run, beyond this they come from the heap
+const uint32_t POST_ARENA_BLOCKS = 16;
+
 ASIOExecutor::ASIOExecutor(asio::io_service& service) :
 	strand(service),
-	pShutdownSignal(nullptr)
+	pShutdownSignal(nullptr),
+	numActiveTimers(0),
+	postArena(HandlerArena::Create(POST_ARENA_BLOCKS))
 {
 
 }
@@ -87,7 +92,7 @@ void ASIOExecutor::CheckForShutdown()
 {
 	if (pShutdownSignal)
 	{
-		if (activeTimers.empty())
+		if (numActiveTimers == 0)
 		{
 			// send the final shutdown signal via the strand to ensure all post events are flushed
 			auto finalpost = [this]()
@@ -132,24 +137,25 @@ void ASIOExecutor::Post(const openpal::Action0& runnable)
 	{
 		runnable.Apply();
 	};
-	strand.post(captured);
+	strand.post(postArena->Wrap(captured));
 }
 
 TimerASIO* ASIOExecutor::GetTimer()
 {
 	TimerASIO* pTimer;
-	if(idleTimers.size() == 0)
+	if(idleTimers.empty())
 	{
-		pTimer = new TimerASIO(strand);
+		pTimer = new TimerASIO(strand.get_io_service());
 		allTimers.push_back(pTimer);
+		idleTimers.reserve(allTimers.size());
 	}
 	else
 	{
-		pTimer = idleTimers.front();
-		idleTimers.pop_front();
+		pTimer = idleTimers.back();
+		idleTimers.pop_back();
 	}
 
-	activeTimers.insert(pTimer);
+	++numActiveTimers;
 	pTimer->canceled = false;
 	return pTimer;
 }
@@ -160,12 +166,12 @@ void ASIOExecutor::StartTimer(TimerASIO* pTimer, const openpal::Action0& runnabl
 	{
 		this->OnTimerCallback(ec, pTimer, runnable);
 	};
-	pTimer->timer.async_wait(strand.wrap(callback));
+	pTimer->timer.async_wait(pTimer->arena->Wrap(strand.wrap(callback)));
 }
 
 void ASIOExecutor::OnTimerCallback(const std::error_code& ec, TimerASIO* pTimer, const openpal::Action0& runnable)
 {
-	activeTimers.erase(pTimer);
+	--numActiveTimers;
 	idleTimers.push_back(pTimer);
 	if (!(ec || pTimer->canceled))
 	{
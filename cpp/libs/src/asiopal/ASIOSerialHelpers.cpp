@@ -27,6 +27,15 @@
 
 #include <asio.hpp>
 
+#ifndef ASIO_WINDOWS
+#include <termios.h>
+#include <sys/ioctl.h>
+#endif
+
+#ifdef __linux__
+#include <linux/serial.h>
+#endif
+
 using namespace asio;
 
 namespace asiopal
@@ -123,7 +132,101 @@ bool Configure(SerialSettings& settings, asio::serial_port& port, error_code& ec
 	port.set_option(ConvertStopBits(settings.stopBits), ec);
 	if (ec) return false;
 
+	// without batching the bytes left over from a read could stay in the driver below the minimum
+	const bool BATCHING = settings.interCharTimeout.GetMilliseconds() > 0;
+	if (!SetReadMinimum(BATCHING ? settings.readMinBytes : 1, port, ec)) return false;
+
+	if (settings.rs485)
+	{
+		if (!SetRS485(settings, port, ec)) return false;
+	}
+
+	return true;
+}
+
+bool SetReadMinimum(uint8_t minBytes, asio::serial_port& port, std::error_code& ec)
+{
+#ifndef ASIO_WINDOWS
+	termios ios;
+	if (::tcgetattr(port.native_handle(), &ios) < 0)
+	{
+		ec = std::error_code(errno, std::generic_category());
+		return false;
+	}
+
+	// with VTIME at zero the tty only reports itself readable once VMIN bytes are waiting
+	ios.c_cc[VMIN] = (minBytes > 0) ? minBytes : 1;
+	ios.c_cc[VTIME] = 0;
+
+	if (::tcsetattr(port.native_handle(), TCSANOW, &ios) < 0)
+	{
+		ec = std::error_code(errno, std::generic_category());
+		return false;
+	}
+#endif
+	return true;
+}
+
+bool SetRS485(const SerialSettings& settings, asio::serial_port& port, std::error_code& ec)
+{
+#ifdef __linux__
+	serial_rs485 rs485 = {};
+	rs485.flags = SER_RS485_ENABLED | SER_RS485_RTS_ON_SEND;
+	rs485.delay_rts_before_send = static_cast<uint32_t>(settings.rtsDelayBeforeSend.GetMilliseconds());
+	rs485.delay_rts_after_send = static_cast<uint32_t>(settings.rtsDelayAfterSend.GetMilliseconds());
+
+	if (::ioctl(port.native_handle(), TIOCSRS485, &rs485) < 0)
+	{
+		ec = std::error_code(errno, std::generic_category());
+		return false;
+	}
+
+	return true;
+#else
+	ec = std::make_error_code(std::errc::not_supported);
+	return false;
+#endif
+}
+
+bool SetLowLatency(asio::serial_port& port, std::error_code& ec)
+{
+#ifdef __linux__
+	serial_struct serial;
+	if (::ioctl(port.native_handle(), TIOCGSERIAL, &serial) < 0)
+	{
+		ec = std::error_code(errno, std::generic_category());
+		return false;
+	}
+
+	serial.flags |= ASYNC_LOW_LATENCY;
+
+	if (::ioctl(port.native_handle(), TIOCSSERIAL, &serial) < 0)
+	{
+		ec = std::error_code(errno, std::generic_category());
+		return false;
+	}
+
 	return true;
+#else
+	ec = std::make_error_code(std::errc::not_supported);
+	return false;
+#endif
+}
+
+uint32_t BytesAvailable(asio::serial_port& port, std::error_code& ec)
+{
+#ifndef ASIO_WINDOWS
+	int available = 0;
+	if (::ioctl(port.native_handle(), FIONREAD, &available) < 0)
+	{
+		ec = std::error_code(errno, std::generic_category());
+		return 0;
+	}
+	return static_cast<uint32_t>(available);
+#else
+	ec = std::make_error_code(std::errc::not_supported);
+	return 0;
+#endif
 }
 
 }
@@ -0,0 +1,574 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include "asiopal/DatagramSocket.h"
+
+#include "asiopal/PhysicalLayerUDP.h"
+
+#include <asio.hpp>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+using namespace openpal;
+
+namespace asiopal
+{
+
+struct DatagramSocket::Batch
+{
+	Batch(uint32_t maxBatch, uint32_t maxDatagramSize) :
+		maxDatagramSize(maxDatagramSize),
+		buffer(maxBatch * maxDatagramSize),
+		senders(maxBatch),
+		sizes(maxBatch)
+#ifdef __linux__
+		, headers(maxBatch),
+		vectors(maxBatch)
+#endif
+	{}
+
+	uint8_t* Datagram(uint32_t i)
+	{
+		return buffer.data() + i * maxDatagramSize;
+	}
+
+	const uint32_t maxDatagramSize;
+	std::vector<uint8_t> buffer;
+	std::vector<asio::ip::udp::endpoint> senders;
+	std::vector<uint32_t> sizes;
+
+#ifdef __linux__
+	std::vector<mmsghdr> headers;
+	std::vector<iovec> vectors;
+#endif
+};
+
+DatagramSocket::DatagramSocket(asio::io_service& service, const std::string& address, uint16_t port, const UDPSettings& settings) :
+	address(address),
+	port(port),
+	settings(settings),
+	service(service),
+	socket(service),
+	generation(0),
+	isFlushPosted(false),
+	isWaitingWritable(false)
+{
+
+}
+
+DatagramSocket::~DatagramSocket()
+{
+
+}
+
+std::error_code DatagramSocket::Attach(PhysicalLayerUDP* pLayer, const asio::ip::udp::endpoint& remote)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (sessions.count(remote))
+	{
+		return std::make_error_code(std::errc::address_in_use);
+	}
+
+	if (!socket.is_open())
+	{
+		auto ec = this->Bind();
+		if (ec)
+		{
+			return ec;
+		}
+	}
+
+	sessions[remote].pLayer = pLayer;
+	return std::error_code();
+}
+
+void DatagramSocket::Detach(PhysicalLayerUDP* pLayer, const asio::ip::udp::endpoint& remote)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto iter = sessions.find(remote);
+	if (iter == sessions.end() || iter->second.pLayer != pLayer)
+	{
+		return;
+	}
+
+	auto& session = iter->second;
+
+	if (session.pRead)
+	{
+		auto callback = [pLayer]()
+		{
+			pLayer->OnReadCallback(asio::error::operation_aborted, nullptr, 0);
+		};
+		pLayer->executor.PostLambda(callback);
+	}
+
+	if (session.isWriting)
+	{
+		transmitQueue.erase(std::remove(transmitQueue.begin(), transmitQueue.end(), remote), transmitQueue.end());
+		this->CompleteWrite(session, asio::error::operation_aborted);
+	}
+
+	sessions.erase(iter);
+
+	if (sessions.empty())
+	{
+		this->Close();
+	}
+}
+
+void DatagramSocket::Read(const asio::ip::udp::endpoint& remote, WSlice& buffer)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto iter = sessions.find(remote);
+	if (iter == sessions.end())
+	{
+		return;
+	}
+
+	auto& session = iter->second;
+	session.pRead = buffer;
+	session.readSize = buffer.Size();
+
+	if (!session.queued.empty())
+	{
+		this->CompleteRead(session);
+	}
+}
+
+void DatagramSocket::Write(const asio::ip::udp::endpoint& remote, const RSlice& buffer)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto iter = sessions.find(remote);
+	if (iter == sessions.end())
+	{
+		return;
+	}
+
+	iter->second.isWriting = true;
+	iter->second.write = buffer;
+	transmitQueue.push_back(remote);
+
+	// the writes of every session that writes before the flush runs go out together
+	if (!(isFlushPosted || isWaitingWritable))
+	{
+		isFlushPosted = true;
+		this->StartFlush();
+	}
+}
+
+DatagramStatistics DatagramSocket::GetStatistics()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return statistics;
+}
+
+uint16_t DatagramSocket::GetLocalPort()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	std::error_code ec;
+	return socket.is_open() ? socket.local_endpoint(ec).port() : 0;
+}
+
+std::error_code DatagramSocket::Bind()
+{
+	std::error_code ec;
+	auto localAddress = asio::ip::address::from_string(address, ec);
+	if (ec)
+	{
+		return ec;
+	}
+
+	asio::ip::udp::endpoint local(localAddress, port);
+
+	socket.open(local.protocol(), ec);
+	if (ec)
+	{
+		return ec;
+	}
+
+	// batches are drained until the socket would block
+	socket.non_blocking(true, ec);
+
+	if (!ec && settings.receiveBufferSize > 0)
+	{
+		socket.set_option(asio::socket_base::receive_buffer_size(settings.receiveBufferSize), ec);
+	}
+
+	if (!ec && settings.sendBufferSize > 0)
+	{
+		socket.set_option(asio::socket_base::send_buffer_size(settings.sendBufferSize), ec);
+	}
+
+	if (!ec)
+	{
+		socket.bind(local, ec);
+	}
+
+	if (ec)
+	{
+		std::error_code ec2;
+		socket.close(ec2);
+		return ec;
+	}
+
+	if (!batch)
+	{
+		batch.reset(new Batch(std::max<uint32_t>(settings.maxBatch, 1), settings.maxDatagramSize));
+	}
+
+	++generation;
+	this->StartReceive();
+	return ec;
+}
+
+void DatagramSocket::Close()
+{
+	std::error_code ec;
+	socket.close(ec);
+	++generation;
+	isWaitingWritable = false;
+}
+
+void DatagramSocket::StartReceive()
+{
+	auto self = shared_from_this();
+	auto gen = generation;
+	socket.async_wait(asio::ip::udp::socket::wait_read, [self, gen](const std::error_code & ec)
+	{
+		self->OnReadable(ec, gen);
+	});
+}
+
+void DatagramSocket::StartFlush()
+{
+	auto self = shared_from_this();
+	service.post([self]()
+	{
+		self->Flush();
+	});
+}
+
+void DatagramSocket::OnReadable(const std::error_code& ec, uint32_t gen)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (ec || gen != generation)
+	{
+		return;
+	}
+
+	std::error_code rec;
+	auto count = this->ReceiveBatch(rec);
+
+	if (count > 0)
+	{
+		++statistics.numReceiveCalls;
+		statistics.numRx += count;
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			this->Route(batch->senders[i], batch->Datagram(i), batch->sizes[i]);
+		}
+	}
+
+	if (count == settings.maxBatch)
+	{
+		// there may be more waiting, but let the other handlers of the io_service run first
+		auto self = shared_from_this();
+		service.post([self, gen]()
+		{
+			self->OnReadable(std::error_code(), gen);
+		});
+	}
+	else
+	{
+		// would block, or an error of a single datagram such as an ICMP report, keep receiving either way
+		this->StartReceive();
+	}
+}
+
+void DatagramSocket::OnWritable(const std::error_code& ec, uint32_t gen)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (ec || gen != generation)
+		{
+			return;
+		}
+		isWaitingWritable = false;
+	}
+
+	this->Flush();
+}
+
+void DatagramSocket::Flush()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	isFlushPosted = false;
+
+	if (isWaitingWritable)
+	{
+		return;
+	}
+
+	while (!transmitQueue.empty())
+	{
+		auto count = std::min<uint32_t>(static_cast<uint32_t>(transmitQueue.size()), std::max<uint32_t>(settings.maxBatch, 1));
+
+		std::error_code ec;
+		auto sent = this->SendBatch(count, ec);
+
+		if (sent > 0)
+		{
+			++statistics.numSendCalls;
+			statistics.numTx += sent;
+		}
+
+		for (uint32_t i = 0; i < sent; ++i)
+		{
+			this->CompleteWrite(sessions[transmitQueue.front()], std::error_code());
+			transmitQueue.pop_front();
+		}
+
+		if (ec)
+		{
+			if (ec == asio::error::would_block || ec == asio::error::try_again)
+			{
+				isWaitingWritable = true;
+				auto self = shared_from_this();
+				auto gen = generation;
+				socket.async_wait(asio::ip::udp::socket::wait_write, [self, gen](const std::error_code & ec)
+				{
+					self->OnWritable(ec, gen);
+				});
+				return;
+			}
+
+			// the datagram at the front can't be sent at all, its session handles the error
+			this->CompleteWrite(sessions[transmitQueue.front()], ec);
+			transmitQueue.pop_front();
+		}
+	}
+}
+
+void DatagramSocket::Route(const asio::ip::udp::endpoint& sender, const uint8_t* pData, uint32_t size)
+{
+	auto iter = sessions.find(sender);
+	if (iter == sessions.end())
+	{
+		++statistics.numUnrouted;
+		return;
+	}
+
+	auto& session = iter->second;
+
+	if (session.pRead && session.queued.empty())
+	{
+		// the common case, copy straight from the batch into the read
+		auto num = std::min(size, session.readSize);
+		memcpy(session.pRead, pData, num);
+		if (num < size)
+		{
+			session.queued.push_back(std::vector<uint8_t>(pData + num, pData + size));
+		}
+		this->PostRead(session, num);
+		return;
+	}
+
+	if (session.queued.size() >= settings.maxQueuedDatagrams)
+	{
+		++statistics.numDropped;
+		return;
+	}
+
+	session.queued.push_back(std::vector<uint8_t>(pData, pData + size));
+}
+
+void DatagramSocket::CompleteRead(Session& session)
+{
+	auto& datagram = session.queued.front();
+	auto num = std::min<uint32_t>(static_cast<uint32_t>(datagram.size()) - session.queuedOffset, session.readSize);
+	memcpy(session.pRead, datagram.data() + session.queuedOffset, num);
+
+	// a datagram larger than the read is returned over several reads
+	session.queuedOffset += num;
+	if (session.queuedOffset == datagram.size())
+	{
+		session.queued.pop_front();
+		session.queuedOffset = 0;
+	}
+
+	this->PostRead(session, num);
+}
+
+void DatagramSocket::PostRead(Session& session, uint32_t num)
+{
+	auto pLayer = session.pLayer;
+	auto pBuffer = session.pRead;
+	session.pRead = nullptr;
+
+	auto callback = [pLayer, pBuffer, num]()
+	{
+		pLayer->OnReadCallback(std::error_code(), pBuffer, num);
+	};
+	pLayer->executor.PostLambda(callback);
+}
+
+void DatagramSocket::CompleteWrite(Session& session, const std::error_code& ec)
+{
+	session.isWriting = false;
+
+	auto pLayer = session.pLayer;
+	auto numWritten = ec ? 0 : session.write.Size();
+
+	auto callback = [pLayer, ec, numWritten]()
+	{
+		pLayer->OnWriteCallback(ec, numWritten);
+	};
+	pLayer->executor.PostLambda(callback);
+}
+
+#ifdef __linux__
+
+uint32_t DatagramSocket::ReceiveBatch(std::error_code& ec)
+{
+	const auto count = static_cast<uint32_t>(batch->headers.size());
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		auto& header = batch->headers[i];
+		memset(&header, 0, sizeof(header));
+		batch->vectors[i].iov_base = batch->Datagram(i);
+		batch->vectors[i].iov_len = batch->maxDatagramSize;
+		header.msg_hdr.msg_iov = &batch->vectors[i];
+		header.msg_hdr.msg_iovlen = 1;
+		header.msg_hdr.msg_name = batch->senders[i].data();
+		header.msg_hdr.msg_namelen = static_cast<socklen_t>(batch->senders[i].capacity());
+	}
+
+	auto result = recvmmsg(socket.native_handle(), batch->headers.data(), count, MSG_DONTWAIT, nullptr);
+	if (result < 0)
+	{
+		ec = std::error_code(errno, std::system_category());
+		return 0;
+	}
+
+	uint32_t num = 0;
+	for (uint32_t i = 0; i < static_cast<uint32_t>(result); ++i)
+	{
+		auto& header = batch->headers[i];
+		if (header.msg_hdr.msg_flags & MSG_TRUNC)
+		{
+			++statistics.numTruncated;
+			continue;
+		}
+
+		// keep the good datagrams contiguous at the front of the batch
+		if (num != i)
+		{
+			memcpy(batch->Datagram(num), batch->Datagram(i), header.msg_len);
+		}
+		batch->senders[num] = batch->senders[i];
+		batch->senders[num].resize(header.msg_hdr.msg_namelen);
+		batch->sizes[num] = header.msg_len;
+		++num;
+	}
+
+	return num;
+}
+
+uint32_t DatagramSocket::SendBatch(uint32_t count, std::error_code& ec)
+{
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		auto& remote = transmitQueue[i];
+		auto& session = sessions[remote];
+		auto& header = batch->headers[i];
+		memset(&header, 0, sizeof(header));
+		batch->vectors[i].iov_base = const_cast<uint8_t*>(static_cast<const uint8_t*>(session.write));
+		batch->vectors[i].iov_len = session.write.Size();
+		header.msg_hdr.msg_iov = &batch->vectors[i];
+		header.msg_hdr.msg_iovlen = 1;
+		header.msg_hdr.msg_name = const_cast<sockaddr*>(remote.data());
+		header.msg_hdr.msg_namelen = static_cast<socklen_t>(remote.size());
+	}
+
+	auto result = sendmmsg(socket.native_handle(), batch->headers.data(), count, MSG_DONTWAIT);
+	if (result < 0)
+	{
+		ec = std::error_code(errno, std::system_category());
+		return 0;
+	}
+
+	return static_cast<uint32_t>(result);
+}
+
+#else
+
+uint32_t DatagramSocket::ReceiveBatch(std::error_code& ec)
+{
+	const auto count = static_cast<uint32_t>(batch->senders.size());
+
+	uint32_t num = 0;
+	while (num < count)
+	{
+		auto size = socket.receive_from(asio::buffer(batch->Datagram(num), batch->maxDatagramSize), batch->senders[num], 0, ec);
+		if (ec)
+		{
+			break;
+		}
+		batch->sizes[num] = static_cast<uint32_t>(size);
+		++num;
+	}
+
+	return num;
+}
+
+uint32_t DatagramSocket::SendBatch(uint32_t count, std::error_code& ec)
+{
+	uint32_t num = 0;
+	while (num < count)
+	{
+		auto& remote = transmitQueue[num];
+		auto& write = sessions[remote].write;
+		socket.send_to(asio::buffer(static_cast<const uint8_t*>(write), write.Size()), remote, 0, ec);
+		if (ec)
+		{
+			break;
+		}
+		++num;
+	}
+
+	return num;
+}
+
+#endif
+
+}
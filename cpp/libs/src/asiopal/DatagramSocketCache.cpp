@@ -0,0 +1,100 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include "asiopal/DatagramSocketCache.h"
+
+#include <sstream>
+#include <vector>
+
+namespace asiopal
+{
+
+std::shared_ptr<DatagramSocket> DatagramSocketCache::Get(asio::io_service& service, const std::string& address, uint16_t port, const UDPSettings& settings)
+{
+	std::ostringstream oss;
+	oss << address << ':' << port;
+	const auto key = oss.str();
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto existing = sockets[key].lock();
+	if (existing)
+	{
+		return existing;
+	}
+
+	// forget the sockets whose channels are all gone
+	for (auto i = sockets.begin(); i != sockets.end();)
+	{
+		if (i->second.expired() && i->first != key)
+		{
+			i = sockets.erase(i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	auto socket = std::make_shared<DatagramSocket>(service, address, port, settings);
+	sockets[key] = socket;
+	return socket;
+}
+
+uint32_t DatagramSocketCache::NumSockets()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	uint32_t count = 0;
+	for (auto& pair : sockets)
+	{
+		if (!pair.second.expired())
+		{
+			++count;
+		}
+	}
+	return count;
+}
+
+DatagramStatistics DatagramSocketCache::GetStatistics()
+{
+	std::vector<std::shared_ptr<DatagramSocket>> active;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (auto& pair : sockets)
+		{
+			auto socket = pair.second.lock();
+			if (socket)
+			{
+				active.push_back(socket);
+			}
+		}
+	}
+
+	DatagramStatistics total;
+	for (auto& socket : active)
+	{
+		total += socket->GetStatistics();
+	}
+	return total;
+}
+
+}
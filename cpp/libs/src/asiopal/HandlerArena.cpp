@@ -0,0 +1,82 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include "asiopal/HandlerArena.h"
+
+namespace asiopal
+{
+
+HandlerArena::HandlerArena(uint32_t numBlocks_) :
+	numBlocks(numBlocks_),
+	blocks(new Block[numBlocks_]),
+	pFree(nullptr)
+{
+	for (uint32_t i = 0; i < numBlocks; ++i)
+	{
+		blocks[i].pNext = pFree;
+		pFree = &blocks[i];
+	}
+}
+
+void* HandlerArena::Allocate(std::size_t size)
+{
+	Header* pHeader = nullptr;
+
+	if (size <= BLOCK_SIZE)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (pFree)
+		{
+			pHeader = reinterpret_cast<Header*>(pFree);
+			pFree = pFree->pNext;
+			pHeader->pOwner = this;
+		}
+	}
+
+	if (!pHeader)
+	{
+		pHeader = static_cast<Header*>(::operator new(sizeof(Header) + size));
+		pHeader->pOwner = nullptr;
+	}
+
+	return pHeader + 1;
+}
+
+void HandlerArena::Deallocate(void* pointer)
+{
+	auto pHeader = static_cast<Header*>(pointer) - 1;
+	if (pHeader->pOwner)
+	{
+		pHeader->pOwner->Release(reinterpret_cast<Block*>(pHeader));
+	}
+	else
+	{
+		::operator delete(pHeader);
+	}
+}
+
+void HandlerArena::Release(Block* pBlock)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	pBlock->pNext = pFree;
+	pFree = pBlock;
+}
+
+}
@@ -23,10 +23,19 @@
 #include <openpal/logging/LogMacros.h>
 #include <openpal/logging/LogLevels.h>
 
+#include <algorithm>
 #include <chrono>
 #include <sstream>
 
 #include <asiopal/SteadyClock.h>
+#include <asiopal/SingleThreadService.h>
+
+#if defined(WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 using namespace std;
 using namespace std::chrono;
@@ -40,28 +49,53 @@ IOServiceThreadPool::IOServiceThreadPool(
     uint32_t levels,
     uint32_t aConcurrency,
     std::function<void()> onThreadStart_,
-    std::function<void()> onThreadExit_) :
+    std::function<void()> onThreadExit_,
+    const ThreadPoolSettings& settings) :
 	root(pHandler, "pool", levels),
 	logger(root.GetLogger()),
 	onThreadStart(onThreadStart_),
 	onThreadExit(onThreadExit_),
 	isShutdown(false),
-	ioservice(),
-	infiniteTimer(ioservice)
+	selector(settings.selector),
+	nextShard(0)
 {
 	if(aConcurrency == 0)
 	{
 		aConcurrency = 1;
 		SIMPLE_LOG_BLOCK(logger, logflags::WARN, "Concurrency was set to 0, defaulting to 1 thread");
 	}
-	infiniteTimer.expires_at(asiopal::asiopal_steady_clock::time_point::max());
-	infiniteTimer.async_wait([](const std::error_code&) {});
+
+	const uint32_t numShards = (settings.mode == ThreadPoolMode::SHARDED) ? aConcurrency : 1;
+	for (uint32_t i = 0; i < numShards; ++i)
+	{
+		shards.push_back(std::unique_ptr<Shard>(new Shard()));
+	}
+
 	for(uint32_t i = 0; i < aConcurrency; ++i)
 	{
-		threads.push_back(new thread(bind(&IOServiceThreadPool::Run, this)));
+		auto pThread = new thread(bind(&IOServiceThreadPool::Run, this, std::ref(*shards[i % numShards])));
+		if (settings.pinThreads)
+		{
+			this->PinToCore(*pThread, i);
+		}
+		threads.push_back(pThread);
+	}
+
+	if (settings.strandFree && (numShards == aConcurrency))
+	{
+		for (uint32_t i = 0; i < numShards; ++i)
+		{
+			SingleThreadService::Mark(shards[i]->ioservice, threads[i]->get_id());
+		}
 	}
 }
 
+IOServiceThreadPool::Shard::Shard() : ioservice(), infiniteTimer(ioservice)
+{
+	infiniteTimer.expires_at(asiopal::asiopal_steady_clock::time_point::max());
+	infiniteTimer.async_wait([](const std::error_code&) {});
+}
+
 IOServiceThreadPool::~IOServiceThreadPool()
 {
 	this->Shutdown();
@@ -76,7 +110,10 @@ void IOServiceThreadPool::Shutdown()
 	if(!isShutdown)
 	{
 		isShutdown = true;
-		infiniteTimer.cancel();
+		for (auto& shard : shards)
+		{
+			shard->infiniteTimer.cancel();
+		}
 		for (auto pThread : threads)
 		{
 			pThread->join();
@@ -86,14 +123,48 @@ void IOServiceThreadPool::Shutdown()
 
 asio::io_service& IOServiceThreadPool::GetIOService()
 {
-	return ioservice;
+	return shards[0]->ioservice;
+}
+
+asio::io_service& IOServiceThreadPool::GetIOService(const std::string& id)
+{
+	const uint32_t index = selector ? selector(id) : nextShard++;
+	return shards[index % shards.size()]->ioservice;
+}
+
+uint32_t IOServiceThreadPool::NumShards() const
+{
+	return static_cast<uint32_t>(shards.size());
 }
 
-void IOServiceThreadPool::Run()
+void IOServiceThreadPool::Run(Shard& shard)
 {
 	onThreadStart();
-	ioservice.run();
+	shard.ioservice.run();
 	onThreadExit();
 }
 
+void IOServiceThreadPool::PinToCore(std::thread& thread, uint32_t index)
+{
+	const auto cores = std::max(1u, std::thread::hardware_concurrency());
+	const auto core = index % cores;
+
+#if defined(WIN32)
+	if (SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << core) == 0)
+	{
+		FORMAT_LOG_BLOCK(logger, logflags::WARN, "Unable to pin thread %u to core %u", index, core);
+	}
+#elif defined(__linux__)
+	cpu_set_t cpuset;
+	CPU_ZERO(&cpuset);
+	CPU_SET(core, &cpuset);
+	if (pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuset) != 0)
+	{
+		FORMAT_LOG_BLOCK(logger, logflags::WARN, "Unable to pin thread %u to core %u", index, core);
+	}
+#else
+	SIMPLE_LOG_BLOCK(logger, logflags::WARN, "Thread pinning is not supported on this platform");
+#endif
+}
+
 }
@@ -0,0 +1,941 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+
+#include "asiopal/IOUring.h"
+
+#include "asiopal/PhysicalLayerBaseTCP.h"
+
+#include <asio.hpp>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#ifdef IORING_RECV_MULTISHOT
+#define ASIOPAL_IO_URING
+#endif
+#endif
+#endif
+
+#ifdef ASIOPAL_IO_URING
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+#endif
+
+namespace asiopal
+{
+
+#ifdef ASIOPAL_IO_URING
+
+namespace
+{
+
+// the low bits of the user data of an entry tell what the rest of it points to
+const uint64_t TAG_RECV = 0;
+const uint64_t TAG_SEND = 1;
+const uint64_t TAG_IGNORE = 2;
+const uint64_t TAG_MASK = 3;
+
+const uint16_t BUFFER_GROUP = 0;
+
+int Setup(uint32_t entries, io_uring_params& params)
+{
+	return static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int Enter(int fd, uint32_t toSubmit)
+{
+	return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, 0, 0, nullptr, 0));
+}
+
+int Register(int fd, uint32_t opcode, void* arg, uint32_t count)
+{
+	return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+std::error_code LastError()
+{
+	return std::error_code(errno, std::system_category());
+}
+
+}
+
+class IOUring::Socket
+{
+public:
+
+	/// Part of a pool buffer that hasn't been read yet
+	struct Chunk
+	{
+		uint16_t bid;
+		uint32_t offset;
+		uint32_t size;
+	};
+
+	Socket(PhysicalLayerBaseTCP* pLayer_, int fd_) :
+		pLayer(pLayer_),
+		fd(fd_),
+		isDetached(false),
+		isRecvArmed(false),
+		isStarved(false),
+		isEof(false),
+		inflight(0),
+		pRead(nullptr),
+		readSize(0),
+		numToWrite(0),
+		numWritten(0)
+	{
+		memset(&msg, 0, sizeof(msg));
+	}
+
+	PhysicalLayerBaseTCP* const pLayer;
+	const int fd;
+
+	bool isDetached;
+	bool isRecvArmed;
+	bool isStarved;
+	bool isEof;
+	std::error_code recvError;
+
+	/// Entries the kernel may still complete, the socket is deleted once it is detached and this drops to 0
+	uint32_t inflight;
+
+	uint8_t* pRead;
+	uint32_t readSize;
+	std::deque<Chunk> received;
+
+	iovec iov[openpal::IPhysicalLayer::MAX_WRITE_BATCH];
+	msghdr msg;
+	uint32_t numToWrite;
+	uint32_t numWritten;
+};
+
+class IOUring::Impl final : public std::enable_shared_from_this<IOUring::Impl>, private openpal::Uncopyable
+{
+public:
+
+	Impl(asio::io_service& service, const IOUringSettings& settings);
+
+	~Impl();
+
+	std::error_code Init();
+
+	Socket* Attach(PhysicalLayerBaseTCP* pLayer, int fd);
+	void Detach(Socket* pSocket);
+	void Read(Socket* pSocket, openpal::WSlice& buffer);
+	void Write(Socket* pSocket, const openpal::RSlice* buffers, uint32_t count);
+	IOUringStatistics GetStatistics();
+	void Shutdown();
+
+private:
+
+	// everything below is called with the mutex held
+
+	io_uring_sqe* NextEntry();
+	void Submit();
+	void StartFlush();
+	void Flush();
+
+	void Drain();
+	void Reap();
+	bool IsCompletionPending() const;
+
+	void OnRecv(Socket& socket, int res, uint32_t flags);
+	void OnSend(Socket& socket, int res);
+
+	void ArmRecv(Socket& socket);
+	void SubmitSend(Socket& socket);
+	void Deliver(Socket& socket);
+	void CompleteWrite(Socket& socket, const std::error_code& ec);
+
+	void Recycle(uint16_t bid);
+	void PublishBuffers();
+
+	void Release(Socket* pSocket);
+
+	asio::io_service& service;
+	const IOUringSettings settings;
+
+	std::mutex mutex;
+	bool isShutdown;
+	bool isWaiting;
+	bool isFlushPosted;
+	bool useMultishot;
+	IOUringStatistics statistics;
+
+	int ringFd;
+	asio::posix::stream_descriptor descriptor;
+
+	void* pRings;
+	size_t ringsSize;
+	io_uring_sqe* sqes;
+	size_t sqesSize;
+
+	unsigned* sqHead;
+	unsigned* sqTail;
+	unsigned sqMask;
+	unsigned sqEntries;
+	unsigned sqLocalTail;
+	uint32_t numPending;
+
+	unsigned* cqHead;
+	unsigned* cqTail;
+	unsigned cqMask;
+	io_uring_cqe* cqes;
+
+	void* pBufferRing;
+	size_t bufferRingSize;
+	uint16_t bufferTail;
+	bool isBufferTailStale;
+	std::vector<uint8_t> pool;
+	std::vector<Socket*> starved;
+
+	/// Attached and detached sockets the kernel isn't done with yet
+	std::unordered_set<Socket*> sockets;
+};
+
+IOUring::Impl::Impl(asio::io_service& service_, const IOUringSettings& settings_) :
+	service(service_),
+	settings(settings_),
+	isShutdown(false),
+	isWaiting(false),
+	isFlushPosted(false),
+	useMultishot(true),
+	ringFd(-1),
+	descriptor(service_),
+	pRings(MAP_FAILED),
+	ringsSize(0),
+	sqes(nullptr),
+	sqesSize(0),
+	sqHead(nullptr),
+	sqTail(nullptr),
+	sqMask(0),
+	sqEntries(0),
+	sqLocalTail(0),
+	numPending(0),
+	cqHead(nullptr),
+	cqTail(nullptr),
+	cqMask(0),
+	cqes(nullptr),
+	pBufferRing(MAP_FAILED),
+	bufferRingSize(0),
+	bufferTail(0),
+	isBufferTailStale(false)
+{
+
+}
+
+IOUring::Impl::~Impl()
+{
+	for (auto pSocket : sockets)
+	{
+		delete pSocket;
+	}
+
+	std::error_code ec;
+	descriptor.close(ec);
+
+	if (pBufferRing != MAP_FAILED)
+	{
+		munmap(pBufferRing, bufferRingSize);
+	}
+	if (sqes)
+	{
+		munmap(sqes, sqesSize);
+	}
+	if (pRings != MAP_FAILED)
+	{
+		munmap(pRings, ringsSize);
+	}
+	if (ringFd >= 0)
+	{
+		close(ringFd);
+	}
+}
+
+std::error_code IOUring::Impl::Init()
+{
+	const auto count = settings.bufferCount;
+	if (count == 0 || count > 32768 || (count & (count - 1)) != 0 || settings.bufferSize == 0 || settings.entries == 0)
+	{
+		return std::make_error_code(std::errc::invalid_argument);
+	}
+
+	io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL;
+	params.cq_entries = 4 * settings.entries;
+
+	ringFd = Setup(settings.entries, params);
+	if (ringFd < 0)
+	{
+		return LastError();
+	}
+
+	// the rings are mapped once and the kernel never drops completions, older kernels lack the receive anyway
+	if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_NODROP))
+	{
+		return std::make_error_code(std::errc::operation_not_supported);
+	}
+
+	ringsSize = std::max<size_t>(params.sq_off.array + params.sq_entries * sizeof(unsigned), params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+	pRings = mmap(nullptr, ringsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+	if (pRings == MAP_FAILED)
+	{
+		return LastError();
+	}
+
+	sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+	auto pSqes = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+	if (pSqes == MAP_FAILED)
+	{
+		return LastError();
+	}
+	sqes = static_cast<io_uring_sqe*>(pSqes);
+
+	auto pBase = static_cast<uint8_t*>(pRings);
+	sqHead = reinterpret_cast<unsigned*>(pBase + params.sq_off.head);
+	sqTail = reinterpret_cast<unsigned*>(pBase + params.sq_off.tail);
+	sqMask = *reinterpret_cast<unsigned*>(pBase + params.sq_off.ring_mask);
+	sqEntries = params.sq_entries;
+	cqHead = reinterpret_cast<unsigned*>(pBase + params.cq_off.head);
+	cqTail = reinterpret_cast<unsigned*>(pBase + params.cq_off.tail);
+	cqMask = *reinterpret_cast<unsigned*>(pBase + params.cq_off.ring_mask);
+	cqes = reinterpret_cast<io_uring_cqe*>(pBase + params.cq_off.cqes);
+
+	// entries are always submitted in order, so slot i of the array is always entry i
+	auto pArray = reinterpret_cast<unsigned*>(pBase + params.sq_off.array);
+	for (unsigned i = 0; i < sqEntries; ++i)
+	{
+		pArray[i] = i;
+	}
+	sqLocalTail = *sqTail;
+
+	// the receive buffers are handed to the kernel through a ring of its own
+	bufferRingSize = count * sizeof(io_uring_buf);
+	pBufferRing = mmap(nullptr, bufferRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (pBufferRing == MAP_FAILED)
+	{
+		return LastError();
+	}
+
+	io_uring_buf_reg reg;
+	memset(&reg, 0, sizeof(reg));
+	reg.ring_addr = reinterpret_cast<uint64_t>(pBufferRing);
+	reg.ring_entries = count;
+	reg.bgid = BUFFER_GROUP;
+	if (Register(ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+	{
+		return LastError();
+	}
+
+	pool.resize(static_cast<size_t>(count) * settings.bufferSize);
+	for (uint32_t bid = 0; bid < count; ++bid)
+	{
+		this->Recycle(static_cast<uint16_t>(bid));
+	}
+	this->PublishBuffers();
+
+	std::error_code ec;
+	descriptor.assign(dup(ringFd), ec);
+	if (ec)
+	{
+		return ec;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	this->Drain();
+	return std::error_code();
+}
+
+IOUring::Socket* IOUring::Impl::Attach(PhysicalLayerBaseTCP* pLayer, int fd)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto pSocket = new Socket(pLayer, fd);
+	sockets.insert(pSocket);
+	this->ArmRecv(*pSocket);
+	return pSocket;
+}
+
+void IOUring::Impl::Detach(Socket* pSocket)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto& socket = *pSocket;
+	socket.isDetached = true;
+
+	if (socket.pRead)
+	{
+		socket.pRead = nullptr;
+		auto pLayer = socket.pLayer;
+		auto callback = [pLayer]()
+		{
+			pLayer->OnReadCallback(asio::error::operation_aborted, nullptr, 0);
+		};
+		pLayer->executor.PostLambda(callback);
+	}
+
+	starved.erase(std::remove(starved.begin(), starved.end(), pSocket), starved.end());
+
+	for (auto& chunk : socket.received)
+	{
+		this->Recycle(chunk.bid);
+	}
+	socket.received.clear();
+	this->PublishBuffers();
+
+	if (socket.isRecvArmed)
+	{
+		auto sqe = this->NextEntry();
+		if (sqe)
+		{
+			sqe->opcode = IORING_OP_ASYNC_CANCEL;
+			sqe->fd = -1;
+			sqe->addr = reinterpret_cast<uint64_t>(pSocket) | TAG_RECV;
+			sqe->user_data = TAG_IGNORE;
+		}
+	}
+
+	// the caller closes the descriptor next, the kernel must have taken every entry that names it by then
+	this->Submit();
+
+	this->Release(pSocket);
+}
+
+void IOUring::Impl::Read(Socket* pSocket, openpal::WSlice& buffer)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto& socket = *pSocket;
+	socket.pRead = buffer;
+	socket.readSize = buffer.Size();
+
+	if (!socket.received.empty() || socket.isEof || socket.recvError)
+	{
+		this->Deliver(socket);
+		this->PublishBuffers();
+	}
+}
+
+void IOUring::Impl::Write(Socket* pSocket, const openpal::RSlice* buffers, uint32_t count)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto& socket = *pSocket;
+	socket.numToWrite = 0;
+	socket.numWritten = 0;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		socket.iov[i].iov_base = const_cast<uint8_t*>(static_cast<const uint8_t*>(buffers[i]));
+		socket.iov[i].iov_len = buffers[i].Size();
+		socket.numToWrite += buffers[i].Size();
+	}
+	socket.msg.msg_iov = socket.iov;
+	socket.msg.msg_iovlen = count;
+
+	this->SubmitSend(socket);
+}
+
+IOUringStatistics IOUring::Impl::GetStatistics()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return statistics;
+}
+
+void IOUring::Impl::Shutdown()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	isShutdown = true;
+	std::error_code ec;
+	descriptor.cancel(ec);
+}
+
+io_uring_sqe* IOUring::Impl::NextEntry()
+{
+	if (sqLocalTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries)
+	{
+		this->Submit();
+		if (sqLocalTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries)
+		{
+			return nullptr;
+		}
+	}
+
+	auto sqe = &sqes[sqLocalTail & sqMask];
+	memset(sqe, 0, sizeof(io_uring_sqe));
+	++sqLocalTail;
+	++numPending;
+	return sqe;
+}
+
+void IOUring::Impl::Submit()
+{
+	if (numPending == 0)
+	{
+		return;
+	}
+
+	__atomic_store_n(sqTail, sqLocalTail, __ATOMIC_RELEASE);
+
+	auto result = Enter(ringFd, numPending);
+	++statistics.numEnter;
+	if (result > 0)
+	{
+		statistics.numSubmitted += result;
+		numPending -= std::min<uint32_t>(numPending, result);
+	}
+
+	// the kernel is short of memory or completion space, try again on the next pass
+	if (numPending > 0)
+	{
+		this->StartFlush();
+	}
+}
+
+void IOUring::Impl::StartFlush()
+{
+	if (isFlushPosted)
+	{
+		return;
+	}
+
+	isFlushPosted = true;
+	auto self = shared_from_this();
+	service.post([self]()
+	{
+		self->Flush();
+	});
+}
+
+void IOUring::Impl::Flush()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	isFlushPosted = false;
+	this->Submit();
+}
+
+void IOUring::Impl::Drain()
+{
+	this->Reap();
+	this->PublishBuffers();
+	this->Submit();
+
+	if (isShutdown)
+	{
+		return;
+	}
+
+	auto self = shared_from_this();
+
+	if (!isWaiting)
+	{
+		isWaiting = true;
+		descriptor.async_wait(asio::posix::descriptor_base::wait_read, [self](const std::error_code & ec)
+		{
+			std::lock_guard<std::mutex> lock(self->mutex);
+			self->isWaiting = false;
+			if (!ec)
+			{
+				++self->statistics.numWakeups;
+				self->Drain();
+			}
+		});
+	}
+
+	// the reactor only reports new readiness, completions that arrived before the wait was queued would go unnoticed
+	if (this->IsCompletionPending())
+	{
+		service.post([self]()
+		{
+			std::lock_guard<std::mutex> lock(self->mutex);
+			if (!self->isShutdown)
+			{
+				self->Drain();
+			}
+		});
+	}
+}
+
+bool IOUring::Impl::IsCompletionPending() const
+{
+	return __atomic_load_n(cqTail, __ATOMIC_ACQUIRE) != *cqHead;
+}
+
+void IOUring::Impl::Reap()
+{
+	auto head = *cqHead;
+
+	while (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE))
+	{
+		const auto cqe = cqes[head & cqMask];
+		__atomic_store_n(cqHead, ++head, __ATOMIC_RELEASE);
+		++statistics.numCompletions;
+
+		auto pSocket = reinterpret_cast<Socket*>(cqe.user_data & ~TAG_MASK);
+		switch (cqe.user_data & TAG_MASK)
+		{
+		case(TAG_RECV):
+			this->OnRecv(*pSocket, cqe.res, cqe.flags);
+			break;
+		case(TAG_SEND):
+			this->OnSend(*pSocket, cqe.res);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+void IOUring::Impl::OnRecv(Socket& socket, int res, uint32_t flags)
+{
+	if (res > 0 && (flags & IORING_CQE_F_BUFFER))
+	{
+		const auto bid = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+		if (socket.isDetached)
+		{
+			this->Recycle(bid);
+		}
+		else
+		{
+			socket.received.push_back({ bid, 0, static_cast<uint32_t>(res) });
+		}
+	}
+	else if (res == 0)
+	{
+		socket.isEof = true;
+	}
+	else if (res == -ENOBUFS)
+	{
+		++statistics.numBufferShortages;
+		if (!socket.isDetached)
+		{
+			socket.isStarved = true;
+			starved.push_back(&socket);
+		}
+	}
+	else if (res == -EINVAL && useMultishot)
+	{
+		// the kernel predates multishot receives, re-arm one at a time from now on
+		useMultishot = false;
+	}
+	else if (res < 0 && res != -ECANCELED)
+	{
+		socket.recvError = std::error_code(-res, std::system_category());
+	}
+
+	if (!(flags & IORING_CQE_F_MORE))
+	{
+		socket.isRecvArmed = false;
+		--socket.inflight;
+
+		if (socket.isDetached)
+		{
+			this->Release(&socket);
+			return;
+		}
+
+		if (!(socket.isEof || socket.recvError || socket.isStarved))
+		{
+			this->ArmRecv(socket);
+		}
+	}
+
+	if (socket.pRead && (!socket.received.empty() || socket.isEof || socket.recvError))
+	{
+		this->Deliver(socket);
+	}
+}
+
+void IOUring::Impl::OnSend(Socket& socket, int res)
+{
+	--socket.inflight;
+
+	if (socket.isDetached)
+	{
+		this->CompleteWrite(socket, asio::error::operation_aborted);
+		this->Release(&socket);
+		return;
+	}
+
+	if (res <= 0)
+	{
+		this->CompleteWrite(socket, res < 0 ? std::error_code(-res, std::system_category()) : asio::error::broken_pipe);
+		return;
+	}
+
+	socket.numWritten += res;
+	if (socket.numWritten == socket.numToWrite)
+	{
+		this->CompleteWrite(socket, std::error_code());
+		return;
+	}
+
+	// a partial send, skip what went out and send the rest
+	auto remaining = static_cast<size_t>(res);
+	while (remaining > 0)
+	{
+		auto& iov = socket.msg.msg_iov[0];
+		if (remaining >= iov.iov_len)
+		{
+			remaining -= iov.iov_len;
+			++socket.msg.msg_iov;
+			--socket.msg.msg_iovlen;
+		}
+		else
+		{
+			iov.iov_base = static_cast<uint8_t*>(iov.iov_base) + remaining;
+			iov.iov_len -= remaining;
+			remaining = 0;
+		}
+	}
+
+	this->SubmitSend(socket);
+}
+
+void IOUring::Impl::ArmRecv(Socket& socket)
+{
+	auto sqe = this->NextEntry();
+	if (!sqe)
+	{
+		// retried when buffers are next recycled, there is little else to wait for
+		socket.isStarved = true;
+		starved.push_back(&socket);
+		return;
+	}
+
+	sqe->opcode = IORING_OP_RECV;
+	sqe->fd = socket.fd;
+	sqe->flags = IOSQE_BUFFER_SELECT;
+	sqe->buf_group = BUFFER_GROUP;
+	sqe->ioprio = useMultishot ? IORING_RECV_MULTISHOT : 0;
+	sqe->len = useMultishot ? 0 : settings.bufferSize;
+	sqe->user_data = reinterpret_cast<uint64_t>(&socket) | TAG_RECV;
+
+	socket.isRecvArmed = true;
+	++socket.inflight;
+	this->StartFlush();
+}
+
+void IOUring::Impl::SubmitSend(Socket& socket)
+{
+	auto sqe = this->NextEntry();
+	if (!sqe)
+	{
+		this->CompleteWrite(socket, asio::error::no_buffer_space);
+		return;
+	}
+
+	sqe->opcode = IORING_OP_SENDMSG;
+	sqe->fd = socket.fd;
+	sqe->addr = reinterpret_cast<uint64_t>(&socket.msg);
+	sqe->len = 1;
+	sqe->msg_flags = MSG_NOSIGNAL;
+	sqe->user_data = reinterpret_cast<uint64_t>(&socket) | TAG_SEND;
+
+	++socket.inflight;
+	this->StartFlush();
+}
+
+void IOUring::Impl::Deliver(Socket& socket)
+{
+	uint32_t num = 0;
+	while (num < socket.readSize && !socket.received.empty())
+	{
+		auto& chunk = socket.received.front();
+		auto size = std::min(chunk.size - chunk.offset, socket.readSize - num);
+		memcpy(socket.pRead + num, &pool[static_cast<size_t>(chunk.bid) * settings.bufferSize + chunk.offset], size);
+		chunk.offset += size;
+		num += size;
+		if (chunk.offset == chunk.size)
+		{
+			this->Recycle(chunk.bid);
+			socket.received.pop_front();
+		}
+	}
+
+	std::error_code ec;
+	if (num == 0)
+	{
+		ec = socket.recvError ? socket.recvError : asio::error::eof;
+	}
+
+	auto pLayer = socket.pLayer;
+	auto pBuffer = socket.pRead;
+	socket.pRead = nullptr;
+
+	auto callback = [pLayer, ec, pBuffer, num]()
+	{
+		pLayer->OnReadCallback(ec, pBuffer, num);
+	};
+	pLayer->executor.PostLambda(callback);
+}
+
+void IOUring::Impl::CompleteWrite(Socket& socket, const std::error_code& ec)
+{
+	auto pLayer = socket.pLayer;
+	auto numWritten = ec ? 0 : socket.numWritten;
+
+	auto callback = [pLayer, ec, numWritten]()
+	{
+		pLayer->OnWriteCallback(ec, numWritten);
+	};
+	pLayer->executor.PostLambda(callback);
+}
+
+void IOUring::Impl::Recycle(uint16_t bid)
+{
+	auto pBuffers = static_cast<io_uring_buf*>(pBufferRing);
+	auto& buf = pBuffers[bufferTail & (settings.bufferCount - 1)];
+	buf.addr = reinterpret_cast<uint64_t>(&pool[static_cast<size_t>(bid) * settings.bufferSize]);
+	buf.len = settings.bufferSize;
+	buf.bid = bid;
+	++bufferTail;
+	isBufferTailStale = true;
+}
+
+void IOUring::Impl::PublishBuffers()
+{
+	if (!isBufferTailStale)
+	{
+		return;
+	}
+
+	// the tail shares its place with the reserved field of the first entry
+	auto pBuffers = static_cast<io_uring_buf_ring*>(pBufferRing);
+	__atomic_store_n(&pBuffers->tail, bufferTail, __ATOMIC_RELEASE);
+	isBufferTailStale = false;
+
+	// receives that ran out of buffers can continue
+	std::vector<Socket*> waiting;
+	waiting.swap(starved);
+	for (auto pSocket : waiting)
+	{
+		pSocket->isStarved = false;
+		if (!pSocket->isRecvArmed)
+		{
+			this->ArmRecv(*pSocket);
+		}
+	}
+}
+
+void IOUring::Impl::Release(Socket* pSocket)
+{
+	if (pSocket->isDetached && pSocket->inflight == 0)
+	{
+		sockets.erase(pSocket);
+		delete pSocket;
+	}
+}
+
+#else
+
+class IOUring::Socket
+{
+};
+
+class IOUring::Impl
+{
+public:
+
+	Socket* Attach(PhysicalLayerBaseTCP*, int)
+	{
+		return nullptr;
+	}
+	void Detach(Socket*) {}
+	void Read(Socket*, openpal::WSlice&) {}
+	void Write(Socket*, const openpal::RSlice*, uint32_t) {}
+	IOUringStatistics GetStatistics()
+	{
+		return IOUringStatistics();
+	}
+	void Shutdown() {}
+};
+
+#endif
+
+std::shared_ptr<IOUring> IOUring::Create(asio::io_service& service, const IOUringSettings& settings, std::error_code& ec)
+{
+#ifdef ASIOPAL_IO_URING
+	auto impl = std::make_shared<Impl>(service, settings);
+	ec = impl->Init();
+	if (ec)
+	{
+		return nullptr;
+	}
+	return std::shared_ptr<IOUring>(new IOUring(impl));
+#else
+	ec = std::make_error_code(std::errc::operation_not_supported);
+	return nullptr;
+#endif
+}
+
+IOUring::IOUring(const std::shared_ptr<Impl>& impl_) : impl(impl_)
+{
+
+}
+
+IOUring::~IOUring()
+{
+	impl->Shutdown();
+}
+
+IOUring::Socket* IOUring::Attach(PhysicalLayerBaseTCP* pLayer, int fd)
+{
+	return impl->Attach(pLayer, fd);
+}
+
+void IOUring::Detach(Socket* pSocket)
+{
+	impl->Detach(pSocket);
+}
+
+void IOUring::Read(Socket* pSocket, openpal::WSlice& buffer)
+{
+	impl->Read(pSocket, buffer);
+}
+
+void IOUring::Write(Socket* pSocket, const openpal::RSlice* buffers, uint32_t count)
+{
+	impl->Write(pSocket, buffers, count);
+}
+
+IOUringStatistics IOUring::GetStatistics()
+{
+	return impl->GetStatistics();
+}
+
+void IOUring::Shutdown()
+{
+	impl->Shutdown();
+}
+
+}
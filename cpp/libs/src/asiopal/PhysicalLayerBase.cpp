@@ -186,6 +186,11 @@ void PhysicalLayerBase::BeginWrite(const openpal::RSlice& buffer)
 	{
 		if (buffer.Size() > 0)
 		{
+			if (pChannelStatistics)
+			{
+				++pChannelStatistics->numWrites;
+			}
+
 			state.isWriting = true;
 			this->DoWrite(buffer);
 		}
@@ -205,6 +210,39 @@ void PhysicalLayerBase::BeginWrite(const openpal::RSlice& buffer)
 	}
 }
 
+void PhysicalLayerBase::BeginWriteBatch(const openpal::RSlice* buffers, uint32_t count)
+{
+	assert(count <= MAX_WRITE_BATCH);
+
+	if (count == 1)
+	{
+		this->BeginWrite(buffers[0]);
+		return;
+	}
+
+	uint32_t total = 0;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		total += buffers[i].Size();
+	}
+
+	if (state.CanWrite() && total > 0)
+	{
+		if (pChannelStatistics)
+		{
+			++pChannelStatistics->numWrites;
+		}
+
+		state.isWriting = true;
+		this->DoWriteBatch(buffers, count);
+	}
+	else
+	{
+		// an empty batch has the same handling as an empty write
+		this->BeginWrite(RSlice());
+	}
+}
+
 void PhysicalLayerBase::BeginRead(WSlice& buffer)
 {
 	if(state.CanRead())
@@ -307,6 +345,7 @@ void PhysicalLayerBase::OnReadCallback(const std::error_code& err, uint8_t* pBuf
 			if (pChannelStatistics)
 			{
 				pChannelStatistics->numBytesRx += numRead;
+				++pChannelStatistics->numReads;
 			}
 
 			if (!state.isClosing)
@@ -360,6 +399,28 @@ void PhysicalLayerBase::OnWriteCallback(const std::error_code& err, uint32_t num
 // Actions
 ////////////////////////////////////
 
+void PhysicalLayerBase::DoWriteBatch(const openpal::RSlice* buffers, uint32_t count)
+{
+	uint32_t total = 0;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		total += buffers[i].Size();
+	}
+
+	if (batchBuffer.Size() < total)
+	{
+		batchBuffer.resize(total);
+	}
+
+	auto dest = batchBuffer.GetWSlice();
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		buffers[i].CopyTo(dest);
+	}
+
+	this->DoWrite(batchBuffer.ToRSlice().Take(total));
+}
+
 void PhysicalLayerBase::DoWriteSuccess()
 {
 	if (pCallbacks)
@@ -20,6 +20,7 @@
  */
 #include "asiopal/PhysicalLayerBaseTCP.h"
 
+#include <array>
 #include <string>
 #include <functional>
 
@@ -40,7 +41,18 @@ namespace asiopal
 
 PhysicalLayerBaseTCP::PhysicalLayerBaseTCP(openpal::LogRoot& root, asio::io_service& service) :
 	PhysicalLayerASIO(root, service),
-	socket(service)
+	socket(service),
+	pRing(nullptr),
+	pRingSocket(nullptr)
+{
+
+}
+
+PhysicalLayerBaseTCP::PhysicalLayerBaseTCP(openpal::LogRoot& root, ASIOExecutor& sharedExecutor) :
+	PhysicalLayerASIO(root, sharedExecutor),
+	socket(sharedExecutor.strand.get_io_service()),
+	pRing(nullptr),
+	pRingSocket(nullptr)
 {
 
 }
@@ -49,12 +61,24 @@ PhysicalLayerBaseTCP::PhysicalLayerBaseTCP(openpal::LogRoot& root, asio::io_serv
 
 void PhysicalLayerBaseTCP::DoClose()
 {
+	if (pRingSocket)
+	{
+		pRing->Detach(pRingSocket);
+		pRingSocket = nullptr;
+	}
+
 	this->ShutdownSocket();
 	this->CloseSocket();
 }
 
 void PhysicalLayerBaseTCP::DoRead(WSlice& buff)
 {
+	if (pRing)
+	{
+		pRing->Read(this->RingSocket(), buff);
+		return;
+	}
+
 	uint8_t* pBuff = buff;
 
 	auto callback = [this, pBuff](const std::error_code & code, size_t  numRead)
@@ -62,17 +86,50 @@ void PhysicalLayerBaseTCP::DoRead(WSlice& buff)
 		this->OnReadCallback(code, pBuff, static_cast<uint32_t>(numRead));
 	};
 
-	socket.async_read_some(buffer(pBuff, buff.Size()), executor.strand.wrap(callback));
+	socket.async_read_some(buffer(pBuff, buff.Size()), readArena->Wrap(executor.strand.wrap(callback)));
 }
 
 void PhysicalLayerBaseTCP::DoWrite(const RSlice& buff)
 {
+	if (pRing)
+	{
+		pRing->Write(this->RingSocket(), &buff, 1);
+		return;
+	}
+
 	auto callback = [this](const std::error_code & code, size_t  numWritten)
 	{
 		this->OnWriteCallback(code, static_cast<uint32_t>(numWritten));
 	};
 
-	async_write(socket, buffer(buff, buff.Size()), executor.strand.wrap(callback));
+	async_write(socket, buffer(buff, buff.Size()), writeArena->Wrap(executor.strand.wrap(callback)));
+}
+
+void PhysicalLayerBaseTCP::DoWriteBatch(const RSlice* buffers, uint32_t count)
+{
+	if (pRing)
+	{
+		pRing->Write(this->RingSocket(), buffers, count);
+		return;
+	}
+
+	auto callback = [this](const std::error_code & code, size_t  numWritten)
+	{
+		this->OnWriteCallback(code, static_cast<uint32_t>(numWritten));
+	};
+
+	// gather the whole batch into one send, the sequence is copied into the operation
+	std::array<const_buffer, MAX_WRITE_BATCH> sequence;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		sequence[i] = buffer(buffers[i], buffers[i].Size());
+	}
+	for (uint32_t i = count; i < MAX_WRITE_BATCH; ++i)
+	{
+		sequence[i] = const_buffer();
+	}
+
+	async_write(socket, sequence, writeArena->Wrap(executor.strand.wrap(callback)));
 }
 
 void PhysicalLayerBaseTCP::DoOpenFailure()
@@ -81,6 +138,20 @@ void PhysicalLayerBaseTCP::DoOpenFailure()
 	this->CloseSocket();
 }
 
+void PhysicalLayerBaseTCP::SetIOUring(IOUring* pRing_)
+{
+	pRing = pRing_;
+}
+
+IOUring::Socket* PhysicalLayerBaseTCP::RingSocket()
+{
+	if (!pRingSocket)
+	{
+		pRingSocket = pRing->Attach(this, socket.native_handle());
+	}
+	return pRingSocket;
+}
+
 void PhysicalLayerBaseTCP::CloseSocket()
 {
 	std::error_code ec;
@@ -0,0 +1,512 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include "asiopal/PhysicalLayerMemoryPipe.h"
+
+#include <openpal/logging/LogMacros.h>
+#include <openpal/logging/LogLevels.h>
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <vector>
+#include <cstring>
+
+using namespace openpal;
+
+namespace asiopal
+{
+
+/**
+* State shared between the two ends of a pipe. Each end only ever touches its own executor, so all
+* cross-end interactions happen under the mutex and the results are posted to the other end.
+*/
+class MemoryPipe
+{
+	// bytes that have left the sender but are still delayed by the configured latency
+	struct Chunk
+	{
+		Chunk(const RSlice& buffer) :
+			bytes(buffer.Size()),
+			offset(0),
+			hasArrived(false)
+		{
+			memcpy(bytes.data(), buffer, buffer.Size());
+		}
+
+		std::vector<uint8_t> bytes;
+		uint32_t offset;
+		bool hasArrived;
+	};
+
+	struct Side
+	{
+		Side() :
+			pLayer(nullptr),
+			isOpening(false),
+			isOpen(false),
+			epoch(0),
+			pRead(nullptr),
+			readSize(0),
+			isWritePending(false),
+			isWriteOnWire(false),
+			pWrite(nullptr),
+			writeSize(0),
+			writeRemaining(0),
+			throttleMicros(0),
+			bitsUntilError(0)
+		{}
+
+		PhysicalLayerMemoryPipe* pLayer;
+
+		bool isOpening;
+		bool isOpen;
+
+		// incremented whenever the side connects or disconnects, invalidating any running timers
+		uint32_t epoch;
+
+		// outstanding read
+		uint8_t* pRead;
+		uint32_t readSize;
+
+		// outstanding write
+		bool isWritePending;
+		bool isWriteOnWire;
+		const uint8_t* pWrite;
+		uint32_t writeSize;
+		uint32_t writeRemaining;
+
+		// state of the direction from this side to its peer
+		std::deque<Chunk> inflight;
+		uint64_t throttleMicros;
+		std::mt19937 generator;
+		uint64_t bitsUntilError;
+	};
+
+public:
+
+	MemoryPipe(const MemoryPipeSettings& settings_) : settings(settings_)
+	{
+		sides[0].generator.seed(settings.seed);
+		sides[1].generator.seed(settings.seed + 1);
+		sides[0].bitsUntilError = this->NextBitError(sides[0]);
+		sides[1].bitsUntilError = this->NextBitError(sides[1]);
+	}
+
+	void Attach(uint8_t s, PhysicalLayerMemoryPipe* pLayer)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		sides[s].pLayer = pLayer;
+	}
+
+	void Detach(uint8_t s)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		sides[s].pLayer = nullptr;
+		this->Disconnect(s, std::make_error_code(std::errc::operation_canceled));
+		this->Disconnect(Peer(s), std::make_error_code(std::errc::connection_reset));
+	}
+
+	void Open(uint8_t s)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		auto& local = sides[s];
+		auto& remote = sides[Peer(s)];
+
+		local.isOpening = true;
+
+		// the pipe connects as soon as both ends are opening
+		if (remote.isOpening)
+		{
+			for (auto i : { s, Peer(s) })
+			{
+				auto& side = sides[i];
+				side.isOpening = false;
+				side.isOpen = true;
+				side.throttleMicros = 0;
+				++side.epoch;
+				this->PostOpenResult(i, std::error_code());
+			}
+		}
+	}
+
+	void AbortOpen(uint8_t s)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		// if the connection was already made, the base class closes it when the result arrives
+		if (sides[s].isOpening)
+		{
+			sides[s].isOpening = false;
+			this->PostOpenResult(s, std::make_error_code(std::errc::operation_canceled));
+		}
+	}
+
+	void Close(uint8_t s)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->Disconnect(s, std::make_error_code(std::errc::operation_canceled));
+		this->Disconnect(Peer(s), std::make_error_code(std::errc::connection_reset));
+	}
+
+	void Read(uint8_t s, WSlice& buffer)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		auto& local = sides[s];
+
+		if (local.isOpen)
+		{
+			local.pRead = buffer;
+			local.readSize = buffer.Size();
+			this->Transfer(Peer(s));
+		}
+		else
+		{
+			this->PostReadResult(s, std::make_error_code(std::errc::not_connected), nullptr, 0);
+		}
+	}
+
+	void Write(uint8_t s, const RSlice& buffer)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		auto& local = sides[s];
+
+		if (!local.isOpen)
+		{
+			this->PostWriteResult(s, std::make_error_code(std::errc::not_connected), 0);
+			return;
+		}
+
+		local.isWritePending = true;
+		local.isWriteOnWire = false;
+		local.pWrite = buffer;
+		local.writeSize = local.writeRemaining = buffer.Size();
+
+		auto delay = this->GetSerializationDelay(local, buffer.Size());
+
+		if (delay > 0)
+		{
+			auto epoch = local.epoch;
+			auto callback = [this, s, epoch]()
+			{
+				this->OnSerialized(s, epoch);
+			};
+			local.pLayer->executor.Start(TimeDuration::Milliseconds(delay), Action0::Bind(callback));
+		}
+		else
+		{
+			this->PutOnWire(s);
+		}
+	}
+
+private:
+
+	static uint8_t Peer(uint8_t s)
+	{
+		return s ^ 1;
+	}
+
+	// ------- all of the following are called with the mutex held --------
+
+	void OnSerialized(uint8_t s, uint32_t epoch)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		auto& local = sides[s];
+		if (local.epoch == epoch && local.isWritePending)
+		{
+			this->PutOnWire(s);
+		}
+	}
+
+	void OnArrival(uint8_t s, uint32_t epoch)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		auto& local = sides[s];
+		if (local.epoch == epoch)
+		{
+			// latency is constant, so chunks always arrive in the order they were sent
+			for (auto& chunk : local.inflight)
+			{
+				if (!chunk.hasArrived)
+				{
+					chunk.hasArrived = true;
+					break;
+				}
+			}
+
+			this->Transfer(s);
+		}
+	}
+
+	void PutOnWire(uint8_t s)
+	{
+		auto& local = sides[s];
+
+		if (settings.latency.GetMilliseconds() > 0)
+		{
+			// the sender is free to reuse its buffer while the bytes are in flight, so they must be copied
+			local.inflight.push_back(Chunk(RSlice(local.pWrite, local.writeRemaining)));
+			local.isWritePending = false;
+			this->PostWriteResult(s, std::error_code(), local.writeSize);
+
+			auto epoch = local.epoch;
+			auto callback = [this, s, epoch]()
+			{
+				this->OnArrival(s, epoch);
+			};
+			local.pLayer->executor.Start(settings.latency, Action0::Bind(callback));
+		}
+		else
+		{
+			local.isWriteOnWire = true;
+			this->Transfer(s);
+		}
+	}
+
+	// move as many bytes as possible from side 's' into the outstanding read of its peer
+	void Transfer(uint8_t s)
+	{
+		auto& sender = sides[s];
+		auto& receiver = sides[Peer(s)];
+
+		if (!(receiver.isOpen && receiver.pRead))
+		{
+			return;
+		}
+
+		uint32_t count = 0;
+
+		while ((count < receiver.readSize) && !sender.inflight.empty() && sender.inflight.front().hasArrived)
+		{
+			auto& chunk = sender.inflight.front();
+			auto available = static_cast<uint32_t>(chunk.bytes.size()) - chunk.offset;
+			auto num = std::min(available, receiver.readSize - count);
+			memcpy(receiver.pRead + count, chunk.bytes.data() + chunk.offset, num);
+			count += num;
+			chunk.offset += num;
+			if (chunk.offset == chunk.bytes.size())
+			{
+				sender.inflight.pop_front();
+			}
+		}
+
+		if ((count < receiver.readSize) && sender.isWritePending && sender.isWriteOnWire)
+		{
+			auto num = std::min(sender.writeRemaining, receiver.readSize - count);
+			memcpy(receiver.pRead + count, sender.pWrite, num);
+			count += num;
+			sender.pWrite += num;
+			sender.writeRemaining -= num;
+			if (sender.writeRemaining == 0)
+			{
+				sender.isWritePending = false;
+				this->PostWriteResult(s, std::error_code(), sender.writeSize);
+			}
+		}
+
+		if (count > 0)
+		{
+			this->InjectBitErrors(sender, receiver.pRead, count);
+			auto pBuffer = receiver.pRead;
+			receiver.pRead = nullptr;
+			this->PostReadResult(Peer(s), std::error_code(), pBuffer, count);
+		}
+	}
+
+	void Disconnect(uint8_t s, const std::error_code& ec)
+	{
+		auto& side = sides[s];
+
+		if (!side.isOpen)
+		{
+			return;
+		}
+
+		side.isOpen = false;
+		++side.epoch;
+		side.inflight.clear();
+
+		if (side.pRead)
+		{
+			side.pRead = nullptr;
+			this->PostReadResult(s, ec, nullptr, 0);
+		}
+
+		if (side.isWritePending)
+		{
+			side.isWritePending = false;
+			this->PostWriteResult(s, ec, 0);
+		}
+	}
+
+	uint32_t GetSerializationDelay(Side& side, uint32_t size)
+	{
+		if (settings.bandwidth == 0)
+		{
+			return 0;
+		}
+
+		// carry the sub-millisecond remainder forward so that small frames are still throttled on average
+		side.throttleMicros += (static_cast<uint64_t>(size) * 1000000) / settings.bandwidth;
+		auto delay = side.throttleMicros / 1000;
+		side.throttleMicros %= 1000;
+		return static_cast<uint32_t>(delay);
+	}
+
+	uint64_t NextBitError(Side& side)
+	{
+		if (settings.bitErrorRate <= 0.0)
+		{
+			return 0;
+		}
+
+		if (settings.bitErrorRate >= 1.0)
+		{
+			return 0;
+		}
+
+		// number of good bits before the next bad one
+		std::geometric_distribution<uint64_t> distribution(settings.bitErrorRate);
+		return distribution(side.generator);
+	}
+
+	void InjectBitErrors(Side& sender, uint8_t* pBuffer, uint32_t count)
+	{
+		if (settings.bitErrorRate <= 0.0)
+		{
+			return;
+		}
+
+		const uint64_t NUM_BITS = static_cast<uint64_t>(count) * 8;
+		uint64_t position = 0;
+
+		while (sender.bitsUntilError < (NUM_BITS - position))
+		{
+			position += sender.bitsUntilError;
+			pBuffer[position / 8] ^= static_cast<uint8_t>(1 << (position % 8));
+			++position;
+			sender.bitsUntilError = this->NextBitError(sender);
+		}
+
+		sender.bitsUntilError -= (NUM_BITS - position);
+	}
+
+	void PostOpenResult(uint8_t s, const std::error_code& ec)
+	{
+		auto pLayer = sides[s].pLayer;
+		if (pLayer)
+		{
+			auto callback = [pLayer, ec]()
+			{
+				pLayer->OnOpenCallback(ec);
+			};
+			pLayer->executor.PostLambda(callback);
+		}
+	}
+
+	void PostReadResult(uint8_t s, const std::error_code& ec, uint8_t* pBuffer, uint32_t numRead)
+	{
+		auto pLayer = sides[s].pLayer;
+		if (pLayer)
+		{
+			auto callback = [pLayer, ec, pBuffer, numRead]()
+			{
+				pLayer->OnReadCallback(ec, pBuffer, numRead);
+			};
+			pLayer->executor.PostLambda(callback);
+		}
+	}
+
+	void PostWriteResult(uint8_t s, const std::error_code& ec, uint32_t numWritten)
+	{
+		auto pLayer = sides[s].pLayer;
+		if (pLayer)
+		{
+			auto callback = [pLayer, ec, numWritten]()
+			{
+				pLayer->OnWriteCallback(ec, numWritten);
+			};
+			pLayer->executor.PostLambda(callback);
+		}
+	}
+
+	const MemoryPipeSettings settings;
+
+	std::mutex mutex;
+	Side sides[2];
+};
+
+std::pair<PhysicalLayerMemoryPipe*, PhysicalLayerMemoryPipe*> PhysicalLayerMemoryPipe::CreatePair(
+    openpal::LogRoot& rootA,
+    openpal::LogRoot& rootB,
+    asio::io_service& service,
+    const MemoryPipeSettings& settings)
+{
+	auto pipe = std::make_shared<MemoryPipe>(settings);
+	auto pA = new PhysicalLayerMemoryPipe(rootA, service, pipe, 0);
+	auto pB = new PhysicalLayerMemoryPipe(rootB, service, pipe, 1);
+	return std::make_pair(pA, pB);
+}
+
+PhysicalLayerMemoryPipe::PhysicalLayerMemoryPipe(openpal::LogRoot& root, asio::io_service& service, const std::shared_ptr<MemoryPipe>& pipe_, uint8_t side_) :
+	PhysicalLayerASIO(root, service),
+	pipe(pipe_),
+	side(side_)
+{
+	pipe->Attach(side, this);
+}
+
+PhysicalLayerMemoryPipe::~PhysicalLayerMemoryPipe()
+{
+	pipe->Detach(side);
+}
+
+void PhysicalLayerMemoryPipe::DoOpen()
+{
+	pipe->Open(side);
+}
+
+void PhysicalLayerMemoryPipe::DoClose()
+{
+	pipe->Close(side);
+}
+
+void PhysicalLayerMemoryPipe::DoOpeningClose()
+{
+	pipe->AbortOpen(side);
+}
+
+void PhysicalLayerMemoryPipe::DoRead(openpal::WSlice& buffer)
+{
+	pipe->Read(side, buffer);
+}
+
+void PhysicalLayerMemoryPipe::DoWrite(const openpal::RSlice& buffer)
+{
+	pipe->Write(side, buffer);
+}
+
+}
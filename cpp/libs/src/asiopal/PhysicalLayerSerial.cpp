@@ -22,6 +22,7 @@
 
 #include <asio.hpp>
 
+#include <algorithm>
 #include <functional>
 #include <string>
 
@@ -45,7 +46,12 @@ PhysicalLayerSerial::PhysicalLayerSerial(
 
 	PhysicalLayerASIO(root, service),
 	settings(settings),
-	port(service)
+	port(service),
+	pReadBuffer(nullptr),
+	readCapacity(0),
+	numBatched(0),
+	pInterCharTimer(nullptr),
+	pTurnaroundTimer(nullptr)
 {
 
 }
@@ -65,6 +71,15 @@ void PhysicalLayerSerial::DoOpen()
 			std::error_code ec2;
 			port.close(ec2);
 		}
+		else if (settings.lowLatency)
+		{
+			// a tuning hint, so ports whose driver doesn't support it still open
+			std::error_code ec2;
+			if (!SetLowLatency(port, ec2))
+			{
+				FORMAT_LOG_BLOCK(logger, logflags::WARN, "Unable to set low latency mode: %s", ec2.message().c_str());
+			}
+		}
 	}
 
 	auto lambda = [this, ec]()
@@ -84,6 +99,29 @@ void PhysicalLayerSerial::DoOpen()
 
 void PhysicalLayerSerial::DoClose()
 {
+	// the read or write waiting on a timer completes as aborted, just like the ones the port cancels
+	if (pInterCharTimer)
+	{
+		pInterCharTimer->Cancel();
+		pInterCharTimer = nullptr;
+		auto lambda = [this]()
+		{
+			this->OnReadCallback(asio::error::operation_aborted, pReadBuffer, 0);
+		};
+		executor.PostLambda(lambda);
+	}
+
+	if (pTurnaroundTimer)
+	{
+		pTurnaroundTimer->Cancel();
+		pTurnaroundTimer = nullptr;
+		auto lambda = [this]()
+		{
+			this->OnWriteCallback(asio::error::operation_aborted, 0);
+		};
+		executor.PostLambda(lambda);
+	}
+
 	std::error_code ec;
 	port.close(ec);
 	if (ec)
@@ -99,27 +137,128 @@ void PhysicalLayerSerial::DoOpenSuccess()
 
 void PhysicalLayerSerial::DoRead(openpal::WSlice& buff)
 {
-	uint8_t* pBuffer = buff;
+	pReadBuffer = buff;
+	readCapacity = buff.Size();
+	numBatched = 0;
 
-	auto callback = [this, pBuffer](const std::error_code & error, size_t numRead)
+	if (this->IsBatching())
 	{
-		this->OnReadCallback(error, pBuffer, static_cast<uint32_t>(numRead));
+		// bytes left behind by a full buffer may be fewer than VMIN, which would never wake the read, so collect them like a batch
+		std::error_code ec;
+		if (BytesAvailable(port, ec) > 0 && !ec)
+		{
+			auto lambda = [this]()
+			{
+				this->OnInterCharTimeout();
+			};
+			pInterCharTimer = executor.Start(settings.interCharTimeout, Action0::Bind(lambda));
+			return;
+		}
+	}
+
+	auto callback = [this](const std::error_code & error, size_t numRead)
+	{
+		this->OnReadSome(error, static_cast<uint32_t>(numRead));
 	};
 
-	port.async_read_some(buffer(pBuffer, buff.Size()), executor.strand.wrap(callback));
+	port.async_read_some(buffer(pReadBuffer, readCapacity), readArena->Wrap(executor.strand.wrap(callback)));
 }
 
 void PhysicalLayerSerial::DoWrite(const RSlice& buff)
 {
-	auto callback = [this](const std::error_code & error, size_t size)
+	if (settings.turnaroundDelay.GetMilliseconds() > 0)
 	{
-		this->OnWriteCallback(error, static_cast<uint32_t>(size));
-	};
+		auto earliest = lastRxTime.Add(settings.turnaroundDelay);
+		if (earliest > executor.GetTime())
+		{
+			pendingWrite = buff;
+			auto lambda = [this]()
+			{
+				pTurnaroundTimer = nullptr;
+				this->StartWrite(pendingWrite);
+			};
+			pTurnaroundTimer = executor.Start(earliest, Action0::Bind(lambda));
+			return;
+		}
+	}
+
+	this->StartWrite(buff);
+}
+
+bool PhysicalLayerSerial::IsBatching() const
+{
+#ifndef ASIO_WINDOWS
+	return settings.interCharTimeout.GetMilliseconds() > 0;
+#else
+	return false;
+#endif
+}
 
-	async_write(port, buffer(buff, buff.Size()), executor.strand.wrap(callback));
+void PhysicalLayerSerial::OnReadSome(const std::error_code& ec, uint32_t numRead)
+{
+	if (!ec)
+	{
+		lastRxTime = executor.GetTime();
+	}
+
+	if (ec || !this->IsBatching() || numRead == readCapacity)
+	{
+		this->OnReadCallback(ec, pReadBuffer, numRead);
+		return;
+	}
+
+	// more of the frame is probably on its way, collect it until the line goes quiet
+	numBatched = numRead;
+	auto lambda = [this]()
+	{
+		this->OnInterCharTimeout();
+	};
+	pInterCharTimer = executor.Start(settings.interCharTimeout, Action0::Bind(lambda));
 }
 
+void PhysicalLayerSerial::OnInterCharTimeout()
+{
+	pInterCharTimer = nullptr;
+
+	if (pChannelStatistics)
+	{
+		++pChannelStatistics->numInterCharWakeups;
+	}
+
+	std::error_code ec;
+	auto available = BytesAvailable(port, ec);
+	if (!ec && available > 0)
+	{
+		// the bytes are already waiting in the driver, so this doesn't block
+		auto num = port.read_some(buffer(pReadBuffer + numBatched, std::min(available, readCapacity - numBatched)), ec);
+		if (!ec)
+		{
+			numBatched += static_cast<uint32_t>(num);
+			lastRxTime = executor.GetTime();
+
+			if (numBatched < readCapacity)
+			{
+				auto lambda = [this]()
+				{
+					this->OnInterCharTimeout();
+				};
+				pInterCharTimer = executor.Start(settings.interCharTimeout, Action0::Bind(lambda));
+				return;
+			}
+		}
+	}
+
+	this->OnReadCallback(ec, pReadBuffer, numBatched);
 }
 
+void PhysicalLayerSerial::StartWrite(const RSlice& buff)
+{
+	auto callback = [this](const std::error_code & error, size_t size)
+	{
+		this->OnWriteCallback(error, static_cast<uint32_t>(size));
+	};
 
+	async_write(port, buffer(buff, buff.Size()), writeArena->Wrap(executor.strand.wrap(callback)));
+}
 
+}
@@ -0,0 +1,59 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include "asiopal/PhysicalLayerTCPSession.h"
+
+#include <openpal/logging/LogMacros.h>
+#include <openpal/logging/LogLevels.h>
+
+using namespace asio;
+using namespace openpal;
+
+namespace asiopal
+{
+
+PhysicalLayerTCPSession::PhysicalLayerTCPSession(
+    openpal::LogRoot& root,
+    ASIOExecutor& executor,
+    asio::ip::tcp::socket&& accepted) :
+
+	PhysicalLayerBaseTCP(root, executor),
+	opened(false)
+{
+	socket = std::move(accepted);
+}
+
+void PhysicalLayerTCPSession::DoOpen()
+{
+	auto ec = (opened || !socket.is_open()) ? std::make_error_code(std::errc::not_connected) : std::error_code();
+	opened = true;
+	auto lambda = [this, ec]()
+	{
+		this->OnOpenCallback(ec);
+	};
+	pExecutor->PostLambda(lambda);
+}
+
+void PhysicalLayerTCPSession::DoOpeningClose()
+{
+	this->CloseSocket();
+}
+
+}
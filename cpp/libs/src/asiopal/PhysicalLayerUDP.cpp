@@ -0,0 +1,90 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include "asiopal/PhysicalLayerUDP.h"
+
+#include <openpal/logging/LogMacros.h>
+#include <openpal/logging/LogLevels.h>
+
+#include <asio.hpp>
+
+using namespace openpal;
+
+namespace asiopal
+{
+
+PhysicalLayerUDP::PhysicalLayerUDP(
+    LogRoot& root,
+    asio::io_service& service,
+    const std::shared_ptr<DatagramSocket>& socket_,
+    const std::string& remoteAddress_,
+    uint16_t remotePort_) :
+
+	PhysicalLayerASIO(root, service),
+	socket(socket_),
+	remoteAddress(remoteAddress_),
+	remotePort(remotePort_)
+{
+
+}
+
+void PhysicalLayerUDP::DoOpen()
+{
+	std::error_code ec;
+	auto address = asio::ip::address::from_string(remoteAddress, ec);
+	if (!ec)
+	{
+		remote = asio::ip::udp::endpoint(address, remotePort);
+		ec = socket->Attach(this, remote);
+	}
+
+	auto lambda = [this, ec]()
+	{
+		this->OnOpenCallback(ec);
+	};
+	executor.PostLambda(lambda);
+}
+
+void PhysicalLayerUDP::DoClose()
+{
+	socket->Detach(this, remote);
+}
+
+void PhysicalLayerUDP::DoOpeningClose()
+{
+	// the open result is already posted, the base class closes the session when it arrives
+}
+
+void PhysicalLayerUDP::DoRead(WSlice& buffer)
+{
+	socket->Read(remote, buffer);
+}
+
+void PhysicalLayerUDP::DoWrite(const RSlice& buffer)
+{
+	socket->Write(remote, buffer);
+}
+
+void PhysicalLayerUDP::DoOpenSuccess()
+{
+	FORMAT_LOG_BLOCK(logger, logflags::INFO, "Exchanging datagrams with: %s:%u", remoteAddress.c_str(), remotePort);
+}
+
+}
@@ -27,9 +27,10 @@ using namespace openpal;
 namespace asiopal
 {
 
-TimerASIO::TimerASIO(asio::strand& strand) :
+TimerASIO::TimerASIO(asio::io_service& service) :
 	canceled(false),
-	timer(strand.get_io_service())
+	timer(service),
+	arena(HandlerArena::Create())
 {
 
 }
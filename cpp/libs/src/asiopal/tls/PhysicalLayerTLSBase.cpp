@@ -21,8 +21,6 @@
 
 #include "asiopal/tls/PhysicalLayerTLSBase.h"
 
-#include "asiopal/tls/TLSHelpers.h"
-
 #include <openpal/logging/LogMacros.h>
 #include <openpal/logging/LogLevels.h>
 
@@ -36,25 +34,58 @@ namespace asiopal
 PhysicalLayerTLSBase::PhysicalLayerTLSBase(
     openpal::LogRoot& root,
     asio::io_service& service,
-    const TLSConfig& config,
-    asio::ssl::context_base::method method) :
+    std::shared_ptr<TLSContext> context_) :
 
 	PhysicalLayerASIO(root, service),
-	ctx(method)
+	service(service),
+	context(context_),
+	pSessionCache(context_->pSessionCache)
 {
 
-	TLSHelpers::ApplyConfig(config, ctx);
+}
 
-	ctx.set_verify_callback(
+void PhysicalLayerTLSBase::ResetStream()
+{
+	/// The stream inherits all the settings of the context it is created from
+	streamContext = context->Get();
+	this->stream = std::unique_ptr<asio::ssl::stream<asio::ip::tcp::socket>>(new asio::ssl::stream<asio::ip::tcp::socket>(service, *streamContext));
+
+	// set on the stream rather than the context, which other channels share
+	this->stream->set_verify_callback(
 	    [this](bool preverified, asio::ssl::verify_context & ctx)
 	{
 		return this->LogPeerCertificateInfo(preverified, ctx);
 	}
 	);
+}
+
+void PhysicalLayerTLSBase::OnHandshakeResult(const std::error_code& ec)
+{
+	if (!ec)
+	{
+		const bool resumed = SSL_session_reused(stream->native_handle()) != 0;
+
+		if (pSessionCache)
+		{
+			pSessionCache->RecordHandshake(resumed);
+		}
+
+		if (pChannelStatistics)
+		{
+			if (resumed)
+			{
+				++pChannelStatistics->numResumedHandshakes;
+			}
+			else
+			{
+				++pChannelStatistics->numFullHandshakes;
+			}
+		}
+
+		SIMPLE_LOG_BLOCK(logger, openpal::logflags::DBG, resumed ? "Resumed TLS session" : "Completed full TLS handshake");
+	}
 
-	/// Now with all of this configured, we can create the stream class
-	/// The order is important since the socket object inerhits all the settings from the context
-	this->stream = std::unique_ptr<asio::ssl::stream<asio::ip::tcp::socket>>(new asio::ssl::stream<asio::ip::tcp::socket>(service, ctx));
+	this->OnOpenCallback(ec);
 }
 
 bool PhysicalLayerTLSBase::LogPeerCertificateInfo(bool preverified, asio::ssl::verify_context& ctx)
@@ -89,7 +120,7 @@ void PhysicalLayerTLSBase::DoRead(openpal::WSlice& dest)
 		this->OnReadCallback(ec, pBuff, static_cast<uint32_t>(numRead));
 	};
 
-	stream->async_read_some(buffer(pBuff, dest.Size()), executor.strand.wrap(callback));
+	stream->async_read_some(buffer(pBuff, dest.Size()), readArena->Wrap(executor.strand.wrap(callback)));
 }
 
 void PhysicalLayerTLSBase::DoWrite(const openpal::RSlice& data)
@@ -99,7 +130,7 @@ void PhysicalLayerTLSBase::DoWrite(const openpal::RSlice& data)
 		this->OnWriteCallback(code, static_cast<uint32_t>(numWritten));
 	};
 
-	async_write(*stream, buffer(data, data.Size()), executor.strand.wrap(callback));
+	async_write(*stream, buffer(data, data.Size()), writeArena->Wrap(executor.strand.wrap(callback)));
 }
 
 void PhysicalLayerTLSBase::DoOpenFailure()
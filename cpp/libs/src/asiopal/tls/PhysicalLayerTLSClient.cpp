@@ -22,7 +22,6 @@
 #include "asiopal/tls/PhysicalLayerTLSClient.h"
 
 #include "asiopal/SocketHelpers.h"
-#include "asiopal/tls/TLSHelpers.h"
 
 using namespace asio;
 using namespace asiopal;
@@ -36,15 +35,16 @@ PhysicalLayerTLSClient::PhysicalLayerTLSClient(
     const std::string& host_,
     const std::string& localAddress_,
     uint16_t port,
-    const TLSConfig& config
+    std::shared_ptr<TLSContext> context
 ) :
-	PhysicalLayerTLSBase(root, service, config, ssl::context_base::sslv23_client),
+	PhysicalLayerTLSBase(root, service, context),
 	condition(logger),
 	host(host_),
 	localAddress(localAddress_),
 	remoteEndpoint(ip::tcp::v4(), port),
 	localEndpoint(),
-	resolver(service)
+	resolver(service),
+	sessionKey(TLSSessionCache::ClientKey(context->config, host_, port))
 {
 
 
@@ -52,6 +52,12 @@ PhysicalLayerTLSClient::PhysicalLayerTLSClient(
 
 void PhysicalLayerTLSClient::DoOpen()
 {
+	this->ResetStream();
+	if (pSessionCache)
+	{
+		pSessionCache->PrepareClient(stream->native_handle(), sessionKey);
+	}
+
 	std::error_code ec;
 	SocketHelpers::BindToLocalAddress(localAddress, localEndpoint, this->stream->lowest_layer(), ec);
 	if (ec)
@@ -126,7 +132,12 @@ void PhysicalLayerTLSClient::HandleConnectResult(const std::error_code& ec)
 	{
 		auto callback = [this](const std::error_code & code)
 		{
-			this->OnOpenCallback(code);
+			if (code && pSessionCache)
+			{
+				// don't offer a session that the server may have rejected again
+				pSessionCache->Remove(sessionKey);
+			}
+			this->OnHandshakeResult(code);
 		};
 
 		this->stream->async_handshake(asio::ssl::stream_base::client, executor.strand.wrap(callback));
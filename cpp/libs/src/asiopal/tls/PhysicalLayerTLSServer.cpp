@@ -21,8 +21,6 @@
 
 #include "asiopal/tls/PhysicalLayerTLSServer.h"
 
-#include "asiopal/tls/TLSHelpers.h"
-
 #include <openpal/logging/LogMacros.h>
 #include <openpal/channel/IPhysicalLayerCallbacks.h>
 #include <openpal/logging/LogLevels.h>
@@ -39,9 +37,9 @@ PhysicalLayerTLSServer::PhysicalLayerTLSServer(
     asio::io_service& service,
     const std::string& endpoint,
     uint16_t port,
-    const TLSConfig& config) :
+    std::shared_ptr<TLSContext> context) :
 
-	PhysicalLayerTLSBase(root, service, config, asio::ssl::context_base::sslv23_server),
+	PhysicalLayerTLSBase(root, service, context),
 	localEndpointString(endpoint),
 	localEndpoint(ip::tcp::v4(), port),
 	acceptor(service)
@@ -51,6 +49,8 @@ PhysicalLayerTLSServer::PhysicalLayerTLSServer(
 
 void PhysicalLayerTLSServer::DoOpen()
 {
+	this->ResetStream();
+
 	std::error_code ec;
 
 	if (!acceptor.is_open())
@@ -86,7 +86,7 @@ void PhysicalLayerTLSServer::HandleAcceptResult(const std::error_code& ec)
 	{
 		auto callback = [this](const std::error_code & code)
 		{
-			this->OnOpenCallback(code);
+			this->OnHandshakeResult(code);
 		};
 
 		this->stream->async_handshake(asio::ssl::stream_base::server, executor.strand.wrap(callback));
@@ -36,7 +36,10 @@ TLSConfig::TLSConfig(
 	cipherList(cipherList_),
 	allowTLSv10(true),
 	allowTLSv11(true),
-	allowTLSv12(true)
+	allowTLSv12(true),
+	allowSessionResumption(true),
+	useSessionTickets(true),
+	sessionLifetimeSeconds(7200)
 {}
 
 }
@@ -0,0 +1,73 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+
+#include "asiopal/tls/TLSContext.h"
+
+#include "asiopal/tls/TLSHelpers.h"
+
+namespace asiopal
+{
+
+TLSContext::TLSContext(const TLSConfig& config_, bool server_, TLSSessionCache* pSessionCache_) :
+	config(config_),
+	server(server_),
+	pSessionCache(pSessionCache_),
+	current(Build())
+{
+
+}
+
+std::shared_ptr<asio::ssl::context> TLSContext::Get()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return current;
+}
+
+void TLSContext::Reload()
+{
+	auto context = this->Build();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	current = context;
+}
+
+std::shared_ptr<asio::ssl::context> TLSContext::Build() const
+{
+	auto context = std::make_shared<asio::ssl::context>(server ? asio::ssl::context_base::sslv23_server : asio::ssl::context_base::sslv23_client);
+
+	TLSHelpers::ApplyConfig(config, *context);
+
+	if (pSessionCache)
+	{
+		if (server)
+		{
+			pSessionCache->ConfigureServer(config, *context);
+		}
+		else
+		{
+			pSessionCache->ConfigureClient(config, *context);
+		}
+	}
+
+	return context;
+}
+
+}
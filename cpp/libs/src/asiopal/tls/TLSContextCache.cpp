@@ -0,0 +1,129 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+
+#include "asiopal/tls/TLSContextCache.h"
+
+#include <sstream>
+#include <system_error>
+#include <vector>
+
+namespace asiopal
+{
+
+std::shared_ptr<TLSContext> TLSContextCache::Get(const TLSConfig& config, bool server)
+{
+	const auto key = Key(config, server);
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto existing = contexts[key].lock();
+	if (existing)
+	{
+		return existing;
+	}
+
+	// forget the contexts whose channels are all gone
+	for (auto i = contexts.begin(); i != contexts.end();)
+	{
+		if (i->second.expired() && i->first != key)
+		{
+			i = contexts.erase(i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	auto context = std::make_shared<TLSContext>(config, server, &sessions);
+	contexts[key] = context;
+	return context;
+}
+
+bool TLSContextCache::Reload()
+{
+	std::vector<std::shared_ptr<TLSContext>> active;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (auto& pair : contexts)
+		{
+			auto context = pair.second.lock();
+			if (context)
+			{
+				active.push_back(context);
+			}
+		}
+	}
+
+	// sessions verified under the old certificates must not be resumed, so peers do a full handshake against the new ones
+	sessions.Invalidate();
+
+	bool success = true;
+	for (auto& context : active)
+	{
+		try
+		{
+			context->Reload();
+		}
+		catch (const std::system_error&)
+		{
+			success = false;
+		}
+	}
+	return success;
+}
+
+uint32_t TLSContextCache::NumContexts()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	uint32_t count = 0;
+	for (auto& pair : contexts)
+	{
+		if (!pair.second.expired())
+		{
+			++count;
+		}
+	}
+	return count;
+}
+
+TLSSessionStatistics TLSContextCache::GetSessionStatistics()
+{
+	return sessions.GetStatistics();
+}
+
+std::string TLSContextCache::Key(const TLSConfig& config, bool server)
+{
+	std::ostringstream key;
+	key << (server ? "server" : "client") << '\n'
+	    << config.peerCertFilePath << '\n'
+	    << config.localCertFilePath << '\n'
+	    << config.privateKeyFilePath << '\n'
+	    << config.cipherList << '\n'
+	    << config.allowTLSv10 << config.allowTLSv11 << config.allowTLSv12
+	    << config.allowSessionResumption << config.useSessionTickets << '\n'
+	    << config.sessionLifetimeSeconds;
+	return key.str();
+}
+
+}
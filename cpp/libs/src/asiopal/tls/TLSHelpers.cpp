@@ -21,6 +21,8 @@
 
 #include "asiopal/tls/TLSHelpers.h"
 
+#include <openssl/evp.h>
+
 using namespace asio;
 
 namespace asiopal
@@ -45,8 +47,27 @@ void TLSHelpers::ApplyConfig(const TLSConfig& config, asio::ssl::context& contex
 		OPTIONS |= ssl::context::no_tlsv1_2;
 	}
 
+	if (!(config.allowSessionResumption && config.useSessionTickets))
+	{
+		OPTIONS |= SSL_OP_NO_TICKET;
+	}
+
 	context.set_options(OPTIONS);
 
+	if (config.allowSessionResumption)
+	{
+		const auto id = SessionContextId(config);
+		SSL_CTX_set_session_id_context(context.native_handle(), reinterpret_cast<const unsigned char*>(id.data()), static_cast<unsigned int>(id.size()));
+		SSL_CTX_set_timeout(context.native_handle(), config.sessionLifetimeSeconds);
+	}
+	else
+	{
+		SSL_CTX_set_session_cache_mode(context.native_handle(), SSL_SESS_CACHE_OFF);
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+		SSL_CTX_set_num_tickets(context.native_handle(), 0);
+#endif
+	}
+
 	// optionally, configure the cipher-list
 	if (!config.cipherList.empty())
 	{
@@ -64,6 +85,16 @@ void TLSHelpers::ApplyConfig(const TLSConfig& config, asio::ssl::context& contex
 	context.use_private_key_file(config.privateKeyFilePath, asio::ssl::context_base::file_format::pem);
 }
 
-}
+std::string TLSHelpers::SessionContextId(const TLSConfig& config)
+{
+	const std::string settings = config.peerCertFilePath + '\n' + config.localCertFilePath + '\n' + config.privateKeyFilePath + '\n' + config.cipherList;
 
+	unsigned char digest[EVP_MAX_MD_SIZE];
+	unsigned int length = 0;
+	EVP_Digest(settings.data(), settings.size(), digest, &length, EVP_sha256(), nullptr);
 
+	static_assert(SSL_MAX_SID_CTX_LENGTH >= 32, "SHA-256 digest must fit in a session id context");
+	return std::string(reinterpret_cast<const char*>(digest), length);
+}
+
+}
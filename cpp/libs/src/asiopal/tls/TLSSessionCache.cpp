@@ -0,0 +1,338 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+
+#include "asiopal/tls/TLSSessionCache.h"
+
+#include "asiopal/tls/TLSHelpers.h"
+
+#include <openssl/rand.h>
+
+#include <ctime>
+
+namespace asiopal
+{
+
+TLSSessionCache::TLSSessionCache(uint32_t maxSessions_) :
+	maxSessions(maxSessions_),
+	generation(0),
+	numFullHandshakes(0),
+	numResumedHandshakes(0)
+{
+	RAND_bytes(ticketKeys, sizeof(ticketKeys));
+}
+
+TLSSessionCache::~TLSSessionCache()
+{
+	for (auto& pair : sessions)
+	{
+		SSL_SESSION_free(pair.second.session);
+	}
+}
+
+void TLSSessionCache::ConfigureClient(const TLSConfig& config, asio::ssl::context& context)
+{
+	if (!config.allowSessionResumption)
+	{
+		return;
+	}
+
+	auto ctx = context.native_handle();
+	SSL_CTX_set_ex_data(ctx, ContextIndex(), this);
+	SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->SetGeneration(ctx);
+	}
+
+	SSL_CTX_sess_set_new_cb(ctx, &TLSSessionCache::OnNewClientSession);
+}
+
+void TLSSessionCache::ConfigureServer(const TLSConfig& config, asio::ssl::context& context)
+{
+	if (!config.allowSessionResumption)
+	{
+		return;
+	}
+
+	auto ctx = context.native_handle();
+	SSL_CTX_set_ex_data(ctx, ContextIndex(), this);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	this->SetGeneration(ctx);
+
+	if (config.useSessionTickets)
+	{
+		// any server context of this cache can decrypt the tickets issued by another
+		SSL_CTX_set_tlsext_ticket_keys(ctx, ticketKeys, sizeof(ticketKeys));
+	}
+	else
+	{
+		SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+		SSL_CTX_sess_set_new_cb(ctx, &TLSSessionCache::OnNewServerSession);
+		SSL_CTX_sess_set_get_cb(ctx, &TLSSessionCache::OnGetServerSession);
+		SSL_CTX_sess_set_remove_cb(ctx, &TLSSessionCache::OnRemoveServerSession);
+	}
+}
+
+void TLSSessionCache::PrepareClient(SSL* ssl, const std::string& key)
+{
+	if (!GetCache(SSL_get_SSL_CTX(ssl)))
+	{
+		return;
+	}
+
+	SSL_set_ex_data(ssl, KeyIndex(), const_cast<std::string*>(&key));
+
+	auto session = this->FindFrom(SSL_get_SSL_CTX(ssl), key);
+	if (session)
+	{
+		SSL_set_session(ssl, session);
+		SSL_SESSION_free(session);
+	}
+}
+
+void TLSSessionCache::Remove(const std::string& key)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	auto entry = sessions.find(key);
+	if (entry != sessions.end())
+	{
+		this->Erase(entry);
+	}
+}
+
+void TLSSessionCache::Invalidate()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	++generation;
+	RAND_bytes(ticketKeys, sizeof(ticketKeys));
+
+	for (auto& pair : sessions)
+	{
+		SSL_SESSION_free(pair.second.session);
+	}
+	sessions.clear();
+	order.clear();
+}
+
+void TLSSessionCache::RecordHandshake(bool resumed)
+{
+	if (resumed)
+	{
+		++numResumedHandshakes;
+	}
+	else
+	{
+		++numFullHandshakes;
+	}
+}
+
+TLSSessionStatistics TLSSessionCache::GetStatistics()
+{
+	TLSSessionStatistics stats;
+	stats.numFullHandshakes = numFullHandshakes;
+	stats.numResumedHandshakes = numResumedHandshakes;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	stats.numCachedSessions = static_cast<uint32_t>(sessions.size());
+	return stats;
+}
+
+std::string TLSSessionCache::ClientKey(const TLSConfig& config, const std::string& host, uint16_t port)
+{
+	return "c" + host + ":" + std::to_string(port) + "/" + TLSHelpers::SessionContextId(config);
+}
+
+int TLSSessionCache::ContextIndex()
+{
+	static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+	return index;
+}
+
+int TLSSessionCache::GenerationIndex()
+{
+	static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+	return index;
+}
+
+int TLSSessionCache::KeyIndex()
+{
+	static const int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+	return index;
+}
+
+TLSSessionCache* TLSSessionCache::GetCache(SSL_CTX* ctx)
+{
+	return static_cast<TLSSessionCache*>(SSL_CTX_get_ex_data(ctx, ContextIndex()));
+}
+
+std::string TLSSessionCache::ServerKey(const unsigned char* id, unsigned int length)
+{
+	return "s" + std::string(reinterpret_cast<const char*>(id), length);
+}
+
+int TLSSessionCache::OnNewClientSession(SSL* ssl, SSL_SESSION* session)
+{
+	auto cache = GetCache(SSL_get_SSL_CTX(ssl));
+	auto key = static_cast<std::string*>(SSL_get_ex_data(ssl, KeyIndex()));
+	if (!(cache && key))
+	{
+		return 0;
+	}
+
+	// TLS 1.3 servers may issue several tickets, the most recent one replaces the others
+	return cache->StoreFrom(SSL_get_SSL_CTX(ssl), *key, session) ? 1 : 0;
+}
+
+int TLSSessionCache::OnNewServerSession(SSL* ssl, SSL_SESSION* session)
+{
+	auto cache = GetCache(SSL_get_SSL_CTX(ssl));
+	if (!cache)
+	{
+		return 0;
+	}
+
+	unsigned int length = 0;
+	auto id = SSL_SESSION_get_id(session, &length);
+	return cache->StoreFrom(SSL_get_SSL_CTX(ssl), ServerKey(id, length), session) ? 1 : 0;
+}
+
+SSL_SESSION* TLSSessionCache::OnGetServerSession(SSL* ssl, const unsigned char* id, int length, int* copy)
+{
+	// Find() already returns a reference owned by OpenSSL
+	*copy = 0;
+	auto cache = GetCache(SSL_get_SSL_CTX(ssl));
+	return cache ? cache->FindFrom(SSL_get_SSL_CTX(ssl), ServerKey(id, static_cast<unsigned int>(length))) : nullptr;
+}
+
+void TLSSessionCache::OnRemoveServerSession(SSL_CTX* ctx, SSL_SESSION* session)
+{
+	auto cache = GetCache(ctx);
+	if (cache)
+	{
+		unsigned int length = 0;
+		auto id = SSL_SESSION_get_id(session, &length);
+		cache->Remove(ServerKey(id, length));
+	}
+}
+
+void TLSSessionCache::SetGeneration(SSL_CTX* ctx)
+{
+	SSL_CTX_set_ex_data(ctx, GenerationIndex(), reinterpret_cast<void*>(generation));
+}
+
+bool TLSSessionCache::IsCurrent(SSL_CTX* ctx) const
+{
+	return reinterpret_cast<uintptr_t>(SSL_CTX_get_ex_data(ctx, GenerationIndex())) == generation;
+}
+
+void TLSSessionCache::Store(const std::string& key, SSL_SESSION* session)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	this->Insert(key, session);
+}
+
+SSL_SESSION* TLSSessionCache::Find(const std::string& key)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return this->Lookup(key);
+}
+
+bool TLSSessionCache::StoreFrom(SSL_CTX* ctx, const std::string& key, SSL_SESSION* session)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (!IsCurrent(ctx))
+	{
+		return false;
+	}
+
+	this->Insert(key, session);
+	return true;
+}
+
+SSL_SESSION* TLSSessionCache::FindFrom(SSL_CTX* ctx, const std::string& key)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return IsCurrent(ctx) ? this->Lookup(key) : nullptr;
+}
+
+void TLSSessionCache::Insert(const std::string& key, SSL_SESSION* session)
+{
+	auto entry = sessions.find(key);
+	if (entry != sessions.end())
+	{
+		this->Erase(entry);
+	}
+
+	if (maxSessions == 0)
+	{
+		SSL_SESSION_free(session);
+		return;
+	}
+
+	while (sessions.size() >= maxSessions)
+	{
+		this->Erase(sessions.find(order.front()));
+	}
+
+	order.push_back(key);
+	Entry value = { session, std::prev(order.end()) };
+	sessions.insert(std::make_pair(key, value));
+}
+
+SSL_SESSION* TLSSessionCache::Lookup(const std::string& key)
+{
+	auto entry = sessions.find(key);
+	if (entry == sessions.end())
+	{
+		return nullptr;
+	}
+
+	auto session = entry->second.session;
+	const auto expires = SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session);
+
+	bool usable = expires > static_cast<long>(std::time(nullptr));
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+	usable = usable && SSL_SESSION_is_resumable(session);
+#endif
+
+	if (!usable)
+	{
+		this->Erase(entry);
+		return nullptr;
+	}
+
+	order.splice(order.end(), order, entry->second.position);
+
+	SSL_SESSION_up_ref(session);
+	return session;
+}
+
+void TLSSessionCache::Erase(std::map<std::string, Entry>::iterator entry)
+{
+	SSL_SESSION_free(entry->second.session);
+	order.erase(entry->second.position);
+	sessions.erase(entry);
+}
+
+}
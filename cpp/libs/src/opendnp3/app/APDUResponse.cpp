@@ -34,6 +34,12 @@ APDUResponse::APDUResponse(const openpal::WSlice& buffer) : APDUWrapper(buffer)
 	remaining.Advance(2);
 }
 
+APDUResponse::APDUResponse(const openpal::WSlice& buffer, uint32_t size) : APDUResponse(buffer)
+{
+	assert(size >= 4 && size <= buffer.Size());
+	remaining.Advance(size - 4);
+}
+
 void APDUResponse::SetIIN(const IINField& indications)
 {
 	buffer[2] = indications.LSB;
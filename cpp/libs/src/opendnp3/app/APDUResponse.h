@@ -34,6 +34,9 @@ public:
 
 	explicit APDUResponse(const openpal::WSlice& aBuffer);
 
+	// resume a response whose first 'size' bytes have already been written to the buffer
+	APDUResponse(const openpal::WSlice& aBuffer, uint32_t size);
+
 	void SetIIN(const IINField& indications);
 
 	IINField GetIIN() const;
@@ -23,10 +23,15 @@
 
 #include <openpal/serialization/Format.h>
 
+#include "opendnp3/app/BitfieldWords.h"
+
 namespace opendnp3
 {
 
 // A facade for writing APDUs to an external buffer
+//
+// Values are accumulated in a 64-bit register and stored a word at a time
+// instead of read-modify-writing the output buffer for every bit
 template <class IndexType>
 class BitfieldRangeWriteIterator
 {
@@ -42,6 +47,7 @@ public:
 		start(start_),
 		count(0),
 		maxCount(0),
+		accumulator(0),
 		isValid(position_.Size() >= (2 * IndexType::SIZE)),
 		range(position_),
 		pPosition(&position_)
@@ -61,14 +67,14 @@ public:
 			typename IndexType::Type stop = start + count - 1;
 			openpal::Format::Write(range, stop);
 
-			auto num = count / 8;
-
-			if ((count % 8) > 0)
+			const uint32_t partial = count % BitfieldWords::BITS_PER_WORD;
+			if (partial > 0)
 			{
-				++num;
+				const uint32_t offset = (count - partial) / 8;
+				BitfieldWords::StorePartialWord(accumulator, *pPosition + offset, BitfieldWords::NumBytes(partial));
 			}
 
-			pPosition->Advance(num);
+			pPosition->Advance(BitfieldWords::NumBytes(count));
 		}
 	}
 
@@ -76,20 +82,18 @@ public:
 	{
 		if (isValid && count < maxCount)
 		{
-			auto byte = count / 8;
-			auto bit = count % 8;
+			const uint32_t bit = count % BitfieldWords::BITS_PER_WORD;
+			accumulator |= static_cast<uint64_t>(value) << bit;
 
-			if (bit == 0)
-			{
-				(*pPosition)[byte] = 0; // initialize byte to 0
-			}
+			++count;
 
-			if (value)
+			if (bit == (BitfieldWords::BITS_PER_WORD - 1))
 			{
-				(*pPosition)[byte] = ((*pPosition)[byte] | (1 << bit));
+				const uint32_t offset = (count - BitfieldWords::BITS_PER_WORD) / 8;
+				BitfieldWords::StoreWord(accumulator, *pPosition + offset);
+				accumulator = 0;
 			}
 
-			++count;
 			return true;
 		}
 		else
@@ -109,6 +113,7 @@ private:
 	typename IndexType::Type count;
 
 	uint32_t maxCount;
+	uint64_t accumulator;
 
 	bool isValid;
 
@@ -0,0 +1,91 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef OPENDNP3_BITFIELDWORDS_H
+#define OPENDNP3_BITFIELDWORDS_H
+
+#include <cstdint>
+
+namespace opendnp3
+{
+
+/**
+* Helpers for packing and unpacking DNP3 bitfields a 64-bit word at a time.
+*
+* Bitfields are little endian with the first value in the least significant bit(s)
+* of the first byte, so a word loaded little endian holds 64 / BITS values in order.
+*/
+struct BitfieldWords
+{
+	static const uint32_t BITS_PER_WORD = 64;
+	static const uint32_t BYTES_PER_WORD = 8;
+
+	static uint32_t NumBytes(uint32_t numBits)
+	{
+		return (numBits + 7) / 8;
+	}
+
+	// the shift/or pattern compiles to a single load on little endian targets
+	static uint64_t LoadWord(const uint8_t* src)
+	{
+		return static_cast<uint64_t>(src[0]) |
+		       (static_cast<uint64_t>(src[1]) << 8) |
+		       (static_cast<uint64_t>(src[2]) << 16) |
+		       (static_cast<uint64_t>(src[3]) << 24) |
+		       (static_cast<uint64_t>(src[4]) << 32) |
+		       (static_cast<uint64_t>(src[5]) << 40) |
+		       (static_cast<uint64_t>(src[6]) << 48) |
+		       (static_cast<uint64_t>(src[7]) << 56);
+	}
+
+	static uint64_t LoadPartialWord(const uint8_t* src, uint32_t numBytes)
+	{
+		uint64_t word = 0;
+		for (uint32_t i = 0; i < numBytes; ++i)
+		{
+			word |= static_cast<uint64_t>(src[i]) << (8 * i);
+		}
+		return word;
+	}
+
+	static void StoreWord(uint64_t word, uint8_t* dest)
+	{
+		dest[0] = static_cast<uint8_t>(word);
+		dest[1] = static_cast<uint8_t>(word >> 8);
+		dest[2] = static_cast<uint8_t>(word >> 16);
+		dest[3] = static_cast<uint8_t>(word >> 24);
+		dest[4] = static_cast<uint8_t>(word >> 32);
+		dest[5] = static_cast<uint8_t>(word >> 40);
+		dest[6] = static_cast<uint8_t>(word >> 48);
+		dest[7] = static_cast<uint8_t>(word >> 56);
+	}
+
+	static void StorePartialWord(uint64_t word, uint8_t* dest, uint32_t numBytes)
+	{
+		for (uint32_t i = 0; i < numBytes; ++i)
+		{
+			dest[i] = static_cast<uint8_t>(word >> (8 * i));
+		}
+	}
+};
+
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include "FragmentBuffer.h"
+
+#include "opendnp3/app/AppConstants.h"
+#include "opendnp3/app/FragmentBufferPool.h"
+
+#include <openpal/util/Comparisons.h>
+
+#include <cstring>
+
+using namespace openpal;
+
+namespace opendnp3
+{
+
+FragmentBuffer::FragmentBuffer(uint32_t maxSize_, bool poolAll) :
+	maxSize(maxSize_),
+	resident(poolAll ? 0 : openpal::Min<uint32_t>(maxSize_, DEFAULT_MAX_APDU_SIZE)),
+	lease(nullptr)
+{
+
+}
+
+FragmentBuffer::~FragmentBuffer()
+{
+	if (lease)
+	{
+		FragmentBufferPool::Release(lease, maxSize);
+	}
+}
+
+uint32_t FragmentBuffer::Capacity() const
+{
+	return lease ? maxSize : resident.Size();
+}
+
+WSlice FragmentBuffer::GetWSlice()
+{
+	return lease ? WSlice(lease, maxSize) : resident.GetWSlice();
+}
+
+RSlice FragmentBuffer::ToRSlice() const
+{
+	return lease ? RSlice(lease, maxSize) : resident.ToRSlice();
+}
+
+bool FragmentBuffer::Grow(uint32_t preserve)
+{
+	if (!this->CanGrow())
+	{
+		return false;
+	}
+
+	lease = FragmentBufferPool::Lease(maxSize);
+	memcpy(lease, resident(), openpal::Min<uint32_t>(preserve, resident.Size()));
+	return true;
+}
+
+bool FragmentBuffer::Shrink(uint32_t preserve)
+{
+	if (!lease)
+	{
+		return true;
+	}
+
+	if (preserve > resident.Size())
+	{
+		return false;
+	}
+
+	memcpy(resident(), lease, preserve);
+	FragmentBufferPool::Release(lease, maxSize);
+	lease = nullptr;
+	return true;
+}
+
+}
@@ -0,0 +1,89 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef OPENDNP3_FRAGMENTBUFFER_H
+#define OPENDNP3_FRAGMENTBUFFER_H
+
+#include <openpal/container/Buffer.h>
+#include <openpal/util/Uncopyable.h>
+
+namespace opendnp3
+{
+
+/**
+* Fragment storage for a configured maximum size that may be well above the default.
+*
+* Only min(maxSize, DEFAULT_MAX_APDU_SIZE) bytes are allocated up front. The full size is leased
+* from the FragmentBufferPool when a fragment actually needs it, and handed back with Shrink() once
+* the owner is done with the large fragment, so idle stacks configured for 64 KB fragments cost
+* no more memory than default ones.
+*
+* With poolAll set nothing is resident, and even the default size is leased only while in use, so an
+* idle stack holds no fragment storage at all.
+*/
+class FragmentBuffer : private openpal::Uncopyable
+{
+
+public:
+
+	explicit FragmentBuffer(uint32_t maxSize, bool poolAll = false);
+
+	~FragmentBuffer();
+
+	uint32_t MaxSize() const
+	{
+		return maxSize;
+	}
+
+	/// Number of bytes currently available, either the resident size or the max size
+	uint32_t Capacity() const;
+
+	bool IsLeased() const
+	{
+		return lease != nullptr;
+	}
+
+	bool CanGrow() const
+	{
+		return Capacity() < maxSize;
+	}
+
+	openpal::WSlice GetWSlice();
+
+	openpal::RSlice ToRSlice() const;
+
+	/// Lease the full max size, copying over the first 'preserve' bytes
+	/// @return false if the buffer was already at its max size
+	bool Grow(uint32_t preserve);
+
+	/// Return the lease to the pool, copying the first 'preserve' bytes back into the resident buffer
+	/// @return false if those bytes do not fit in the resident buffer, in which case the lease is kept
+	bool Shrink(uint32_t preserve);
+
+private:
+
+	const uint32_t maxSize;
+	openpal::Buffer resident;
+	uint8_t* lease;
+};
+
+}
+
+#endif
@@ -0,0 +1,144 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include "FragmentBufferPool.h"
+
+namespace opendnp3
+{
+
+const uint32_t FragmentBufferPool::MIN_BLOCK_SIZE;
+const uint32_t FragmentBufferPool::MAX_BLOCK_SIZE;
+const uint32_t FragmentBufferPool::MAX_RETAINED_PER_CLASS;
+const uint32_t FragmentBufferPool::NUM_CLASSES;
+
+FragmentBufferPool::State::~State()
+{
+	for (auto& list : free)
+	{
+		for (auto block : list)
+		{
+			delete[] block;
+		}
+	}
+}
+
+FragmentBufferPool::State& FragmentBufferPool::GetState()
+{
+	static State state;
+	return state;
+}
+
+uint32_t FragmentBufferPool::ClassOf(uint32_t size)
+{
+	uint32_t blockSize = MIN_BLOCK_SIZE;
+	for (uint32_t i = 0; i < NUM_CLASSES; ++i)
+	{
+		if (size <= blockSize)
+		{
+			return i;
+		}
+		blockSize <<= 1;
+	}
+	return NUM_CLASSES;
+}
+
+uint32_t FragmentBufferPool::BlockSize(uint32_t size)
+{
+	auto index = ClassOf(size);
+	return (index < NUM_CLASSES) ? (MIN_BLOCK_SIZE << index) : size;
+}
+
+uint8_t* FragmentBufferPool::Lease(uint32_t size)
+{
+	auto index = ClassOf(size);
+	auto& state = GetState();
+
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		++state.numLeased;
+		if (index < NUM_CLASSES && !state.free[index].empty())
+		{
+			auto block = state.free[index].back();
+			state.free[index].pop_back();
+			return block;
+		}
+	}
+
+	return new uint8_t[BlockSize(size)];
+}
+
+void FragmentBufferPool::Release(uint8_t* block, uint32_t size)
+{
+	auto index = ClassOf(size);
+	auto& state = GetState();
+
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		--state.numLeased;
+		if (index < NUM_CLASSES && state.free[index].size() < MAX_RETAINED_PER_CLASS)
+		{
+			state.free[index].push_back(block);
+			return;
+		}
+	}
+
+	delete[] block;
+}
+
+uint32_t FragmentBufferPool::NumLeased()
+{
+	auto& state = GetState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	return state.numLeased;
+}
+
+uint32_t FragmentBufferPool::NumRetained()
+{
+	auto& state = GetState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	uint32_t count = 0;
+	for (auto& list : state.free)
+	{
+		count += static_cast<uint32_t>(list.size());
+	}
+	return count;
+}
+
+void FragmentBufferPool::Clear()
+{
+	auto& state = GetState();
+	std::vector<uint8_t*> blocks;
+
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		for (auto& list : state.free)
+		{
+			blocks.insert(blocks.end(), list.begin(), list.end());
+			list.clear();
+		}
+	}
+
+	for (auto block : blocks)
+	{
+		delete[] block;
+	}
+}
+
+}
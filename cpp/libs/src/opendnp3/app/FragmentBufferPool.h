@@ -0,0 +1,90 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef OPENDNP3_FRAGMENTBUFFERPOOL_H
+#define OPENDNP3_FRAGMENTBUFFERPOOL_H
+
+#include <openpal/util/Uncopyable.h>
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace opendnp3
+{
+
+/**
+* Process-wide, thread-safe pool of the large blocks used by FragmentBuffer.
+*
+* Blocks are handed out in power-of-two size classes from 2 KB to 64 KB so that every stack
+* configured for large fragments draws from the same free lists. Requests larger than the
+* biggest class are allocated on demand and freed on release.
+*/
+class FragmentBufferPool : private openpal::StaticOnly
+{
+
+public:
+
+	static const uint32_t MIN_BLOCK_SIZE = 2048;
+	static const uint32_t MAX_BLOCK_SIZE = 65536;
+
+	/// Number of idle blocks retained per size class, extras are freed on release
+	static const uint32_t MAX_RETAINED_PER_CLASS = 32;
+
+	/// @return a block of at least BlockSize(size) bytes
+	static uint8_t* Lease(uint32_t size);
+
+	/// Return a block previously leased with the same size
+	static void Release(uint8_t* block, uint32_t size);
+
+	/// The actual size of the block handed out for a given request
+	static uint32_t BlockSize(uint32_t size);
+
+	/// Number of blocks currently leased, across all stacks
+	static uint32_t NumLeased();
+
+	/// Number of idle blocks held by the pool
+	static uint32_t NumRetained();
+
+	/// Free every idle block
+	static void Clear();
+
+private:
+
+	static const uint32_t NUM_CLASSES = 6;
+
+	// returns NUM_CLASSES for sizes that are not pooled
+	static uint32_t ClassOf(uint32_t size);
+
+	struct State
+	{
+		std::mutex mutex;
+		std::vector<uint8_t*> free[NUM_CLASSES];
+		uint32_t numLeased = 0;
+
+		~State();
+	};
+
+	static State& GetState();
+};
+
+}
+
+#endif
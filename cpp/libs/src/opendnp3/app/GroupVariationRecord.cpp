@@ -58,120 +58,13 @@ uint16_t GroupVariationRecord::GetGroupVar(uint8_t group, uint8_t variation)
 
 EnumAndType GroupVariationRecord::GetEnumAndType(uint8_t group, uint8_t variation)
 {
-	auto type = GetType(group, variation);
-	auto enumeration = GroupVariationFromType(GetGroupVar(group, variation));
-
-	if (enumeration == GroupVariation::UNKNOWN)
-	{
-		switch (group)
-		{
-		case(110) :
-			enumeration = GroupVariation::Group110Var0;
-			break;
-		case(111) :
-			enumeration = GroupVariation::Group111Var0;
-			break;
-		case(112) :
-			enumeration = GroupVariation::Group112Var0;
-			break;
-		case(113) :
-			enumeration = GroupVariation::Group113Var0;
-			break;
-		default:
-			break;
-		}
-	}
-
-	return EnumAndType(enumeration, type);
+	const auto& entry = LookupGroupVariation(group, variation);
+	return EnumAndType(entry.enumeration, entry.type);
 }
 
 GroupVariationType GroupVariationRecord::GetType(uint8_t group, uint8_t variation)
 {
-	switch (group)
-	{
-	case(1) :
-		return GroupVariationType::STATIC;
-
-	case(2) :
-		return GroupVariationType::EVENT;
-
-	case(3) :
-		return GroupVariationType::STATIC;
-
-	case(4) :
-		return GroupVariationType::EVENT;
-
-	case(10) :
-		return GroupVariationType::STATIC;
-
-	case(11) :
-		return GroupVariationType::EVENT;
-
-	case(13) :
-		return GroupVariationType::EVENT;
-
-	case(20) :
-		return GroupVariationType::STATIC;
-
-	case(21) :
-		return GroupVariationType::STATIC;
-
-	case(22) :
-		return GroupVariationType::EVENT;
-
-	case(23) :
-		return GroupVariationType::EVENT;
-
-	case(30) :
-		return GroupVariationType::STATIC;
-
-	case(32) :
-		return GroupVariationType::EVENT;
-
-	case(40) :
-		return GroupVariationType::STATIC;
-
-	case(41) :
-		return GroupVariationType::EVENT;
-
-	case(42) :
-		return GroupVariationType::EVENT;
-
-	case(43) :
-		return GroupVariationType::EVENT;
-
-	case(50) :
-		switch (variation)
-		{
-		case(4) :
-			return GroupVariationType::STATIC;
-		default:
-			return GroupVariationType::OTHER;
-		}
-
-	case(60):
-		switch (variation)
-		{
-		case(1) :
-			return GroupVariationType::STATIC;
-		default:
-			return GroupVariationType::EVENT;
-		}
-
-	case(110):
-		return GroupVariationType::STATIC;
-
-	case(111):
-		return GroupVariationType::EVENT;
-
-	case(121) :
-		return GroupVariationType::STATIC;
-	case(122) :
-		return GroupVariationType::EVENT;
-
-	default:
-		return GroupVariationType::OTHER;
-	}
+	return LookupGroupVariation(group, variation).type;
 }
 
 } //end ns
@@ -28,6 +28,7 @@
 #include "opendnp3/gen/QualifierCode.h"
 #include "opendnp3/gen/TimestampMode.h"
 #include "opendnp3/gen/GroupVariation.h"
+#include "opendnp3/gen/GroupVariationTable.h"
 
 #include "opendnp3/app/Range.h"
 
@@ -35,13 +36,6 @@
 namespace opendnp3
 {
 
-enum class GroupVariationType : int
-{
-    STATIC,
-    EVENT,
-    OTHER
-};
-
 struct EnumAndType
 {
 	EnumAndType(GroupVariation enumeration_, GroupVariationType type_) :
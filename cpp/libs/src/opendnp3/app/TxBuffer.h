@@ -21,25 +21,65 @@
 #ifndef OPENDNP3_TXBUFFER_H
 #define OPENDNP3_TXBUFFER_H
 
-#include <openpal/container/Buffer.h>
-#include <opendnp3/app/APDUResponse.h>
+#include "opendnp3/app/APDUResponse.h"
+#include "opendnp3/app/FragmentBuffer.h"
 
 namespace opendnp3
 {
 
+/**
+* Transmit buffer for responses. Responses are built in a default-sized buffer and only move to a
+* pooled buffer of the full configured size when they don't fit.
+*/
 class TxBuffer
 {
 public:
 
-	TxBuffer(uint32_t maxTxSize) : buffer(maxTxSize)
+	TxBuffer(uint32_t maxTxSize, bool poolAll = false) : buffer(maxTxSize, poolAll)
 	{}
 
-	APDUResponse Start()
+	/// Start a new response, growing up front if the caller knows it needs more than the default size
+	APDUResponse Start(uint32_t sizeHint = 0)
 	{
+		if (sizeHint > buffer.Capacity() || buffer.Capacity() == 0)
+		{
+			buffer.Grow(0);
+		}
+
 		APDUResponse response(buffer.GetWSlice());
 		return response;
 	}
 
+	bool CanGrow() const
+	{
+		return buffer.CanGrow();
+	}
+
+	/// Move a partially built response into a buffer of the full size so that it can be continued
+	APDUResponse Grow(const APDUResponse& partial)
+	{
+		auto size = partial.Size();
+		buffer.Grow(size);
+		APDUResponse response(buffer.GetWSlice(), size);
+		return response;
+	}
+
+	/// Hand any large buffer back to the pool. If the last response may still be repeated it is kept,
+	/// which holds on to the large buffer when the response doesn't fit in the default size.
+	void Trim(bool keepLastResponse)
+	{
+		if (!buffer.IsLeased())
+		{
+			return;
+		}
+
+		auto size = keepLastResponse ? lastResponse.Size() : 0;
+		if (buffer.Shrink(size))
+		{
+			lastResponse = buffer.ToRSlice().Take(size);
+		}
+	}
+
 	void Record(const openpal::RSlice& view)
 	{
 		lastResponse = view;
@@ -53,7 +93,7 @@ public:
 private:
 
 	openpal::RSlice lastResponse;
-	openpal::Buffer buffer;
+	FragmentBuffer buffer;
 };
 
 }
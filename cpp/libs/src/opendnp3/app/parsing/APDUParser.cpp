@@ -48,6 +48,22 @@ ParseResult APDUParser::Parse(const openpal::RSlice& buffer, IAPDUHandler& handl
 }
 
 ParseResult APDUParser::Parse(const openpal::RSlice& buffer, IAPDUHandler& handler, openpal::Logger* pLogger, ParserSettings settings)
+{
+	// validate every header with logging and white-listing, recording each one so that it doesn't have to be parsed again
+	HeaderIndex index;
+	auto result = ParseHeaders(buffer, pLogger, nullptr, &handler, &index, settings);
+	if (result != ParseResult::OK)
+	{
+		return result;
+	}
+
+	index.InvokeAll(handler);
+
+	// any headers that didn't fit in the index are parsed a 2nd time with the handler but no logging or white-list
+	return index.IsComplete() ? ParseResult::OK : ParseHeaders(index.Remainder(), nullptr, &handler, nullptr, nullptr, settings, index.Size());
+}
+
+ParseResult APDUParser::ParseTwoPass(const openpal::RSlice& buffer, IAPDUHandler& handler, openpal::Logger* pLogger, ParserSettings settings)
 {
 	// do two state parsing process with logging and white-listing first but no handling on the first pass
 	auto result = ParseSinglePass(buffer, pLogger, nullptr, &handler, settings);
@@ -62,21 +78,38 @@ ParseResult APDUParser::ParseAndLogAll(const openpal::RSlice& buffer, openpal::L
 
 ParseResult APDUParser::ParseSinglePass(const openpal::RSlice& buffer, openpal::Logger* pLogger, IAPDUHandler* pHandler, IWhiteList* pWhiteList, const ParserSettings& settings)
 {
-	uint32_t count = 0;
+	return ParseHeaders(buffer, pLogger, pHandler, pWhiteList, nullptr, settings);
+}
+
+ParseResult APDUParser::ParseHeaders(const openpal::RSlice& buffer, openpal::Logger* pLogger, IAPDUHandler* pHandler, IWhiteList* pWhiteList, HeaderIndex* pIndex, const ParserSettings& settings, uint32_t firstHeader)
+{
+	uint32_t count = firstHeader;
 	RSlice copy(buffer);
 	while(copy.Size() > 0)
 	{
-		auto result = ParseHeader(copy, pLogger, count, settings, pHandler, pWhiteList);
+		const RSlice position(copy);
+		ParsedHeader header;
+		auto result = ParseHeader(copy, pLogger, count, settings, pWhiteList, header);
 		++count;
 		if (result != ParseResult::OK)
 		{
 			return result;
 		}
+
+		if (pHandler)
+		{
+			header.Invoke(*pHandler);
+		}
+
+		if (pIndex)
+		{
+			pIndex->Add(header, position);
+		}
 	}
 	return ParseResult::OK;
 }
 
-ParseResult APDUParser::ParseHeader(RSlice& buffer, openpal::Logger* pLogger, uint32_t count, const ParserSettings& settings, IAPDUHandler* pHandler, IWhiteList* pWhiteList)
+ParseResult APDUParser::ParseHeader(RSlice& buffer, openpal::Logger* pLogger, uint32_t count, const ParserSettings& settings, IWhiteList* pWhiteList, ParsedHeader& parsed)
 {
 	ObjectHeader header;
 	auto result = ObjectHeaderParser::ParseObjectHeader(header, buffer, pLogger);
@@ -110,36 +143,36 @@ ParseResult APDUParser::ParseHeader(RSlice& buffer, openpal::Logger* pLogger, ui
 	}
 
 
-	return APDUParser::ParseQualifier(buffer, pLogger, HeaderRecord(GV, header.qualifier, count), settings, pHandler);
+	return APDUParser::ParseQualifier(buffer, pLogger, HeaderRecord(GV, header.qualifier, count), settings, parsed);
 }
 
-ParseResult APDUParser::ParseQualifier(RSlice& buffer, openpal::Logger* pLogger, const HeaderRecord& record, const ParserSettings& settings, IAPDUHandler* pHandler)
+ParseResult APDUParser::ParseQualifier(RSlice& buffer, openpal::Logger* pLogger, const HeaderRecord& record, const ParserSettings& settings, ParsedHeader& header)
 {
 	switch (record.GetQualifierCode())
 	{
 	case(QualifierCode::ALL_OBJECTS) :
-		return HandleAllObjectsHeader(pLogger, record, settings, pHandler);
+		return ParseAllObjectsHeader(pLogger, record, settings, header);
 
 	case(QualifierCode::UINT8_CNT) :
-		return CountParser::ParseHeader(buffer, NumParser::OneByte(), settings, record, pLogger, pHandler);
+		return CountParser::ParseHeader(buffer, NumParser::OneByte(), settings, record, pLogger, header);
 
 	case(QualifierCode::UINT16_CNT) :
-		return CountParser::ParseHeader(buffer, NumParser::TwoByte(), settings, record, pLogger, pHandler);
+		return CountParser::ParseHeader(buffer, NumParser::TwoByte(), settings, record, pLogger, header);
 
 	case(QualifierCode::UINT8_START_STOP) :
-		return RangeParser::ParseHeader(buffer, NumParser::OneByte(), settings, record, pLogger, pHandler);
+		return RangeParser::ParseHeader(buffer, NumParser::OneByte(), settings, record, pLogger, header);
 
 	case(QualifierCode::UINT16_START_STOP) :
-		return RangeParser::ParseHeader(buffer, NumParser::TwoByte(), settings, record, pLogger, pHandler);
+		return RangeParser::ParseHeader(buffer, NumParser::TwoByte(), settings, record, pLogger, header);
 
 	case(QualifierCode::UINT8_CNT_UINT8_INDEX) :
-		return CountIndexParser::ParseHeader(buffer, NumParser::OneByte(), settings, record, pLogger, pHandler);
+		return CountIndexParser::ParseHeader(buffer, NumParser::OneByte(), settings, record, pLogger, header);
 
 	case(QualifierCode::UINT16_CNT_UINT16_INDEX) :
-		return CountIndexParser::ParseHeader(buffer, NumParser::TwoByte(), settings, record, pLogger, pHandler);
+		return CountIndexParser::ParseHeader(buffer, NumParser::TwoByte(), settings, record, pLogger, header);
 
 	case(QualifierCode::UINT16_FREE_FORMAT) :
-		return FreeFormatParser::ParseHeader(buffer, settings, record, pLogger, pHandler);
+		return FreeFormatParser::ParseHeader(buffer, settings, record, pLogger, header);
 
 	default:
 		FORMAT_LOGGER_BLOCK(pLogger, flags::WARN, "Unknown qualifier %x", record.qualifier);
@@ -147,7 +180,7 @@ ParseResult APDUParser::ParseQualifier(RSlice& buffer, openpal::Logger* pLogger,
 	}
 }
 
-ParseResult APDUParser::HandleAllObjectsHeader(openpal::Logger* pLogger, const HeaderRecord& record, const ParserSettings& settings, IAPDUHandler* pHandler)
+ParseResult APDUParser::ParseAllObjectsHeader(openpal::Logger* pLogger, const HeaderRecord& record, const ParserSettings& settings, ParsedHeader& header)
 {
 	FORMAT_LOGGER_BLOCK(pLogger, settings.Filters(),
 	                    "%03u,%03u - %s - %s",
@@ -156,13 +189,16 @@ ParseResult APDUParser::HandleAllObjectsHeader(openpal::Logger* pLogger, const H
 	                    GroupVariationToString(record.enumeration),
 	                    QualifierCodeToString(QualifierCode::ALL_OBJECTS));
 
-	if (pHandler)
-	{
-		pHandler->OnHeader(AllObjectsHeader(record));
-	}
+	header.record = record;
+	header.invoke = &InvokeAllObjects;
 
 	return ParseResult::OK;
 }
 
+void APDUParser::InvokeAllObjects(const ParsedHeader& header, IAPDUHandler& handler)
+{
+	handler.OnHeader(AllObjectsHeader(header.record));
+}
+
 }
 
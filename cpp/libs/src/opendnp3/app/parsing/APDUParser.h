@@ -28,6 +28,7 @@
 #include "opendnp3/app/parsing/ParseResult.h"
 #include "opendnp3/app/parsing/ParserSettings.h"
 #include "opendnp3/app/parsing/NumParser.h"
+#include "opendnp3/app/parsing/HeaderIndex.h"
 
 namespace opendnp3
 {
@@ -44,6 +45,8 @@ public:
 
 	static ParseResult ParseSinglePass(const openpal::RSlice& buffer, openpal::Logger* pLogger, IAPDUHandler* pHandler, IWhiteList* pWhiteList, const ParserSettings& settings);
 
+	static ParseResult ParseTwoPass(const openpal::RSlice& buffer, IAPDUHandler& handler, openpal::Logger* pLogger, ParserSettings settings = ParserSettings::Default());
+
 private:
 
 	static bool AllowAll(uint32_t headerCount, GroupVariation gv, QualifierCode qc)
@@ -51,13 +54,15 @@ private:
 		return true;
 	}
 
-	static ParseResult ParseHeaders(const openpal::RSlice& buffer, openpal::Logger* pLogger, const ParserSettings& settings, IAPDUHandler* pHandler);
+	static ParseResult ParseHeaders(const openpal::RSlice& buffer, openpal::Logger* pLogger, IAPDUHandler* pHandler, IWhiteList* pWhiteList, HeaderIndex* pIndex, const ParserSettings& settings, uint32_t firstHeader = 0);
+
+	static ParseResult ParseHeader(openpal::RSlice& buffer, openpal::Logger* pLogger, uint32_t count, const ParserSettings& settings, IWhiteList* pWhiteList, ParsedHeader& header);
 
-	static ParseResult ParseHeader(openpal::RSlice& buffer, openpal::Logger* pLogger, uint32_t count, const ParserSettings& settings, IAPDUHandler* pHandler, IWhiteList* pWhiteList);
+	static ParseResult ParseQualifier(openpal::RSlice& buffer, openpal::Logger* pLogger, const HeaderRecord& record, const ParserSettings& settings, ParsedHeader& header);
 
-	static ParseResult ParseQualifier(openpal::RSlice& buffer, openpal::Logger* pLogger, const HeaderRecord& record, const ParserSettings& settings, IAPDUHandler* pHandler);
+	static ParseResult ParseAllObjectsHeader(openpal::Logger* pLogger, const HeaderRecord& record, const ParserSettings& settings, ParsedHeader& header);
 
-	static ParseResult HandleAllObjectsHeader(openpal::Logger* pLogger, const HeaderRecord& record, const ParserSettings& settings, IAPDUHandler* pHandler);
+	static void InvokeAllObjects(const ParsedHeader& header, IAPDUHandler& handler);
 };
 
 }
@@ -0,0 +1,146 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef OPENDNP3_BITFIELDCOLLECTION_H
+#define OPENDNP3_BITFIELDCOLLECTION_H
+
+#include "opendnp3/app/parsing/ICollection.h"
+#include "opendnp3/app/BitfieldWords.h"
+#include "opendnp3/app/Indexed.h"
+#include "opendnp3/gen/DoubleBit.h"
+
+#include <openpal/container/RSlice.h>
+
+namespace opendnp3
+{
+
+// maps the raw bits of a single bitfield entry to the value used to construct the measurement
+template <uint8_t BITS>
+struct BitfieldValue;
+
+template <>
+struct BitfieldValue<1>
+{
+	static bool Get(uint64_t bits)
+	{
+		return bits != 0;
+	}
+};
+
+template <>
+struct BitfieldValue<2>
+{
+	static DoubleBit Get(uint64_t bits)
+	{
+		return DoubleBitFromType(static_cast<uint8_t>(bits));
+	}
+};
+
+/**
+* A collection over a packed bitfield (g1v1, g3v1, g10v1, g80v1) that loads
+* a 64-bit word at a time and shifts the values out of the register
+*/
+template <class T, uint8_t BITS>
+class BitfieldCollection : public ICollection<Indexed<T>>
+{
+	static const uint32_t VALUES_PER_WORD = BitfieldWords::BITS_PER_WORD / BITS;
+	static const uint64_t MASK = (1u << BITS) - 1;
+
+public:
+
+	BitfieldCollection(const openpal::RSlice& buffer_, uint16_t start_, uint32_t count) :
+		buffer(buffer_),
+		start(start_),
+		COUNT(count)
+	{}
+
+	virtual uint32_t Count() const override final
+	{
+		return COUNT;
+	}
+
+	virtual void Foreach(IVisitor<Indexed<T>>& visitor) const override final
+	{
+		auto visit = [&visitor](const Indexed<T>& item)
+		{
+			visitor.OnValue(item);
+		};
+
+		this->Decode(COUNT, visit);
+	}
+
+	virtual uint32_t ReadInto(Indexed<T>* values, uint32_t max) const override final
+	{
+		const uint32_t NUM = (max < COUNT) ? max : COUNT;
+
+		auto copy = [&values](const Indexed<T>& item)
+		{
+			*values = item;
+			++values;
+		};
+
+		this->Decode(NUM, copy);
+		return NUM;
+	}
+
+private:
+
+	template <class Output>
+	void Decode(uint32_t num, const Output& output) const
+	{
+		const uint8_t* src = buffer;
+		uint16_t index = start;
+		uint32_t remaining = num;
+
+		while (remaining > 0)
+		{
+			uint32_t count = VALUES_PER_WORD;
+			uint64_t word = 0;
+
+			if (remaining >= VALUES_PER_WORD)
+			{
+				word = BitfieldWords::LoadWord(src);
+				src += BitfieldWords::BYTES_PER_WORD;
+			}
+			else
+			{
+				count = remaining;
+				word = BitfieldWords::LoadPartialWord(src, BitfieldWords::NumBytes(count * BITS));
+			}
+
+			remaining -= count;
+
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				output(WithIndex(T(BitfieldValue<BITS>::Get(word & MASK)), index));
+				word >>= BITS;
+				++index;
+			}
+		}
+	}
+
+	openpal::RSlice buffer;
+	uint16_t start;
+	const uint32_t COUNT;
+};
+
+}
+
+#endif
@@ -23,6 +23,8 @@
 
 #include "opendnp3/app/parsing/ICollection.h"
 
+#include <openpal/container/RSlice.h>
+
 namespace opendnp3
 {
 
@@ -53,6 +55,18 @@ public:
 		}
 	}
 
+	virtual uint32_t ReadInto(T* values, uint32_t max) const override final
+	{
+		openpal::RSlice copy(buffer);
+
+		const uint32_t NUM = (max < COUNT) ? max : COUNT;
+		for (uint32_t pos = 0; pos < NUM; ++pos)
+		{
+			values[pos] = readFunc(copy, pos);
+		}
+		return NUM;
+	}
+
 private:
 
 	openpal::RSlice buffer;
@@ -23,6 +23,8 @@
 
 #include "opendnp3/app/parsing/ICollection.h"
 
+#include <type_traits>
+
 namespace opendnp3
 {
 
@@ -51,6 +53,16 @@ public:
 		}
 	}
 
+	virtual uint32_t ReadInto(T* values, uint32_t max) const override final
+	{
+		const uint32_t NUM = (max < COUNT) ? max : COUNT;
+		for (uint32_t i = 0; i < NUM; ++i)
+		{
+			values[i] = pArray[i];
+		}
+		return NUM;
+	}
+
 private:
 
 	const T* pArray;
@@ -81,8 +93,39 @@ public:
 		input->ForeachItem(process);
 	}
 
+	virtual uint32_t ReadInto(U* values, uint32_t max) const override final
+	{
+		return this->ReadTransformed(values, max, std::is_same<T, U>());
+	}
+
 private:
 
+	// same type in and out, the input decodes in bulk and the values are transformed in place
+	uint32_t ReadTransformed(U* values, uint32_t max, std::true_type) const
+	{
+		const auto NUM = input->ReadInto(values, max);
+		for (uint32_t i = 0; i < NUM; ++i)
+		{
+			values[i] = transform(values[i]);
+		}
+		return NUM;
+	}
+
+	uint32_t ReadTransformed(U* values, uint32_t max, std::false_type) const
+	{
+		uint32_t num = 0;
+		auto copy = [this, values, max, &num](const T & elem)
+		{
+			if (num < max)
+			{
+				values[num] = transform(elem);
+				++num;
+			}
+		};
+		input->ForeachItem(copy);
+		return num;
+	}
+
 	const ICollection<T>* input;
 	Transform transform;
 
@@ -24,14 +24,21 @@
 
 #include "opendnp3/ErrorCodes.h"
 
+#include "opendnp3/objects/Group1.h"
 #include "opendnp3/objects/Group2.h"
+#include "opendnp3/objects/Group3.h"
 #include "opendnp3/objects/Group4.h"
+#include "opendnp3/objects/Group10.h"
 #include "opendnp3/objects/Group11.h"
 #include "opendnp3/objects/Group12.h"
 #include "opendnp3/objects/Group13.h"
+#include "opendnp3/objects/Group20.h"
+#include "opendnp3/objects/Group21.h"
 #include "opendnp3/objects/Group22.h"
 #include "opendnp3/objects/Group23.h"
+#include "opendnp3/objects/Group30.h"
 #include "opendnp3/objects/Group32.h"
+#include "opendnp3/objects/Group40.h"
 #include "opendnp3/objects/Group41.h"
 #include "opendnp3/objects/Group42.h"
 #include "opendnp3/objects/Group43.h"
@@ -43,11 +50,11 @@ using namespace openpal;
 namespace opendnp3
 {
 
-CountIndexParser::CountIndexParser(uint16_t count_, uint32_t requiredSize_, const NumParser& numparser_, HandleFun handler_) :
+CountIndexParser::CountIndexParser(uint16_t count_, uint32_t requiredSize_, const NumParser& numparser_, ParsedHeader::InvokeFun invoke_) :
 	count(count_),
 	requiredSize(requiredSize_),
 	numparser(numparser_),
-	handler(handler_)
+	invoke(invoke_)
 {}
 
 ParseResult CountIndexParser::ParseHeader(
@@ -56,7 +63,7 @@ ParseResult CountIndexParser::ParseHeader(
     const ParserSettings& settings,
     const HeaderRecord& record,
     openpal::Logger* pLogger,
-    IAPDUHandler* pHandler)
+    ParsedHeader& header)
 {
 	uint16_t count;
 	auto res = numparser.ParseCount(buffer, count, pLogger);
@@ -70,7 +77,7 @@ ParseResult CountIndexParser::ParseHeader(
 		                    QualifierCodeToString(record.GetQualifierCode()),
 		                    count);
 
-		return ParseCountOfObjects(buffer, record, numparser, count, pLogger, pHandler);
+		return ParseCountOfObjects(buffer, record, numparser, count, pLogger, header);
 	}
 	else
 	{
@@ -78,7 +85,7 @@ ParseResult CountIndexParser::ParseHeader(
 	}
 }
 
-ParseResult CountIndexParser::Process(const HeaderRecord& record, openpal::RSlice& buffer, IAPDUHandler* pHandler, openpal::Logger* pLogger) const
+ParseResult CountIndexParser::Process(const HeaderRecord& record, openpal::RSlice& buffer, ParsedHeader& header, openpal::Logger* pLogger) const
 {
 	if (buffer.Size() < requiredSize)
 	{
@@ -87,134 +94,188 @@ ParseResult CountIndexParser::Process(const HeaderRecord& record, openpal::RSlic
 	}
 	else
 	{
-		if (pHandler)
-		{
-			handler(record, count, numparser, buffer, *pHandler);
-		}
+		header.record = record;
+		header.count = count;
+		header.numparser = numparser;
+		header.objects = buffer.Take(requiredSize);
+		header.invoke = invoke;
 		buffer.Advance(requiredSize);
 		return ParseResult::OK;
 	}
 }
 
 
-ParseResult CountIndexParser::ParseCountOfObjects(openpal::RSlice& buffer, const HeaderRecord& record, const NumParser& numparser, uint16_t count, openpal::Logger* pLogger, IAPDUHandler* pHandler)
+ParseResult CountIndexParser::ParseCountOfObjects(openpal::RSlice& buffer, const HeaderRecord& record, const NumParser& numparser, uint16_t count, openpal::Logger* pLogger, ParsedHeader& header)
 {
 	switch (record.enumeration)
 	{
+	case(GroupVariation::Group1Var2) :
+		return CountIndexParser::From<Group1Var2>(count, numparser).Process(record, buffer, header, pLogger);
+
+	case(GroupVariation::Group3Var2) :
+		return CountIndexParser::From<Group3Var2>(count, numparser).Process(record, buffer, header, pLogger);
+
+	case(GroupVariation::Group10Var2) :
+		return CountIndexParser::From<Group10Var2>(count, numparser).Process(record, buffer, header, pLogger);
+
+	case(GroupVariation::Group20Var1) :
+		return CountIndexParser::From<Group20Var1>(count, numparser).Process(record, buffer, header, pLogger);
+	case(GroupVariation::Group20Var2) :
+		return CountIndexParser::From<Group20Var2>(count, numparser).Process(record, buffer, header, pLogger);
+	case(GroupVariation::Group20Var5) :
+		return CountIndexParser::From<Group20Var5>(count, numparser).Process(record, buffer, header, pLogger);
+	case(GroupVariation::Group20Var6) :
+		return CountIndexParser::From<Group20Var6>(count, numparser).Process(record, buffer, header, pLogger);
+
+	case(GroupVariation::Group21Var1) :
+		return CountIndexParser::From<Group21Var1>(count, numparser).Process(record, buffer, header, pLogger);
+	case(GroupVariation::Group21Var2) :
+		return CountIndexParser::From<Group21Var2>(count, numparser).Process(record, buffer, header, pLogger);
+	case(GroupVariation::Group21Var5) :
+		return CountIndexParser::From<Group21Var5>(count, numparser).Process(record, buffer, header, pLogger);
+	case(GroupVariation::Group21Var6) :
+		return CountIndexParser::From<Group21Var6>(count, numparser).Process(record, buffer, header, pLogger);
+	case(GroupVariation::Group21Var9) :
+		return CountIndexParser::From<Group21Var9>(count, numparser).Process(record, buffer, header, pLogger);
+	case(GroupVariation::Group21Var10) :
+		return CountIndexParser::From<Group21Var10>(count, numparser).Process(record, buffer, header, pLogger);
+
+	case(GroupVariation::Group30Var1) :
+		return CountIndexParser::From<Group30Var1>(count, numparser).Process(record, buffer, header, pLogger);
+	case(GroupVariation::Group30Var2) :
+		return CountIndexParser::From<Group30Var2>(count, numparser).Process(record, buffer, header, pLogger);
+	case(GroupVariation::Group30Var3) :
+		return CountIndexParser::From<Group30Var3>(count, numparser).Process(record, buffer, header, pLogger);
+	case(GroupVariation::Group30Var4) :
+		return CountIndexParser::From<Group30Var4>(count, numparser).Process(record, buffer, header, pLogger);
+	case(GroupVariation::Group30Var5) :
+		return CountIndexParser::From<Group30Var5>(count, numparser).Process(record, buffer, header, pLogger);
+	case(GroupVariation::Group30Var6) :
+		return CountIndexParser::From<Group30Var6>(count, numparser).Process(record, buffer, header, pLogger);
+
+	case(GroupVariation::Group40Var1) :
+		return CountIndexParser::From<Group40Var1>(count, numparser).Process(record, buffer, header, pLogger);
+	case(GroupVariation::Group40Var2) :
+		return CountIndexParser::From<Group40Var2>(count, numparser).Process(record, buffer, header, pLogger);
+	case(GroupVariation::Group40Var3) :
+		return CountIndexParser::From<Group40Var3>(count, numparser).Process(record, buffer, header, pLogger);
+	case(GroupVariation::Group40Var4) :
+		return CountIndexParser::From<Group40Var4>(count, numparser).Process(record, buffer, header, pLogger);
+
 	case(GroupVariation::Group2Var1) :
-		return CountIndexParser::From<Group2Var1>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group2Var1>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group2Var2) :
-		return CountIndexParser::From<Group2Var2>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group2Var2>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group2Var3) :
-		return CountIndexParser::From<Group2Var3>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group2Var3>(count, numparser).Process(record, buffer, header, pLogger);
 
 	case(GroupVariation::Group4Var1) :
-		return CountIndexParser::From<Group4Var1>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group4Var1>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group4Var2) :
-		return CountIndexParser::From<Group4Var2>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group4Var2>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group4Var3) :
-		return CountIndexParser::From<Group4Var3>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group4Var3>(count, numparser).Process(record, buffer, header, pLogger);
 
 
 	case(GroupVariation::Group11Var1) :
-		return CountIndexParser::From<Group11Var1>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group11Var1>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group11Var2) :
-		return CountIndexParser::From<Group11Var2>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group11Var2>(count, numparser).Process(record, buffer, header, pLogger);
 
 	case(GroupVariation::Group12Var1) :
-		return CountIndexParser::From<Group12Var1>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group12Var1>(count, numparser).Process(record, buffer, header, pLogger);
 
 	case(GroupVariation::Group13Var1) :
-		return CountIndexParser::From<Group13Var1>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group13Var1>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group13Var2) :
-		return CountIndexParser::From<Group13Var2>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group13Var2>(count, numparser).Process(record, buffer, header, pLogger);
 
 	case(GroupVariation::Group22Var1) :
-		return CountIndexParser::From<Group22Var1>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group22Var1>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group22Var2) :
-		return CountIndexParser::From<Group22Var2>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group22Var2>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group22Var5) :
-		return CountIndexParser::From<Group22Var5>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group22Var5>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group22Var6) :
-		return CountIndexParser::From<Group22Var6>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group22Var6>(count, numparser).Process(record, buffer, header, pLogger);
 
 	case(GroupVariation::Group23Var1) :
-		return CountIndexParser::From<Group23Var1>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group23Var1>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group23Var2) :
-		return CountIndexParser::From<Group23Var2>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group23Var2>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group23Var5) :
-		return CountIndexParser::From<Group23Var5>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group23Var5>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group23Var6) :
-		return CountIndexParser::From<Group23Var6>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group23Var6>(count, numparser).Process(record, buffer, header, pLogger);
 
 	case(GroupVariation::Group32Var1) :
-		return CountIndexParser::From<Group32Var1>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group32Var1>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group32Var2) :
-		return CountIndexParser::From<Group32Var2>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group32Var2>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group32Var3) :
-		return CountIndexParser::From<Group32Var3>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group32Var3>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group32Var4) :
-		return CountIndexParser::From<Group32Var4>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group32Var4>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group32Var5) :
-		return CountIndexParser::From<Group32Var5>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group32Var5>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group32Var6) :
-		return CountIndexParser::From<Group32Var6>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group32Var6>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group32Var7) :
-		return CountIndexParser::From<Group32Var7>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group32Var7>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group32Var8) :
-		return CountIndexParser::From<Group32Var8>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group32Var8>(count, numparser).Process(record, buffer, header, pLogger);
 
 	case(GroupVariation::Group41Var1) :
-		return CountIndexParser::From<Group41Var1>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group41Var1>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group41Var2) :
-		return CountIndexParser::From<Group41Var2>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group41Var2>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group41Var3) :
-		return CountIndexParser::From<Group41Var3>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group41Var3>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group41Var4) :
-		return CountIndexParser::From<Group41Var4>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group41Var4>(count, numparser).Process(record, buffer, header, pLogger);
 
 	case(GroupVariation::Group42Var1) :
-		return CountIndexParser::From<Group42Var1>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group42Var1>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group42Var2) :
-		return CountIndexParser::From<Group42Var2>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group42Var2>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group42Var3) :
-		return CountIndexParser::From<Group42Var3>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group42Var3>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group42Var4) :
-		return CountIndexParser::From<Group42Var4>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group42Var4>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group42Var5) :
-		return CountIndexParser::From<Group42Var5>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group42Var5>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group42Var6) :
-		return CountIndexParser::From<Group42Var6>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group42Var6>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group42Var7) :
-		return CountIndexParser::From<Group42Var7>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group42Var7>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group42Var8) :
-		return CountIndexParser::From<Group42Var8>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group42Var8>(count, numparser).Process(record, buffer, header, pLogger);
 
 	case(GroupVariation::Group43Var1) :
-		return CountIndexParser::From<Group43Var1>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group43Var1>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group43Var2) :
-		return CountIndexParser::From<Group43Var2>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group43Var2>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group43Var3) :
-		return CountIndexParser::From<Group43Var3>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group43Var3>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group43Var4) :
-		return CountIndexParser::From<Group43Var4>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group43Var4>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group43Var5) :
-		return CountIndexParser::From<Group43Var5>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group43Var5>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group43Var6) :
-		return CountIndexParser::From<Group43Var6>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group43Var6>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group43Var7) :
-		return CountIndexParser::From<Group43Var7>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group43Var7>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group43Var8) :
-		return CountIndexParser::From<Group43Var8>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group43Var8>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group50Var4) :
-		return CountIndexParser::From<Group50Var4>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::From<Group50Var4>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group111Var0) :
-		return ParseIndexPrefixedOctetData(buffer, record, numparser, count, pLogger, pHandler);
+		return ParseIndexPrefixedOctetData(buffer, record, numparser, count, pLogger, header);
 
 	case(GroupVariation::Group122Var1) :
-		return CountIndexParser::FromType<Group122Var1>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::FromType<Group122Var1>(count, numparser).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group122Var2) :
-		return CountIndexParser::FromType<Group122Var2>(count, numparser).Process(record, buffer, pHandler, pLogger);
+		return CountIndexParser::FromType<Group122Var2>(count, numparser).Process(record, buffer, header, pLogger);
 
 	default:
 
@@ -226,7 +287,7 @@ ParseResult CountIndexParser::ParseCountOfObjects(openpal::RSlice& buffer, const
 	}
 }
 
-ParseResult CountIndexParser::ParseIndexPrefixedOctetData(openpal::RSlice& buffer, const HeaderRecord& record, const NumParser& numparser, uint32_t count, openpal::Logger* pLogger, IAPDUHandler* pHandler)
+ParseResult CountIndexParser::ParseIndexPrefixedOctetData(openpal::RSlice& buffer, const HeaderRecord& record, const NumParser& numparser, uint16_t count, openpal::Logger* pLogger, ParsedHeader& header)
 {
 	if (record.variation == 0)
 	{
@@ -242,22 +303,31 @@ ParseResult CountIndexParser::ParseIndexPrefixedOctetData(openpal::RSlice& buffe
 		return ParseResult::NOT_ENOUGH_DATA_FOR_OBJECTS;
 	}
 
-	if (pHandler)
-	{
-		auto read = [&numparser, record](RSlice & buffer, uint32_t pos) -> Indexed<OctetString>
-		{
-			auto index = numparser.ReadNum(buffer);
-			OctetString octets(buffer.Take(record.variation));
-			buffer.Advance(record.variation);
-			return WithIndex(octets, index);
-		};
-
-		auto collection = CreateBufferedCollection<Indexed<OctetString>>(buffer, count, read);
-		pHandler->OnHeader(PrefixHeader(record, count), collection);
-	}
+	header.record = record;
+	header.count = count;
+	header.numparser = numparser;
+	header.objects = buffer.Take(TOTAL_SIZE);
+	header.invoke = &InvokeIndexPrefixedOctetData;
 
 	buffer.Advance(TOTAL_SIZE);
 	return ParseResult::OK;
 }
 
+void CountIndexParser::InvokeIndexPrefixedOctetData(const ParsedHeader& header, IAPDUHandler& handler)
+{
+	const auto& numparser = header.numparser;
+	const auto& record = header.record;
+
+	auto read = [&numparser, record](RSlice & buffer, uint32_t pos) -> Indexed<OctetString>
+	{
+		auto index = numparser.ReadNum(buffer);
+		OctetString octets(buffer.Take(record.variation));
+		buffer.Advance(record.variation);
+		return WithIndex(octets, index);
+	};
+
+	auto collection = CreateBufferedCollection<Indexed<OctetString>>(header.objects, header.count, read);
+	handler.OnHeader(PrefixHeader(record, header.count), collection);
+}
+
 }
\ No newline at end of file
@@ -31,14 +31,13 @@
 #include "opendnp3/app/parsing/ParserSettings.h"
 
 #include "opendnp3/app/parsing/BufferedCollection.h"
+#include "opendnp3/app/parsing/ParsedHeader.h"
 
 namespace opendnp3
 {
 
 class CountIndexParser
 {
-	typedef void(*HandleFun)(const HeaderRecord& record, uint16_t count, const NumParser& numparser, const openpal::RSlice& buffer, IAPDUHandler& handler);
-
 public:
 
 	static ParseResult ParseHeader(
@@ -47,13 +46,13 @@ public:
 	    const ParserSettings& settings,
 	    const HeaderRecord& record,
 	    openpal::Logger* pLogger,
-	    IAPDUHandler* pHandler
+	    ParsedHeader& header
 	);
 
 private:
 
-	// Process the count handler against the buffer
-	ParseResult Process(const HeaderRecord& record, openpal::RSlice& buffer, IAPDUHandler* pHandler, openpal::Logger* pLogger) const;
+	// Validate the count against the buffer and describe the header if successful
+	ParseResult Process(const HeaderRecord& record, openpal::RSlice& buffer, ParsedHeader& header, openpal::Logger* pLogger) const;
 
 	// Create a count handler from a fixed size descriptor
 	template <class Descriptor>
@@ -63,22 +62,24 @@ private:
 	template <class Type>
 	static CountIndexParser FromType(uint16_t count, const NumParser& numparser);
 
-	static ParseResult ParseCountOfObjects(openpal::RSlice& buffer, const HeaderRecord& record, const NumParser& numparser, uint16_t count, openpal::Logger* pLogger, IAPDUHandler* pHandler);
+	static ParseResult ParseCountOfObjects(openpal::RSlice& buffer, const HeaderRecord& record, const NumParser& numparser, uint16_t count, openpal::Logger* pLogger, ParsedHeader& header);
+
+	static ParseResult ParseIndexPrefixedOctetData(openpal::RSlice& buffer, const HeaderRecord& record, const NumParser& numParser, uint16_t count, openpal::Logger* pLogger, ParsedHeader& header);
 
-	static ParseResult ParseIndexPrefixedOctetData(openpal::RSlice& buffer, const HeaderRecord& record, const NumParser& numParser, uint32_t count, openpal::Logger* pLogger, IAPDUHandler* pHandler);
+	static void InvokeIndexPrefixedOctetData(const ParsedHeader& header, IAPDUHandler& handler);
 
 	template <class Descriptor>
-	static void InvokeCountOf(const HeaderRecord& record, uint16_t count, const NumParser& numparser, const openpal::RSlice& buffer, IAPDUHandler& handler);
+	static void InvokeCountOf(const ParsedHeader& header, IAPDUHandler& handler);
 
 	template <class Type>
-	static void InvokeCountOfType(const HeaderRecord& record, uint16_t count, const NumParser& numparser, const openpal::RSlice& buffer, IAPDUHandler& handler);
+	static void InvokeCountOfType(const ParsedHeader& header, IAPDUHandler& handler);
 
-	CountIndexParser(uint16_t count, uint32_t requiredSize, const NumParser& numparser, HandleFun handler);
+	CountIndexParser(uint16_t count, uint32_t requiredSize, const NumParser& numparser, ParsedHeader::InvokeFun invoke);
 
 	uint16_t count;
 	uint32_t requiredSize;
 	NumParser numparser;
-	HandleFun handler;
+	ParsedHeader::InvokeFun invoke;
 
 	CountIndexParser() = delete;
 };
@@ -98,8 +99,10 @@ CountIndexParser CountIndexParser::FromType(uint16_t count, const NumParser& num
 }
 
 template <class Descriptor>
-void CountIndexParser::InvokeCountOf(const HeaderRecord& record, uint16_t count, const NumParser& numparser, const openpal::RSlice& buffer, IAPDUHandler& handler)
+void CountIndexParser::InvokeCountOf(const ParsedHeader& header, IAPDUHandler& handler)
 {
+	const auto& numparser = header.numparser;
+
 	auto read = [&numparser](openpal::RSlice & buffer, uint32_t) -> Indexed<typename Descriptor::Target>
 	{
 		Indexed<typename Descriptor::Target> pair;
@@ -108,13 +111,15 @@ void CountIndexParser::InvokeCountOf(const HeaderRecord& record, uint16_t count,
 		return pair;
 	};
 
-	auto collection = CreateBufferedCollection<Indexed<typename Descriptor::Target>>(buffer, count, read);
-	handler.OnHeader(PrefixHeader(record, count), collection);
+	auto collection = CreateBufferedCollection<Indexed<typename Descriptor::Target>>(header.objects, header.count, read);
+	handler.OnHeader(PrefixHeader(header.record, header.count), collection);
 }
 
 template <class Type>
-void CountIndexParser::InvokeCountOfType(const HeaderRecord& record, uint16_t count, const NumParser& numparser, const openpal::RSlice& buffer, IAPDUHandler& handler)
+void CountIndexParser::InvokeCountOfType(const ParsedHeader& header, IAPDUHandler& handler)
 {
+	const auto& numparser = header.numparser;
+
 	auto read = [&numparser](openpal::RSlice & buffer, uint32_t) -> Indexed<Type>
 	{
 		Indexed<Type> pair;
@@ -123,8 +128,8 @@ void CountIndexParser::InvokeCountOfType(const HeaderRecord& record, uint16_t co
 		return pair;
 	};
 
-	auto collection = CreateBufferedCollection<Indexed<Type>>(buffer, count, read);
-	handler.OnHeader(PrefixHeader(record, count), collection);
+	auto collection = CreateBufferedCollection<Indexed<Type>>(header.objects, header.count, read);
+	handler.OnHeader(PrefixHeader(header.record, header.count), collection);
 }
 
 }
@@ -28,15 +28,15 @@
 namespace opendnp3
 {
 
-CountParser::CountParser(uint16_t count_, uint32_t requiredSize_, HandleFun handler_) :
+CountParser::CountParser(uint16_t count_, uint32_t requiredSize_, ParsedHeader::InvokeFun invoke_) :
 	count(count_),
 	requiredSize(requiredSize_),
-	handler(handler_)
+	invoke(invoke_)
 {
 
 }
 
-ParseResult CountParser::Process(const HeaderRecord& record, openpal::RSlice& buffer, IAPDUHandler* pHandler, openpal::Logger* pLogger) const
+ParseResult CountParser::Process(const HeaderRecord& record, openpal::RSlice& buffer, ParsedHeader& header, openpal::Logger* pLogger) const
 {
 	if (buffer.Size() < requiredSize)
 	{
@@ -45,16 +45,16 @@ ParseResult CountParser::Process(const HeaderRecord& record, openpal::RSlice& bu
 	}
 	else
 	{
-		if (pHandler)
-		{
-			handler(record, count, buffer, *pHandler);
-		}
+		header.record = record;
+		header.count = count;
+		header.objects = buffer.Take(requiredSize);
+		header.invoke = invoke;
 		buffer.Advance(requiredSize);
 		return ParseResult::OK;
 	}
 }
 
-ParseResult CountParser::ParseHeader(openpal::RSlice& buffer, const NumParser& numParser, const ParserSettings& settings, const HeaderRecord& record, openpal::Logger* pLogger, IAPDUHandler* pHandler)
+ParseResult CountParser::ParseHeader(openpal::RSlice& buffer, const NumParser& numParser, const ParserSettings& settings, const HeaderRecord& record, openpal::Logger* pLogger, ParsedHeader& header)
 {
 	uint16_t count;
 	auto result = numParser.ParseCount(buffer, count, pLogger);
@@ -70,15 +70,13 @@ ParseResult CountParser::ParseHeader(openpal::RSlice& buffer, const NumParser& n
 
 		if (settings.ExpectsContents())
 		{
-			return ParseCountOfObjects(buffer, record, count, pLogger, pHandler);
+			return ParseCountOfObjects(buffer, record, count, pLogger, header);
 		}
 		else
 		{
-			if (pHandler)
-			{
-				pHandler->OnHeader(CountHeader(record, count));
-			}
-
+			header.record = record;
+			header.count = count;
+			header.invoke = &InvokeCount;
 			return ParseResult::OK;
 		}
 	}
@@ -88,30 +86,30 @@ ParseResult CountParser::ParseHeader(openpal::RSlice& buffer, const NumParser& n
 	}
 }
 
-ParseResult CountParser::ParseCountOfObjects(openpal::RSlice& buffer, const HeaderRecord& record, uint16_t count, openpal::Logger* pLogger, IAPDUHandler* pHandler)
+ParseResult CountParser::ParseCountOfObjects(openpal::RSlice& buffer, const HeaderRecord& record, uint16_t count, openpal::Logger* pLogger, ParsedHeader& header)
 {
 	switch (record.enumeration)
 	{
 	case(GroupVariation::Group50Var1) :
-		return CountParser::From<Group50Var1>(count).Process(record, buffer, pHandler, pLogger);
+		return CountParser::From<Group50Var1>(count).Process(record, buffer, header, pLogger);
 
 	case(GroupVariation::Group51Var1) :
-		return CountParser::From<Group51Var1>(count).Process(record, buffer, pHandler, pLogger);
+		return CountParser::From<Group51Var1>(count).Process(record, buffer, header, pLogger);
 
 	case(GroupVariation::Group51Var2) :
-		return CountParser::From<Group51Var2>(count).Process(record, buffer, pHandler, pLogger);
+		return CountParser::From<Group51Var2>(count).Process(record, buffer, header, pLogger);
 
 	case(GroupVariation::Group52Var1) :
-		return CountParser::From<Group52Var1>(count).Process(record, buffer, pHandler, pLogger);
+		return CountParser::From<Group52Var1>(count).Process(record, buffer, header, pLogger);
 
 	case(GroupVariation::Group52Var2) :
-		return CountParser::From<Group52Var2>(count).Process(record, buffer, pHandler, pLogger);
+		return CountParser::From<Group52Var2>(count).Process(record, buffer, header, pLogger);
 
 	case(GroupVariation::Group120Var3) :
-		return CountParser::From<Group120Var3>(count).Process(record, buffer, pHandler, pLogger);
+		return CountParser::From<Group120Var3>(count).Process(record, buffer, header, pLogger);
 
 	case(GroupVariation::Group120Var4) :
-		return CountParser::From<Group120Var4>(count).Process(record, buffer, pHandler, pLogger);
+		return CountParser::From<Group120Var4>(count).Process(record, buffer, header, pLogger);
 
 	default:
 		FORMAT_LOGGER_BLOCK(pLogger, flags::WARN, "Unsupported qualifier/object - %s - %i / %i",
@@ -123,6 +121,11 @@ ParseResult CountParser::ParseCountOfObjects(openpal::RSlice& buffer, const Head
 	}
 }
 
+void CountParser::InvokeCount(const ParsedHeader& header, IAPDUHandler& handler)
+{
+	handler.OnHeader(CountHeader(header.record, header.count));
+}
+
 }
 
 
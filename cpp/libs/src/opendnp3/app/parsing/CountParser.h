@@ -31,14 +31,13 @@
 #include "opendnp3/app/parsing/NumParser.h"
 #include "opendnp3/app/parsing/ParserSettings.h"
 #include "opendnp3/app/parsing/BufferedCollection.h"
+#include "opendnp3/app/parsing/ParsedHeader.h"
 
 namespace opendnp3
 {
 
 class CountParser
 {
-	typedef void (*HandleFun)(const HeaderRecord& record, uint16_t count, const openpal::RSlice& buffer, IAPDUHandler& handler);
-
 public:
 
 	static ParseResult ParseHeader(
@@ -47,28 +46,30 @@ public:
 	    const ParserSettings& settings,
 	    const HeaderRecord& record,
 	    openpal::Logger* pLogger,
-	    IAPDUHandler* pHandler
+	    ParsedHeader& header
 	);
 
 private:
 
-	// Process the count handler against the buffer
-	ParseResult Process(const HeaderRecord& record, openpal::RSlice& buffer, IAPDUHandler* pHandler, openpal::Logger* pLogger) const;
+	// Validate the count against the buffer and describe the header if successful
+	ParseResult Process(const HeaderRecord& record, openpal::RSlice& buffer, ParsedHeader& header, openpal::Logger* pLogger) const;
 
 	// Create a count handler from a fixed size descriptor
 	template <class Descriptor>
 	static CountParser From(uint16_t count);
 
-	static ParseResult ParseCountOfObjects(openpal::RSlice& buffer, const HeaderRecord& record, uint16_t count, openpal::Logger* pLogger, IAPDUHandler* pHandler);
+	static ParseResult ParseCountOfObjects(openpal::RSlice& buffer, const HeaderRecord& record, uint16_t count, openpal::Logger* pLogger, ParsedHeader& header);
+
+	static void InvokeCount(const ParsedHeader& header, IAPDUHandler& handler);
 
 	template <class Descriptor>
-	static void InvokeCountOf(const HeaderRecord& record, uint16_t count, const openpal::RSlice& buffer, IAPDUHandler& handler);
+	static void InvokeCountOf(const ParsedHeader& header, IAPDUHandler& handler);
 
-	CountParser(uint16_t count, uint32_t requiredSize, HandleFun handler);
+	CountParser(uint16_t count, uint32_t requiredSize, ParsedHeader::InvokeFun invoke);
 
 	uint16_t count;
 	uint32_t requiredSize;
-	HandleFun handler;
+	ParsedHeader::InvokeFun invoke;
 
 	CountParser() = delete;
 };
@@ -81,7 +82,7 @@ CountParser CountParser::From(uint16_t count)
 }
 
 template <class T>
-void CountParser::InvokeCountOf(const HeaderRecord& record, uint16_t count, const openpal::RSlice& buffer, IAPDUHandler& handler)
+void CountParser::InvokeCountOf(const ParsedHeader& header, IAPDUHandler& handler)
 {
 	auto read = [](openpal::RSlice & buffer, uint32_t) -> T
 	{
@@ -90,8 +91,8 @@ void CountParser::InvokeCountOf(const HeaderRecord& record, uint16_t count, cons
 		return value;
 	};
 
-	auto collection = CreateBufferedCollection<T>(buffer, count, read);
-	handler.OnHeader(CountHeader(record, count), collection);
+	auto collection = CreateBufferedCollection<T>(header.objects, header.count, read);
+	handler.OnHeader(CountHeader(header.record, header.count), collection);
 }
 
 }
@@ -53,7 +53,7 @@ using namespace openpal;
 
 namespace opendnp3
 {
-ParseResult FreeFormatParser::ParseHeader(openpal::RSlice& buffer, const ParserSettings& settings, const HeaderRecord& record, openpal::Logger* pLogger, IAPDUHandler* pHandler)
+ParseResult FreeFormatParser::ParseHeader(openpal::RSlice& buffer, const ParserSettings& settings, const HeaderRecord& record, openpal::Logger* pLogger, ParsedHeader& parsed)
 {
 	if (buffer.Size() < 3)
 	{
@@ -94,43 +94,43 @@ ParseResult FreeFormatParser::ParseHeader(openpal::RSlice& buffer, const ParserS
 	switch (record.enumeration)
 	{
 	case(GroupVariation::Group120Var1) :
-		return ParseFreeFormat(ParseAny<Group120Var1>, header, FREE_FORMAT_SIZE, copy, pHandler, pLogger);
+		return ParseFreeFormat(ValidateAny<Group120Var1>, &InvokeAny<Group120Var1>, header, copy, parsed, pLogger);
 
 	case(GroupVariation::Group120Var2) :
-		return ParseFreeFormat(ParseAny<Group120Var2>, header, FREE_FORMAT_SIZE, copy, pHandler, pLogger);
+		return ParseFreeFormat(ValidateAny<Group120Var2>, &InvokeAny<Group120Var2>, header, copy, parsed, pLogger);
 
 	case(GroupVariation::Group120Var5) :
-		return ParseFreeFormat(ParseAny<Group120Var5>, header, FREE_FORMAT_SIZE, copy, pHandler, pLogger);
+		return ParseFreeFormat(ValidateAny<Group120Var5>, &InvokeAny<Group120Var5>, header, copy, parsed, pLogger);
 
 	case(GroupVariation::Group120Var6) :
-		return ParseFreeFormat(ParseAny<Group120Var6>, header, FREE_FORMAT_SIZE, copy, pHandler, pLogger);
+		return ParseFreeFormat(ValidateAny<Group120Var6>, &InvokeAny<Group120Var6>, header, copy, parsed, pLogger);
 
 	case(GroupVariation::Group120Var7) :
-		return ParseFreeFormat(ParseAny<Group120Var7>, header, FREE_FORMAT_SIZE, copy, pHandler, pLogger);
+		return ParseFreeFormat(ValidateAny<Group120Var7>, &InvokeAny<Group120Var7>, header, copy, parsed, pLogger);
 
 	case(GroupVariation::Group120Var9) :
-		return ParseFreeFormat(ParseAny<Group120Var9>, header, FREE_FORMAT_SIZE, copy, pHandler, pLogger);
+		return ParseFreeFormat(ValidateAny<Group120Var9>, &InvokeAny<Group120Var9>, header, copy, parsed, pLogger);
 
 	case(GroupVariation::Group120Var8) :
-		return ParseFreeFormat(ParseAny<Group120Var8>, header, FREE_FORMAT_SIZE, copy, pHandler, pLogger);
+		return ParseFreeFormat(ValidateAny<Group120Var8>, &InvokeAny<Group120Var8>, header, copy, parsed, pLogger);
 
 	case(GroupVariation::Group120Var10) :
-		return ParseFreeFormat(ParseAny<Group120Var10>, header, FREE_FORMAT_SIZE, copy, pHandler, pLogger);
+		return ParseFreeFormat(ValidateAny<Group120Var10>, &InvokeAny<Group120Var10>, header, copy, parsed, pLogger);
 
 	case(GroupVariation::Group120Var11) :
-		return ParseFreeFormat(ParseAny<Group120Var11>, header, FREE_FORMAT_SIZE, copy, pHandler, pLogger);
+		return ParseFreeFormat(ValidateAny<Group120Var11>, &InvokeAny<Group120Var11>, header, copy, parsed, pLogger);
 
 	case(GroupVariation::Group120Var12) :
-		return ParseFreeFormat(ParseAny<Group120Var12>, header, FREE_FORMAT_SIZE, copy, pHandler, pLogger);
+		return ParseFreeFormat(ValidateAny<Group120Var12>, &InvokeAny<Group120Var12>, header, copy, parsed, pLogger);
 
 	case(GroupVariation::Group120Var13) :
-		return ParseFreeFormat(ParseAny<Group120Var13>, header, FREE_FORMAT_SIZE, copy, pHandler, pLogger);
+		return ParseFreeFormat(ValidateAny<Group120Var13>, &InvokeAny<Group120Var13>, header, copy, parsed, pLogger);
 
 	case(GroupVariation::Group120Var14) :
-		return ParseFreeFormat(ParseAny<Group120Var14>, header, FREE_FORMAT_SIZE, copy, pHandler, pLogger);
+		return ParseFreeFormat(ValidateAny<Group120Var14>, &InvokeAny<Group120Var14>, header, copy, parsed, pLogger);
 
 	case(GroupVariation::Group120Var15) :
-		return ParseFreeFormat(ParseAny<Group120Var15>, header, FREE_FORMAT_SIZE, copy, pHandler, pLogger);
+		return ParseFreeFormat(ValidateAny<Group120Var15>, &InvokeAny<Group120Var15>, header, copy, parsed, pLogger);
 
 	default:
 		FORMAT_LOGGER_BLOCK(pLogger, flags::WARN,
@@ -143,10 +143,14 @@ ParseResult FreeFormatParser::ParseHeader(openpal::RSlice& buffer, const ParserS
 
 }
 
-ParseResult FreeFormatParser::ParseFreeFormat(FreeFormatHandler parser, const FreeFormatHeader& header, uint16_t size, openpal::RSlice& objects, IAPDUHandler* pHandler, openpal::Logger* pLogger)
+ParseResult FreeFormatParser::ParseFreeFormat(FreeFormatValidator validator, ParsedHeader::InvokeFun invoke, const FreeFormatHeader& header, const openpal::RSlice& object, ParsedHeader& parsed, openpal::Logger* pLogger)
 {
-	if (parser(header, objects, pHandler))
+	if (validator(object))
 	{
+		parsed.record = header;
+		parsed.count = header.count;
+		parsed.objects = object;
+		parsed.invoke = invoke;
 		return ParseResult::OK;
 	}
 	else
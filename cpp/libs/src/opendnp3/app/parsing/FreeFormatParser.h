@@ -29,6 +29,7 @@
 #include "opendnp3/app/parsing/ParseResult.h"
 #include "opendnp3/app/parsing/IAPDUHandler.h"
 #include "opendnp3/app/parsing/ParserSettings.h"
+#include "opendnp3/app/parsing/ParsedHeader.h"
 
 namespace opendnp3
 {
@@ -40,26 +41,29 @@ class FreeFormatParser : private openpal::StaticOnly
 {
 public:
 
-	static ParseResult ParseHeader(openpal::RSlice& buffer, const ParserSettings& settings, const HeaderRecord& record, openpal::Logger* pLogger, IAPDUHandler* pHandler);
+	static ParseResult ParseHeader(openpal::RSlice& buffer, const ParserSettings& settings, const HeaderRecord& record, openpal::Logger* pLogger, ParsedHeader& header);
 
 private:
 
-	typedef bool(&FreeFormatHandler)(const FreeFormatHeader& header, const openpal::RSlice& objects, IAPDUHandler* pHandler);
+	typedef bool(&FreeFormatValidator)(const openpal::RSlice& object);
 
-	static ParseResult ParseFreeFormat(FreeFormatHandler handler, const FreeFormatHeader& header, uint16_t size, openpal::RSlice& objects, IAPDUHandler* pHandler, openpal::Logger* pLogger);
+	static ParseResult ParseFreeFormat(FreeFormatValidator validator, ParsedHeader::InvokeFun invoke, const FreeFormatHeader& header, const openpal::RSlice& object, ParsedHeader& parsed, openpal::Logger* pLogger);
 
-	// Free format handlers
+	// Free format validators and handlers
 
 	template <class T>
-	static bool ParseAny(const FreeFormatHeader& header, const openpal::RSlice& object, IAPDUHandler* pHandler)
+	static bool ValidateAny(const openpal::RSlice& object)
 	{
 		T value;
-		auto success = value.Read(object);
-		if (success && pHandler)
-		{
-			pHandler->OnHeader(header, value, object);
-		}
-		return success;
+		return value.Read(object);
+	}
+
+	template <class T>
+	static void InvokeAny(const ParsedHeader& header, IAPDUHandler& handler)
+	{
+		T value;
+		value.Read(header.objects);
+		handler.OnHeader(FreeFormatHeader(header.record, header.count), value, header.objects);
 	}
 };
 
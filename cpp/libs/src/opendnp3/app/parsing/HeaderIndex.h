@@ -0,0 +1,104 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef OPENDNP3_HEADERINDEX_H
+#define OPENDNP3_HEADERINDEX_H
+
+#include <openpal/util/Uncopyable.h>
+
+#include "opendnp3/app/parsing/ParsedHeader.h"
+
+namespace opendnp3
+{
+
+/**
+* Fixed capacity record of the headers validated while parsing a fragment
+*/
+class HeaderIndex : private openpal::Uncopyable
+{
+public:
+
+	// enough for any practical response, headers beyond this are parsed a 2nd time
+	static const uint32_t MAX_HEADERS = 32;
+
+	HeaderIndex() : numHeaders(0), overflow(false)
+	{}
+
+	/**
+	* Record a header, or if the index is full, the position of the first header that doesn't fit
+	*
+	* @param header the validated header
+	* @param position the buffer starting at the header
+	*/
+	void Add(const ParsedHeader& header, const openpal::RSlice& position)
+	{
+		if (overflow)
+		{
+			return;
+		}
+
+		if (numHeaders < MAX_HEADERS)
+		{
+			headers[numHeaders] = header;
+			++numHeaders;
+		}
+		else
+		{
+			overflow = true;
+			remainder = position;
+		}
+	}
+
+	/// @return true if every header in the fragment was recorded
+	bool IsComplete() const
+	{
+		return !overflow;
+	}
+
+	uint32_t Size() const
+	{
+		return numHeaders;
+	}
+
+	/// @return the headers that were validated but not recorded
+	openpal::RSlice Remainder() const
+	{
+		return remainder;
+	}
+
+	void InvokeAll(IAPDUHandler& handler) const
+	{
+		for (uint32_t i = 0; i < numHeaders; ++i)
+		{
+			headers[i].Invoke(handler);
+		}
+	}
+
+private:
+
+	uint32_t numHeaders;
+	bool overflow;
+	openpal::RSlice remainder;
+	ParsedHeader headers[MAX_HEADERS];
+};
+
+}
+
+#endif
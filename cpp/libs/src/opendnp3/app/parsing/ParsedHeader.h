@@ -0,0 +1,72 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef OPENDNP3_PARSEDHEADER_H
+#define OPENDNP3_PARSEDHEADER_H
+
+#include <openpal/container/RSlice.h>
+
+#include "opendnp3/app/GroupVariationRecord.h"
+#include "opendnp3/app/Range.h"
+#include "opendnp3/app/parsing/IAPDUHandler.h"
+#include "opendnp3/app/parsing/NumParser.h"
+
+namespace opendnp3
+{
+
+/**
+* An object header that has been fully validated, but not yet delivered to a handler.
+*
+* Holds the decoded qualifier fields, the slice of object data, and the function that
+* builds the collection for the handler, so that a header can be delivered without
+* being parsed a second time.
+*/
+class ParsedHeader
+{
+public:
+
+	typedef void (*InvokeFun)(const ParsedHeader& header, IAPDUHandler& handler);
+
+	ParsedHeader() : count(0), numparser(NumParser::OneByte()), invoke(nullptr)
+	{}
+
+	void Invoke(IAPDUHandler& handler) const
+	{
+		invoke(*this, handler);
+	}
+
+	HeaderRecord record;
+
+	// start/stop qualifiers
+	Range range;
+
+	// count, index prefixed, and free format qualifiers
+	uint16_t count;
+	NumParser numparser;
+
+	// exactly the bytes occupied by the objects
+	openpal::RSlice objects;
+
+	InvokeFun invoke;
+};
+
+}
+
+#endif
@@ -44,15 +44,15 @@
 namespace opendnp3
 {
 
-RangeParser::RangeParser(const Range& range_, uint32_t requiredSize_, HandleFun handler_) :
+RangeParser::RangeParser(const Range& range_, uint32_t requiredSize_, ParsedHeader::InvokeFun invoke_) :
 	range(range_),
 	requiredSize(requiredSize_),
-	handler(handler_)
+	invoke(invoke_)
 {
 
 }
 
-ParseResult RangeParser::ParseHeader(openpal::RSlice& buffer, const NumParser& numparser, const ParserSettings& settings, const HeaderRecord& record, openpal::Logger* pLogger, IAPDUHandler* pHandler)
+ParseResult RangeParser::ParseHeader(openpal::RSlice& buffer, const NumParser& numparser, const ParserSettings& settings, const HeaderRecord& record, openpal::Logger* pLogger, ParsedHeader& header)
 {
 	Range range;
 	auto res = numparser.ParseRange(buffer, range, pLogger);
@@ -72,19 +72,18 @@ ParseResult RangeParser::ParseHeader(openpal::RSlice& buffer, const NumParser& n
 
 	if (settings.ExpectsContents())
 	{
-		return ParseRangeOfObjects(buffer, record, range, pLogger, pHandler);
+		return ParseRangeOfObjects(buffer, record, range, pLogger, header);
 	}
 	else
 	{
-		if (pHandler)
-		{
-			pHandler->OnHeader(RangeHeader(record, range));
-		}
+		header.record = record;
+		header.range = range;
+		header.invoke = &InvokeRange;
 		return ParseResult::OK;
 	}
 }
 
-ParseResult RangeParser::Process(const HeaderRecord& record, openpal::RSlice& buffer, IAPDUHandler* pHandler, openpal::Logger* pLogger) const
+ParseResult RangeParser::Process(const HeaderRecord& record, openpal::RSlice& buffer, ParsedHeader& header, openpal::Logger* pLogger) const
 {
 	if (buffer.Size() < requiredSize)
 	{
@@ -93,10 +92,10 @@ ParseResult RangeParser::Process(const HeaderRecord& record, openpal::RSlice& bu
 	}
 	else
 	{
-		if (pHandler)
-		{
-			handler(record, range, buffer, *pHandler);
-		}
+		header.record = record;
+		header.range = range;
+		header.objects = buffer.Take(requiredSize);
+		header.invoke = invoke;
 		buffer.Advance(requiredSize);
 		return ParseResult::OK;
 	}
@@ -104,21 +103,21 @@ ParseResult RangeParser::Process(const HeaderRecord& record, openpal::RSlice& bu
 
 #define MACRO_PARSE_OBJECTS_WITH_RANGE(descriptor) \
 	case(GroupVariation::descriptor): \
-	return RangeParser::FromFixedSize<descriptor>(range).Process(record, buffer, pHandler, pLogger);
+	return RangeParser::FromFixedSize<descriptor>(range).Process(record, buffer, header, pLogger);
 
-ParseResult RangeParser::ParseRangeOfObjects(openpal::RSlice& buffer, const HeaderRecord& record, const Range& range, openpal::Logger* pLogger, IAPDUHandler* pHandler)
+ParseResult RangeParser::ParseRangeOfObjects(openpal::RSlice& buffer, const HeaderRecord& record, const Range& range, openpal::Logger* pLogger, ParsedHeader& header)
 {
 	switch (record.enumeration)
 	{
 	case(GroupVariation::Group1Var1) :
-		return RangeParser::FromBitfieldType<Binary>(range).Process(record, buffer, pHandler, pLogger);
+		return RangeParser::FromBitfieldType<Binary>(range).Process(record, buffer, header, pLogger);
 
 		MACRO_PARSE_OBJECTS_WITH_RANGE(Group1Var2);
 
 	case(GroupVariation::Group3Var1) :
-		return RangeParser::FromDoubleBitfieldType<DoubleBitBinary>(range).Process(record, buffer, pHandler, pLogger);
+		return RangeParser::FromDoubleBitfieldType<DoubleBitBinary>(range).Process(record, buffer, header, pLogger);
 	case(GroupVariation::Group10Var1):
-		return RangeParser::FromBitfieldType<BinaryOutputStatus>(range).Process(record, buffer, pHandler, pLogger);
+		return RangeParser::FromBitfieldType<BinaryOutputStatus>(range).Process(record, buffer, header, pLogger);
 
 		MACRO_PARSE_OBJECTS_WITH_RANGE(Group3Var2);
 		MACRO_PARSE_OBJECTS_WITH_RANGE(Group10Var2);
@@ -150,13 +149,13 @@ ParseResult RangeParser::ParseRangeOfObjects(openpal::RSlice& buffer, const Head
 		MACRO_PARSE_OBJECTS_WITH_RANGE(Group50Var4);
 
 	case(GroupVariation::Group80Var1) :
-		return RangeParser::FromBitfieldType<IINValue>(range).Process(record, buffer, pHandler, pLogger);
+		return RangeParser::FromBitfieldType<IINValue>(range).Process(record, buffer, header, pLogger);
 
 	case(GroupVariation::Group110Var0) :
-		return ParseRangeOfOctetData(buffer, record, range, pLogger, pHandler);
+		return ParseRangeOfOctetData(buffer, record, range, pLogger, header);
 
 	case(GroupVariation::Group121Var1) :
-		return RangeParser::FromFixedSizeType<Group121Var1>(range).Process(record, buffer, pHandler, pLogger);
+		return RangeParser::FromFixedSizeType<Group121Var1>(range).Process(record, buffer, header, pLogger);
 
 	default:
 		FORMAT_LOGGER_BLOCK(pLogger, flags::WARN, "Unsupported qualifier/object - %s - %i / %i",
@@ -168,7 +167,7 @@ ParseResult RangeParser::ParseRangeOfObjects(openpal::RSlice& buffer, const Head
 	}
 }
 
-ParseResult RangeParser::ParseRangeOfOctetData(openpal::RSlice& buffer, const HeaderRecord& record, const Range& range, openpal::Logger* pLogger, IAPDUHandler* pHandler)
+ParseResult RangeParser::ParseRangeOfOctetData(openpal::RSlice& buffer, const HeaderRecord& record, const Range& range, openpal::Logger* pLogger, ParsedHeader& header)
 {
 	if (record.variation > 0)
 	{
@@ -181,20 +180,10 @@ ParseResult RangeParser::ParseRangeOfOctetData(openpal::RSlice& buffer, const He
 		}
 		else
 		{
-			if (pHandler)
-			{
-				auto read = [range, record](openpal::RSlice & buffer, uint32_t pos) -> Indexed<OctetString>
-				{
-					OctetString octets(buffer.Take(record.variation));
-					buffer.Advance(record.variation);
-					return WithIndex(octets, range.start + pos);
-				};
-
-				auto collection = CreateBufferedCollection<Indexed<OctetString>>(buffer, COUNT, read);
-
-				pHandler->OnHeader(RangeHeader(record, range), collection);
-			}
-
+			header.record = record;
+			header.range = range;
+			header.objects = buffer.Take(size);
+			header.invoke = &InvokeRangeOfOctetData;
 			buffer.Advance(size);
 			return ParseResult::OK;
 		}
@@ -206,6 +195,27 @@ ParseResult RangeParser::ParseRangeOfOctetData(openpal::RSlice& buffer, const He
 	}
 }
 
+void RangeParser::InvokeRange(const ParsedHeader& header, IAPDUHandler& handler)
+{
+	handler.OnHeader(RangeHeader(header.record, header.range));
+}
+
+void RangeParser::InvokeRangeOfOctetData(const ParsedHeader& header, IAPDUHandler& handler)
+{
+	const auto& range = header.range;
+	const auto& record = header.record;
+
+	auto read = [range, record](openpal::RSlice & buffer, uint32_t pos) -> Indexed<OctetString>
+	{
+		OctetString octets(buffer.Take(record.variation));
+		buffer.Advance(record.variation);
+		return WithIndex(octets, range.start + pos);
+	};
+
+	auto collection = CreateBufferedCollection<Indexed<OctetString>>(header.objects, range.Count(), read);
+
+	handler.OnHeader(RangeHeader(record, range), collection);
+}
 
 }
 
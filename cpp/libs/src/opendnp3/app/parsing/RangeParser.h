@@ -30,6 +30,8 @@
 #include "opendnp3/app/parsing/NumParser.h"
 #include "opendnp3/app/parsing/ParserSettings.h"
 #include "opendnp3/app/parsing/BitReader.h"
+#include "opendnp3/app/parsing/BitfieldCollection.h"
+#include "opendnp3/app/parsing/ParsedHeader.h"
 
 #include "opendnp3/app/Range.h"
 #include "opendnp3/app/parsing/BufferedCollection.h"
@@ -40,10 +42,6 @@ namespace opendnp3
 
 class RangeParser
 {
-	typedef void (*HandleFun)(const HeaderRecord& record, const Range& range, const openpal::RSlice& buffer, IAPDUHandler& handler);
-
-
-
 public:
 
 	static ParseResult ParseHeader(
@@ -52,13 +50,13 @@ public:
 	    const ParserSettings& settings,
 	    const HeaderRecord& record,
 	    openpal::Logger* pLogger,
-	    IAPDUHandler* pHandler
+	    ParsedHeader& header
 	);
 
 private:
 
-	// Process the range against the buffer
-	ParseResult Process(const HeaderRecord& record, openpal::RSlice& buffer, IAPDUHandler* pHandler, openpal::Logger* pLogger) const;
+	// Validate the range against the buffer and describe the header if successful
+	ParseResult Process(const HeaderRecord& record, openpal::RSlice& buffer, ParsedHeader& header, openpal::Logger* pLogger) const;
 
 	// Create a range parser from a fixed size descriptor
 	template <class Descriptor>
@@ -74,27 +72,31 @@ private:
 	template <class Type>
 	static RangeParser FromDoubleBitfieldType(const Range& range);
 
-	static ParseResult ParseRangeOfObjects(openpal::RSlice& buffer, const HeaderRecord& record, const Range& range, openpal::Logger* pLogger, IAPDUHandler* pHandler);
+	static ParseResult ParseRangeOfObjects(openpal::RSlice& buffer, const HeaderRecord& record, const Range& range, openpal::Logger* pLogger, ParsedHeader& header);
+
+	static ParseResult ParseRangeOfOctetData(openpal::RSlice& buffer, const HeaderRecord& record, const Range& range, openpal::Logger* pLogger, ParsedHeader& header);
 
-	static ParseResult ParseRangeOfOctetData(openpal::RSlice& buffer, const HeaderRecord& record, const Range& range, openpal::Logger* pLogger, IAPDUHandler* pHandler);
+	static void InvokeRange(const ParsedHeader& header, IAPDUHandler& handler);
+
+	static void InvokeRangeOfOctetData(const ParsedHeader& header, IAPDUHandler& handler);
 
 	template <class Descriptor>
-	static void InvokeRangeOf(const HeaderRecord& record, const Range& range, const openpal::RSlice& buffer, IAPDUHandler& handler);
+	static void InvokeRangeOf(const ParsedHeader& header, IAPDUHandler& handler);
 
 	template <class Type>
-	static void InvokeRangeOfType(const HeaderRecord& record, const Range& range, const openpal::RSlice& buffer, IAPDUHandler& handler);
+	static void InvokeRangeOfType(const ParsedHeader& header, IAPDUHandler& handler);
 
 	template <class Type>
-	static void InvokeRangeBitfieldType(const HeaderRecord& record, const Range& range, const openpal::RSlice& buffer, IAPDUHandler& handler);
+	static void InvokeRangeBitfieldType(const ParsedHeader& header, IAPDUHandler& handler);
 
 	template <class Type>
-	static void InvokeRangeDoubleBitfieldType(const HeaderRecord& record, const Range& range, const openpal::RSlice& buffer, IAPDUHandler& handler);
+	static void InvokeRangeDoubleBitfieldType(const ParsedHeader& header, IAPDUHandler& handler);
 
-	RangeParser(const Range& range, uint32_t requiredSize, HandleFun handler);
+	RangeParser(const Range& range, uint32_t requiredSize, ParsedHeader::InvokeFun invoke);
 
 	Range range;
 	uint32_t requiredSize;
-	HandleFun handler;
+	ParsedHeader::InvokeFun invoke;
 
 	RangeParser() = delete;
 };
@@ -114,8 +116,9 @@ RangeParser RangeParser::FromFixedSizeType(const Range& range)
 }
 
 template <class Descriptor>
-void RangeParser::InvokeRangeOf(const HeaderRecord& record, const Range& range, const openpal::RSlice& buffer, IAPDUHandler& handler)
+void RangeParser::InvokeRangeOf(const ParsedHeader& header, IAPDUHandler& handler)
 {
+	const auto& range = header.range;
 	const auto COUNT = range.Count();
 
 	auto read = [range](openpal::RSlice & buffer, uint32_t pos)
@@ -125,14 +128,15 @@ void RangeParser::InvokeRangeOf(const HeaderRecord& record, const Range& range,
 		return WithIndex(target, range.start + pos);
 	};
 
-	auto collection = CreateBufferedCollection<Indexed<typename Descriptor::Target>>(buffer, COUNT, read);
+	auto collection = CreateBufferedCollection<Indexed<typename Descriptor::Target>>(header.objects, COUNT, read);
 
-	handler.OnHeader(RangeHeader(record, range), collection);
+	handler.OnHeader(RangeHeader(header.record, range), collection);
 }
 
 template <class Type>
-void RangeParser::InvokeRangeOfType(const HeaderRecord& record, const Range& range, const openpal::RSlice& buffer, IAPDUHandler& handler)
+void RangeParser::InvokeRangeOfType(const ParsedHeader& header, IAPDUHandler& handler)
 {
+	const auto& range = header.range;
 	const auto COUNT = range.Count();
 
 	auto read = [range](openpal::RSlice & buffer, uint32_t pos) -> Indexed<Type>
@@ -142,9 +146,9 @@ void RangeParser::InvokeRangeOfType(const HeaderRecord& record, const Range& ran
 		return WithIndex(target, range.start + pos);
 	};
 
-	auto collection = CreateBufferedCollection<Indexed<Type>>(buffer, COUNT, read);
+	auto collection = CreateBufferedCollection<Indexed<Type>>(header.objects, COUNT, read);
 
-	handler.OnHeader(RangeHeader(record, range), collection);
+	handler.OnHeader(RangeHeader(header.record, range), collection);
 }
 
 
@@ -156,19 +160,13 @@ RangeParser RangeParser::FromBitfieldType(const Range& range)
 }
 
 template <class Type>
-void RangeParser::InvokeRangeBitfieldType(const HeaderRecord& record, const Range& range, const openpal::RSlice& buffer, IAPDUHandler& handler)
+void RangeParser::InvokeRangeBitfieldType(const ParsedHeader& header, IAPDUHandler& handler)
 {
-	const uint32_t COUNT = range.Count();
+	const auto& range = header.range;
 
-	auto read = [range](openpal::RSlice & buffer, uint32_t pos) -> Indexed<Type>
-	{
-		Type value(GetBit(buffer, pos));
-		return WithIndex(value, range.start + pos);
-	};
-
-	auto collection = CreateBufferedCollection<Indexed<Type>>(buffer, COUNT, read);
+	BitfieldCollection<Type, 1> collection(header.objects, range.start, range.Count());
 
-	handler.OnHeader(RangeHeader(record, range), collection);
+	handler.OnHeader(RangeHeader(header.record, range), collection);
 }
 
 template <class Type>
@@ -179,19 +177,13 @@ RangeParser RangeParser::FromDoubleBitfieldType(const Range& range)
 }
 
 template <class Type>
-void RangeParser::InvokeRangeDoubleBitfieldType(const HeaderRecord& record, const Range& range, const openpal::RSlice& buffer, IAPDUHandler& handler)
+void RangeParser::InvokeRangeDoubleBitfieldType(const ParsedHeader& header, IAPDUHandler& handler)
 {
-	const uint32_t COUNT = range.Count();
-
-	auto read = [range](openpal::RSlice & buffer, uint32_t pos) -> Indexed<Type>
-	{
-		Type value(GetDoubleBit(buffer, pos));
-		return WithIndex(value, range.start + pos);
-	};
+	const auto& range = header.range;
 
-	auto collection = CreateBufferedCollection<Indexed<Type>>(buffer, COUNT, read);
+	BitfieldCollection<Type, 2> collection(header.objects, range.start, range.Count());
 
-	handler.OnHeader(RangeHeader(record, range), collection);
+	handler.OnHeader(RangeHeader(header.record, range), collection);
 }
 
 }
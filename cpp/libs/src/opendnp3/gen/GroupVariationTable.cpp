@@ -0,0 +1,562 @@
+//
+//  _   _         ______    _ _ _   _             _ _ _
+// | \ | |       |  ____|  | (_) | (_)           | | | |
+// |  \| | ___   | |__   __| |_| |_ _ _ __   __ _| | | |
+// | . ` |/ _ \  |  __| / _` | | __| | '_ \ / _` | | | |
+// | |\  | (_) | | |___| (_| | | |_| | | | | (_| |_|_|_|
+// |_| \_|\___/  |______\__,_|_|\__|_|_| |_|\__, (_|_|_)
+//                                           __/ |
+//                                          |___/
+// 
+// This file is auto-generated. Do not edit manually
+// 
+// Copyright 2013 Automatak LLC
+// 
+// Automatak LLC (www.automatak.com) licenses this file
+// to you under the the Apache License Version 2.0 (the "License"):
+// 
+// http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "opendnp3/gen/GroupVariationTable.h"
+
+namespace opendnp3 {
+
+const GroupVariationEntry Group1Entries[] =
+{
+  { GroupVariation::Group1Var0, GroupVariationType::STATIC, 0 },
+  { GroupVariation::Group1Var1, GroupVariationType::STATIC, 0 },
+  { GroupVariation::Group1Var2, GroupVariationType::STATIC, 1 }
+};
+
+const GroupVariationEntry Group2Entries[] =
+{
+  { GroupVariation::Group2Var0, GroupVariationType::EVENT, 0 },
+  { GroupVariation::Group2Var1, GroupVariationType::EVENT, 1 },
+  { GroupVariation::Group2Var2, GroupVariationType::EVENT, 7 },
+  { GroupVariation::Group2Var3, GroupVariationType::EVENT, 3 }
+};
+
+const GroupVariationEntry Group3Entries[] =
+{
+  { GroupVariation::Group3Var0, GroupVariationType::STATIC, 0 },
+  { GroupVariation::Group3Var1, GroupVariationType::STATIC, 0 },
+  { GroupVariation::Group3Var2, GroupVariationType::STATIC, 1 }
+};
+
+const GroupVariationEntry Group4Entries[] =
+{
+  { GroupVariation::Group4Var0, GroupVariationType::EVENT, 0 },
+  { GroupVariation::Group4Var1, GroupVariationType::EVENT, 1 },
+  { GroupVariation::Group4Var2, GroupVariationType::EVENT, 7 },
+  { GroupVariation::Group4Var3, GroupVariationType::EVENT, 3 }
+};
+
+const GroupVariationEntry Group10Entries[] =
+{
+  { GroupVariation::Group10Var0, GroupVariationType::STATIC, 0 },
+  { GroupVariation::Group10Var1, GroupVariationType::STATIC, 0 },
+  { GroupVariation::Group10Var2, GroupVariationType::STATIC, 1 }
+};
+
+const GroupVariationEntry Group11Entries[] =
+{
+  { GroupVariation::Group11Var0, GroupVariationType::EVENT, 0 },
+  { GroupVariation::Group11Var1, GroupVariationType::EVENT, 1 },
+  { GroupVariation::Group11Var2, GroupVariationType::EVENT, 7 }
+};
+
+const GroupVariationEntry Group12Entries[] =
+{
+  { GroupVariation::Group12Var0, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group12Var1, GroupVariationType::OTHER, 11 }
+};
+
+const GroupVariationEntry Group13Entries[] =
+{
+  { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 },
+  { GroupVariation::Group13Var1, GroupVariationType::EVENT, 1 },
+  { GroupVariation::Group13Var2, GroupVariationType::EVENT, 7 }
+};
+
+const GroupVariationEntry Group20Entries[] =
+{
+  { GroupVariation::Group20Var0, GroupVariationType::STATIC, 0 },
+  { GroupVariation::Group20Var1, GroupVariationType::STATIC, 5 },
+  { GroupVariation::Group20Var2, GroupVariationType::STATIC, 3 },
+  { GroupVariation::UNKNOWN, GroupVariationType::STATIC, 0 },
+  { GroupVariation::UNKNOWN, GroupVariationType::STATIC, 0 },
+  { GroupVariation::Group20Var5, GroupVariationType::STATIC, 4 },
+  { GroupVariation::Group20Var6, GroupVariationType::STATIC, 2 }
+};
+
+const GroupVariationEntry Group21Entries[] =
+{
+  { GroupVariation::Group21Var0, GroupVariationType::STATIC, 0 },
+  { GroupVariation::Group21Var1, GroupVariationType::STATIC, 5 },
+  { GroupVariation::Group21Var2, GroupVariationType::STATIC, 3 },
+  { GroupVariation::UNKNOWN, GroupVariationType::STATIC, 0 },
+  { GroupVariation::UNKNOWN, GroupVariationType::STATIC, 0 },
+  { GroupVariation::Group21Var5, GroupVariationType::STATIC, 11 },
+  { GroupVariation::Group21Var6, GroupVariationType::STATIC, 9 },
+  { GroupVariation::UNKNOWN, GroupVariationType::STATIC, 0 },
+  { GroupVariation::UNKNOWN, GroupVariationType::STATIC, 0 },
+  { GroupVariation::Group21Var9, GroupVariationType::STATIC, 4 },
+  { GroupVariation::Group21Var10, GroupVariationType::STATIC, 2 }
+};
+
+const GroupVariationEntry Group22Entries[] =
+{
+  { GroupVariation::Group22Var0, GroupVariationType::EVENT, 0 },
+  { GroupVariation::Group22Var1, GroupVariationType::EVENT, 5 },
+  { GroupVariation::Group22Var2, GroupVariationType::EVENT, 3 },
+  { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 },
+  { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 },
+  { GroupVariation::Group22Var5, GroupVariationType::EVENT, 11 },
+  { GroupVariation::Group22Var6, GroupVariationType::EVENT, 9 }
+};
+
+const GroupVariationEntry Group23Entries[] =
+{
+  { GroupVariation::Group23Var0, GroupVariationType::EVENT, 0 },
+  { GroupVariation::Group23Var1, GroupVariationType::EVENT, 5 },
+  { GroupVariation::Group23Var2, GroupVariationType::EVENT, 3 },
+  { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 },
+  { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 },
+  { GroupVariation::Group23Var5, GroupVariationType::EVENT, 11 },
+  { GroupVariation::Group23Var6, GroupVariationType::EVENT, 9 }
+};
+
+const GroupVariationEntry Group30Entries[] =
+{
+  { GroupVariation::Group30Var0, GroupVariationType::STATIC, 0 },
+  { GroupVariation::Group30Var1, GroupVariationType::STATIC, 5 },
+  { GroupVariation::Group30Var2, GroupVariationType::STATIC, 3 },
+  { GroupVariation::Group30Var3, GroupVariationType::STATIC, 4 },
+  { GroupVariation::Group30Var4, GroupVariationType::STATIC, 2 },
+  { GroupVariation::Group30Var5, GroupVariationType::STATIC, 5 },
+  { GroupVariation::Group30Var6, GroupVariationType::STATIC, 9 }
+};
+
+const GroupVariationEntry Group32Entries[] =
+{
+  { GroupVariation::Group32Var0, GroupVariationType::EVENT, 0 },
+  { GroupVariation::Group32Var1, GroupVariationType::EVENT, 5 },
+  { GroupVariation::Group32Var2, GroupVariationType::EVENT, 3 },
+  { GroupVariation::Group32Var3, GroupVariationType::EVENT, 11 },
+  { GroupVariation::Group32Var4, GroupVariationType::EVENT, 9 },
+  { GroupVariation::Group32Var5, GroupVariationType::EVENT, 5 },
+  { GroupVariation::Group32Var6, GroupVariationType::EVENT, 9 },
+  { GroupVariation::Group32Var7, GroupVariationType::EVENT, 11 },
+  { GroupVariation::Group32Var8, GroupVariationType::EVENT, 15 }
+};
+
+const GroupVariationEntry Group40Entries[] =
+{
+  { GroupVariation::Group40Var0, GroupVariationType::STATIC, 0 },
+  { GroupVariation::Group40Var1, GroupVariationType::STATIC, 5 },
+  { GroupVariation::Group40Var2, GroupVariationType::STATIC, 3 },
+  { GroupVariation::Group40Var3, GroupVariationType::STATIC, 5 },
+  { GroupVariation::Group40Var4, GroupVariationType::STATIC, 9 }
+};
+
+const GroupVariationEntry Group41Entries[] =
+{
+  { GroupVariation::Group41Var0, GroupVariationType::EVENT, 0 },
+  { GroupVariation::Group41Var1, GroupVariationType::EVENT, 5 },
+  { GroupVariation::Group41Var2, GroupVariationType::EVENT, 3 },
+  { GroupVariation::Group41Var3, GroupVariationType::EVENT, 5 },
+  { GroupVariation::Group41Var4, GroupVariationType::EVENT, 9 }
+};
+
+const GroupVariationEntry Group42Entries[] =
+{
+  { GroupVariation::Group42Var0, GroupVariationType::EVENT, 0 },
+  { GroupVariation::Group42Var1, GroupVariationType::EVENT, 5 },
+  { GroupVariation::Group42Var2, GroupVariationType::EVENT, 3 },
+  { GroupVariation::Group42Var3, GroupVariationType::EVENT, 11 },
+  { GroupVariation::Group42Var4, GroupVariationType::EVENT, 9 },
+  { GroupVariation::Group42Var5, GroupVariationType::EVENT, 5 },
+  { GroupVariation::Group42Var6, GroupVariationType::EVENT, 9 },
+  { GroupVariation::Group42Var7, GroupVariationType::EVENT, 11 },
+  { GroupVariation::Group42Var8, GroupVariationType::EVENT, 15 }
+};
+
+const GroupVariationEntry Group43Entries[] =
+{
+  { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 },
+  { GroupVariation::Group43Var1, GroupVariationType::EVENT, 5 },
+  { GroupVariation::Group43Var2, GroupVariationType::EVENT, 3 },
+  { GroupVariation::Group43Var3, GroupVariationType::EVENT, 11 },
+  { GroupVariation::Group43Var4, GroupVariationType::EVENT, 9 },
+  { GroupVariation::Group43Var5, GroupVariationType::EVENT, 5 },
+  { GroupVariation::Group43Var6, GroupVariationType::EVENT, 9 },
+  { GroupVariation::Group43Var7, GroupVariationType::EVENT, 11 },
+  { GroupVariation::Group43Var8, GroupVariationType::EVENT, 15 }
+};
+
+const GroupVariationEntry Group50Entries[] =
+{
+  { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group50Var1, GroupVariationType::OTHER, 6 },
+  { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 },
+  { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group50Var4, GroupVariationType::STATIC, 11 }
+};
+
+const GroupVariationEntry Group51Entries[] =
+{
+  { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group51Var1, GroupVariationType::OTHER, 6 },
+  { GroupVariation::Group51Var2, GroupVariationType::OTHER, 6 }
+};
+
+const GroupVariationEntry Group52Entries[] =
+{
+  { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group52Var1, GroupVariationType::OTHER, 2 },
+  { GroupVariation::Group52Var2, GroupVariationType::OTHER, 2 }
+};
+
+const GroupVariationEntry Group60Entries[] =
+{
+  { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 },
+  { GroupVariation::Group60Var1, GroupVariationType::STATIC, 0 },
+  { GroupVariation::Group60Var2, GroupVariationType::EVENT, 0 },
+  { GroupVariation::Group60Var3, GroupVariationType::EVENT, 0 },
+  { GroupVariation::Group60Var4, GroupVariationType::EVENT, 0 }
+};
+
+const GroupVariationEntry Group70Entries[] =
+{
+  { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group70Var1, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group70Var2, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group70Var3, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group70Var4, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group70Var5, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group70Var6, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group70Var7, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group70Var8, GroupVariationType::OTHER, 0 }
+};
+
+const GroupVariationEntry Group80Entries[] =
+{
+  { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group80Var1, GroupVariationType::OTHER, 0 }
+};
+
+const GroupVariationEntry Group110Entries[] =
+{
+  { GroupVariation::Group110Var0, GroupVariationType::STATIC, 0 }
+};
+
+const GroupVariationEntry Group111Entries[] =
+{
+  { GroupVariation::Group111Var0, GroupVariationType::EVENT, 0 }
+};
+
+const GroupVariationEntry Group112Entries[] =
+{
+  { GroupVariation::Group112Var0, GroupVariationType::OTHER, 0 }
+};
+
+const GroupVariationEntry Group113Entries[] =
+{
+  { GroupVariation::Group113Var0, GroupVariationType::OTHER, 0 }
+};
+
+const GroupVariationEntry Group120Entries[] =
+{
+  { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group120Var1, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group120Var2, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group120Var3, GroupVariationType::OTHER, 6 },
+  { GroupVariation::Group120Var4, GroupVariationType::OTHER, 2 },
+  { GroupVariation::Group120Var5, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group120Var6, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group120Var7, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group120Var8, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group120Var9, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group120Var10, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group120Var11, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group120Var12, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group120Var13, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group120Var14, GroupVariationType::OTHER, 0 },
+  { GroupVariation::Group120Var15, GroupVariationType::OTHER, 0 }
+};
+
+const GroupVariationEntry Group121Entries[] =
+{
+  { GroupVariation::Group121Var0, GroupVariationType::STATIC, 0 },
+  { GroupVariation::Group121Var1, GroupVariationType::STATIC, 7 }
+};
+
+const GroupVariationEntry Group122Entries[] =
+{
+  { GroupVariation::Group122Var0, GroupVariationType::EVENT, 0 },
+  { GroupVariation::Group122Var1, GroupVariationType::EVENT, 7 },
+  { GroupVariation::Group122Var2, GroupVariationType::EVENT, 13 }
+};
+
+const GroupVariationRow GroupVariationTable[256] =
+{
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { Group1Entries, 3, { GroupVariation::UNKNOWN, GroupVariationType::STATIC, 0 } },
+  { Group2Entries, 4, { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 } },
+  { Group3Entries, 3, { GroupVariation::UNKNOWN, GroupVariationType::STATIC, 0 } },
+  { Group4Entries, 4, { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { Group10Entries, 3, { GroupVariation::UNKNOWN, GroupVariationType::STATIC, 0 } },
+  { Group11Entries, 3, { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 } },
+  { Group12Entries, 2, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { Group13Entries, 3, { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { Group20Entries, 7, { GroupVariation::UNKNOWN, GroupVariationType::STATIC, 0 } },
+  { Group21Entries, 11, { GroupVariation::UNKNOWN, GroupVariationType::STATIC, 0 } },
+  { Group22Entries, 7, { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 } },
+  { Group23Entries, 7, { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { Group30Entries, 7, { GroupVariation::UNKNOWN, GroupVariationType::STATIC, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { Group32Entries, 9, { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { Group40Entries, 5, { GroupVariation::UNKNOWN, GroupVariationType::STATIC, 0 } },
+  { Group41Entries, 5, { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 } },
+  { Group42Entries, 9, { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 } },
+  { Group43Entries, 9, { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { Group50Entries, 5, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { Group51Entries, 3, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { Group52Entries, 3, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { Group60Entries, 5, { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { Group70Entries, 9, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { Group80Entries, 2, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { Group110Entries, 1, { GroupVariation::Group110Var0, GroupVariationType::STATIC, 0 } },
+  { Group111Entries, 1, { GroupVariation::Group111Var0, GroupVariationType::EVENT, 0 } },
+  { Group112Entries, 1, { GroupVariation::Group112Var0, GroupVariationType::OTHER, 0 } },
+  { Group113Entries, 1, { GroupVariation::Group113Var0, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { Group120Entries, 16, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { Group121Entries, 2, { GroupVariation::UNKNOWN, GroupVariationType::STATIC, 0 } },
+  { Group122Entries, 3, { GroupVariation::UNKNOWN, GroupVariationType::EVENT, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } },
+  { nullptr, 0, { GroupVariation::UNKNOWN, GroupVariationType::OTHER, 0 } }
+};
+
+}
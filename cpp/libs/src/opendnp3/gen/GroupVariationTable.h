@@ -0,0 +1,69 @@
+//
+//  _   _         ______    _ _ _   _             _ _ _
+// | \ | |       |  ____|  | (_) | (_)           | | | |
+// |  \| | ___   | |__   __| |_| |_ _ _ __   __ _| | | |
+// | . ` |/ _ \  |  __| / _` | | __| | '_ \ / _` | | | |
+// | |\  | (_) | | |___| (_| | | |_| | | | | (_| |_|_|_|
+// |_| \_|\___/  |______\__,_|_|\__|_|_| |_|\__, (_|_|_)
+//                                           __/ |
+//                                          |___/
+// 
+// This file is auto-generated. Do not edit manually
+// 
+// Copyright 2013 Automatak LLC
+// 
+// Automatak LLC (www.automatak.com) licenses this file
+// to you under the the Apache License Version 2.0 (the "License"):
+// 
+// http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef OPENDNP3_GROUPVARIATIONTABLE_H
+#define OPENDNP3_GROUPVARIATIONTABLE_H
+
+#include <cstdint>
+#include "opendnp3/gen/GroupVariation.h"
+
+namespace opendnp3 {
+
+/**
+  How a group/variation is classified when dispatching object headers
+*/
+enum class GroupVariationType : uint8_t
+{
+  STATIC,
+  EVENT,
+  OTHER
+};
+
+/**
+  Enumeration, type, and fixed object size (0 if not fixed) of a group/variation
+*/
+struct GroupVariationEntry
+{
+  GroupVariation enumeration;
+  GroupVariationType type;
+  uint16_t size;
+};
+
+/**
+  The entries of a single group, indexed by variation, and the entry for any variation beyond them
+*/
+struct GroupVariationRow
+{
+  const GroupVariationEntry* entries;
+  uint16_t count;
+  GroupVariationEntry other;
+};
+
+extern const GroupVariationRow GroupVariationTable[256];
+
+inline const GroupVariationEntry& LookupGroupVariation(uint8_t group, uint8_t variation)
+{
+  const GroupVariationRow& row = GroupVariationTable[group];
+  return (variation < row.count) ? row.entries[variation] : row.other;
+}
+
+}
+
+#endif
@@ -33,7 +33,8 @@ ChannelRetry::ChannelRetry(
 ) :
 	minOpenRetry(minOpenRetry_),
 	maxOpenRetry(maxOpenRetry_),
-	strategy(strategy_)
+	strategy(strategy_),
+	priority(0)
 {}
 
 ChannelRetry ChannelRetry::Default()
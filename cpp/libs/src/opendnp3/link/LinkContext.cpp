@@ -34,6 +34,8 @@ namespace opendnp3
 {
 
 LinkContext::LinkContext(openpal::Logger logger, openpal::IExecutor& executor, IUpperLayer& upper, opendnp3::ILinkListener& linkListener, ILinkSession& session, const LinkConfig& config_) :
+	batchTxBuffer(LPDU_MAX_BATCH_SIZE, true),
+	batchHasMoreSegments(false),
 	logger(logger),
 	config(config_),
 	pSegments(nullptr),
@@ -41,7 +43,8 @@ LinkContext::LinkContext(openpal::Logger logger, openpal::IExecutor& executor, I
 	numRetryRemaining(0),
 	pExecutor(&executor),
 	rspTimeoutTimer(executor),
-	keepAliveTimer(executor),
+	pKeepAlives(nullptr),
+	keepAliveSlot(NO_KEEP_ALIVE_SLOT),
 	nextReadFCB(false),
 	nextWriteFCB(false),
 	isOnline(false),
@@ -56,6 +59,14 @@ LinkContext::LinkContext(openpal::Logger logger, openpal::IExecutor& executor, I
 	pUpperLayer(&upper)
 {}
 
+LinkContext::~LinkContext()
+{
+	if (pKeepAlives)
+	{
+		pKeepAlives->Remove(*this);
+	}
+}
+
 bool LinkContext::OnLowerLayerUp()
 {
 	if (this->isOnline)
@@ -66,10 +77,14 @@ bool LinkContext::OnLowerLayerUp()
 
 	this->isOnline = true;
 
-	auto now = this->pExecutor->GetTime();
-	this->lastMessageTimestamp = now; // no reason to trigger a keep-alive until we've actually expired
-	MonotonicTimestamp expiration(now.milliseconds + config.KeepAliveTimeout.GetMilliseconds());
-	this->StartKeepAliveTimer(MonotonicTimestamp(now.milliseconds + config.KeepAliveTimeout.GetMilliseconds()));
+	this->lastMessageTimestamp = this->pExecutor->GetTime(); // no reason to trigger a keep-alive until we've actually expired
+
+	if (!this->pKeepAlives)
+	{
+		this->ownedKeepAlives.reset(new LinkKeepAliveScheduler(*pExecutor, TimeDuration::Zero()));
+		this->pKeepAlives = this->ownedKeepAlives.get();
+	}
+	this->pKeepAlives->Add(*this);
 
 	this->PostStatusCallback(opendnp3::LinkStatus::UNRESET);
 
@@ -93,12 +108,13 @@ bool LinkContext::OnLowerLayerDown()
 	keepAliveTimeout = false;
 	isRemoteReset = false;
 	pSegments = nullptr;
+	batchTxBuffer.Shrink(0);
 	txMode = LinkTransmitMode::Idle;
 	pendingPriTx.Clear();
 	pendingSecTx.Clear();
 
 	rspTimeoutTimer.Cancel();
-	keepAliveTimer.Cancel();
+	pKeepAlives->Remove(*this);
 
 	pPriState = &PLLS_Idle::Instance();
 	pSecState = &SLLS_NotReset::Instance();
@@ -175,6 +191,36 @@ RSlice LinkContext::FormatPrimaryBufferWithUnconfirmed(const openpal::RSlice& tp
 	return output;
 }
 
+RSlice LinkContext::FormatPrimaryBatchWithUnconfirmed(ITransportSegment& segments)
+{
+	auto first = this->FormatPrimaryBufferWithUnconfirmed(segments.GetSegment());
+	this->batchHasMoreSegments = segments.Advance();
+	if (!this->batchHasMoreSegments)
+	{
+		return first;
+	}
+
+	// nothing acknowledges unconfirmed frames, so the rest of the fragment goes out back to back in as few writes as possible
+	if (!batchTxBuffer.IsLeased())
+	{
+		batchTxBuffer.Grow(0);
+	}
+
+	auto dest = batchTxBuffer.GetWSlice();
+	auto size = first.CopyTo(dest).Size();
+
+	while (this->batchHasMoreSegments && dest.Size() >= LPDU_MAX_FRAME_SIZE)
+	{
+		auto tpdu = segments.GetSegment();
+		auto output = LinkFrame::FormatUnconfirmedUserData(dest, config.IsMaster, config.RemoteAddr, config.LocalAddr, tpdu, tpdu.Size(), &logger);
+		FORMAT_HEX_BLOCK(logger, flags::LINK_TX_HEX, output, 10, 18);
+		size += output.Size();
+		this->batchHasMoreSegments = segments.Advance();
+	}
+
+	return batchTxBuffer.ToRSlice().Take(size);
+}
+
 void LinkContext::QueueTransmit(const RSlice& buffer, bool primary)
 {
 	if (txMode == LinkTransmitMode::Idle)
@@ -266,6 +312,7 @@ void LinkContext::PostStatusCallback(opendnp3::LinkStatus status)
 void LinkContext::CompleteSendOperation(bool success)
 {
 	this->pSegments = nullptr;
+	this->batchTxBuffer.Shrink(0);
 
 	if (pUpperLayer)
 	{
@@ -291,21 +338,10 @@ void LinkContext::TryStartTransmission()
 	}
 }
 
-void LinkContext::OnKeepAliveTimeout()
+void LinkContext::OnKeepAliveTimeout(const MonotonicTimestamp& now)
 {
-	auto now = this->pExecutor->GetTime();
-
-	auto elapsed = now.milliseconds - this->lastMessageTimestamp.milliseconds;
-
-	if (elapsed >= this->config.KeepAliveTimeout.GetMilliseconds())
-	{
-		this->lastMessageTimestamp = now;
-		this->keepAliveTimeout = true;
-	}
-
-	// No matter what, reschedule the timer based on last message timestamp
-	MonotonicTimestamp expiration(this->lastMessageTimestamp.milliseconds + config.KeepAliveTimeout);
-	this->StartKeepAliveTimer(expiration);
+	this->lastMessageTimestamp = now;
+	this->keepAliveTimeout = true;
 
 	this->TryStartTransmission();
 }
@@ -328,12 +364,9 @@ void LinkContext::StartResponseTimer()
 	);
 }
 
-void LinkContext::StartKeepAliveTimer(const MonotonicTimestamp& expiration)
+MonotonicTimestamp LinkContext::KeepAliveDeadline() const
 {
-	this->keepAliveTimer.Start(expiration, [this]()
-	{
-		this->OnKeepAliveTimeout();
-	});
+	return this->lastMessageTimestamp.Add(config.KeepAliveTimeout);
 }
 
 void LinkContext::CancelTimer()
@@ -28,11 +28,15 @@
 #include <openpal/container/StaticBuffer.h>
 
 #include "opendnp3/gen/LinkStatus.h"
+#include "opendnp3/app/FragmentBuffer.h"
 #include "opendnp3/link/ILinkLayer.h"
 #include "opendnp3/link/ILinkSession.h"
 #include "opendnp3/link/LinkLayerConstants.h"
 #include "opendnp3/link/LinkConfig.h"
 #include "opendnp3/link/ILinkListener.h"
+#include "opendnp3/link/LinkKeepAliveScheduler.h"
+
+#include <memory>
 
 namespace opendnp3
 {
@@ -57,6 +61,10 @@ public:
 
 	LinkContext(openpal::Logger logger, openpal::IExecutor&, IUpperLayer& upper, opendnp3::ILinkListener&, ILinkSession& session, const LinkConfig&);
 
+	~LinkContext();
+
+	/// keepAliveSlot of a session that isn't registered with a keep-alive scheduler
+	static const uint32_t NO_KEEP_ALIVE_SLOT = 0xFFFFFFFF;
 
 	/// ---- helpers for dealing with the FCB bits ----
 
@@ -85,6 +93,7 @@ public:
 
 	/// --- helpers for formatting user data messages ---
 	openpal::RSlice FormatPrimaryBufferWithUnconfirmed(const openpal::RSlice& tpdu);
+	openpal::RSlice FormatPrimaryBatchWithUnconfirmed(ITransportSegment& segments);
 	openpal::RSlice FormatPrimaryBufferWithConfirmed(const openpal::RSlice& tpdu, bool FCB);
 
 	/// --- Helpers for queueing frames ---
@@ -102,10 +111,10 @@ public:
 	void PostStatusCallback(opendnp3::LinkStatus status);
 	void CompleteSendOperation(bool success);
 	void TryStartTransmission();
-	void OnKeepAliveTimeout();
+	void OnKeepAliveTimeout(const openpal::MonotonicTimestamp& now);
 	void OnResponseTimeout();
 	void StartResponseTimer();
-	void StartKeepAliveTimer(const openpal::MonotonicTimestamp& expiration);
+	openpal::MonotonicTimestamp KeepAliveDeadline() const;
 	void CancelTimer();
 	void FailKeepAlive(bool timeout);
 	void CompleteKeepAlive();
@@ -117,6 +126,11 @@ public:
 	openpal::StaticBuffer<LPDU_MAX_FRAME_SIZE> priTxBuffer;
 	openpal::StaticBuffer<LPDU_HEADER_SIZE> secTxBuffer;
 
+	// unconfirmed frames of a multi-frame fragment, leased from the pool only while they are sent
+	FragmentBuffer batchTxBuffer;
+	// true if the current segment still has to be formatted into the next batch
+	bool batchHasMoreSegments;
+
 	openpal::Settable<openpal::RSlice> pendingPriTx;
 	openpal::Settable<openpal::RSlice> pendingSecTx;
 
@@ -127,7 +141,10 @@ public:
 	uint32_t numRetryRemaining;
 	openpal::IExecutor* pExecutor;
 	openpal::TimerRef rspTimeoutTimer;
-	openpal::TimerRef keepAliveTimer;
+	// keep-alives are sent by a scheduler shared with the other sessions on the executor, or a private one if none is set
+	LinkKeepAliveScheduler* pKeepAlives;
+	std::unique_ptr<LinkKeepAliveScheduler> ownedKeepAlives;
+	uint32_t keepAliveSlot;
 	bool nextReadFCB;
 	bool nextWriteFCB;
 	bool isOnline;
@@ -79,6 +79,31 @@ uint32_t LinkFrame::CalcFrameSize(uint8_t dataLength)
 	return LPDU_HEADER_SIZE + CalcUserDataSize(dataLength);
 }
 
+uint32_t LinkFrame::CountFrames(const openpal::RSlice& frames)
+{
+	uint32_t count = 0;
+	auto remaining = frames;
+	while (remaining.Size() >= LPDU_HEADER_SIZE)
+	{
+		// the length field counts the 5 header bytes after it, but not the CRCs
+		auto length = remaining[2];
+		if (length < LPDU_MIN_LENGTH)
+		{
+			break;
+		}
+
+		auto size = CalcFrameSize(length - LPDU_MIN_LENGTH);
+		if (size > remaining.Size())
+		{
+			break;
+		}
+
+		++count;
+		remaining.Advance(size);
+	}
+	return count;
+}
+
 uint32_t LinkFrame::CalcUserDataSize(uint8_t dataLength)
 {
 	if (dataLength > 0)
@@ -80,6 +80,9 @@ public:
 	// @return Total frame size based on user data length
 	static uint32_t CalcFrameSize(uint8_t dataLength);
 
+	// @return Number of well formed frames written back to back in the buffer
+	static uint32_t CountFrames(const openpal::RSlice& frames);
+
 private:
 
 	static uint32_t CalcUserDataSize(uint8_t dataLength);
@@ -0,0 +1,130 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+
+#include "LinkKeepAliveScheduler.h"
+
+#include "opendnp3/link/LinkContext.h"
+
+#include <limits>
+
+using namespace openpal;
+
+namespace opendnp3
+{
+
+const TimeDuration LinkKeepAliveScheduler::DEFAULT_RESOLUTION = TimeDuration::Seconds(1);
+
+LinkKeepAliveScheduler::LinkKeepAliveScheduler(openpal::IExecutor& executor, const openpal::TimeDuration& resolution) :
+	pExecutor(&executor),
+	resolutionMs(resolution.GetMilliseconds()),
+	timer(executor),
+	numSweeps(0)
+{
+
+}
+
+void LinkKeepAliveScheduler::Add(LinkContext& session)
+{
+	session.keepAliveSlot = static_cast<uint32_t>(sessions.size());
+	sessions.push_back(&session);
+	this->Schedule(session.KeepAliveDeadline());
+}
+
+void LinkKeepAliveScheduler::Remove(LinkContext& session)
+{
+	auto slot = session.keepAliveSlot;
+	if (slot >= sessions.size() || sessions[slot] != &session)
+	{
+		return;
+	}
+
+	sessions[slot] = sessions.back();
+	sessions[slot]->keepAliveSlot = slot;
+	sessions.pop_back();
+	session.keepAliveSlot = LinkContext::NO_KEEP_ALIVE_SLOT;
+
+	if (sessions.empty())
+	{
+		timer.Cancel();
+	}
+}
+
+void LinkKeepAliveScheduler::Sweep()
+{
+	++numSweeps;
+
+	auto now = pExecutor->GetTime();
+	auto next = MonotonicTimestamp::Max();
+
+	due.clear();
+	for (auto pSession : sessions)
+	{
+		auto deadline = pSession->KeepAliveDeadline();
+		if (!(deadline > now))
+		{
+			due.push_back(pSession);
+			deadline = now.Add(pSession->config.KeepAliveTimeout);
+		}
+		if (deadline < next)
+		{
+			next = deadline;
+		}
+	}
+
+	if (!sessions.empty())
+	{
+		this->Schedule(next);
+	}
+
+	// skip the sessions that went offline while earlier ones were handled
+	for (auto pSession : due)
+	{
+		if (pSession->keepAliveSlot != LinkContext::NO_KEEP_ALIVE_SLOT)
+		{
+			pSession->OnKeepAliveTimeout(now);
+		}
+	}
+}
+
+void LinkKeepAliveScheduler::Schedule(const MonotonicTimestamp& deadline)
+{
+	auto expiration = deadline;
+	if (resolutionMs > 1 && !deadline.IsMax() && deadline.milliseconds < std::numeric_limits<int64_t>::max() - resolutionMs)
+	{
+		auto remainder = deadline.milliseconds % resolutionMs;
+		if (remainder > 0)
+		{
+			expiration = MonotonicTimestamp(deadline.milliseconds + resolutionMs - remainder);
+		}
+	}
+
+	if (timer.IsActive() && !(timer.ExpiresAt() > expiration))
+	{
+		return;
+	}
+
+	timer.Restart(expiration, [this]()
+	{
+		this->Sweep();
+	});
+}
+
+}
@@ -0,0 +1,84 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef OPENDNP3_LINK_KEEP_ALIVE_SCHEDULER_H
+#define OPENDNP3_LINK_KEEP_ALIVE_SCHEDULER_H
+
+#include <openpal/executor/IExecutor.h>
+#include <openpal/executor/TimerRef.h>
+#include <openpal/util/Uncopyable.h>
+
+#include <vector>
+
+namespace opendnp3
+{
+
+class LinkContext;
+
+/**
+* Sends the keep-alives of every online link session on an executor from a single timer.
+*
+* Each sweep requests link status from the sessions that have been quiet for their keep-alive timeout,
+* then re-arms the timer for the earliest remaining deadline. Deadlines are rounded up to the resolution
+* so that sessions falling due close together are handled, and their requests queued, by the same sweep.
+*/
+class LinkKeepAliveScheduler : private openpal::Uncopyable
+{
+public:
+
+	/// Resolution of the schedulers shared by the sessions of a channel or listener
+	static const openpal::TimeDuration DEFAULT_RESOLUTION;
+
+	LinkKeepAliveScheduler(openpal::IExecutor& executor, const openpal::TimeDuration& resolution);
+
+	/// Start checking a session that came online
+	void Add(LinkContext& session);
+
+	/// Stop checking a session that went offline
+	void Remove(LinkContext& session);
+
+	uint32_t NumSessions() const
+	{
+		return static_cast<uint32_t>(sessions.size());
+	}
+
+	uint64_t NumSweeps() const
+	{
+		return numSweeps;
+	}
+
+private:
+
+	void Sweep();
+
+	void Schedule(const openpal::MonotonicTimestamp& deadline);
+
+	openpal::IExecutor* pExecutor;
+	const int64_t resolutionMs;
+	openpal::TimerRef timer;
+	uint64_t numSweeps;
+
+	std::vector<LinkContext*> sessions;
+	std::vector<LinkContext*> due;
+};
+
+}
+
+#endif
@@ -35,6 +35,12 @@ void LinkLayer::SetRouter(ILinkRouter& router)
 	ctx.pRouter = &router;
 }
 
+void LinkLayer::SetKeepAliveScheduler(LinkKeepAliveScheduler& scheduler)
+{
+	assert(!ctx.isOnline);
+	ctx.pKeepAlives = &scheduler;
+}
+
 ////////////////////////////////
 // ILowerLayer
 ////////////////////////////////
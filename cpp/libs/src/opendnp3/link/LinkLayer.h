@@ -36,6 +36,9 @@ public:
 
 	void SetRouter(ILinkRouter&);
 
+	/// Share a keep-alive scheduler with the other sessions on the executor, set before the session comes online
+	void SetKeepAliveScheduler(LinkKeepAliveScheduler&);
+
 	// ---- Events from below: ILinkSession / IFrameSink  ----
 
 	virtual bool OnLowerLayerUp() override;
@@ -35,6 +35,9 @@ const uint8_t LPDU_DATA_PLUS_CRC_SIZE = 18;
 const uint8_t LPDU_MAX_USER_DATA_SIZE = 250;
 const uint16_t LPDU_MAX_FRAME_SIZE = 292;	//10(header) + 250 (user data) + 32 (block CRC's) = 292 frame bytes
 
+// bytes of unconfirmed frames written back to back in one transmission, 7 full frames fit the smallest pooled fragment block
+const uint16_t LPDU_MAX_BATCH_SIZE = 7 * LPDU_MAX_FRAME_SIZE;
+
 
 /// Indices for use with buffers containing link headers
 enum LinkHeaderIndex : uint8_t
@@ -95,8 +95,7 @@ PLLS_Idle PLLS_Idle::instance;
 
 PriStateBase& PLLS_Idle::TrySendUnconfirmed(LinkContext& ctx, ITransportSegment& segments)
 {
-	auto first = segments.GetSegment();
-	auto output = ctx.FormatPrimaryBufferWithUnconfirmed(first);
+	auto output = ctx.FormatPrimaryBatchWithUnconfirmed(segments);
 	ctx.QueueTransmit(output, true);
 	return PLLS_SendUnconfirmedTransmitWait::Instance();
 }
@@ -134,9 +133,9 @@ PLLS_SendUnconfirmedTransmitWait PLLS_SendUnconfirmedTransmitWait::instance;
 
 PriStateBase& PLLS_SendUnconfirmedTransmitWait::OnTransmitResult(LinkContext& ctx, bool success)
 {
-	if (ctx.pSegments->Advance())
+	if (ctx.batchHasMoreSegments)
 	{
-		auto output = ctx.FormatPrimaryBufferWithUnconfirmed(ctx.pSegments->GetSegment());
+		auto output = ctx.FormatPrimaryBatchWithUnconfirmed(*ctx.pSegments);
 		ctx.QueueTransmit(output, true);
 		return *this;
 	}
@@ -26,78 +26,115 @@
 #include <opendnp3/objects/Group12.h>
 #include <opendnp3/objects/Group41.h>
 
+#include <cstddef>
+
 namespace opendnp3
 {
 
-CommandSet::CommandSet(CommandSet&& other) : m_headers(std::move(other.m_headers))
+template <class T>
+TypedCommandHeader<T>* ConstructHeader(void* slot, const DNP3Serializer<T>& serializer)
 {
+	static_assert(sizeof(TypedCommandHeader<T>) <= CommandSet::HEADER_SLOT_SIZE, "header does not fit in an inline slot");
+	static_assert(std::alignment_of<TypedCommandHeader<T>>::value <= std::alignment_of<std::max_align_t>::value, "header is over-aligned");
+
+	return slot ? new (slot) TypedCommandHeader<T>(serializer) : new TypedCommandHeader<T>(serializer);
+}
 
+CommandSet::CommandSet(CommandSet&& other) :
+	m_headers(std::move(other.m_headers)),
+	m_block(other.m_block)
+{
+	other.m_block = nullptr;
 }
 
 CommandSet::~CommandSet()
 {
-	for(auto header : m_headers)
+	for (uint32_t i = 0; i < m_headers.size(); ++i)
+	{
+		if (i < INLINE_HEADERS)
+		{
+			m_headers[i]->~ICommandHeader();
+		}
+		else
+		{
+			delete m_headers[i];
+		}
+	}
+
+	delete m_block;
+}
+
+void* CommandSet::NextSlot()
+{
+	if (m_headers.size() >= INLINE_HEADERS)
 	{
-		delete header;
+		return nullptr;
 	}
+
+	if (!m_block)
+	{
+		m_block = new HeaderBlock();
+	}
+
+	return &m_block->slots[m_headers.size()];
 }
 
-CommandSet::CommandSet(std::initializer_list<Indexed<ControlRelayOutputBlock>> items)
+CommandSet::CommandSet(std::initializer_list<Indexed<ControlRelayOutputBlock>> items) : m_block(nullptr)
 {
 	this->Add(items);
 }
 
-CommandSet::CommandSet(std::initializer_list<Indexed<AnalogOutputInt16>> items)
+CommandSet::CommandSet(std::initializer_list<Indexed<AnalogOutputInt16>> items) : m_block(nullptr)
 {
 	this->Add(items);
 }
 
-CommandSet::CommandSet(std::initializer_list<Indexed<AnalogOutputInt32>> items)
+CommandSet::CommandSet(std::initializer_list<Indexed<AnalogOutputInt32>> items) : m_block(nullptr)
 {
 	this->Add(items);
 }
 
-CommandSet::CommandSet(std::initializer_list<Indexed<AnalogOutputFloat32>> items)
+CommandSet::CommandSet(std::initializer_list<Indexed<AnalogOutputFloat32>> items) : m_block(nullptr)
 {
 	this->Add(items);
 }
 
-CommandSet::CommandSet(std::initializer_list<Indexed<AnalogOutputDouble64>> items)
+CommandSet::CommandSet(std::initializer_list<Indexed<AnalogOutputDouble64>> items) : m_block(nullptr)
 {
 	this->Add(items);
 }
 
 ICommandCollection<ControlRelayOutputBlock>& CommandSet::StartHeaderCROB()
 {
-	TypedCommandHeader<ControlRelayOutputBlock>* header = new TypedCommandHeader<ControlRelayOutputBlock>(Group12Var1::Inst());
+	auto header = ConstructHeader<ControlRelayOutputBlock>(this->NextSlot(), Group12Var1::Inst());
 	this->m_headers.push_back(header);
 	return *header;
 }
 
 ICommandCollection<AnalogOutputInt32>& CommandSet::StartHeaderAOInt32()
 {
-	TypedCommandHeader<AnalogOutputInt32>* header = new TypedCommandHeader<AnalogOutputInt32>(Group41Var1::Inst());
+	auto header = ConstructHeader<AnalogOutputInt32>(this->NextSlot(), Group41Var1::Inst());
 	this->m_headers.push_back(header);
 	return *header;
 }
 
 ICommandCollection<AnalogOutputInt16>& CommandSet::StartHeaderAOInt16()
 {
-	TypedCommandHeader<AnalogOutputInt16>* header = new TypedCommandHeader<AnalogOutputInt16>(Group41Var2::Inst());
+	auto header = ConstructHeader<AnalogOutputInt16>(this->NextSlot(), Group41Var2::Inst());
 	this->m_headers.push_back(header);
 	return *header;
 }
 
 ICommandCollection<AnalogOutputFloat32>& CommandSet::StartHeaderAOFloat32()
 {
-	TypedCommandHeader<AnalogOutputFloat32>* header = new TypedCommandHeader<AnalogOutputFloat32>(Group41Var3::Inst());
+	auto header = ConstructHeader<AnalogOutputFloat32>(this->NextSlot(), Group41Var3::Inst());
 	this->m_headers.push_back(header);
 	return *header;
 }
 
 ICommandCollection<AnalogOutputDouble64>& CommandSet::StartHeaderAODouble64()
 {
-	TypedCommandHeader<AnalogOutputDouble64>* header = new TypedCommandHeader<AnalogOutputDouble64>(Group41Var4::Inst());
+	auto header = ConstructHeader<AnalogOutputDouble64>(this->NextSlot(), Group41Var4::Inst());
 	this->m_headers.push_back(header);
 	return *header;
 }
@@ -39,31 +39,36 @@ IINField CommandSetOps::ProcessAny(const PrefixHeader& header, const ICollection
 		return IINBit::PARAM_ERROR;
 	}
 
-	if (header.headerIndex >= commands->m_headers.size()) // more response headers than request headers
+	if (header.headerIndex >= headers->size()) // more response headers than request headers
 	{
 		return IINBit::PARAM_ERROR;
 	}
 
 	if (mode == Mode::Select)
 	{
-		commands->m_headers[header.headerIndex]->ApplySelectResponse(values);
+		(*headers)[header.headerIndex]->ApplySelectResponse(values);
 	}
 	else
 	{
-		commands->m_headers[header.headerIndex]->ApplyOperateResponse(values);
+		(*headers)[header.headerIndex]->ApplyOperateResponse(values);
 	}
 
 	return IINField::Empty();
 }
 
-CommandSetOps::CommandSetOps(Mode mode_, CommandSet& commands_) :
+CommandSetOps::CommandSetOps(Mode mode_, const CommandSet::HeaderVector& headers_) :
 	mode(mode_),
-	commands(&commands_)
+	headers(&headers_)
 {}
 
 bool CommandSetOps::Write(const CommandSet& set, HeaderWriter& writer)
 {
-	for(auto & header : set.m_headers)
+	return Write(set.m_headers, writer);
+}
+
+bool CommandSetOps::Write(const CommandSet::HeaderVector& headers, HeaderWriter& writer)
+{
+	for(auto & header : headers)
 	{
 		if (!header->Write(writer))
 		{
@@ -74,6 +79,33 @@ bool CommandSetOps::Write(const CommandSet& set, HeaderWriter& writer)
 	return true;
 }
 
+void CommandSetOps::AppendHeaders(const CommandSet& set, CommandSet::HeaderVector& headers)
+{
+	for (auto header : set.m_headers)
+	{
+		headers.push_back(header);
+	}
+}
+
+bool CommandSetOps::Measure(const CommandSet& set, uint32_t& numObjects, uint32_t& numBytes)
+{
+	numObjects = 0;
+	numBytes = 0;
+
+	for (auto & header : set.m_headers)
+	{
+		if (header->Count() == 0)
+		{
+			return false;
+		}
+
+		numObjects += header->Count();
+		numBytes += header->WriteSize();
+	}
+
+	return numObjects > 0;
+}
+
 void CommandSetOps::InvokeCallback(const CommandSet& set, TaskCompletion result, CommandCallbackT& callback)
 {
 	CommandTaskResult impl(result, set.m_headers);
@@ -82,7 +114,12 @@ void CommandSetOps::InvokeCallback(const CommandSet& set, TaskCompletion result,
 
 CommandSetOps::SelectResult CommandSetOps::ProcessSelectResponse(CommandSet& set, const openpal::RSlice& headers, openpal::Logger* logger)
 {
-	CommandSetOps handler(Mode::Select, set);
+	return ProcessSelectResponse(set.m_headers, headers, logger);
+}
+
+CommandSetOps::SelectResult CommandSetOps::ProcessSelectResponse(const CommandSet::HeaderVector& commands, const openpal::RSlice& headers, openpal::Logger* logger)
+{
+	CommandSetOps handler(Mode::Select, commands);
 	if (APDUParser::Parse(headers, handler, logger) != ParseResult::OK)
 	{
 		return SelectResult::FAIL_PARSE;
@@ -92,12 +129,17 @@ CommandSetOps::SelectResult CommandSetOps::ProcessSelectResponse(CommandSet& set
 	{
 		return header->AreAllSelected();
 	};
-	return std::all_of(set.m_headers.begin(), set.m_headers.end(), selected) ? SelectResult::OK : SelectResult::FAIL_SELECT;
+	return std::all_of(commands.begin(), commands.end(), selected) ? SelectResult::OK : SelectResult::FAIL_SELECT;
 }
 
 CommandSetOps::OperateResult CommandSetOps::ProcessOperateResponse(CommandSet& set, const openpal::RSlice& headers, openpal::Logger* logger)
 {
-	CommandSetOps handler(Mode::Operate, set);
+	return ProcessOperateResponse(set.m_headers, headers, logger);
+}
+
+CommandSetOps::OperateResult CommandSetOps::ProcessOperateResponse(const CommandSet::HeaderVector& commands, const openpal::RSlice& headers, openpal::Logger* logger)
+{
+	CommandSetOps handler(Mode::Operate, commands);
 	return (APDUParser::Parse(headers, handler, logger) == ParseResult::OK) ? OperateResult::OK : OperateResult::FAIL_PARSE;
 }
 
@@ -45,7 +45,7 @@ class CommandSetOps final : public IAPDUHandler, private openpal::Uncopyable
 	    Operate
 	};
 
-	CommandSetOps(Mode mode, CommandSet& commands_);
+	CommandSetOps(Mode mode, const CommandSet::HeaderVector& headers_);
 
 	Mode mode;
 
@@ -67,6 +67,19 @@ public:
 	/// Write the headers to an ASDU
 	static bool Write(const CommandSet& set, HeaderWriter& writer);
 
+	/// Write the headers of one or more sets to an ASDU
+	static bool Write(const CommandSet::HeaderVector& headers, HeaderWriter& writer);
+
+	/// Append pointers to the headers of a set to a vector without transferring ownership
+	static void AppendHeaders(const CommandSet& set, CommandSet::HeaderVector& headers);
+
+	/**
+	* Measure the number of command objects in a set and the number of bytes its headers occupy in an ASDU
+	*
+	* @return false if the set is empty or contains an empty header, i.e. it can't be written
+	*/
+	static bool Measure(const CommandSet& set, uint32_t& numObjects, uint32_t& numBytes);
+
 	/// Invoke the callback for a response
 	static void InvokeCallback(const CommandSet& set, TaskCompletion result, CommandCallbackT& callback);
 
@@ -76,6 +89,7 @@ public:
 	* @return true if every object in every header was correctly selected, false otherwise
 	*/
 	static SelectResult ProcessSelectResponse(CommandSet& set, const openpal::RSlice& headers, openpal::Logger* logger);
+	static SelectResult ProcessSelectResponse(const CommandSet::HeaderVector& commands, const openpal::RSlice& headers, openpal::Logger* logger);
 
 	/**
 	* parses a response to an operate (or DO), applying each received header to the command set
@@ -83,6 +97,7 @@ public:
 	* @return true if parsing was successful, the results are left in the set
 	*/
 	static OperateResult ProcessOperateResponse(CommandSet& set, const openpal::RSlice& headers, openpal::Logger* logger);
+	static OperateResult ProcessOperateResponse(const CommandSet::HeaderVector& commands, const openpal::RSlice& headers, openpal::Logger* logger);
 
 private:
 
@@ -97,7 +112,7 @@ private:
 	template <class T>
 	IINField ProcessAny(const PrefixHeader& header, const ICollection<Indexed<T>>& values);
 
-	CommandSet* commands;
+	const CommandSet::HeaderVector* headers;
 };
 
 }
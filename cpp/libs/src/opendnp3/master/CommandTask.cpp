@@ -26,6 +26,7 @@
 #include <openpal/logging/LogMacros.h>
 
 #include "opendnp3/app/parsing/APDUParser.h"
+#include "opendnp3/app/APDUHeader.h"
 #include "opendnp3/LogLevels.h"
 
 using namespace openpal;
@@ -35,7 +36,12 @@ namespace opendnp3
 
 IMasterTask* CommandTask::FDirectOperate(CommandSet&& set, IMasterApplication& app, const CommandCallbackT& callback, const TaskConfig& config, openpal::Logger logger)
 {
-	auto task = new CommandTask(std::move(set), app, callback, config, logger);
+	return FDirectOperate(std::move(set), app, callback, config, CoalesceLimits::None(), logger);
+}
+
+IMasterTask* CommandTask::FDirectOperate(CommandSet&& set, IMasterApplication& app, const CommandCallbackT& callback, const TaskConfig& config, const CoalesceLimits& limits, openpal::Logger logger)
+{
+	auto task = new CommandTask(std::move(set), app, callback, config, limits, logger);
 	task->LoadDirectOperate();
 	return task;
 }
@@ -43,42 +49,88 @@ IMasterTask* CommandTask::FDirectOperate(CommandSet&& set, IMasterApplication& a
 
 IMasterTask* CommandTask::FSelectAndOperate(CommandSet&& set, IMasterApplication& app, const CommandCallbackT& callback, const TaskConfig& config, openpal::Logger logger)
 {
-	auto task = new CommandTask(std::move(set), app, callback, config, logger);
+	auto task = new CommandTask(std::move(set), app, callback, config, CoalesceLimits::None(), logger);
 	task->LoadSelectAndOperate();
 	return task;
 }
 
-CommandTask::CommandTask(CommandSet&& commands_, IMasterApplication& app, const CommandCallbackT& callback, const TaskConfig& config, openpal::Logger logger) :
+CommandTask::CommandTask(CommandSet&& commands_, IMasterApplication& app, const CommandCallbackT& callback, const TaskConfig& config, const CoalesceLimits& limits_, openpal::Logger logger) :
 	IMasterTask(app, MonotonicTimestamp::Min(), logger, config),
+	numFunctionCodes(0),
+	nextFunctionCode(0),
 	statusResult(CommandStatus::UNDEFINED),
-	commandCallback(callback),
-	commands(std::move(commands_))
+	limits(limits_),
+	coalescable(false),
+	numObjects(0),
+	numBytes(0)
+{
+	coalescable = (limits.maxObjects > 0) && IsCoalescable(config) && CommandSetOps::Measure(commands_, numObjects, numBytes);
+	batches.push_back(Batch(std::move(commands_), callback));
+	CommandSetOps::AppendHeaders(batches.back().commands, headers);
+}
+
+bool CommandTask::IsCoalescable(const TaskConfig& config)
 {
+	// a task callback or id belongs to a single caller and can't be shared by a merged request
+	return (config.pCallback == nullptr) && !config.taskId.IsDefined();
+}
+
+bool CommandTask::CoalesceDirectOperate(CommandSet& commands, const CommandCallbackT& callback, const TaskConfig& config)
+{
+	if (!coalescable || !IsCoalescable(config))
+	{
+		return false;
+	}
 
+	uint32_t objects = 0;
+	uint32_t bytes = 0;
+	if (!CommandSetOps::Measure(commands, objects, bytes))
+	{
+		return false;
+	}
+
+	const bool FITS_OBJECTS = (numObjects + objects) <= limits.maxObjects;
+	const bool FITS_FRAGMENT = (APDU_REQUEST_HEADER_SIZE + numBytes + bytes) <= limits.maxTxFragSize;
+
+	if (!(FITS_OBJECTS && FITS_FRAGMENT))
+	{
+		return false;
+	}
+
+	numObjects += objects;
+	numBytes += bytes;
+	batches.push_back(Batch(std::move(commands), callback));
+	CommandSetOps::AppendHeaders(batches.back().commands, headers);
+
+	FORMAT_LOG_BLOCK(logger, flags::DBG, "Coalesced %u command(s) into pending direct operate, %u total", objects, numObjects);
+
+	return true;
 }
 
 void CommandTask::LoadSelectAndOperate()
 {
-	functionCodes.clear();
-	functionCodes.push_back(FunctionCode::SELECT);
-	functionCodes.push_back(FunctionCode::OPERATE);
+	functionCodes[0] = FunctionCode::SELECT;
+	functionCodes[1] = FunctionCode::OPERATE;
+	numFunctionCodes = 2;
+	nextFunctionCode = 0;
 }
 
 void CommandTask::LoadDirectOperate()
 {
-	functionCodes.clear();
-	functionCodes.push_back(FunctionCode::DIRECT_OPERATE);
+	functionCodes[0] = FunctionCode::DIRECT_OPERATE;
+	numFunctionCodes = 1;
+	nextFunctionCode = 0;
 }
 
 bool CommandTask::BuildRequest(APDURequest& request, uint8_t seq)
 {
-	if (!functionCodes.empty())
+	if (nextFunctionCode < numFunctionCodes)
 	{
-		request.SetFunction(functionCodes.front());
-		functionCodes.pop_front();
+		request.SetFunction(functionCodes[nextFunctionCode]);
+		++nextFunctionCode;
 		request.SetControl(AppControlField::Request(seq));
 		auto writer = request.GetWriter();
-		return CommandSetOps::Write(commands, writer);
+		return CommandSetOps::Write(headers, writer);
 	}
 
 	return false;
@@ -91,7 +143,10 @@ IMasterTask::ResponseResult CommandTask::ProcessResponse(const APDUResponseHeade
 
 IMasterTask::TaskState CommandTask::OnTaskComplete(TaskCompletion result, openpal::MonotonicTimestamp now)
 {
-	CommandSetOps::InvokeCallback(commands, result, this->commandCallback);
+	for (auto & batch : batches)
+	{
+		CommandSetOps::InvokeCallback(batch.commands, result, batch.callback);
+	}
 	return TaskState::Infinite();
 }
 
@@ -102,14 +157,14 @@ void CommandTask::Initialize()
 
 IMasterTask::ResponseResult CommandTask::ProcessResponse(const openpal::RSlice& objects)
 {
-	if (functionCodes.empty())
+	if (nextFunctionCode == numFunctionCodes)
 	{
-		auto result = CommandSetOps::ProcessOperateResponse(commands, objects, &logger);
+		auto result = CommandSetOps::ProcessOperateResponse(headers, objects, &logger);
 		return (result == CommandSetOps::OperateResult::FAIL_PARSE) ? ResponseResult::ERROR_BAD_RESPONSE : ResponseResult::OK_FINAL;
 	}
 	else
 	{
-		auto result = CommandSetOps::ProcessSelectResponse(commands, objects, &logger);
+		auto result = CommandSetOps::ProcessSelectResponse(headers, objects, &logger);
 
 		switch (result)
 		{
@@ -35,7 +35,6 @@
 #include <openpal/Configure.h>
 #include <assert.h>
 
-#include <deque>
 #include <memory>
 
 namespace opendnp3
@@ -47,7 +46,26 @@ class CommandTask : public IMasterTask
 
 public:
 
+	/**
+	* Limits on how many DIRECT_OPERATE command sets can be sent in a single request
+	*/
+	struct CoalesceLimits
+	{
+		CoalesceLimits(uint32_t maxObjects_, uint32_t maxTxFragSize_) : maxObjects(maxObjects_), maxTxFragSize(maxTxFragSize_)
+		{}
+
+		/// disables coalescing
+		static CoalesceLimits None()
+		{
+			return CoalesceLimits(0, 0);
+		}
+
+		uint32_t maxObjects;
+		uint32_t maxTxFragSize;
+	};
+
 	static IMasterTask* FDirectOperate(CommandSet&& commands, IMasterApplication& app, const CommandCallbackT& callback, const TaskConfig& config, openpal::Logger logger);
+	static IMasterTask* FDirectOperate(CommandSet&& commands, IMasterApplication& app, const CommandCallbackT& callback, const TaskConfig& config, const CoalesceLimits& limits, openpal::Logger logger);
 	static IMasterTask* FSelectAndOperate(CommandSet&& commands, IMasterApplication& app, const CommandCallbackT& callback, const TaskConfig& config, openpal::Logger logger);
 
 	virtual char const* Name() const override final
@@ -72,8 +90,22 @@ public:
 
 	virtual bool BuildRequest(APDURequest& request, uint8_t seq) override final;
 
+	virtual bool CoalesceDirectOperate(CommandSet& commands, const CommandCallbackT& callback, const TaskConfig& config) override final;
+
 private:
 
+	struct Batch
+	{
+		Batch(CommandSet&& commands_, const CommandCallbackT& callback_) : commands(std::move(commands_)), callback(callback_)
+		{}
+
+		Batch(Batch&& other) : commands(std::move(other.commands)), callback(std::move(other.callback))
+		{}
+
+		CommandSet commands;
+		CommandCallbackT callback;
+	};
+
 	virtual bool IsEnabled() const override final
 	{
 		return true;
@@ -90,18 +122,30 @@ private:
 
 	virtual IMasterTask::TaskState OnTaskComplete(TaskCompletion result, openpal::MonotonicTimestamp now) override final;
 
-	CommandTask(CommandSet&& set, IMasterApplication& app, const CommandCallbackT& callback, const TaskConfig& config, openpal::Logger logger);
+	CommandTask(CommandSet&& set, IMasterApplication& app, const CommandCallbackT& callback, const TaskConfig& config, const CoalesceLimits& limits, openpal::Logger logger);
+
+	static bool IsCoalescable(const TaskConfig& config);
 
 	ResponseResult ProcessResponse(const openpal::RSlice& objects);
 
 	void LoadSelectAndOperate();
 	void LoadDirectOperate();
 
-	std::deque<FunctionCode> functionCodes;
+	// the function codes still to be sent, in order
+	FunctionCode functionCodes[2];
+	uint8_t numFunctionCodes;
+	uint8_t nextFunctionCode;
 
 	CommandStatus statusResult;
-	CommandCallbackT commandCallback;
-	CommandSet commands;
+	CoalesceLimits limits;
+	bool coalescable;
+	uint32_t numObjects;
+	uint32_t numBytes;
+
+	// each caller's command set and callback, all sent in the same request
+	InlineVector<Batch, 1> batches;
+	// the headers of every batch in request order, owned by the batches
+	CommandSet::HeaderVector headers;
 
 };
 
@@ -60,6 +60,9 @@ public:
 	/// Write all of the headers to an ASDU
 	virtual bool Write(HeaderWriter&) const = 0;
 
+	/// The number of bytes the header occupies when written to an ASDU
+	virtual uint32_t WriteSize() const = 0;
+
 	/// Ask if all of the individual commands have been selected
 	virtual bool AreAllSelected() const = 0;
 
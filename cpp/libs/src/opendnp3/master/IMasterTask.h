@@ -30,6 +30,8 @@
 
 #include "opendnp3/master/TaskConfig.h"
 #include "opendnp3/master/IMasterApplication.h"
+#include "opendnp3/master/CommandSet.h"
+#include "opendnp3/master/CommandCallbackT.h"
 
 namespace opendnp3
 {
@@ -156,6 +158,17 @@ public:
 	 */
 	virtual bool BuildRequest(APDURequest& request, uint8_t seq) = 0;
 
+	/**
+	 * Offer a DIRECT_OPERATE command set to a task that has not started yet, so that it can be
+	 * sent in the same request as the task's own commands.
+	 *
+	 * Return true if the task took ownership of the commands and will invoke the callback.
+	 */
+	virtual bool CoalesceDirectOperate(CommandSet& commands, const CommandCallbackT& callback, const TaskConfig& config)
+	{
+		return false;
+	}
+
 	/**
 	 * Handler for responses
 	 */
@@ -62,7 +62,7 @@ MContext::MContext(
 	taskStartTimeoutTimer(executor),
 	tasks(params, logger, application, SOEHandler, application),
 	scheduler(*this),
-	txBuffer(params.maxTxFragSize),
+	txBuffer(params.maxTxFragSize, params.poolAllFragmentBuffers),
 	tstate(TaskState::IDLE)
 {}
 
@@ -105,6 +105,7 @@ bool MContext::OnLowerLayerDown()
 
 	solSeq = unsolSeq = 0;
 	isOnline = isSending = false;
+	this->ReleaseTx();
 
 	return true;
 }
@@ -149,6 +150,7 @@ bool MContext::OnSendResult(bool isSucccess)
 	this->isSending = false;
 	this->CheckConfirmTransmit();
 	this->CheckForTask();
+	this->ReleaseTx();
 	return true;
 }
 
@@ -196,7 +198,20 @@ void MContext::OnParsedHeader(const RSlice& apdu, const APDUResponseHeader& head
 
 void MContext::DirectOperate(CommandSet&& commands, const CommandCallbackT& callback, const TaskConfig& config)
 {
-	this->ScheduleAdhocTask(CommandTask::FDirectOperate(std::move(commands), *pApplication, callback, config, logger));
+	if (!params.coalesceDirectOperate)
+	{
+		this->ScheduleAdhocTask(CommandTask::FDirectOperate(std::move(commands), *pApplication, callback, config, logger));
+		return;
+	}
+
+	// ride along with a direct operate that is still waiting to start
+	if (this->isOnline && this->scheduler.CoalesceDirectOperate(commands, callback, config))
+	{
+		return;
+	}
+
+	CommandTask::CoalesceLimits limits(params.maxControlsPerRequest, params.maxTxFragSize);
+	this->ScheduleAdhocTask(CommandTask::FDirectOperate(std::move(commands), *pApplication, callback, config, limits, logger));
 }
 
 void MContext::SelectAndOperate(CommandSet&& commands, const CommandCallbackT& callback, const TaskConfig& config)
@@ -288,7 +303,7 @@ bool MContext::CheckConfirmTransmit()
 	}
 
 	auto confirm = this->confirmQueue.front();
-	APDUWrapper wrapper(this->txBuffer.GetWSlice());
+	APDUWrapper wrapper(this->StartTx());
 	wrapper.SetFunction(confirm.function);
 	wrapper.SetControl(confirm.control);
 	this->Transmit(wrapper.ToRSlice());
@@ -304,6 +319,23 @@ void MContext::Transmit(const RSlice& data)
 	this->pLower->BeginTransmit(data);
 }
 
+openpal::WSlice MContext::StartTx()
+{
+	if (this->txBuffer.CanGrow())
+	{
+		this->txBuffer.Grow(0);
+	}
+	return this->txBuffer.GetWSlice();
+}
+
+void MContext::ReleaseTx()
+{
+	if (!this->isSending)
+	{
+		this->txBuffer.Shrink(0);
+	}
+}
+
 void MContext::StartResponseTimer()
 {
 	auto timeout = [this]()
@@ -481,7 +513,7 @@ MContext::TaskState MContext::ResumeActiveTask()
 		return TaskState::TASK_READY;
 	}
 
-	APDURequest request(this->txBuffer.GetWSlice());
+	APDURequest request(this->StartTx());
 
 	/// try to build a requst for the task
 	if (!this->pActiveTask->BuildRequest(request, this->solSeq))
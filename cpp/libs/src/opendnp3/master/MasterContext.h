@@ -30,6 +30,7 @@
 
 #include "opendnp3/app/AppSeqNum.h"
 #include "opendnp3/app/TimeAndInterval.h"
+#include "opendnp3/app/FragmentBuffer.h"
 
 #include "opendnp3/gen/RestartType.h"
 
@@ -97,7 +98,7 @@ public:
 	MasterTasks tasks;
 	MasterScheduler scheduler;
 	std::deque<APDUHeader> confirmQueue;
-	openpal::Buffer txBuffer;
+	FragmentBuffer txBuffer;
 	TaskState tstate;
 
 	/// --- implement  IUpperLayer ------
@@ -191,6 +192,11 @@ public:
 	void Transmit(const openpal::RSlice& data);
 
 private:
+	/// Space for the next request, leasing the full maxTxFragSize if it isn't resident
+	openpal::WSlice StartTx();
+
+	/// Hand a leased tx buffer back to the pool once nothing is being sent
+	void ReleaseTx();
 
 	void ScheduleRecurringPollTask(IMasterTask* pTask);
 
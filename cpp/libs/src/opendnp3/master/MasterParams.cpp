@@ -38,7 +38,10 @@ MasterParams::MasterParams() :
 	taskRetryPeriod(TimeDuration::Seconds(5)),
 	taskStartTimeout(TimeDuration::Seconds(10)),
 	maxTxFragSize(DEFAULT_MAX_APDU_SIZE),
-	maxRxFragSize(DEFAULT_MAX_APDU_SIZE)
+	maxRxFragSize(DEFAULT_MAX_APDU_SIZE),
+	poolAllFragmentBuffers(false),
+	coalesceDirectOperate(false),
+	maxControlsPerRequest(16)
 {}
 
 }
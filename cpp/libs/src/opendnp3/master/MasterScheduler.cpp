@@ -43,6 +43,20 @@ void MasterScheduler::Schedule(openpal::ManagedPtr<IMasterTask> pTask)
 	this->RecalculateTaskStartTimeout();
 }
 
+bool MasterScheduler::CoalesceDirectOperate(CommandSet& commands, const CommandCallbackT& callback, const TaskConfig& config)
+{
+	// only the last one-shot task may take the commands, merging into an earlier one would send them ahead of the tasks queued after it
+	for (auto task = m_tasks.rbegin(); task != m_tasks.rend(); ++task)
+	{
+		if (!(*task)->IsRecurring())
+		{
+			return (*task)->CoalesceDirectOperate(commands, callback, config);
+		}
+	}
+
+	return false;
+}
+
 std::vector<openpal::ManagedPtr<IMasterTask>>::iterator MasterScheduler::GetNextTask(const MonotonicTimestamp& now)
 {
 	auto runningBest = m_tasks.begin();
@@ -49,6 +49,14 @@ public:
 	*/
 	void Schedule(openpal::ManagedPtr<IMasterTask> pTask);
 
+	/**
+	* Offer a DIRECT_OPERATE to the most recently queued one-shot task, so that commands still
+	* reach the outstation in the order they were issued. Recurring scans are skipped.
+	*
+	* @return true if a pending task took ownership of the commands
+	*/
+	bool CoalesceDirectOperate(CommandSet& commands, const CommandCallbackT& callback, const TaskConfig& config);
+
 	/**
 	* @return Task to start or undefined pointer if no task to start
 	* If there is no task to start, 'next' is set to the timestamp when the scheduler should be re-evaluated
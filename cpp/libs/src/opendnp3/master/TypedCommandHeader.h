@@ -23,6 +23,7 @@
 
 #include "opendnp3/master/ICommandHeader.h"
 #include "opendnp3/master/ICommandCollection.h"
+#include "opendnp3/master/InlineVector.h"
 
 #include "opendnp3/gen/CommandStatus.h"
 #include "opendnp3/gen/CommandPointState.h"
@@ -31,8 +32,6 @@
 #include "opendnp3/app/parsing/ICollection.h"
 #include "opendnp3/app/Indexed.h"
 
-
-#include <vector>
 #include <algorithm>
 
 namespace opendnp3
@@ -51,6 +50,9 @@ class TypedCommandHeader final : public ICommandHeader, public ICommandCollectio
 
 public:
 
+	/// Headers with up to this many commands are stored without any heap allocation
+	static const uint32_t INLINE_RECORDS = 4;
+
 	TypedCommandHeader(const DNP3Serializer<T>& serializer) : m_serializer(serializer)
 	{}
 
@@ -64,6 +66,8 @@ public:
 
 	virtual bool Write(HeaderWriter&) const override;
 
+	virtual uint32_t WriteSize() const override;
+
 	virtual void ApplySelectResponse(const ICollection<Indexed<T>>& commands) override;
 
 	virtual void ApplyOperateResponse(const ICollection<Indexed<T>>& commands) override;
@@ -77,7 +81,7 @@ public:
 private:
 
 	DNP3Serializer<T> m_serializer;
-	std::vector<Record> m_records;
+	InlineVector<Record, INLINE_RECORDS> m_records;
 };
 
 
@@ -116,6 +120,13 @@ bool TypedCommandHeader<T>::Write(HeaderWriter& writer) const
 	return iter.IsValid();
 }
 
+template <class T>
+uint32_t TypedCommandHeader<T>::WriteSize() const
+{
+	// group, variation, qualifier, and count followed by an index prefixed object per record
+	return 3 + openpal::UInt16::SIZE + static_cast<uint32_t>(m_records.size()) * (openpal::UInt16::SIZE + m_serializer.Size());
+}
+
 template <class T>
 void TypedCommandHeader<T>::ApplySelectResponse(const ICollection<Indexed<T>>& commands)
 {
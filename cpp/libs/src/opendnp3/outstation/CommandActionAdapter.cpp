@@ -25,10 +25,11 @@
 namespace opendnp3
 {
 
-CommandActionAdapter::CommandActionAdapter(ICommandHandler* handler, bool isSelect, OperateType opType) :
+CommandActionAdapter::CommandActionAdapter(ICommandHandler* handler, bool isSelect, OperateType opType, PendingOperate* pending) :
 	m_handler(handler),
 	m_isSelect(isSelect),
 	m_opType(opType),
+	m_pending(pending),
 	m_isStarted(false)
 {}
 
@@ -24,6 +24,7 @@
 #include "ICommandAction.h"
 
 #include "opendnp3/outstation/ICommandHandler.h"
+#include "opendnp3/outstation/PendingOperate.h"
 
 namespace opendnp3
 {
@@ -36,7 +37,9 @@ class CommandActionAdapter : public ICommandAction
 
 public:
 
-	CommandActionAdapter(ICommandHandler* handler, bool isSelect, OperateType opType);
+	/// When 'pending' is supplied, operates are dispatched through ICommandHandler::BeginOperate and a result is
+	/// reserved in 'pending' for each one. Actions then report SUCCESS and the real results are read back later.
+	CommandActionAdapter(ICommandHandler* handler, bool isSelect, OperateType opType, PendingOperate* pending = nullptr);
 
 	~CommandActionAdapter();
 
@@ -56,7 +59,19 @@ private:
 	CommandStatus ActionT(const T& command, uint16_t index)
 	{
 		this->CheckStart();
-		return m_isSelect ? m_handler->Select(command, index) : m_handler->Operate(command, index, m_opType);
+
+		if (m_isSelect)
+		{
+			return m_handler->Select(command, index);
+		}
+
+		if (m_pending)
+		{
+			m_handler->BeginOperate(command, index, m_opType, m_pending->Add());
+			return CommandStatus::SUCCESS;
+		}
+
+		return m_handler->Operate(command, index, m_opType);
 	}
 
 	void CheckStart();
@@ -64,6 +79,7 @@ private:
 	ICommandHandler* m_handler;
 	bool m_isSelect;
 	OperateType m_opType;
+	PendingOperate* m_pending;
 	bool m_isStarted;
 
 };
@@ -31,10 +31,11 @@ using namespace openpal;
 namespace opendnp3
 {
 
-DatabaseBuffers::DatabaseBuffers(const DatabaseTemplate& dbTemplate, StaticTypeBitField allowedClass0Types, IndexMode indexMode_) :
+DatabaseBuffers::DatabaseBuffers(const DatabaseTemplate& dbTemplate, StaticTypeBitField allowedClass0Types, IndexMode indexMode_, bool planQualifiers_) :
 	buffers(dbTemplate),
 	class0(allowedClass0Types),
-	indexMode(indexMode_)
+	indexMode(indexMode_),
+	planQualifiers(planQualifiers_)
 {
 
 }
@@ -46,7 +46,7 @@ class DatabaseBuffers : public IStaticSelector, public IResponseLoader, public I
 {
 public:
 
-	DatabaseBuffers(const DatabaseTemplate&, StaticTypeBitField allowedClass0Types, IndexMode indexMode);
+	DatabaseBuffers(const DatabaseTemplate&, StaticTypeBitField allowedClass0Types, IndexMode indexMode, bool planQualifiers = false);
 
 	// ------- IStaticSelector -------------
 
@@ -76,6 +76,7 @@ private:
 
 	StaticTypeBitField class0;
 	IndexMode indexMode;
+	bool planQualifiers;
 
 	SelectedRanges ranges;
 
@@ -242,7 +243,7 @@ bool DatabaseBuffers::LoadType(HeaderWriter& writer)
 				auto writeFun = GetStaticWriter(view[range.start].selection.variation);
 
 				// start writing a header, the invoked function will advance the range appropriately
-				spaceRemaining = writeFun(view, writer, range);
+				spaceRemaining = writeFun(view, writer, range, planQualifiers);
 			}
 			else
 			{
@@ -23,12 +23,13 @@
 namespace opendnp3
 {
 
-DeferredRequest::DeferredRequest(uint32_t maxAPDUSize) : isSet(false), buffer(maxAPDUSize)
+DeferredRequest::DeferredRequest(uint32_t maxAPDUSize, bool poolAll) : isSet(false), buffer(maxAPDUSize, poolAll)
 {}
 
 void DeferredRequest::Reset()
 {
 	isSet = false;
+	buffer.Shrink(0);
 }
 
 bool DeferredRequest::IsSet() const
@@ -45,6 +46,10 @@ void DeferredRequest::Set(APDUHeader header_, openpal::RSlice objects_)
 {
 	this->isSet = true;
 	this->header = header_;
+	if (objects_.Size() > buffer.Capacity())
+	{
+		buffer.Grow(0);
+	}
 	auto dest = buffer.GetWSlice();
 	this->objects = objects_.CopyTo(dest);
 }
@@ -22,8 +22,8 @@
 #define OPENDNP3_DEFERREDREQUEST_H
 
 #include "opendnp3/app/APDUHeader.h"
+#include "opendnp3/app/FragmentBuffer.h"
 
-#include <openpal/container/Buffer.h>
 #include <openpal/util/Uncopyable.h>
 
 namespace opendnp3
@@ -37,7 +37,7 @@ class DeferredRequest : private openpal::Uncopyable
 
 public:
 
-	explicit DeferredRequest(uint32_t maxAPDUSize);
+	explicit DeferredRequest(uint32_t maxAPDUSize, bool poolAll = false);
 
 	void Reset();
 
@@ -57,7 +57,7 @@ private:
 	bool isSet;
 	APDUHeader header;
 	openpal::RSlice objects;
-	openpal::Buffer buffer;
+	FragmentBuffer buffer;
 
 };
 
@@ -67,7 +67,10 @@ bool DeferredRequest::Process(const Handler& handler)
 	if (isSet)
 	{
 		bool processed = handler(header, objects);
-		isSet = !processed;
+		if (processed)
+		{
+			this->Reset();
+		}
 		return processed;
 	}
 	else
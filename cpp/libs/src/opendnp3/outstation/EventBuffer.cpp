@@ -25,8 +25,9 @@
 namespace opendnp3
 {
 
-EventBuffer::EventBuffer(const EventBufferConfig& config_) :
+EventBuffer::EventBuffer(const EventBufferConfig& config_, bool packRelativeTimeEvents_) :
 	overflow(false),
+	packRelativeTimeEvents(packRelativeTimeEvents_),
 	config(config_),
 	events(config_.TotalEvents())
 {
@@ -182,7 +183,7 @@ bool EventBuffer::HasAnySelection() const
 
 bool EventBuffer::Load(HeaderWriter& writer)
 {
-	return EventWriter::Write(writer, *this, events.Iterate());
+	return EventWriter::Write(writer, *this, events.Iterate(), packRelativeTimeEvents);
 }
 
 bool EventBuffer::HasMoreUnwrittenEvents() const
@@ -50,7 +50,7 @@ class EventBuffer : public IEventReceiver, public IEventSelector, public IRespon
 
 public:
 
-	explicit EventBuffer(const EventBufferConfig& config);
+	explicit EventBuffer(const EventBufferConfig& config, bool packRelativeTimeEvents = false);
 
 	// ------- IEventReceiver ------
 
@@ -153,6 +153,8 @@ private:
 
 	bool overflow;
 
+	const bool packRelativeTimeEvents;
+
 	EventBufferConfig config;
 
 	openpal::LinkedList<SOERecord, uint32_t> events;
@@ -34,7 +34,7 @@ using namespace openpal;
 
 namespace opendnp3
 {
-bool EventWriter::Write(HeaderWriter& writer, IEventRecorder& recorder, openpal::LinkedListIterator<SOERecord> iterator)
+bool EventWriter::Write(HeaderWriter& writer, IEventRecorder& recorder, openpal::LinkedListIterator<SOERecord> iterator, bool packCTO)
 {
 	while (iterator.HasNext() && recorder.HasMoreUnwrittenEvents())
 	{
@@ -42,7 +42,7 @@ bool EventWriter::Write(HeaderWriter& writer, IEventRecorder& recorder, openpal:
 
 		if (IsWritable(pCurrent->value))
 		{
-			auto result = LoadHeader(writer, recorder, pCurrent);
+			auto result = LoadHeader(writer, recorder, pCurrent, packCTO);
 			iterator = result.location;
 
 			if (result.isFragmentFull)
@@ -55,14 +55,14 @@ bool EventWriter::Write(HeaderWriter& writer, IEventRecorder& recorder, openpal:
 	return true;
 }
 
-EventWriter::Result EventWriter::LoadHeader(HeaderWriter& writer, IEventRecorder& recorder, openpal::ListNode<SOERecord>* pLocation)
+EventWriter::Result EventWriter::LoadHeader(HeaderWriter& writer, IEventRecorder& recorder, openpal::ListNode<SOERecord>* pLocation, bool packCTO)
 {
 	switch (pLocation->value.type)
 	{
 	case(EventType::Binary) :
-		return LoadHeaderBinary(writer, recorder, pLocation);
+		return LoadHeaderBinary(writer, recorder, pLocation, packCTO);
 	case(EventType::DoubleBitBinary) :
-		return LoadHeaderDoubleBinary(writer, recorder, pLocation);
+		return LoadHeaderDoubleBinary(writer, recorder, pLocation, packCTO);
 	case(EventType::Counter):
 		return LoadHeaderCounter(writer, recorder, pLocation);
 	case(EventType::FrozenCounter):
@@ -80,7 +80,7 @@ EventWriter::Result EventWriter::LoadHeader(HeaderWriter& writer, IEventRecorder
 	}
 }
 
-EventWriter::Result EventWriter::LoadHeaderBinary(HeaderWriter& writer, IEventRecorder& recorder, openpal::ListNode<SOERecord>* pLocation)
+EventWriter::Result EventWriter::LoadHeaderBinary(HeaderWriter& writer, IEventRecorder& recorder, openpal::ListNode<SOERecord>* pLocation, bool packCTO)
 {
 	auto variation = pLocation->value.GetValue<Binary>().selectedVariation;
 
@@ -91,13 +91,15 @@ EventWriter::Result EventWriter::LoadHeaderBinary(HeaderWriter& writer, IEventRe
 	case(EventBinaryVariation::Group2Var2):
 		return WriteTypeWithSerializer<Binary>(writer, recorder, pLocation, Group2Var2::Inst(), variation);
 	case(EventBinaryVariation::Group2Var3) :
-		return WriteCTOTypeWithSerializer<Binary, Group51Var1>(writer, recorder, pLocation, Group2Var3::Inst(), variation);
+		return packCTO ?
+		       WriteCTOWindowWithSerializer<Binary, Group51Var1>(writer, recorder, pLocation, Group2Var3::Inst(), variation) :
+		       WriteCTOTypeWithSerializer<Binary, Group51Var1>(writer, recorder, pLocation, Group2Var3::Inst(), variation);
 	default:
 		return WriteTypeWithSerializer<Binary>(writer, recorder, pLocation, Group2Var1::Inst(), variation);
 	}
 }
 
-EventWriter::Result EventWriter::LoadHeaderDoubleBinary(HeaderWriter& writer, IEventRecorder& recorder, openpal::ListNode<SOERecord>* pLocation)
+EventWriter::Result EventWriter::LoadHeaderDoubleBinary(HeaderWriter& writer, IEventRecorder& recorder, openpal::ListNode<SOERecord>* pLocation, bool packCTO)
 {
 	auto variation = pLocation->value.GetValue<DoubleBitBinary>().selectedVariation;
 
@@ -108,7 +110,9 @@ EventWriter::Result EventWriter::LoadHeaderDoubleBinary(HeaderWriter& writer, IE
 	case(EventDoubleBinaryVariation::Group4Var2) :
 		return WriteTypeWithSerializer<DoubleBitBinary>(writer, recorder, pLocation, Group4Var2::Inst(), variation);
 	case(EventDoubleBinaryVariation::Group4Var3) :
-		return WriteCTOTypeWithSerializer<DoubleBitBinary, Group51Var1>(writer, recorder, pLocation, Group4Var3::Inst(), variation);
+		return packCTO ?
+		       WriteCTOWindowWithSerializer<DoubleBitBinary, Group51Var1>(writer, recorder, pLocation, Group4Var3::Inst(), variation) :
+		       WriteCTOTypeWithSerializer<DoubleBitBinary, Group51Var1>(writer, recorder, pLocation, Group4Var3::Inst(), variation);
 	default:
 		return WriteTypeWithSerializer<DoubleBitBinary>(writer, recorder, pLocation, Group4Var1::Inst(), variation);
 	}
@@ -36,7 +36,13 @@ class EventWriter : openpal::StaticOnly
 {
 public:
 
-	static bool Write(HeaderWriter& writer, IEventRecorder& recorder, openpal::LinkedListIterator<SOERecord> iterator);
+	/**
+	* Write selected events in SOE order
+	*
+	* @param packCTO if true, relative time events are grouped into CTO windows (see OutstationParams::packRelativeTimeEvents)
+	* @return false if the fragment filled before all selected events were written
+	*/
+	static bool Write(HeaderWriter& writer, IEventRecorder& recorder, openpal::LinkedListIterator<SOERecord> iterator, bool packCTO = false);
 
 private:
 
@@ -56,10 +62,10 @@ private:
 		Result() = delete;
 	};
 
-	static Result LoadHeader(HeaderWriter& writer, IEventRecorder& recorder, openpal::ListNode<SOERecord>* pLocation);
+	static Result LoadHeader(HeaderWriter& writer, IEventRecorder& recorder, openpal::ListNode<SOERecord>* pLocation, bool packCTO);
 
-	static Result LoadHeaderBinary(HeaderWriter& writer, IEventRecorder& recorder, openpal::ListNode<SOERecord>* pLocation);
-	static Result LoadHeaderDoubleBinary(HeaderWriter& writer, IEventRecorder& recorder, openpal::ListNode<SOERecord>* pLocation);
+	static Result LoadHeaderBinary(HeaderWriter& writer, IEventRecorder& recorder, openpal::ListNode<SOERecord>* pLocation, bool packCTO);
+	static Result LoadHeaderDoubleBinary(HeaderWriter& writer, IEventRecorder& recorder, openpal::ListNode<SOERecord>* pLocation, bool packCTO);
 	static Result LoadHeaderCounter(HeaderWriter& writer, IEventRecorder& recorder, openpal::ListNode<SOERecord>* pLocation);
 	static Result LoadHeaderFrozenCounter(HeaderWriter& writer, IEventRecorder& recorder, openpal::ListNode<SOERecord>* pLocation);
 	static Result LoadHeaderAnalog(HeaderWriter& writer, IEventRecorder& recorder, openpal::ListNode<SOERecord>* pLocation);
@@ -176,6 +182,110 @@ private:
 		return Result(false, location);
 	}
 
+	/**
+	* Writes a CTO header for the events of this type and variation that follow pLocation in SOE order. The
+	* window is greedy: it takes each event in turn until one would stretch it past the 16-bit relative time
+	* range or the header is full, and the CTO is the earliest time in the window.
+	*
+	* Events of other types don't end the window. They are left unwritten and the returned location points
+	* at the first of them, so the caller writes them in the next header. A different variation of the same
+	* type ends the window so that the order of each type is preserved.
+	*/
+	template <class T, class CTOType>
+	static Result WriteCTOWindowWithSerializer(HeaderWriter& writer, IEventRecorder& recorder, openpal::ListNode<SOERecord>* pLocation, opendnp3::DNP3Serializer<T> serializer, typename T::EventVariation variation)
+	{
+		uint64_t minTime = pLocation->value.GetTime();
+		uint64_t maxTime = minTime;
+
+		// the header can't hold more events than fit in the rest of the fragment, so the window stops there
+		const uint32_t HEADER_SIZE = (3 + openpal::UInt8::SIZE + CTOType::Size()) + (3 + openpal::UInt16::SIZE);
+		const uint32_t EVENT_SIZE = openpal::UInt16::SIZE + serializer.Size();
+		const uint32_t remaining = writer.Remaining();
+		const uint32_t capacity = (remaining > HEADER_SIZE) ? (remaining - HEADER_SIZE) / EVENT_SIZE : 0;
+
+		// first pass finds the record that ends the window, or null if the window runs to the end of the SOE list or fills the header
+		openpal::ListNode<SOERecord>* pEnd = nullptr;
+		uint32_t numInWindow = 0;
+
+		auto iter = openpal::LinkedListIterator<SOERecord>::From(pLocation);
+		while (numInWindow < capacity)
+		{
+			auto pCurrent = iter.Next();
+			if (!pCurrent)
+			{
+				break;
+			}
+
+			auto& record = pCurrent->value;
+
+			if (IsWritable(record) && (record.type == T::EventTypeEnum))
+			{
+				if (record.GetValue<T>().selectedVariation != variation)
+				{
+					pEnd = pCurrent;
+					break;
+				}
+
+				const uint64_t time = record.GetTime();
+				const uint64_t lower = (time < minTime) ? time : minTime;
+				const uint64_t upper = (time > maxTime) ? time : maxTime;
+
+				if ((upper - lower) > openpal::UInt16::Max)
+				{
+					pEnd = pCurrent;
+					break;
+				}
+
+				minTime = lower;
+				maxTime = upper;
+				++numInWindow;
+			}
+		}
+
+		CTOType cto;
+		cto.time = DNPTime(minTime);
+
+		auto header = writer.IterateOverCountWithPrefixAndCTO<openpal::UInt16, T, CTOType>(QualifierCode::UINT16_CNT_UINT16_INDEX, serializer, cto);
+
+		// the first record of another type that was passed over
+		openpal::ListNode<SOERecord>* pSkipped = nullptr;
+		openpal::ListNode<SOERecord>* pCurrent = nullptr;
+		uint32_t numWritten = 0;
+
+		iter = openpal::LinkedListIterator<SOERecord>::From(pLocation);
+		while (recorder.HasMoreUnwrittenEvents() && (pCurrent = iter.Next()) && (pCurrent != pEnd))
+		{
+			auto& record = pCurrent->value;
+
+			if (IsWritable(record))
+			{
+				if (record.type == T::EventTypeEnum)
+				{
+					auto evt = record.ReadEvent<T>();
+					evt.value.time = DNPTime(record.GetTime() - minTime);
+					if ((numWritten < numInWindow) && header.Write(evt.value, evt.index))
+					{
+						record.written = true;
+						recorder.RecordWritten(record.clazz, record.type);
+						++numWritten;
+					}
+					else
+					{
+						auto location = openpal::LinkedListIterator<SOERecord>::From(pSkipped ? pSkipped : pCurrent);
+						return Result(true, location);
+					}
+				}
+				else if (!pSkipped)
+				{
+					pSkipped = pCurrent;
+				}
+			}
+		}
+
+		auto location = openpal::LinkedListIterator<SOERecord>::From(pSkipped ? pSkipped : pCurrent);
+		return Result(false, location);
+	}
+
 };
 
 }
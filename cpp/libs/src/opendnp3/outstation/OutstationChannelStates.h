@@ -35,9 +35,9 @@ class OutstationSolState : private openpal::Uncopyable
 {
 public:
 
-	OutstationSolState(uint32_t maxTxSize) :
+	OutstationSolState(uint32_t maxTxSize, bool poolAll) :
 		pState(&OutstationSolicitedStateIdle::Inst()),
-		tx(maxTxSize)
+		tx(maxTxSize, poolAll)
 	{}
 
 	void Reset()
@@ -59,10 +59,10 @@ class OutstationUnsolState : private openpal::Uncopyable
 {
 public:
 
-	OutstationUnsolState(uint32_t maxTxSize) :
+	OutstationUnsolState(uint32_t maxTxSize, bool poolAll) :
 		completedNull(false),
 		pState(&OutstationUnsolicitedStateIdle::Inst()),
-		tx(maxTxSize)
+		tx(maxTxSize, poolAll)
 	{}
 
 	bool IsIdle() const
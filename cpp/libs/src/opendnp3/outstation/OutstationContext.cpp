@@ -35,6 +35,7 @@
 #include "opendnp3/outstation/CommandActionAdapter.h"
 #include "opendnp3/outstation/CommandResponseHandler.h"
 #include "opendnp3/outstation/ConstantCommandAction.h"
+#include "opendnp3/outstation/PendingOperateAction.h"
 #include "opendnp3/outstation/EventWriter.h"
 
 #include "opendnp3/outstation/ClassBasedRequestHandler.h"
@@ -61,21 +62,28 @@ OContext::OContext(
 	pLower(&lower),
 	pCommandHandler(&commandHandler),
 	pApplication(&application),
-	eventBuffer(config.eventBufferConfig),
-	database(dbTemplate, eventBuffer, config.params.indexMode, config.params.typesAllowedInClass0),
+	eventBuffer(config.eventBufferConfig, config.params.packRelativeTimeEvents),
+	database(dbTemplate, eventBuffer, config.params.indexMode, config.params.typesAllowedInClass0, config.params.planStaticQualifiers),
 	rspContext(database.GetResponseLoader(), eventBuffer),
 	params(config.params),
 	isOnline(false),
 	isTransmitting(false),
 	staticIIN(IINBit::DEVICE_RESTART),
 	confirmTimer(executor),
-	deferred(config.params.maxRxFragSize),
-	sol(config.params.maxTxFragSize),
-	unsol(config.params.maxTxFragSize)
+	deferred(config.params.maxRxFragSize, config.params.poolAllFragmentBuffers),
+	operateRequest(config.params.maxRxFragSize, config.params.poolAllFragmentBuffers),
+	operateTimer(executor),
+	sol(config.params.maxTxFragSize, config.params.poolAllFragmentBuffers),
+	unsol(config.params.maxTxFragSize, config.params.poolAllFragmentBuffers)
 {
 
 }
 
+OContext::~OContext()
+{
+	this->CancelAsyncOperate();
+}
+
 bool OContext::OnLowerLayerUp()
 {
 	if (isOnline)
@@ -104,6 +112,7 @@ bool OContext::OnLowerLayerDown()
 	unsol.Reset();
 	history.Reset();
 	deferred.Reset();
+	this->CancelAsyncOperate();
 	eventBuffer.Unselect();
 	rspContext.Reset();
 	confirmTimer.Cancel();
@@ -226,6 +235,11 @@ void OContext::ProcessAPDU(const openpal::RSlice& apdu, const APDUHeader& header
 			{
 				this->ProcessConfirm(header);
 			}
+			else if (this->pendingOperate)
+			{
+				// the master is still waiting on the response to an operate
+				this->deferred.Set(header, objects);
+			}
 			else
 			{
 				this->ProcessRequest(header, objects);
@@ -293,6 +307,42 @@ void OContext::CheckForDeferredRequest()
 	}
 }
 
+AppControlField OContext::LoadSolicitedResponse(APDUResponse& response)
+{
+	auto writer = response.GetWriter();
+	auto control = this->rspContext.LoadResponse(writer);
+
+	// a response that doesn't fit is continued in a larger buffer instead of being split into fragments
+	while (!control.FIN && this->sol.tx.CanGrow())
+	{
+		response = this->sol.tx.Grow(response);
+		writer = response.GetWriter();
+		control = this->rspContext.ContinueResponse(writer);
+	}
+
+	return control;
+}
+
+void OContext::ReleaseIdleBuffers()
+{
+	if (this->isTransmitting)
+	{
+		return;
+	}
+
+	if (this->sol.IsIdle())
+	{
+		// only responses to non-read requests are ever repeated
+		auto repeatable = this->history.HasLastRequest() && (this->history.GetLastHeader().function != FunctionCode::READ);
+		this->sol.tx.Trim(repeatable);
+	}
+
+	if (this->unsol.IsIdle())
+	{
+		this->unsol.tx.Trim(false);
+	}
+}
+
 bool OContext::ProcessDeferredRequest(APDUHeader header, openpal::RSlice objects)
 {
 	if (header.function == FunctionCode::CONFIRM)
@@ -302,6 +352,11 @@ bool OContext::ProcessDeferredRequest(APDUHeader header, openpal::RSlice objects
 	}
 	else
 	{
+		if (this->pendingOperate)
+		{
+			return false;
+		}
+
 		if (header.function == FunctionCode::READ)
 		{
 			if (this->unsol.IsIdle())
@@ -337,7 +392,11 @@ void OContext::CheckForUnsolicited()
 
 				this->eventBuffer.Unselect();
 				this->eventBuffer.SelectAllByClass(this->params.unsolClassMask);
-				this->eventBuffer.Load(writer);
+				while (!this->eventBuffer.Load(writer) && this->unsol.tx.CanGrow())
+				{
+					response = this->unsol.tx.Grow(response);
+					writer = response.GetWriter();
+				}
 
 				build::NullUnsolicited(response, this->unsol.seq.num, this->GetResponseIIN());
 				this->StartUnsolicitedConfirmTimer();
@@ -377,11 +436,115 @@ bool OContext::StartUnsolicitedConfirmTimer()
 	return this->confirmTimer.Start(this->params.unsolConfirmTimeout, timeout);
 }
 
+bool OContext::IsAsyncOperate(FunctionCode function) const
+{
+	return ((function == FunctionCode::OPERATE) || (function == FunctionCode::DIRECT_OPERATE)) && this->pCommandHandler->IsAsync();
+}
+
+bool OContext::BeginAsyncOperate(const APDUHeader& header, const openpal::RSlice& objects)
+{
+	// requests rejected before reaching the handler are answered by the synchronous path
+	if (objects.Size() > (this->params.maxTxFragSize - APDU_RESPONSE_HEADER_SIZE))
+	{
+		return false;
+	}
+
+	if (header.function == FunctionCode::OPERATE)
+	{
+		auto now = this->pExecutor->GetTime();
+		if (this->control.ValidateSelection(this->sol.seq.num, now, this->params.selectTimeout, objects) != CommandStatus::SUCCESS)
+		{
+			return false;
+		}
+	}
+
+	auto pending = std::make_shared<PendingOperate>(this, this->pExecutor);
+	auto opType = (header.function == FunctionCode::OPERATE) ? OperateType::SelectBeforeOperate : OperateType::DirectOperate;
+
+	{
+		CommandActionAdapter adapter(this->pCommandHandler, false, opType, pending.get());
+		CommandResponseHandler handler(this->logger, this->params.maxControlsPerRequest, &adapter, nullptr);
+		APDUParser::Parse(objects, handler, &this->logger); // a parse failure is reported when the response is built
+	}
+
+	this->pendingOperate = pending;
+	this->operateRequest.Set(header, objects);
+
+	if (!pending->Seal())
+	{
+		FORMAT_LOG_BLOCK(this->logger, flags::DBG, "Waiting on command handler to complete operate (seq: %u)", header.control.SEQ);
+
+		auto timeout = [this]()
+		{
+			SIMPLE_LOG_BLOCK(this->logger, flags::WARN, "Timed out waiting on command handler to complete operate");
+			this->pendingOperate->Expire(CommandStatus::TIMEOUT);
+			this->CheckForTaskStart();
+		};
+		this->operateTimer.Start(this->params.asyncOperateTimeout, timeout);
+	}
+
+	return true;
+}
+
+void OContext::CheckForOperateResponse()
+{
+	if (this->pendingOperate && this->CanTransmit() && this->pendingOperate->IsComplete())
+	{
+		auto pending = this->pendingOperate;
+		pending->Detach();
+		this->pendingOperate.reset();
+		this->operateTimer.Cancel();
+
+		auto respond = [this, &pending](const APDUHeader & header, const RSlice & objects)
+		{
+			this->RespondToAsyncOperate(header, objects, *pending);
+			return true;
+		};
+		this->operateRequest.Process(respond);
+	}
+}
+
+void OContext::RespondToAsyncOperate(const APDUHeader& header, const openpal::RSlice& objects, PendingOperate& pending)
+{
+	auto response = this->sol.tx.Start(objects.Size() + APDU_RESPONSE_HEADER_SIZE);
+	auto writer = response.GetWriter();
+	response.SetFunction(FunctionCode::RESPONSE);
+	response.SetControl(AppControlField(true, true, false, false, header.control.SEQ));
+
+	PendingOperateAction action(pending);
+	CommandResponseHandler handler(this->logger, this->params.maxControlsPerRequest, &action, &writer);
+	auto result = APDUParser::Parse(objects, handler, &this->logger);
+	auto iin = (result == ParseResult::OK) ? handler.Errors() : IINFromParseResult(result);
+
+	response.SetIIN(iin | this->GetResponseIIN());
+	this->sol.pState = &OutstationSolicitedStateIdle::Inst();
+	this->BeginResponseTx(response.ToRSlice());
+}
+
+void OContext::CancelAsyncOperate()
+{
+	if (this->pendingOperate)
+	{
+		this->pendingOperate->Detach();
+		this->pendingOperate.reset();
+	}
+
+	this->operateRequest.Reset();
+	this->operateTimer.Cancel();
+}
+
 OutstationSolicitedStateBase* OContext::RespondToNonReadRequest(const APDUHeader& header, const openpal::RSlice& objects)
 {
 	this->history.RecordLastProcessedRequest(header, objects);
 
-	auto response = this->sol.tx.Start();
+	if (this->IsAsyncOperate(header.function) && this->BeginAsyncOperate(header, objects))
+	{
+		// handlers that complete during dispatch are answered right away, otherwise once the last token completes
+		this->CheckForOperateResponse();
+		return &OutstationSolicitedStateIdle::Inst();
+	}
+
+	auto response = this->sol.tx.Start(objects.Size() + APDU_RESPONSE_HEADER_SIZE);
 	auto writer = response.GetWriter();
 	response.SetFunction(FunctionCode::RESPONSE);
 	response.SetControl(AppControlField(true, true, false, false, header.control.SEQ));
@@ -396,9 +559,8 @@ OutstationSolicitedStateBase* OContext::RespondToReadRequest(const APDUHeader& h
 	this->history.RecordLastProcessedRequest(header, objects);
 
 	auto response = this->sol.tx.Start();
-	auto writer = response.GetWriter();
 	response.SetFunction(FunctionCode::RESPONSE);
-	auto result = this->HandleRead(objects, writer);
+	auto result = this->HandleRead(objects, response);
 	result.second.SEQ = header.control.SEQ;
 	this->sol.seq.confirmNum = header.control.SEQ;
 	response.SetControl(result.second);
@@ -419,9 +581,8 @@ OutstationSolicitedStateBase* OContext::RespondToReadRequest(const APDUHeader& h
 OutstationSolicitedStateBase* OContext::ContinueMultiFragResponse(const AppSeqNum& seq)
 {
 	auto response = this->sol.tx.Start();
-	auto writer = response.GetWriter();
 	response.SetFunction(FunctionCode::RESPONSE);
-	auto control = this->rspContext.LoadResponse(writer);
+	auto control = this->LoadSolicitedResponse(response);
 	control.SEQ = seq;
 	this->sol.seq.confirmNum = seq;
 	response.SetControl(control);
@@ -496,7 +657,10 @@ void OContext::ParseHeader(const openpal::RSlice& apdu)
 
 void OContext::CheckForTaskStart()
 {
+	this->ReleaseIdleBuffers();
+
 	// do these checks in order of priority
+	this->CheckForOperateResponse();
 	this->CheckForDeferredRequest();
 	this->CheckForUnsolicited();
 }
@@ -560,7 +724,7 @@ IINField OContext::HandleNonReadResponse(const APDUHeader& header, const openpal
 	}
 }
 
-Pair<IINField, AppControlField> OContext::HandleRead(const openpal::RSlice& objects, HeaderWriter& writer)
+Pair<IINField, AppControlField> OContext::HandleRead(const openpal::RSlice& objects, APDUResponse& response)
 {
 	this->rspContext.Reset();
 	this->eventBuffer.Unselect(); // always un-select any previously selected points when we start a new read request
@@ -570,7 +734,7 @@ Pair<IINField, AppControlField> OContext::HandleRead(const openpal::RSlice& obje
 	auto result = APDUParser::Parse(objects, handler, &this->logger, ParserSettings::NoContents()); // don't expect range/count context on a READ
 	if (result == ParseResult::OK)
 	{
-		auto control = this->rspContext.LoadResponse(writer);
+		auto control = this->LoadSolicitedResponse(response);
 		return Pair<IINField, AppControlField>(handler.Errors(), control);
 	}
 	else
@@ -597,7 +761,14 @@ IINField OContext::HandleDirectOperate(const openpal::RSlice& objects, OperateTy
 	}
 	else
 	{
-		CommandActionAdapter adapter(this->pCommandHandler, false, opType);
+		// nothing is echoed for DIRECT_OPERATE_NR, so the results of asynchronous operates are never collected
+		std::shared_ptr<PendingOperate> pending;
+		if (!pWriter && this->pCommandHandler->IsAsync())
+		{
+			pending = std::make_shared<PendingOperate>(nullptr, nullptr);
+		}
+
+		CommandActionAdapter adapter(this->pCommandHandler, false, opType, pending.get());
 		CommandResponseHandler handler(this->logger, this->params.maxControlsPerRequest, &adapter, pWriter);
 		auto result = APDUParser::Parse(objects, handler, &this->logger);
 		return (result == ParseResult::OK) ? handler.Errors() : IINFromParseResult(result);
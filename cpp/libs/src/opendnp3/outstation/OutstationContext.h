@@ -28,6 +28,7 @@
 #include "opendnp3/outstation/OutstationConfig.h"
 #include "opendnp3/outstation/RequestHistory.h"
 #include "opendnp3/outstation/DeferredRequest.h"
+#include "opendnp3/outstation/PendingOperate.h"
 #include "opendnp3/outstation/OutstationChannelStates.h"
 #include "opendnp3/outstation/ControlState.h"
 #include "opendnp3/outstation/OutstationSeqNum.h"
@@ -41,6 +42,8 @@
 #include <openpal/logging/LogRoot.h>
 #include <openpal/container/Pair.h>
 
+#include <memory>
+
 namespace opendnp3
 {
 
@@ -60,6 +63,8 @@ public:
 	            ICommandHandler& commandHandler,
 	            IOutstationApplication& application);
 
+	virtual ~OContext();
+
 public:
 
 	/// ----- Implement IUpperLayer ------
@@ -122,8 +127,30 @@ public:
 
 	void CheckForDeferredRequest();
 
+	/// Fill a solicited response, moving it to a pooled buffer of maxTxFragSize if it outgrows the default size
+	AppControlField LoadSolicitedResponse(APDUResponse& response);
+
+	/// Return large tx buffers to the pool once nothing is in flight
+	void ReleaseIdleBuffers();
+
 	bool ProcessDeferredRequest(APDUHeader header, openpal::RSlice objects);
 
+	/// ---- asynchronous operates ----
+
+	bool IsAsyncOperate(FunctionCode function) const;
+
+	/// Dispatch an OPERATE or DIRECT_OPERATE to an asynchronous command handler and hold the response
+	/// @return false if the request was rejected before reaching the handler and must be answered immediately
+	bool BeginAsyncOperate(const APDUHeader& header, const openpal::RSlice& objects);
+
+	/// Send the held response once every command has been completed
+	void CheckForOperateResponse();
+
+	void RespondToAsyncOperate(const APDUHeader& header, const openpal::RSlice& objects, PendingOperate& pending);
+
+	/// Abandon an operate in progress, any later completions are ignored
+	void CancelAsyncOperate();
+
 	bool StartSolicitedConfirmTimer();
 
 	bool StartUnsolicitedConfirmTimer();
@@ -144,7 +171,7 @@ public:
 
 	/// Handles read function codes. May trigger an unsolicited response
 	/// @return an IIN field and a partial AppControlField (missing sequence info)
-	openpal::Pair<IINField, AppControlField> HandleRead(const openpal::RSlice& objects, HeaderWriter& writer);
+	openpal::Pair<IINField, AppControlField> HandleRead(const openpal::RSlice& objects, APDUResponse& response);
 
 	/// Handles no-response function codes.
 	void ProcessRequestNoAck(const APDUHeader& header, const openpal::RSlice& objects);
@@ -187,6 +214,9 @@ public:
 
 	// ------ Dynamic state related to controls ------
 	ControlState control;
+	std::shared_ptr<PendingOperate> pendingOperate;
+	DeferredRequest operateRequest;
+	openpal::TimerRef operateTimer;
 
 	// ------ Dynamic state related to solicited and unsolicited modes ------
 	OutstationSolState  sol;
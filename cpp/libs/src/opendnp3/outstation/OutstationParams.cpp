@@ -31,13 +31,17 @@ OutstationParams::OutstationParams() :
 	indexMode(IndexMode::Contiguous),
 	maxControlsPerRequest(16),
 	selectTimeout(TimeDuration::Seconds(10)),
+	asyncOperateTimeout(TimeDuration::Seconds(3)),
 	solConfirmTimeout(DEFAULT_APP_TIMEOUT),
 	unsolConfirmTimeout(DEFAULT_APP_TIMEOUT),
 	unsolRetryTimeout(DEFAULT_APP_TIMEOUT),
 	maxTxFragSize(DEFAULT_MAX_APDU_SIZE),
 	maxRxFragSize(DEFAULT_MAX_APDU_SIZE),
+	poolAllFragmentBuffers(false),
 	allowUnsolicited(false),
 	ignoreRepeatReads(true),
+	packRelativeTimeEvents(false),
+	planStaticQualifiers(false),
 	typesAllowedInClass0(StaticTypeBitField::AllTypes())
 {
 
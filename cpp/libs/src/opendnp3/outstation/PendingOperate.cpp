@@ -0,0 +1,112 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include "PendingOperate.h"
+
+#include "opendnp3/outstation/OutstationContext.h"
+
+namespace opendnp3
+{
+
+PendingOperate::PendingOperate(OContext* pContext_, openpal::IExecutor* pExecutor_) :
+	pContext(pContext_),
+	pExecutor(pExecutor_),
+	sealed(false),
+	numOutstanding(0)
+{}
+
+OperateToken PendingOperate::Add()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	results.push_back(Result());
+	++numOutstanding;
+	return OperateToken(this->shared_from_this(), static_cast<uint32_t>(results.size() - 1));
+}
+
+bool PendingOperate::Seal()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	sealed = true;
+	return numOutstanding == 0;
+}
+
+void PendingOperate::Complete(uint32_t ordinal, CommandStatus status)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (ordinal >= results.size() || results[ordinal].completed)
+	{
+		return;
+	}
+
+	results[ordinal].status = status;
+	results[ordinal].completed = true;
+	--numOutstanding;
+
+	// completions during dispatch are picked up synchronously when the request is sealed
+	if (sealed && (numOutstanding == 0) && pExecutor)
+	{
+		// the outstation keeps this object, so only it is captured. It detaches on its own executor before it's deleted,
+		// so a wakeup posted before then is handled first and one that is never run has nothing to release
+		auto pTarget = pContext;
+		auto resume = [pTarget]()
+		{
+			pTarget->CheckForTaskStart();
+		};
+		pExecutor->PostLambda(resume);
+	}
+}
+
+void PendingOperate::Expire(CommandStatus status)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	for (auto & result : results)
+	{
+		if (!result.completed)
+		{
+			result.status = status;
+			result.completed = true;
+		}
+	}
+
+	numOutstanding = 0;
+}
+
+bool PendingOperate::IsComplete()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return sealed && (numOutstanding == 0);
+}
+
+CommandStatus PendingOperate::GetStatus(uint32_t ordinal)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return (ordinal < results.size()) ? results[ordinal].status : CommandStatus::UNDEFINED;
+}
+
+void PendingOperate::Detach()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	pContext = nullptr;
+	pExecutor = nullptr;
+}
+
+}
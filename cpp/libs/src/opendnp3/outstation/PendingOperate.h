@@ -0,0 +1,92 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef OPENDNP3_PENDINGOPERATE_H
+#define OPENDNP3_PENDINGOPERATE_H
+
+#include "opendnp3/outstation/OperateToken.h"
+
+#include <openpal/executor/IExecutor.h>
+#include <openpal/util/Uncopyable.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace opendnp3
+{
+
+class OContext;
+
+/**
+* Thread-safe record of the commands in one request that were dispatched to an asynchronous
+* ICommandHandler, shared between the outstation and the tokens handed to the user.
+*/
+class PendingOperate : public std::enable_shared_from_this<PendingOperate>, private openpal::Uncopyable
+{
+
+public:
+
+	/// Both pointers may be null for operations that require no response (DIRECT_OPERATE_NR)
+	PendingOperate(OContext* pContext, openpal::IExecutor* pExecutor);
+
+	/// Reserve a result for a command about to be dispatched and return its token
+	OperateToken Add();
+
+	/// Called once every command in the request has been dispatched
+	/// @return true if every command was already completed during dispatch
+	bool Seal();
+
+	/// Record the result of a command, waking the outstation if it was the last one outstanding
+	void Complete(uint32_t ordinal, CommandStatus status);
+
+	/// Complete every outstanding command with the same status, used when the operate times out
+	void Expire(CommandStatus status);
+
+	/// True once sealed and every command has been completed
+	bool IsComplete();
+
+	CommandStatus GetStatus(uint32_t ordinal);
+
+	/// Sever the link to the outstation. Completions that arrive later have no effect.
+	void Detach();
+
+private:
+
+	struct Result
+	{
+		Result() : status(CommandStatus::UNDEFINED), completed(false)
+		{}
+
+		CommandStatus status;
+		bool completed;
+	};
+
+	std::mutex mutex;
+	OContext* pContext;
+	openpal::IExecutor* pExecutor;
+	bool sealed;
+	uint32_t numOutstanding;
+	std::vector<Result> results;
+};
+
+}
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef OPENDNP3_PENDINGOPERATEACTION_H
+#define OPENDNP3_PENDINGOPERATEACTION_H
+
+#include "ICommandAction.h"
+#include "PendingOperate.h"
+
+namespace opendnp3
+{
+
+/**
+* Replays the results of a completed asynchronous operate, in the order the commands were dispatched
+*/
+class PendingOperateAction : public ICommandAction
+{
+
+public:
+
+	PendingOperateAction(PendingOperate& pending_) : pending(&pending_), ordinal(0)
+	{}
+
+	virtual CommandStatus Action(const ControlRelayOutputBlock& command, uint16_t aIndex) final { return Next(); }
+
+	virtual CommandStatus Action(const AnalogOutputInt16& command, uint16_t aIndex) final { return Next(); }
+
+	virtual CommandStatus Action(const AnalogOutputInt32& command, uint16_t aIndex) final { return Next(); }
+
+	virtual CommandStatus Action(const AnalogOutputFloat32& command, uint16_t aIndex) final { return Next(); }
+
+	virtual CommandStatus Action(const AnalogOutputDouble64& command, uint16_t aIndex) final { return Next(); }
+
+private:
+
+	CommandStatus Next()
+	{
+		return pending->GetStatus(ordinal++);
+	}
+
+	PendingOperate* pending;
+	uint32_t ordinal;
+};
+
+}
+
+#endif
@@ -25,6 +25,7 @@ namespace opendnp3
 
 ResponseContext::ResponseContext(IResponseLoader& staticLoader, IResponseLoader& eventLoader) :
 	fragmentCount(0),
+	someEventsWritten(false),
 	pStaticLoader(&staticLoader),
 	pEventLoader(&eventLoader)
 {
@@ -43,12 +44,23 @@ void ResponseContext::Reset()
 
 AppControlField ResponseContext::LoadResponse(HeaderWriter& writer)
 {
-	bool fir = fragmentCount == 0;
 	++fragmentCount;
+	someEventsWritten = false;
+	return this->Load(writer);
+}
+
+AppControlField ResponseContext::ContinueResponse(HeaderWriter& writer)
+{
+	return this->Load(writer);
+}
+
+AppControlField ResponseContext::Load(HeaderWriter& writer)
+{
+	bool fir = fragmentCount == 1;
 
 	uint32_t startingSize = writer.Remaining();
 	bool notFull = pEventLoader->Load(writer);
-	bool someEventsWritten = writer.Remaining() < startingSize;
+	someEventsWritten |= writer.Remaining() < startingSize;
 
 	if (notFull)
 	{
@@ -51,11 +51,17 @@ public:
 
 	AppControlField LoadResponse(HeaderWriter& writer);
 
+	// keep loading the current fragment after its buffer has grown
+	AppControlField ContinueResponse(HeaderWriter& writer);
+
 private:
 
+	AppControlField Load(HeaderWriter& writer);
+
 	static AppControlField GetControl(bool fir, bool fin, bool hasEvents);
 
 	uint16_t fragmentCount;
+	bool someEventsWritten;
 	IResponseLoader* pStaticLoader;
 	IResponseLoader* pEventLoader;
 };
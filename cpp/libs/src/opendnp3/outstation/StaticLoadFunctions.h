@@ -36,7 +36,7 @@ namespace opendnp3
 template <class T>
 struct StaticWriter
 {
-	typedef bool (*Function)(openpal::ArrayView<Cell<T>, uint16_t>& view, HeaderWriter& writer, Range& range);
+	typedef bool (*Function)(openpal::ArrayView<Cell<T>, uint16_t>& view, HeaderWriter& writer, Range& range, bool planQualifiers);
 };
 
 StaticWriter<Binary>::Function GetStaticWriter(StaticBinaryVariation variation);
@@ -116,8 +116,193 @@ bool LoadWithBitfieldIterator(openpal::ArrayView<Cell<Target>, uint16_t>& view,
 	return true;
 }
 
+template <class Target, class PrefixType>
+bool LoadWithPrefixIterator(openpal::ArrayView<Cell<Target>, uint16_t>& view, PrefixedWriteIterator<PrefixType, Target>& iterator, Range& range, uint32_t count)
+{
+	const auto variation = view[range.start].selection.variation;
+
+	while (count > 0 && range.IsValid())
+	{
+		auto& cell = view[range.start];
+
+		if (cell.selection.selected)
+		{
+			if (cell.selection.variation != variation)
+			{
+				return true;
+			}
+
+			if (!iterator.Write(cell.selection.value, static_cast<typename PrefixType::Type>(cell.vIndex)))
+			{
+				return false;
+			}
+
+			// deselect the value and advance the range
+			cell.selection.selected = false;
+			--count;
+		}
+
+		range.Advance();
+	}
+
+	return true;
+}
+
+/**
+* The encoding chosen for the next static header
+*/
+struct StaticHeaderPlan
+{
+	StaticHeaderPlan() : prefixed(false), count(0)
+	{}
+
+	// true for count and index prefix (0x17/0x28), false for start/stop range (0x00/0x01)
+	bool prefixed;
+
+	// number of selected values covered by a prefixed header
+	uint32_t count;
+};
+
+/**
+* Chooses between a range header for the run of contiguous indices at the start of the range and a
+* single count and index prefixed header that spans several runs, whichever encodes in fewer bytes.
+*
+* The object bytes are the same in both encodings, so only the header and index bytes are compared.
+* Runs are found by looking ahead over selected values of the same variation, skipping unselected ones,
+* and the best split of those runs is computed from the back. Only the first header of the split is
+* returned, the next call plans again from wherever that header ended.
+*/
+template <class T>
+StaticHeaderPlan PlanStaticHeader(openpal::ArrayView<Cell<T>, uint16_t>& view, const Range& range, uint32_t maxValues)
+{
+	static const uint32_t MAX_RUNS = 32;
+	static const uint32_t OBJECT_HEADER_SIZE = 3;
+
+	// size of a start/stop header, matching how WriteWithSerializer will write it
+	const uint32_t rangeHeaderSize = OBJECT_HEADER_SIZE + (Range::From(view[range.start].vIndex, view[range.stop].vIndex).IsOneByte() ? 2 : 4);
+
+	uint32_t lengths[MAX_RUNS];
+	uint32_t numRuns = 0;
+	uint32_t numValues = 0;
+
+	const auto variation = view[range.start].selection.variation;
+	uint16_t lastIndex = view[range.start].vIndex;
+	bool inRun = false;
+
+	for (uint32_t i = range.start; i <= range.stop && numValues < maxValues; ++i)
+	{
+		const auto& cell = view[static_cast<uint16_t>(i)];
+
+		if (!cell.selection.selected)
+		{
+			inRun = false;
+			continue;
+		}
+
+		if (cell.selection.variation != variation)
+		{
+			break;
+		}
+
+		if (inRun && cell.vIndex == (lastIndex + 1))
+		{
+			++lengths[numRuns - 1];
+
+			// once the first run's prefixes would cost as much as a range header, a range header is always
+			// at least as good for it, whatever follows
+			if (numRuns == 1 && lengths[0] >= rangeHeaderSize)
+			{
+				return StaticHeaderPlan();
+			}
+		}
+		else
+		{
+			if (numRuns == MAX_RUNS)
+			{
+				break;
+			}
+
+			lengths[numRuns] = 1;
+			++numRuns;
+		}
+
+		inRun = true;
+		lastIndex = cell.vIndex;
+		++numValues;
+	}
+
+	// width of the count and prefix fields, matching how the header would be written
+	const uint32_t prefixSize = ((lastIndex <= openpal::UInt8::Max) && (numValues <= openpal::UInt8::Max)) ? 1 : 2;
+
+	// best[i] is the fewest bytes needed to encode runs i..N-1, and split[i] the last run of the first header
+	uint32_t best[MAX_RUNS + 1];
+	uint32_t split[MAX_RUNS];
+	best[numRuns] = 0;
+
+	for (uint32_t i = numRuns; i-- > 0;)
+	{
+		best[i] = rangeHeaderSize + best[i + 1];
+		split[i] = i;
+		bool prefixed = false;
+
+		uint32_t values = 0;
+		for (uint32_t j = i; j < numRuns; ++j)
+		{
+			values += lengths[j];
+			const uint32_t cost = OBJECT_HEADER_SIZE + prefixSize + (values * prefixSize) + best[j + 1];
+			if (cost < best[i])
+			{
+				best[i] = cost;
+				split[i] = j;
+				prefixed = true;
+			}
+		}
+
+		if (i == 0 && prefixed)
+		{
+			StaticHeaderPlan plan;
+			plan.prefixed = true;
+			for (uint32_t j = 0; j <= split[0]; ++j)
+			{
+				plan.count += lengths[j];
+			}
+			return plan;
+		}
+	}
+
+	return StaticHeaderPlan();
+}
+
+template <class Serializer>
+bool WriteWithPrefix(openpal::ArrayView<Cell<typename Serializer::Target>, uint16_t>& view, HeaderWriter& writer, Range& range, uint32_t count)
+{
+	typedef typename Serializer::Target Target;
+
+	// the cells are sorted by index so the last value in the header has the largest index
+	auto last = range.start;
+	for (uint32_t remaining = count; remaining > 0; ++last)
+	{
+		if (view[last].selection.selected)
+		{
+			--remaining;
+		}
+	}
+	--last;
+
+	if ((view[last].vIndex <= openpal::UInt8::Max) && (count <= openpal::UInt8::Max))
+	{
+		auto iter = writer.IterateOverCountWithPrefix<openpal::UInt8, Target>(QualifierCode::UINT8_CNT_UINT8_INDEX, Serializer::Inst());
+		return LoadWithPrefixIterator<Target, openpal::UInt8>(view, iter, range, count);
+	}
+	else
+	{
+		auto iter = writer.IterateOverCountWithPrefix<openpal::UInt16, Target>(QualifierCode::UINT16_CNT_UINT16_INDEX, Serializer::Inst());
+		return LoadWithPrefixIterator<Target, openpal::UInt16>(view, iter, range, count);
+	}
+}
+
 template <class T, class GV>
-bool WriteSingleBitfield(openpal::ArrayView<Cell<T>, uint16_t>& view, HeaderWriter& writer, Range& range)
+bool WriteSingleBitfield(openpal::ArrayView<Cell<T>, uint16_t>& view, HeaderWriter& writer, Range& range, bool planQualifiers)
 {
 	auto start = view[range.start].vIndex;
 	auto stop = view[range.stop].vIndex;
@@ -136,8 +321,19 @@ bool WriteSingleBitfield(openpal::ArrayView<Cell<T>, uint16_t>& view, HeaderWrit
 }
 
 template <class Serializer>
-bool WriteWithSerializer(openpal::ArrayView<Cell<typename Serializer::Target>, uint16_t>& view, HeaderWriter& writer, Range& range)
+bool WriteWithSerializer(openpal::ArrayView<Cell<typename Serializer::Target>, uint16_t>& view, HeaderWriter& writer, Range& range, bool planQualifiers)
 {
+	if (planQualifiers)
+	{
+		// no more values than could fit in the rest of the fragment are worth planning for
+		const uint32_t maxValues = (writer.Remaining() / Serializer::Inst().Size()) + 1;
+		auto plan = PlanStaticHeader(view, range, maxValues);
+		if (plan.prefixed)
+		{
+			return WriteWithPrefix<Serializer>(view, writer, range, plan.count);
+		}
+	}
+
 	auto start = view[range.start].vIndex;
 	auto stop = view[range.stop].vIndex;
 	auto mapped = Range::From(start, stop);
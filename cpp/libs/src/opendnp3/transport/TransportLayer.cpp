@@ -34,14 +34,14 @@ using namespace openpal;
 namespace opendnp3
 {
 
-TransportLayer::TransportLayer(openpal::Logger logger, openpal::IExecutor& executor, uint32_t maxRxFragSize, StackStatistics* pStatistics) :
+TransportLayer::TransportLayer(openpal::Logger logger, openpal::IExecutor& executor, uint32_t maxRxFragSize, StackStatistics* pStatistics, bool poolRxBuffer) :
 	logger(logger),
 	pUpperLayer(nullptr),
 	pLinkLayer(nullptr),
 	isOnline(false),
 	isSending(false),
 	pExecutor(&executor),
-	receiver(logger, maxRxFragSize, pStatistics),
+	receiver(logger, maxRxFragSize, pStatistics, poolRxBuffer),
 	transmitter(logger, pStatistics)
 {
 
@@ -109,6 +109,7 @@ bool TransportLayer::OnReceive(const RSlice& tpdu)
 		if (apdu.IsNotEmpty() && pUpperLayer)
 		{
 			pUpperLayer->OnReceive(apdu);
+			receiver.ReleaseFragment();
 		}
 		return true;
 	}
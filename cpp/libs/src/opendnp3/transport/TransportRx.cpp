@@ -33,10 +33,10 @@ using namespace openpal;
 namespace opendnp3
 {
 
-TransportRx::TransportRx(const Logger& logger_, uint32_t maxRxFragSize, StackStatistics* pStatistics_) :
+TransportRx::TransportRx(const Logger& logger_, uint32_t maxRxFragSize, StackStatistics* pStatistics_, bool poolRxBuffer) :
 	logger(logger_),
 	pStatistics(pStatistics_),
-	rxBuffer(maxRxFragSize),
+	rxBuffer(maxRxFragSize, poolRxBuffer),
 	numBytesRead(0)
 {
 
@@ -48,9 +48,18 @@ void TransportRx::Reset()
 	this->ClearRxBuffer();
 }
 
+void TransportRx::ReleaseFragment()
+{
+	if (numBytesRead == 0)
+	{
+		rxBuffer.Shrink(0);
+	}
+}
+
 void TransportRx::ClearRxBuffer()
 {
 	numBytesRead = 0;
+	rxBuffer.Shrink(0);
 }
 
 openpal::WSlice TransportRx::GetAvailable()
@@ -88,6 +97,12 @@ RSlice TransportRx::ProcessReceive(const RSlice& input)
 
 	auto available = this->GetAvailable();
 
+	// only fragments that outgrow the resident size lease the full maxRxFragSize
+	if (payload.Size() > available.Size() && rxBuffer.Grow(numBytesRead))
+	{
+		available = this->GetAvailable();
+	}
+
 	if (payload.Size() > available.Size())
 	{
 		if (pStatistics) ++pStatistics->numTransportErrorRx;
@@ -108,8 +123,9 @@ RSlice TransportRx::ProcessReceive(const RSlice& input)
 
 	if(FIN)
 	{
+		// the returned slice points into the buffer until ReleaseFragment() is called
 		RSlice ret = rxBuffer.ToRSlice().Take(numBytesRead);
-		this->ClearRxBuffer();
+		numBytesRead = 0;
 		return ret;
 	}
 	else
@@ -127,8 +143,8 @@ bool TransportRx::ValidateHeader(bool fir, bool fin, uint8_t sequence_)
 		{
 			// drop existing received bytes from segment
 			SIMPLE_LOG_BLOCK_WITH_CODE(logger, flags::WARN, TLERR_NEW_FIR_MID_SEQUENCE, "FIR received mid-fragment, discarding previous bytes");
-			numBytesRead = 0;
 		}
+		this->ClearRxBuffer();
 		return true;
 	}
 
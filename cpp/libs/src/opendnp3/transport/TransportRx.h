@@ -22,11 +22,11 @@
 #define OPENDNP3_TRANSPORTRX_H
 
 #include "opendnp3/StackStatistics.h"
+#include "opendnp3/app/FragmentBuffer.h"
 #include "opendnp3/transport/TransportConstants.h"
 #include "opendnp3/transport/TransportSeqNum.h"
 
 #include <openpal/container/RSlice.h>
-#include <openpal/container/Buffer.h>
 #include <openpal/logging/Logger.h>
 
 namespace opendnp3
@@ -41,12 +41,15 @@ class TransportRx
 {
 
 public:
-	TransportRx(const openpal::Logger&, uint32_t maxRxFragSize, StackStatistics* pStatistics);
+	TransportRx(const openpal::Logger&, uint32_t maxRxFragSize, StackStatistics* pStatistics, bool poolRxBuffer = false);
 
 	openpal::RSlice ProcessReceive(const openpal::RSlice& input);
 
 	void Reset();
 
+	/// Called once the fragment returned by ProcessReceive has been consumed
+	void ReleaseFragment();
+
 private:
 
 	openpal::WSlice GetAvailable();
@@ -58,7 +61,7 @@ private:
 	openpal::Logger logger;
 	StackStatistics* pStatistics;
 
-	openpal::Buffer rxBuffer;
+	FragmentBuffer rxBuffer;
 	uint32_t numBytesRead;
 
 	TransportSeqNum sequence;
@@ -25,8 +25,8 @@ using namespace openpal;
 namespace opendnp3
 {
 
-TransportStack::TransportStack(openpal::Logger logger, openpal::IExecutor& executor, ILinkListener& listener, uint32_t maxRxFragSize, StackStatistics* pStatistics, const LinkConfig& config) :
-	transport(logger, executor, maxRxFragSize, pStatistics),
+TransportStack::TransportStack(openpal::Logger logger, openpal::IExecutor& executor, ILinkListener& listener, uint32_t maxRxFragSize, StackStatistics* pStatistics, const LinkConfig& config, bool poolRxBuffer) :
+	transport(logger, executor, maxRxFragSize, pStatistics, poolRxBuffer),
 	link(logger, executor, transport, listener, config)
 {
 	transport.SetLinkLayer(&link);
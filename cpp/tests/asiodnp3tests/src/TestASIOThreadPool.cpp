@@ -28,6 +28,8 @@
 
 #include <opendnp3/LogLevels.h>
 
+#include <mutex>
+#include <set>
 #include <thread>
 
 using namespace std;
@@ -91,7 +93,92 @@ TEST_CASE(SUITE("StrandsSequenceCallbacksViaStrandWrap"))
 	REQUIRE(iterations ==  count1);
 }
 
+TEST_CASE(SUITE("ShardedPoolRunsEachShardOnItsOwnThread"))
+{
+	IOServiceThreadPool pool(nullptr, levels::NORMAL, 4, []() {}, []() {}, ThreadPoolSettings::Sharded());
+	REQUIRE(pool.NumShards() == 4);
+
+	std::mutex mutex;
+	std::vector<std::set<std::thread::id>> ids(pool.NumShards());
+	std::vector<asio::io_service*> services;
 
+	for (uint32_t i = 0; i < pool.NumShards(); ++i)
+	{
+		services.push_back(&pool.GetIOService("channel"));
+	}
 
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		const auto shard = i % services.size();
+		services[shard]->post([&mutex, &ids, shard]()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			ids[shard].insert(std::this_thread::get_id());
+		});
+	}
 
+	pool.Shutdown();
+
+	std::set<std::thread::id> all;
+	for (auto& set : ids)
+	{
+		REQUIRE(set.size() == 1);
+		all.insert(*set.begin());
+	}
+	REQUIRE(all.size() == 4);
+}
+
+TEST_CASE(SUITE("ShardedPoolAssignsRoundRobinByDefault"))
+{
+	IOServiceThreadPool pool(nullptr, levels::NORMAL, 3, []() {}, []() {}, ThreadPoolSettings::Sharded());
+
+	auto& first = pool.GetIOService("a");
+	auto& second = pool.GetIOService("b");
+	auto& third = pool.GetIOService("c");
+
+	REQUIRE(&first != &second);
+	REQUIRE(&second != &third);
+	REQUIRE(&first != &third);
+	REQUIRE(&pool.GetIOService("d") == &first);
+}
 
+TEST_CASE(SUITE("ShardedPoolUsesSelectorWhenSupplied"))
+{
+	auto selector = [](const std::string & id) -> uint32_t
+	{
+		return id.size();
+	};
+
+	IOServiceThreadPool pool(nullptr, levels::NORMAL, 2, []() {}, []() {}, ThreadPoolSettings::Sharded(false, selector));
+
+	REQUIRE(&pool.GetIOService("aa") == &pool.GetIOService("bbbb"));
+	REQUIRE(&pool.GetIOService("a") != &pool.GetIOService("bb"));
+}
+
+TEST_CASE(SUITE("SharedPoolHasOneShard"))
+{
+	IOServiceThreadPool pool(nullptr, levels::NORMAL, 4);
+	REQUIRE(pool.NumShards() == 1);
+	REQUIRE(&pool.GetIOService("a") == &pool.GetIOService());
+}
+
+TEST_CASE(SUITE("SingleThreadedServicesProduceStrandFreeExecutors"))
+{
+	IOServiceThreadPool sharded(nullptr, levels::NORMAL, 2, []() {}, []() {}, ThreadPoolSettings::Sharded());
+	ASIOExecutor shardExecutor(sharded.GetIOService("a"));
+	REQUIRE(shardExecutor.strand.IsStrandFree());
+
+	IOServiceThreadPool single(nullptr, levels::NORMAL, 1);
+	ASIOExecutor singleExecutor(single.GetIOService());
+	REQUIRE(singleExecutor.strand.IsStrandFree());
+
+	IOServiceThreadPool shared(nullptr, levels::NORMAL, 2);
+	ASIOExecutor sharedExecutor(shared.GetIOService());
+	REQUIRE_FALSE(sharedExecutor.strand.IsStrandFree());
+
+	ThreadPoolSettings settings;
+	settings.strandFree = false;
+	IOServiceThreadPool disabled(nullptr, levels::NORMAL, 1, []() {}, []() {}, settings);
+	ASIOExecutor disabledExecutor(disabled.GetIOService());
+	REQUIRE_FALSE(disabledExecutor.strand.IsStrandFree());
+}
@@ -0,0 +1,263 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <catch.hpp>
+
+#include <asiodnp3/DNP3Manager.h>
+#include <asiodnp3/DefaultMasterApplication.h>
+
+#include <opendnp3/LogLevels.h>
+#include <opendnp3/outstation/SimpleCommandHandler.h>
+#include <opendnp3/outstation/IOutstationApplication.h>
+
+#include <dnp3mocks/NullSOEHandler.h>
+
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace opendnp3;
+using namespace asiodnp3;
+using namespace openpal;
+
+#define SUITE(name) "DNP3ListenerTestSuite - " name
+
+const int ITERATIONS = 100;
+
+const uint16_t PORT = 20000;
+
+static bool WaitFor(const std::function<bool ()>& condition, std::chrono::milliseconds timeout = std::chrono::milliseconds(10000))
+{
+	auto expiration = std::chrono::steady_clock::now() + timeout;
+	while (std::chrono::steady_clock::now() < expiration)
+	{
+		if (condition())
+		{
+			return true;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	return condition();
+}
+
+static OutstationStackConfig ListenerOutstationConfig(uint16_t local, uint16_t remote)
+{
+	OutstationStackConfig config(DatabaseTemplate::AnalogOnly(1));
+	config.link.LocalAddr = local;
+	config.link.RemoteAddr = remote;
+	return config;
+}
+
+static MasterStackConfig ListenerMasterConfig(uint16_t local, uint16_t remote)
+{
+	MasterStackConfig config;
+	config.link.LocalAddr = local;
+	config.link.RemoteAddr = remote;
+	return config;
+}
+
+TEST_CASE(SUITE("ConstructionDestruction"))
+{
+	for (int i = 0; i < ITERATIONS; ++i)
+	{
+		DNP3Manager manager(std::thread::hardware_concurrency());
+
+		auto pListener = manager.AddTCPListener("listener", levels::NORMAL, "127.0.0.1", PORT);
+		REQUIRE(pListener != nullptr);
+		auto pClient = manager.AddTCPClient("client", levels::NORMAL, ChannelRetry::Default(), "127.0.0.1", "", PORT);
+
+		auto pOutstation = pListener->AddOutstation("outstation", SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), ListenerOutstationConfig(1024, 1));
+		auto pMaster = pClient->AddMaster("master", NullSOEHandler::Instance(), asiodnp3::DefaultMasterApplication::Instance(), ListenerMasterConfig(1, 1024));
+
+		pOutstation->Enable();
+		pMaster->Enable();
+	}
+}
+
+TEST_CASE(SUITE("ManualListenerShutdownWithStacks"))
+{
+	for (int i = 0; i < ITERATIONS; ++i)
+	{
+		DNP3Manager manager(std::thread::hardware_concurrency());
+
+		auto pListener = manager.AddTCPListener("listener", levels::NORMAL, "127.0.0.1", PORT);
+		auto pClient = manager.AddTCPClient("client", levels::NORMAL, ChannelRetry::Default(), "127.0.0.1", "", PORT);
+
+		auto pOutstation = pListener->AddOutstation("outstation", SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), ListenerOutstationConfig(1024, 1));
+		auto pMaster = pClient->AddMaster("master", NullSOEHandler::Instance(), asiodnp3::DefaultMasterApplication::Instance(), ListenerMasterConfig(1, 1024));
+
+		pOutstation->Enable();
+		pMaster->Enable();
+
+		pListener->Shutdown();
+		pClient->Shutdown();
+	}
+}
+
+TEST_CASE(SUITE("BindFailureReturnsNull"))
+{
+	DNP3Manager manager(1);
+	REQUIRE(manager.AddTCPListener("listener", levels::NORMAL, "not an address", PORT) == nullptr);
+}
+
+TEST_CASE(SUITE("DuplicateRouteIsRejected"))
+{
+	DNP3Manager manager(1);
+	auto pListener = manager.AddTCPListener("listener", levels::NORMAL, "127.0.0.1", PORT);
+	REQUIRE(pListener->AddOutstation("os1", SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), ListenerOutstationConfig(1024, 1)) != nullptr);
+	REQUIRE(pListener->AddOutstation("os2", SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), ListenerOutstationConfig(1024, 1)) == nullptr);
+	REQUIRE(pListener->AddOutstation("os3", SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), ListenerOutstationConfig(1024, 2)) != nullptr);
+}
+
+TEST_CASE(SUITE("RoutesEachConnectionToItsOutstation"))
+{
+	const uint16_t NUM_CLIENTS = 5;
+
+	DNP3Manager manager(std::thread::hardware_concurrency());
+
+	auto pListener = manager.AddTCPListener("listener", levels::NORMAL, "127.0.0.1", PORT);
+
+	std::vector<IMaster*> masters;
+
+	for (uint16_t i = 0; i < NUM_CLIENTS; ++i)
+	{
+		auto pOutstation = pListener->AddOutstation("outstation", SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), ListenerOutstationConfig(10 + i, 1));
+		REQUIRE(pOutstation != nullptr);
+		pOutstation->Enable();
+	}
+
+	for (uint16_t i = 0; i < NUM_CLIENTS; ++i)
+	{
+		auto pClient = manager.AddTCPClient("client", levels::NORMAL, ChannelRetry::Default(), "127.0.0.1", "", PORT);
+		auto pMaster = pClient->AddMaster("master", NullSOEHandler::Instance(), asiodnp3::DefaultMasterApplication::Instance(), ListenerMasterConfig(1, 10 + i));
+		pMaster->Enable();
+		masters.push_back(pMaster);
+	}
+
+	auto allRouted = [&]()
+	{
+		return pListener->GetStatistics().numRouted == NUM_CLIENTS;
+	};
+	REQUIRE(WaitFor(allRouted));
+
+	// every master receives the response to its startup integrity poll
+	for (auto pMaster : masters)
+	{
+		auto received = [pMaster]()
+		{
+			return pMaster->GetStackStatistics().numTransportRx > 0;
+		};
+		REQUIRE(WaitFor(received));
+	}
+
+	auto stats = pListener->GetStatistics();
+	REQUIRE(stats.numAccepted == NUM_CLIENTS);
+	REQUIRE(stats.numActive == NUM_CLIENTS);
+	REQUIRE(stats.numUnrouted == 0);
+}
+
+TEST_CASE(SUITE("UnroutedConnectionIsClosedAfterTimeout"))
+{
+	DNP3Manager manager(std::thread::hardware_concurrency());
+
+	auto pListener = manager.AddTCPListener("listener", levels::NORMAL, "127.0.0.1", PORT, TimeDuration::Milliseconds(100));
+	auto pOutstation = pListener->AddOutstation("outstation", SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), ListenerOutstationConfig(1024, 1));
+	pOutstation->Enable();
+
+	auto pClient = manager.AddTCPClient("client", levels::NORMAL, ChannelRetry::Default(), "127.0.0.1", "", PORT);
+	auto pMaster = pClient->AddMaster("master", NullSOEHandler::Instance(), asiodnp3::DefaultMasterApplication::Instance(), ListenerMasterConfig(1, 2048));
+	pMaster->Enable();
+
+	auto timedOut = [&]()
+	{
+		auto stats = pListener->GetStatistics();
+		return stats.numUnrouted > 0 && stats.numTimedOut > 0;
+	};
+	REQUIRE(WaitFor(timedOut));
+	REQUIRE(pListener->GetStatistics().numRouted == 0);
+}
+
+TEST_CASE(SUITE("ConnectionCannotTakeOverABoundRouteByDefault"))
+{
+	DNP3Manager manager(std::thread::hardware_concurrency());
+
+	auto pListener = manager.AddTCPListener("listener", levels::NORMAL, "127.0.0.1", PORT);
+	auto pOutstation = pListener->AddOutstation("outstation", SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), ListenerOutstationConfig(1024, 1));
+	pOutstation->Enable();
+
+	auto pClient1 = manager.AddTCPClient("client1", levels::NORMAL, ChannelRetry::Default(), "127.0.0.1", "", PORT);
+	pClient1->AddMaster("master", NullSOEHandler::Instance(), asiodnp3::DefaultMasterApplication::Instance(), ListenerMasterConfig(1, 1024))->Enable();
+	REQUIRE(WaitFor([&]()
+	{
+		return pListener->GetStatistics().numRouted == 1;
+	}));
+
+	// a second connection presenting the same addresses is refused while the first is open
+	auto pClient2 = manager.AddTCPClient("client2", levels::NORMAL, ChannelRetry::Default(), "127.0.0.1", "", PORT);
+	pClient2->AddMaster("master", NullSOEHandler::Instance(), asiodnp3::DefaultMasterApplication::Instance(), ListenerMasterConfig(1, 1024))->Enable();
+	REQUIRE(WaitFor([&]()
+	{
+		return pListener->GetStatistics().numRefused > 0;
+	}));
+
+	auto stats = pListener->GetStatistics();
+	REQUIRE(stats.numRouted == 1);
+	REQUIRE(stats.numReplaced == 0);
+}
+
+TEST_CASE(SUITE("TakeoverHandlerCanAllowAConnectionToTakeOverARoute"))
+{
+	DNP3Manager manager(std::thread::hardware_concurrency());
+
+	auto pListener = manager.AddTCPListener("listener", levels::NORMAL, "127.0.0.1", PORT);
+	auto pOutstation = pListener->AddOutstation("outstation", SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), ListenerOutstationConfig(1024, 1));
+	pOutstation->Enable();
+
+	std::vector<std::string> requests;
+	pListener->SetRouteTakeoverHandler([&requests](const std::string & bound, const std::string & incoming)
+	{
+		requests.push_back(bound + " " + incoming);
+		return bound == incoming;
+	});
+
+	auto pClient1 = manager.AddTCPClient("client1", levels::NORMAL, ChannelRetry::Default(), "127.0.0.1", "", PORT);
+	pClient1->AddMaster("master", NullSOEHandler::Instance(), asiodnp3::DefaultMasterApplication::Instance(), ListenerMasterConfig(1, 1024))->Enable();
+	REQUIRE(WaitFor([&]()
+	{
+		return pListener->GetStatistics().numRouted == 1;
+	}));
+
+	auto pClient2 = manager.AddTCPClient("client2", levels::NORMAL, ChannelRetry::Default(), "127.0.0.1", "", PORT);
+	pClient2->AddMaster("master", NullSOEHandler::Instance(), asiodnp3::DefaultMasterApplication::Instance(), ListenerMasterConfig(1, 1024))->Enable();
+	REQUIRE(WaitFor([&]()
+	{
+		return pListener->GetStatistics().numReplaced > 0;
+	}));
+
+	auto stats = pListener->GetStatistics();
+	REQUIRE(stats.numRouted >= 2);
+	REQUIRE(stats.numRefused == 0);
+
+	// the handler runs on the listener's executor, so only inspect what it saw once the listener is gone
+	pListener->Shutdown();
+	REQUIRE(!requests.empty());
+	REQUIRE(requests.front() == "127.0.0.1 127.0.0.1");
+}
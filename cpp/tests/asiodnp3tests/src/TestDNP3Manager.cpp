@@ -60,6 +60,80 @@ TEST_CASE(SUITE("ConstructionDestruction"))
 	}
 }
 
+TEST_CASE(SUITE("MemoryPairConstructionDestruction"))
+{
+	for (int i = 0; i < ITERATIONS; ++i)
+	{
+		DNP3Manager manager(std::thread::hardware_concurrency());
+
+		auto channels = manager.AddMemoryPair("client", "server", levels::NORMAL, ChannelRetry::Default());
+
+		auto pOutstation = channels.second->AddOutstation("outstation", SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), OutstationStackConfig(DatabaseTemplate()));
+		auto pMaster = channels.first->AddMaster("master", NullSOEHandler::Instance(), asiodnp3::DefaultMasterApplication::Instance(), MasterStackConfig());
+
+		pOutstation->Enable();
+		pMaster->Enable();
+	}
+}
+
+TEST_CASE(SUITE("UDPConstructionDestruction"))
+{
+	for (int i = 0; i < ITERATIONS; ++i)
+	{
+		DNP3Manager manager(std::thread::hardware_concurrency());
+
+		// both masters share the socket of port 20000
+		auto pClientA = manager.AddUDPChannel("clientA", levels::NORMAL, ChannelRetry::Default(), "127.0.0.1", 20000, "127.0.0.1", 20001);
+		auto pClientB = manager.AddUDPChannel("clientB", levels::NORMAL, ChannelRetry::Default(), "127.0.0.1", 20000, "127.0.0.1", 20002);
+		auto pServer = manager.AddUDPChannel("server", levels::NORMAL, ChannelRetry::Default(), "127.0.0.1", 20001, "127.0.0.1", 20000);
+
+		auto pOutstation = pServer->AddOutstation("outstation", SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), OutstationStackConfig(DatabaseTemplate()));
+		auto pMasterA = pClientA->AddMaster("masterA", NullSOEHandler::Instance(), asiodnp3::DefaultMasterApplication::Instance(), MasterStackConfig());
+		auto pMasterB = pClientB->AddMaster("masterB", NullSOEHandler::Instance(), asiodnp3::DefaultMasterApplication::Instance(), MasterStackConfig());
+
+		pOutstation->Enable();
+		pMasterA->Enable();
+		pMasterB->Enable();
+	}
+}
+
+TEST_CASE(SUITE("IOUringConstructionDestruction"))
+{
+	for (int i = 0; i < ITERATIONS; ++i)
+	{
+		DNP3Manager manager(std::thread::hardware_concurrency());
+
+		// channels fall back to the reactor where io_uring isn't available
+		manager.EnableIOUring();
+
+		auto pClient = manager.AddTCPClient("client", levels::NORMAL, ChannelRetry::Default(), "127.0.0.1", "", 20000);
+		auto pServer = manager.AddTCPServer("server", levels::NORMAL, ChannelRetry::Default(), "0.0.0.0", 20000);
+
+		auto pOutstation = pServer->AddOutstation("outstation", SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), OutstationStackConfig(DatabaseTemplate()));
+		auto pMaster = pClient->AddMaster("master", NullSOEHandler::Instance(), asiodnp3::DefaultMasterApplication::Instance(), MasterStackConfig());
+
+		pOutstation->Enable();
+		pMaster->Enable();
+	}
+}
+
+TEST_CASE(SUITE("ShardedConstructionDestruction"))
+{
+	for (int i = 0; i < ITERATIONS; ++i)
+	{
+		DNP3Manager manager(4, std::shared_ptr<openpal::ILogHandler>(), []() {}, []() {}, asiopal::ThreadPoolSettings::Sharded(true));
+
+		auto pClient = manager.AddTCPClient("client", levels::NORMAL, ChannelRetry::Default(), "127.0.0.1", "", 20000);
+		auto pServer = manager.AddTCPServer("server", levels::NORMAL, ChannelRetry::Default(), "0.0.0.0", 20000);
+
+		auto pOutstation = pServer->AddOutstation("outstation", SuccessCommandHandler::Instance(), DefaultOutstationApplication::Instance(), OutstationStackConfig(DatabaseTemplate()));
+		auto pMaster = pClient->AddMaster("master", NullSOEHandler::Instance(), asiodnp3::DefaultMasterApplication::Instance(), MasterStackConfig());
+
+		pOutstation->Enable();
+		pMaster->Enable();
+	}
+}
+
 TEST_CASE(SUITE("ManualStackShutdown"))
 {
 	for(int i = 0; i < ITERATIONS; ++i)
@@ -200,10 +200,8 @@ private:
 	std::mt19937 m_gen;
 };
 
-IOutstation* ConfigureOutstation(DNP3Manager& manager, int levels, uint16_t numValues, uint16_t eventBufferSize)
+IOutstation* ConfigureOutstation(IChannel* server, uint16_t numValues, uint16_t eventBufferSize)
 {
-	auto server = manager.AddTCPServer("server", levels, ChannelRetry::Default(), "127.0.0.1", 20000);
-
 	OutstationStackConfig stackConfig;
 	stackConfig.dbTemplate = DatabaseTemplate::AllTypes(numValues);
 	stackConfig.outstation.eventBufferConfig = EventBufferConfig::AllTypes(eventBufferSize);
@@ -214,10 +212,8 @@ IOutstation* ConfigureOutstation(DNP3Manager& manager, int levels, uint16_t numV
 	return outstation;
 }
 
-IMaster* ConfigureMaster(DNP3Manager& manager, ISOEHandler& handler, int levels)
+IMaster* ConfigureMaster(IChannel* client, ISOEHandler& handler)
 {
-	auto client = manager.AddTCPClient("client", levels, ChannelRetry::Default(), "127.0.0.1", "127.0.0.1", 20000);
-
 	MasterStackConfig mconfig;
 	mconfig.master.startupIntegrityClassMask = ClassField::None(); //disable integrity poll so we don't have to worry about static values coming back
 	auto master = client->AddMaster("master", handler, DefaultMasterApplication::Instance(), mconfig);
@@ -242,8 +238,32 @@ TEST_CASE(SUITE("TestEventIntegration"))
 	DNP3Manager manager(2);
 	//manager.AddLogSubscriber(ConsoleLogger::Instance());
 
-	auto outstation = ConfigureOutstation(manager, LEVELS, NUM_VALUES, EVENT_BUFFER_SIZE);
-	auto master = ConfigureMaster(manager, eventrx, LEVELS);
+	auto server = manager.AddTCPServer("server", LEVELS, ChannelRetry::Default(), "127.0.0.1", 20000);
+	auto client = manager.AddTCPClient("client", LEVELS, ChannelRetry::Default(), "127.0.0.1", "127.0.0.1", 20000);
+
+	auto outstation = ConfigureOutstation(server, NUM_VALUES, EVENT_BUFFER_SIZE);
+	auto master = ConfigureMaster(client, eventrx);
+
+	while (!eventrx.LoadAndWait(outstation, std::chrono::seconds(3)));
+}
+
+TEST_CASE(SUITE("TestEventIntegrationOverMemoryPipe"))
+{
+	const auto LEVELS = levels::NORMAL;
+
+	const uint32_t NUM_TO_SEND = 100000;
+	const uint16_t EVENT_BUFFER_SIZE = 100;
+	const uint32_t MAX_OUTSTANDING = EVENT_BUFFER_SIZE / 4;
+	const uint16_t NUM_VALUES = 100;
+
+	EventReceiver eventrx(NUM_TO_SEND, MAX_OUTSTANDING, NUM_VALUES);
+
+	DNP3Manager manager(2);
+
+	auto channels = manager.AddMemoryPair("client", "server", LEVELS, ChannelRetry::Default());
+
+	auto outstation = ConfigureOutstation(channels.second, NUM_VALUES, EVENT_BUFFER_SIZE);
+	auto master = ConfigureMaster(channels.first, eventrx);
 
 	while (!eventrx.LoadAndWait(outstation, std::chrono::seconds(3)));
 }
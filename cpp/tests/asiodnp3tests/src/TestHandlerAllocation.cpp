@@ -0,0 +1,180 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <catch.hpp>
+#include <asio.hpp>
+
+#include <asiopal/PhysicalLayerTCPClient.h>
+#include <asiopal/PhysicalLayerTCPServer.h>
+
+#include <asiodnp3/PhysicalLayerMonitor.h>
+
+#include <openpal/channel/IPhysicalLayer.h>
+#include <openpal/logging/LogRoot.h>
+
+#include <opendnp3/LogLevels.h>
+
+#include <testlib/AllocationCounter.h>
+#include <testlib/MockLogHandler.h>
+
+#include "mocks/PhysLoopback.h"
+#include "mocks/TestObjectASIO.h"
+
+#include <functional>
+
+using namespace opendnp3;
+using namespace openpal;
+using namespace asiopal;
+
+/**
+*	Writes a fixed frame, waits for the echo, and on every round trip also
+*	starts a zero length timer and posts a task to the executor
+*/
+class PingPong final : public asiodnp3::PhysicalLayerMonitor
+{
+public:
+
+	static const uint32_t SIZE = 64;
+
+	PingPong(LogRoot& root, ASIOExecutor& executor, IPhysicalLayer* pPhys) :
+		PhysicalLayerMonitor(root, executor, pPhys, ChannelRetry::Default()),
+		pExecutor(&executor),
+		numReceived(0),
+		roundTrips(0),
+		timers(0),
+		posts(0)
+	{
+		for (uint32_t i = 0; i < SIZE; ++i)
+		{
+			frame[i] = static_cast<uint8_t>(i);
+		}
+	}
+
+	virtual void OnReceive(const RSlice& buffer) override
+	{
+		numReceived += buffer.Size();
+		if (numReceived < SIZE)
+		{
+			this->StartRead();
+			return;
+		}
+
+		numReceived = 0;
+		++roundTrips;
+
+		auto onTimeout = [this]()
+		{
+			++timers;
+		};
+		pExecutor->Start(TimeDuration::Milliseconds(0), Action0::Bind(onTimeout));
+
+		auto onPost = [this]()
+		{
+			++posts;
+		};
+		pExecutor->Post(Action0::Bind(onPost));
+
+		this->StartWrite();
+	}
+
+	virtual void OnSendResult(bool isSuccess) override
+	{
+		if (isSuccess)
+		{
+			this->StartRead();
+		}
+	}
+
+	ASIOExecutor* pExecutor;
+	uint32_t numReceived;
+	uint32_t roundTrips;
+	uint32_t timers;
+	uint32_t posts;
+
+private:
+
+	virtual void OnPhysicalLayerOpenSuccessCallback() override
+	{
+		this->StartWrite();
+	}
+
+	virtual void OnPhysicalLayerOpenFailureCallback() override {}
+	virtual void OnPhysicalLayerCloseCallback() override {}
+
+	void StartWrite()
+	{
+		pPhys->BeginWrite(RSlice(frame, SIZE));
+	}
+
+	void StartRead()
+	{
+		WSlice dest(buffer, SIZE - numReceived);
+		pPhys->BeginRead(dest);
+	}
+
+	uint8_t frame[SIZE];
+	uint8_t buffer[SIZE];
+};
+
+#define SUITE(name) "HandlerAllocationSuite - " name
+
+TEST_CASE(SUITE("SteadyStateTCPReadsWritesTimersAndPostsDoNotAllocate"))
+{
+	const uint32_t WARMUP = 100;
+	const uint32_t ITERATIONS = 1000;
+
+	testlib::MockLogHandler log;
+	LogRoot root(&log, "test", levels::NORMAL);
+	TestObjectASIO test;
+
+	PhysicalLayerTCPServer server(root, test.GetService(), "127.0.0.1", 30001);
+	PhysLoopback loopback(root, server.executor, &server);
+	loopback.Start();
+
+	PhysicalLayerTCPClient client(root, test.GetService(), "127.0.0.1", "127.0.0.1", 30001);
+	PingPong ping(root, client.executor, &client);
+	ping.Start();
+
+	std::function<bool ()> warmedUp = [&]()
+	{
+		return ping.roundTrips >= WARMUP;
+	};
+	std::function<bool ()> finished = [&]()
+	{
+		return ping.roundTrips >= (WARMUP + ITERATIONS);
+	};
+
+	REQUIRE(test.ProceedUntil(warmedUp));
+
+	const auto timersBefore = ping.timers;
+	const auto postsBefore = ping.posts;
+
+	bool success = false;
+	auto count = testlib::CountAllocations([&]()
+	{
+		success = test.ProceedUntil(finished);
+	});
+
+	REQUIRE(success);
+	REQUIRE(ping.timers > timersBefore);
+	REQUIRE(ping.posts > postsBefore);
+	REQUIRE(count == 0);
+}
+
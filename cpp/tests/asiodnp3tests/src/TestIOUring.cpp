@@ -0,0 +1,183 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <catch.hpp>
+#include <asio.hpp>
+
+#include <asiopal/IOUring.h>
+
+#include "mocks/PhysTestObject.h"
+
+#include <testlib/BufferHelpers.h>
+
+using namespace opendnp3;
+using namespace openpal;
+using namespace asiopal;
+using namespace testlib;
+
+#define SUITE(name) "IOUringSuite - " name
+
+/// A client and server whose connections are carried by a ring
+class RingTestObject
+{
+public:
+
+	RingTestObject(const IOUringSettings& settings = IOUringSettings())
+	{
+		std::error_code ec;
+		ring = IOUring::Create(t.GetService(), settings, ec);
+		if (ring)
+		{
+			t.mTCPClient.SetIOUring(ring.get());
+			t.mTCPServer.SetIOUring(ring.get());
+		}
+	}
+
+	bool Connect()
+	{
+		t.mTCPServer.BeginOpen();
+		t.mTCPClient.BeginOpen();
+		return t.ProceedUntil(std::bind(&MockUpperLayer::IsOnline, &t.mServerUpper)) &&
+		       t.ProceedUntil(std::bind(&MockUpperLayer::IsOnline, &t.mClientUpper));
+	}
+
+	bool Disconnect(bool server)
+	{
+		if (server) t.mTCPServer.BeginClose();
+		else t.mTCPClient.BeginClose();
+		return t.ProceedUntilFalse(std::bind(&MockUpperLayer::IsOnline, &t.mServerUpper)) &&
+		       t.ProceedUntilFalse(std::bind(&MockUpperLayer::IsOnline, &t.mClientUpper));
+	}
+
+	PhysTestObject t;
+	std::shared_ptr<IOUring> ring;
+};
+
+TEST_CASE(SUITE("ConnectDisconnect"))
+{
+	RingTestObject test;
+	if (!test.ring)
+	{
+		WARN("io_uring is not supported here");
+		return;
+	}
+
+	for (size_t i = 0; i < 10; ++i)
+	{
+		REQUIRE(test.Connect());
+
+		// the remote sees the end of the stream through its multishot receive
+		REQUIRE(test.Disconnect((i % 2) == 0));
+	}
+}
+
+TEST_CASE(SUITE("TwoWaySend"))
+{
+	const size_t SEND_SIZE = 1 << 20; // 1 MB
+
+	RingTestObject test;
+	if (!test.ring)
+	{
+		WARN("io_uring is not supported here");
+		return;
+	}
+
+	REQUIRE(test.Connect());
+
+	ByteStr bs(SEND_SIZE, 77);
+	test.t.mClientUpper.SendDown(bs.ToRSlice());
+	test.t.mServerUpper.SendDown(bs.ToRSlice());
+
+	REQUIRE(test.t.ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &test.t.mServerUpper, SEND_SIZE)));
+	REQUIRE(test.t.ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &test.t.mClientUpper, SEND_SIZE)));
+	REQUIRE(test.t.mClientUpper.BufferEquals(bs.ToRSlice()));
+	REQUIRE(test.t.mServerUpper.BufferEquals(bs.ToRSlice()));
+
+	auto statistics = test.ring->GetStatistics();
+	REQUIRE(statistics.numCompletions > 0);
+	REQUIRE(statistics.numSubmitted >= statistics.numEnter);
+
+	REQUIRE(test.Disconnect(true));
+}
+
+TEST_CASE(SUITE("BatchedWriteArrivesInOrder"))
+{
+	RingTestObject test;
+	if (!test.ring)
+	{
+		WARN("io_uring is not supported here");
+		return;
+	}
+
+	REQUIRE(test.Connect());
+
+	ByteStr whole(3 * 292, 77);
+	RSlice batch[] = { whole.ToRSlice().Take(292), whole.ToRSlice().Skip(292).Take(292), whole.ToRSlice().Skip(2 * 292) };
+
+	test.t.mTCPClient.BeginWriteBatch(batch, 3);
+	REQUIRE(test.t.ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &test.t.mServerUpper, whole.Size())));
+	REQUIRE(test.t.mServerUpper.BufferEquals(whole.ToRSlice()));
+	REQUIRE(test.t.ProceedUntil([&]()
+	{
+		return test.t.mClientUpper.CountersEqual(1, 0);
+	}));
+
+	REQUIRE(test.Disconnect(false));
+}
+
+TEST_CASE(SUITE("SmallPoolRecoversFromBufferShortage"))
+{
+	const size_t SEND_SIZE = 1 << 16;
+
+	// far fewer buffers than the data in flight, receives stop until reads hand some back
+	IOUringSettings settings;
+	settings.bufferCount = 4;
+	settings.bufferSize = 256;
+
+	RingTestObject test(settings);
+	if (!test.ring)
+	{
+		WARN("io_uring is not supported here");
+		return;
+	}
+
+	REQUIRE(test.Connect());
+
+	ByteStr bs(SEND_SIZE, 33);
+	test.t.mClientUpper.SendDown(bs.ToRSlice());
+
+	REQUIRE(test.t.ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &test.t.mServerUpper, SEND_SIZE)));
+	REQUIRE(test.t.mServerUpper.BufferEquals(bs.ToRSlice()));
+	REQUIRE(test.ring->GetStatistics().numBufferShortages > 0);
+
+	REQUIRE(test.Disconnect(true));
+}
+
+TEST_CASE(SUITE("InvalidSettingsAreRejected"))
+{
+	asio::io_service service;
+
+	IOUringSettings settings;
+	settings.bufferCount = 1000;
+
+	std::error_code ec;
+	REQUIRE_FALSE(IOUring::Create(service, settings, ec));
+	REQUIRE(ec);
+}
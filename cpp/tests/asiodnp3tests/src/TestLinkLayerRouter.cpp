@@ -31,6 +31,8 @@
 
 #include "mocks/LinkLayerRouterTest.h"
 
+#include <asiodnp3/IRouteResolver.h>
+
 #include <testlib/BufferHelpers.h>
 #include <testlib/HexConversions.h>
 
@@ -40,6 +42,25 @@ using namespace testlib;
 
 #define SUITE(name) "LinkLayerRouterSuite - " name
 
+class MockRouteResolver : public asiodnp3::IRouteResolver
+{
+public:
+
+	MockRouteResolver(ILinkSession* pContext_) : pContext(pContext_), numResolved(0)
+	{}
+
+	virtual bool Resolve(asiodnp3::LinkLayerRouter& router, const Route& route) override
+	{
+		++numResolved;
+		lastRoute = route;
+		return pContext ? (router.AddContext(pContext, route) && router.Enable(pContext)) : false;
+	}
+
+	ILinkSession* pContext;
+	Route lastRoute;
+	int numResolved;
+};
+
 // Test that frames with unknown destinations are correctly logged
 TEST_CASE(SUITE("UnknownDestination"))
 {
@@ -193,6 +214,39 @@ TEST_CASE(SUITE("MultiContextSend"))
 }
 
 /// Test that the router correctly clear the receive buffer when the layer closes
+TEST_CASE(SUITE("FramesQueuedDuringWriteAreCoalesced"))
+{
+	LinkLayerRouterTest t;
+	MockFrameSink mfs1;
+	MockFrameSink mfs2;
+
+	t.router.AddContext(&mfs1, Route(1, 1024));
+	t.router.Enable(&mfs1);
+	t.router.AddContext(&mfs2, Route(1, 2048));
+	t.router.Enable(&mfs2);
+
+	HexSequence first("05 64 05 C0 00 04 01 00 00 00");
+	HexSequence second("05 64 05 C0 00 08 01 00 00 00");
+
+	t.phys.SignalOpenSuccess();
+	t.router.BeginTransmit(first.ToRSlice(), &mfs1);
+	REQUIRE(t.phys.NumWrites() == 1);
+
+	// both of these wait for the first write and then go out together
+	t.router.BeginTransmit(second.ToRSlice(), &mfs2);
+	t.router.BeginTransmit(first.ToRSlice(), &mfs1);
+	REQUIRE(t.phys.NumWrites() == 1);
+	t.phys.SignalSendSuccess();
+	REQUIRE(mfs1.m_num_tx_results == 1);
+
+	REQUIRE(t.phys.NumWrites() == 2);
+	REQUIRE(t.phys.BufferEqualsHex("05 64 05 C0 00 04 01 00 00 00 05 64 05 C0 00 08 01 00 00 00 05 64 05 C0 00 04 01 00 00 00"));
+	t.phys.SignalSendSuccess();
+	REQUIRE(mfs1.m_num_tx_results == 2);
+	REQUIRE(mfs2.m_num_tx_results == 1);
+	REQUIRE(t.phys.NumWrites() == 2);
+}
+
 TEST_CASE(SUITE("LinkLayerRouterClearsBufferOnLowerLayerDown"))
 {
 	LinkLayerRouterTest t;
@@ -219,3 +273,40 @@ TEST_CASE(SUITE("LinkLayerRouterClearsBufferOnLowerLayerDown"))
 	REQUIRE(1 ==  mfs.m_num_frames);
 }
 
+TEST_CASE(SUITE("ResolverBindsContextOnFirstFrame"))
+{
+	LinkLayerRouterTest t;
+	MockFrameSink mfs;
+	MockRouteResolver resolver(&mfs);
+	t.router.SetRouteResolver(&resolver);
+
+	t.router.StartOne();
+	t.phys.SignalOpenSuccess();
+	REQUIRE_FALSE(mfs.mLowerOnline);
+
+	t.phys.TriggerRead("05 64 05 C0 01 00 00 04 E9 21");
+
+	REQUIRE(resolver.numResolved == 1);
+	REQUIRE(resolver.lastRoute.Equals(Route(1024, 1)));
+	REQUIRE(mfs.mLowerOnline);
+	REQUIRE(1 == mfs.m_num_frames);
+
+	// subsequent frames go straight to the bound context
+	t.phys.TriggerRead("05 64 05 C0 01 00 00 04 E9 21");
+	REQUIRE(resolver.numResolved == 1);
+	REQUIRE(2 == mfs.m_num_frames);
+}
+
+TEST_CASE(SUITE("UnresolvedRouteIsLogged"))
+{
+	LinkLayerRouterTest t;
+	MockRouteResolver resolver(nullptr);
+	t.router.SetRouteResolver(&resolver);
+
+	t.router.StartOne();
+	t.phys.SignalOpenSuccess();
+
+	t.phys.TriggerRead("05 64 05 C0 01 00 00 04 E9 21");
+	REQUIRE(resolver.numResolved == 1);
+	REQUIRE(t.log.NextErrorCode() == DLERR_UNKNOWN_ROUTE);
+}
@@ -0,0 +1,227 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <catch.hpp>
+
+#include <opendnp3/LogLevels.h>
+
+#include <asiodnp3/PhysicalLayerMonitor.h>
+#include <asiodnp3/OpenAdmissionScheduler.h>
+
+#include "mocks/MockPhysicalLayer.h"
+
+#include <testlib/MockExecutor.h>
+#include <testlib/MockLogHandler.h>
+
+#include <memory>
+#include <vector>
+
+using namespace opendnp3;
+using namespace openpal;
+using namespace asiodnp3;
+
+class AdmittedMonitor final : public asiodnp3::PhysicalLayerMonitor
+{
+public:
+
+	AdmittedMonitor(openpal::LogRoot& root, openpal::IExecutor& executor, IPhysicalLayer* pPhys, const ChannelRetry& retry, OpenAdmissionScheduler* pAdmission) :
+		PhysicalLayerMonitor(root, executor, pPhys, retry, pAdmission)
+	{}
+
+	virtual void OnReceive(const openpal::RSlice&) override {}
+	virtual void OnSendResult(bool isSuccess) override {}
+
+protected:
+
+	void OnPhysicalLayerOpenSuccessCallback() override {}
+	void OnPhysicalLayerOpenFailureCallback() override {}
+	void OnPhysicalLayerCloseCallback() override {}
+};
+
+class AdmissionTestObject
+{
+public:
+
+	AdmissionTestObject(const OpenAdmissionSettings& settings) :
+		log(),
+		exe(),
+		schedulerExe(),
+		scheduler(schedulerExe)
+	{
+		scheduler.Configure(settings);
+	}
+
+	AdmittedMonitor& AddMonitor(uint8_t priority = 0)
+	{
+		auto retry = ChannelRetry::Default();
+		retry.priority = priority;
+		phys.push_back(std::unique_ptr<MockPhysicalLayer>(new MockPhysicalLayer(log.root, exe)));
+		monitors.push_back(std::unique_ptr<AdmittedMonitor>(new AdmittedMonitor(log.root, exe, phys.back().get(), retry, &scheduler)));
+		return *monitors.back();
+	}
+
+	testlib::MockLogHandler log;
+	testlib::MockExecutor exe;
+	testlib::MockExecutor schedulerExe;
+	OpenAdmissionScheduler scheduler;
+	std::vector<std::unique_ptr<MockPhysicalLayer>> phys;
+	std::vector<std::unique_ptr<AdmittedMonitor>> monitors;
+};
+
+OpenAdmissionSettings ConcurrencyOf(uint32_t max)
+{
+	OpenAdmissionSettings settings;
+	settings.maxConcurrentOpens = max;
+	return settings;
+}
+
+#define SUITE(name) "OpenAdmissionSchedulerTestSuite - " name
+
+TEST_CASE(SUITE("UnlimitedByDefault"))
+{
+	AdmissionTestObject test((OpenAdmissionSettings()));
+	test.AddMonitor().Start();
+	test.AddMonitor().Start();
+	REQUIRE(test.phys[0]->NumOpen() == 1);
+	REQUIRE(test.phys[1]->NumOpen() == 1);
+	REQUIRE(test.scheduler.GetStatistics().numOpening == 2);
+}
+
+TEST_CASE(SUITE("ConcurrencyLimitDefersOpens"))
+{
+	AdmissionTestObject test(ConcurrencyOf(1));
+	test.AddMonitor().Start();
+	test.AddMonitor().Start();
+
+	REQUIRE(test.phys[0]->NumOpen() == 1);
+	REQUIRE(test.phys[1]->NumOpen() == 0);
+	REQUIRE((ChannelState::OPENING == test.monitors[1]->GetState()));
+	REQUIRE(test.scheduler.GetStatistics().numWaiting == 1);
+
+	test.phys[0]->SignalOpenSuccess();
+	REQUIRE(test.exe.RunMany() > 0);
+	REQUIRE(test.phys[1]->NumOpen() == 1);
+
+	auto stats = test.scheduler.GetStatistics();
+	REQUIRE(stats.numWaiting == 0);
+	REQUIRE(stats.numOpening == 1);
+	REQUIRE(stats.numAdmitted == 2);
+	REQUIRE(stats.numOpenSuccess == 1);
+}
+
+TEST_CASE(SUITE("FailureReleasesConcurrency"))
+{
+	AdmissionTestObject test(ConcurrencyOf(1));
+	test.AddMonitor().Start();
+	test.AddMonitor().Start();
+
+	test.phys[0]->SignalOpenFailure();
+	REQUIRE((ChannelState::WAITING == test.monitors[0]->GetState()));
+	test.exe.RunMany();
+	REQUIRE(test.phys[1]->NumOpen() == 1);
+	REQUIRE(test.scheduler.GetStatistics().numOpenFailure == 1);
+}
+
+TEST_CASE(SUITE("HigherPriorityIsAdmittedFirst"))
+{
+	AdmissionTestObject test(ConcurrencyOf(1));
+	test.AddMonitor(0).Start();
+	test.AddMonitor(0).Start();
+	test.AddMonitor(5).Start();
+
+	test.phys[0]->SignalOpenSuccess();
+	test.exe.RunMany();
+	REQUIRE(test.phys[1]->NumOpen() == 0);
+	REQUIRE(test.phys[2]->NumOpen() == 1);
+
+	test.phys[2]->SignalOpenSuccess();
+	test.exe.RunMany();
+	REQUIRE(test.phys[1]->NumOpen() == 1);
+}
+
+TEST_CASE(SUITE("CloseWhileWaitingAbandonsTheOpen"))
+{
+	AdmissionTestObject test(ConcurrencyOf(1));
+	test.AddMonitor().Start();
+	test.AddMonitor().StartOne();
+
+	test.monitors[1]->Close();
+	test.exe.RunMany();
+	REQUIRE((ChannelState::CLOSED == test.monitors[1]->GetState()));
+	REQUIRE(test.phys[1]->NumOpen() == 0);
+	REQUIRE(test.scheduler.GetStatistics().numWaiting == 0);
+
+	// the abandoned request is not admitted later
+	test.phys[0]->SignalOpenSuccess();
+	test.exe.RunMany();
+	REQUIRE(test.phys[1]->NumOpen() == 0);
+}
+
+TEST_CASE(SUITE("ShutdownWhileWaitingRemovesTheRequest"))
+{
+	AdmissionTestObject test(ConcurrencyOf(1));
+	test.AddMonitor().Start();
+	test.AddMonitor().Start();
+
+	test.monitors[1]->Shutdown();
+	test.exe.RunMany();
+	REQUIRE((ChannelState::SHUTDOWN == test.monitors[1]->GetState()));
+
+	auto stats = test.scheduler.GetStatistics();
+	REQUIRE(stats.numWaiting == 0);
+	REQUIRE(stats.numOpening == 1);
+}
+
+TEST_CASE(SUITE("RateLimitStartsRefillTimer"))
+{
+	OpenAdmissionSettings settings;
+	settings.opensPerSecond = 1;
+	settings.openBurst = 1;
+
+	AdmissionTestObject test(settings);
+	test.AddMonitor().Start();
+	test.AddMonitor().Start();
+
+	REQUIRE(test.phys[0]->NumOpen() == 1);
+	REQUIRE(test.phys[1]->NumOpen() == 0);
+	REQUIRE(test.schedulerExe.RunMany() == 1);
+	REQUIRE(test.schedulerExe.NumPendingTimers() == 1);
+
+	test.scheduler.Shutdown();
+	REQUIRE(test.schedulerExe.NumPendingTimers() == 0);
+}
+
+TEST_CASE(SUITE("FullJitterStaysWithinNominalDelay"))
+{
+	OpenAdmissionSettings settings;
+	settings.fullJitter = true;
+
+	AdmissionTestObject test(settings);
+	for (int i = 0; i < 100; ++i)
+	{
+		auto delay = test.scheduler.RetryDelay(TimeDuration::Seconds(2));
+		REQUIRE(delay.GetMilliseconds() >= 0);
+		REQUIRE(delay.GetMilliseconds() <= 2000);
+	}
+
+	settings.fullJitter = false;
+	test.scheduler.Configure(settings);
+	REQUIRE(test.scheduler.RetryDelay(TimeDuration::Seconds(2)).GetMilliseconds() == 2000);
+}
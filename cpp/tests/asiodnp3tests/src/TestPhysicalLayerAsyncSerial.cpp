@@ -25,6 +25,16 @@
 #include <asio.hpp>
 #include <catch.hpp>
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <thread>
+#endif
+
 using namespace opendnp3;
 using namespace openpal;
 
@@ -35,7 +45,7 @@ using namespace openpal;
 
 TEST_CASE(SUITE("TestSendReceiveLoopback"))
 {
-	SerialSettings s;
+	asiopal::SerialSettings s;
 	s.mDevice = TOSTRING(SERIAL_PORT);
 	s.mBaud = 9600;
 	s.mDataBits = 8;
@@ -56,5 +66,179 @@ TEST_CASE(SUITE("TestSendReceiveLoopback"))
 
 #endif
 
+#ifdef __linux__
+
+/// A pseudo terminal stands in for the wire, the serial layer opens the slave side
+class PtyPair
+{
+public:
+
+	PtyPair() : master(posix_openpt(O_RDWR | O_NOCTTY))
+	{
+		if (master >= 0)
+		{
+			grantpt(master);
+			unlockpt(master);
+		}
+	}
+
+	~PtyPair()
+	{
+		if (master >= 0)
+		{
+			close(master);
+		}
+	}
+
+	std::string SlaveName() const
+	{
+		return ptsname(master);
+	}
+
+	void Write(const std::string& data)
+	{
+		REQUIRE(write(master, data.data(), data.size()) == static_cast<ssize_t>(data.size()));
+	}
+
+	/// @return milliseconds until the master has something to read, or -1 on timeout
+	int MillisecondsUntilReadable(int timeoutMs)
+	{
+		auto start = std::chrono::steady_clock::now();
+		pollfd fd = { master, POLLIN, 0 };
+		if (poll(&fd, 1, timeoutMs) <= 0)
+		{
+			return -1;
+		}
+		return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	int master;
+};
+
+class PtySerialTest
+{
+public:
+
+	PtySerialTest(const PtyPair& pty, asiopal::SerialSettings settings) : object(Settings(pty, settings))
+	{
+		object.mPort.SetChannelStatistics(&statistics);
+		object.mPort.BeginOpen();
+		REQUIRE(object.ProceedUntil(std::bind(&MockUpperLayer::IsOnline, &object.mUpper)));
+	}
+
+	static asiopal::SerialSettings Settings(const PtyPair& pty, asiopal::SerialSettings settings)
+	{
+		settings.deviceName = pty.SlaveName();
+		settings.asyncOpenDelay = TimeDuration::Zero();
+		return settings;
+	}
+
+	bool ReceivedSize(size_t size)
+	{
+		return object.ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &object.mUpper, size));
+	}
+
+	ChannelStatistics statistics;
+	SerialTestObject object;
+};
+
+TEST_CASE(SUITE("InterCharTimeoutCollectsBurstsIntoOneRead"))
+{
+	PtyPair pty;
+	REQUIRE(pty.master >= 0);
+
+	asiopal::SerialSettings settings;
+	settings.interCharTimeout = TimeDuration::Milliseconds(100);
+	PtySerialTest test(pty, settings);
+
+	pty.Write("hello");
+	test.object.ProceedForTime(TimeDuration::Milliseconds(20));
+	pty.Write("world");
+
+	REQUIRE(test.ReceivedSize(10));
+	REQUIRE(test.object.mUpper.BufferEqualsString("helloworld"));
+	REQUIRE(test.statistics.numReads == 1);
+	REQUIRE(test.statistics.numInterCharWakeups >= 1);
+}
+
+TEST_CASE(SUITE("ReadMinBytesHoldsBackShortReads"))
+{
+	PtyPair pty;
+	REQUIRE(pty.master >= 0);
+
+	asiopal::SerialSettings settings;
+	settings.readMinBytes = 10;
+	settings.interCharTimeout = TimeDuration::Milliseconds(20);
+	PtySerialTest test(pty, settings);
+
+	pty.Write("hello");
+	test.object.ProceedForTime(TimeDuration::Milliseconds(50));
+	REQUIRE(test.object.mUpper.IsBufferEmpty());
+
+	pty.Write("world");
+	REQUIRE(test.ReceivedSize(10));
+	REQUIRE(test.statistics.numReads == 1);
+}
+
+TEST_CASE(SUITE("ReadMinBytesCollectsTheTailOfASplitFrame"))
+{
+	PtyPair pty;
+	REQUIRE(pty.master >= 0);
+
+	asiopal::SerialSettings settings;
+	settings.readMinBytes = 10;
+	settings.interCharTimeout = TimeDuration::Milliseconds(100);
+	PtySerialTest test(pty, settings);
+
+	pty.Write("0123456789");
+	test.object.ProceedForTime(TimeDuration::Milliseconds(20));
+	pty.Write("abcde");
+
+	REQUIRE(test.ReceivedSize(15));
+	REQUIRE(test.object.mUpper.BufferEqualsString("0123456789abcde"));
+	REQUIRE(test.statistics.numReads == 1);
+}
+
+TEST_CASE(SUITE("ReadMinBytesIsIgnoredWithoutInterCharTimeout"))
+{
+	PtyPair pty;
+	REQUIRE(pty.master >= 0);
+
+	asiopal::SerialSettings settings;
+	settings.readMinBytes = 10;
+	PtySerialTest test(pty, settings);
+
+	pty.Write("0123456789");
+	REQUIRE(test.ReceivedSize(10));
+
+	// with VMIN of 10 the last 5 bytes of the frame would wait in the driver for more traffic
+	pty.Write("abcde");
+	REQUIRE(test.ReceivedSize(15));
+	REQUIRE(test.object.mUpper.BufferEqualsString("0123456789abcde"));
+}
+
+TEST_CASE(SUITE("TurnaroundDelayHoldsBackTransmit"))
+{
+	PtyPair pty;
+	REQUIRE(pty.master >= 0);
+
+	asiopal::SerialSettings settings;
+	settings.turnaroundDelay = TimeDuration::Milliseconds(100);
+	PtySerialTest test(pty, settings);
+
+	pty.Write("request");
+	REQUIRE(test.ReceivedSize(7));
 
+	// the test drives the io_service, so run it on another thread while this one watches the wire
+	test.object.mUpper.SendDown("01 02 03 04");
+	std::thread respond([&test]()
+	{
+		test.object.ProceedForTime(TimeDuration::Milliseconds(300));
+	});
+	auto elapsed = pty.MillisecondsUntilReadable(1000);
+	respond.join();
 
+	REQUIRE(elapsed >= 80);
+}
+
+#endif
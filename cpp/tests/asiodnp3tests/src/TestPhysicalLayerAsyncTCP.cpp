@@ -169,6 +169,32 @@ TEST_CASE(SUITE("TwoWaySend"))
 	REQUIRE(t.ProceedUntilFalse(std::bind(&MockUpperLayer::IsOnline, &t.mClientUpper)));
 }
 
+TEST_CASE(SUITE("BatchedWriteArrivesInOrder"))
+{
+	PhysTestObject t;
+
+	t.mTCPServer.BeginOpen();
+	t.mTCPClient.BeginOpen();
+	REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::IsOnline, &t.mServerUpper)));
+	REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::IsOnline, &t.mClientUpper)));
+
+	ByteStr whole(3 * 292, 77);
+	RSlice batch[] = { whole.ToRSlice().Take(292), whole.ToRSlice().Skip(292).Take(292), whole.ToRSlice().Skip(2 * 292) };
+
+	// a single write completes the whole batch
+	t.mTCPClient.BeginWriteBatch(batch, 3);
+	REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &t.mServerUpper, whole.Size())));
+	REQUIRE(t.mServerUpper.BufferEquals(whole.ToRSlice()));
+	REQUIRE(t.ProceedUntil([&]()
+	{
+		return t.mClientUpper.CountersEqual(1, 0);
+	}));
+
+	t.mTCPServer.BeginClose();
+	REQUIRE(t.ProceedUntilFalse(std::bind(&MockUpperLayer::IsOnline, &t.mServerUpper)));
+	REQUIRE(t.ProceedUntilFalse(std::bind(&MockUpperLayer::IsOnline, &t.mClientUpper)));
+}
+
 TEST_CASE(SUITE("ServerCloseWhileOpeningKillsAcceptor"))
 {
 	PhysTestObject t;
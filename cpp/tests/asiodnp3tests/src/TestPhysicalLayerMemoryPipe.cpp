@@ -0,0 +1,196 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <catch.hpp>
+
+#include <asio.hpp>
+
+#include <asiopal/PhysicalLayerMemoryPipe.h>
+
+#include <dnp3mocks/MockUpperLayer.h>
+#include <dnp3mocks/LowerLayerToPhysAdapter.h>
+
+#include <testlib/BufferHelpers.h>
+#include <testlib/MockLogHandler.h>
+
+#include "mocks/TestObjectASIO.h"
+
+#include <functional>
+#include <memory>
+
+using namespace opendnp3;
+using namespace openpal;
+using namespace asiopal;
+using namespace testlib;
+
+#define SUITE(name) "PhysicalLayerMemoryPipeSuite - " name
+
+class MemoryPipeTestObject : public TestObjectASIO
+{
+public:
+
+	MemoryPipeTestObject(const MemoryPipeSettings& settings = MemoryPipeSettings()) :
+		log(),
+		pair(PhysicalLayerMemoryPipe::CreatePair(log.root, log.root, this->GetService(), settings)),
+		pipeA(pair.first),
+		pipeB(pair.second),
+		adapterA(log.GetLogger(), pipeA.get()),
+		adapterB(log.GetLogger(), pipeB.get())
+	{
+		adapterA.SetUpperLayer(upperA);
+		adapterB.SetUpperLayer(upperB);
+
+		upperA.SetLowerLayer(adapterA);
+		upperB.SetLowerLayer(adapterB);
+	}
+
+	bool OpenBoth()
+	{
+		pipeA->BeginOpen();
+		pipeB->BeginOpen();
+		return ProceedUntil(std::bind(&MockUpperLayer::IsOnline, &upperA)) && ProceedUntil(std::bind(&MockUpperLayer::IsOnline, &upperB));
+	}
+
+	bool BothClosed()
+	{
+		return ProceedUntilFalse(std::bind(&MockUpperLayer::IsOnline, &upperA)) && ProceedUntilFalse(std::bind(&MockUpperLayer::IsOnline, &upperB));
+	}
+
+	testlib::MockLogHandler log;
+
+	std::pair<PhysicalLayerMemoryPipe*, PhysicalLayerMemoryPipe*> pair;
+
+	std::unique_ptr<PhysicalLayerMemoryPipe> pipeA;
+	std::unique_ptr<PhysicalLayerMemoryPipe> pipeB;
+
+	LowerLayerToPhysAdapter adapterA;
+	LowerLayerToPhysAdapter adapterB;
+
+	MockUpperLayer upperA;
+	MockUpperLayer upperB;
+};
+
+TEST_CASE(SUITE("OpenWaitsForPeer"))
+{
+	MemoryPipeTestObject t;
+
+	t.pipeA->BeginOpen();
+	t.ProceedForTime(TimeDuration::Milliseconds(10));
+	REQUIRE(t.pipeA->IsOpening());
+	REQUIRE_FALSE(t.upperA.IsOnline());
+
+	t.pipeB->BeginOpen();
+	REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::IsOnline, &t.upperA)));
+	REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::IsOnline, &t.upperB)));
+}
+
+TEST_CASE(SUITE("OpenCanceled"))
+{
+	MemoryPipeTestObject t;
+
+	for (uint32_t i = 0; i < 2; ++i)
+	{
+		t.pipeA->BeginOpen();
+		t.pipeA->BeginClose();
+		REQUIRE(t.ProceedUntil(std::bind(&LowerLayerToPhysAdapter::OpenFailureEquals, &t.adapterA, i + 1)));
+	}
+}
+
+TEST_CASE(SUITE("ConnectDisconnect"))
+{
+	MemoryPipeTestObject t;
+
+	for (uint32_t i = 0; i < 10; ++i)
+	{
+		REQUIRE(t.OpenBoth());
+
+		// closing either end closes the other one
+		if ((i % 2) == 0) t.pipeA->BeginClose();
+		else t.pipeB->BeginClose();
+
+		REQUIRE(t.BothClosed());
+	}
+}
+
+TEST_CASE(SUITE("TwoWaySend"))
+{
+	const uint32_t SEND_SIZE = 1 << 20; // 1 MB
+
+	MemoryPipeTestObject t;
+	REQUIRE(t.OpenBoth());
+
+	ByteStr bs(SEND_SIZE, 77);
+	t.upperA.SendDown(bs.ToRSlice());
+	t.upperB.SendDown(bs.ToRSlice());
+
+	REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &t.upperA, SEND_SIZE)));
+	REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &t.upperB, SEND_SIZE)));
+
+	REQUIRE(t.upperA.BufferEquals(bs.ToRSlice()));
+	REQUIRE(t.upperB.BufferEquals(bs.ToRSlice()));
+
+	t.pipeB->BeginClose();
+	REQUIRE(t.BothClosed());
+}
+
+TEST_CASE(SUITE("LatencyAndBandwidthDelayDelivery"))
+{
+	const uint32_t SEND_SIZE = 1000;
+
+	MemoryPipeSettings settings;
+	settings.latency = TimeDuration::Milliseconds(20);
+	settings.bandwidth = 50000; // 1000 bytes takes 20ms
+
+	MemoryPipeTestObject t(settings);
+	REQUIRE(t.OpenBoth());
+
+	ByteStr bs(SEND_SIZE, 33);
+	t.upperA.SendDown(bs.ToRSlice());
+
+	t.ProceedForTime(TimeDuration::Milliseconds(10));
+	REQUIRE(t.upperB.IsBufferEmpty());
+
+	REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &t.upperB, SEND_SIZE)));
+	REQUIRE(t.upperB.BufferEquals(bs.ToRSlice()));
+	REQUIRE(t.upperA.CountersEqual(1, 0));
+
+	t.pipeA->BeginClose();
+	REQUIRE(t.BothClosed());
+}
+
+TEST_CASE(SUITE("BitErrorsAreInjected"))
+{
+	const uint32_t SEND_SIZE = 1 << 16;
+
+	MemoryPipeSettings settings;
+	settings.bitErrorRate = 0.001;
+
+	MemoryPipeTestObject t(settings);
+	REQUIRE(t.OpenBoth());
+
+	ByteStr bs(SEND_SIZE, 0);
+	t.upperA.SendDown(bs.ToRSlice());
+
+	REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &t.upperB, SEND_SIZE)));
+	REQUIRE_FALSE(t.upperB.BufferEquals(bs.ToRSlice()));
+
+	t.pipeA->BeginClose();
+	REQUIRE(t.BothClosed());
+}
@@ -0,0 +1,272 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <catch.hpp>
+
+#include <asio.hpp>
+
+#include <asiopal/PhysicalLayerUDP.h>
+
+#include <dnp3mocks/MockUpperLayer.h>
+#include <dnp3mocks/LowerLayerToPhysAdapter.h>
+
+#include <testlib/BufferHelpers.h>
+#include <testlib/HexConversions.h>
+#include <testlib/MockLogHandler.h>
+
+#include "mocks/TestObjectASIO.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace opendnp3;
+using namespace openpal;
+using namespace asiopal;
+using namespace testlib;
+
+#define SUITE(name) "PhysicalLayerUDPSuite - " name
+
+/// A session on the shared socket and the plain socket of its peer
+class UDPSession
+{
+public:
+
+	UDPSession(testlib::MockLogHandler& log, asio::io_service& service, const std::shared_ptr<DatagramSocket>& socket, bool autoRead = true) :
+		peer(service, asio::ip::udp::endpoint(asio::ip::address::from_string("127.0.0.1"), 0)),
+		layer(log.root, service, socket, "127.0.0.1", peer.local_endpoint().port()),
+		adapter(log.GetLogger(), &layer, autoRead)
+	{
+		peer.non_blocking(true);
+		adapter.SetUpperLayer(upper);
+		upper.SetLowerLayer(adapter);
+	}
+
+	void PeerSend(uint16_t port, const std::string& hex)
+	{
+		HexSequence bytes(hex);
+		peer.send_to(asio::buffer(static_cast<const uint8_t*>(bytes.ToRSlice()), bytes.Size()), asio::ip::udp::endpoint(asio::ip::address::from_string("127.0.0.1"), port));
+	}
+
+	/// @return the size of the datagram the peer received, 0 if none is waiting
+	size_t PeerReceive()
+	{
+		std::error_code ec;
+		asio::ip::udp::endpoint sender;
+		return peer.receive_from(asio::buffer(received, sizeof(received)), sender, 0, ec);
+	}
+
+	asio::ip::udp::socket peer;
+	PhysicalLayerUDP layer;
+	LowerLayerToPhysAdapter adapter;
+	MockUpperLayer upper;
+	uint8_t received[2048];
+};
+
+class UDPTestObject : public TestObjectASIO
+{
+public:
+
+	UDPTestObject(uint32_t numSessions, const UDPSettings& settings = UDPSettings()) :
+		socket(std::make_shared<DatagramSocket>(this->GetService(), "127.0.0.1", 0, settings))
+	{
+		for (uint32_t i = 0; i < numSessions; ++i)
+		{
+			sessions.push_back(std::unique_ptr<UDPSession>(new UDPSession(log, this->GetService(), socket)));
+		}
+	}
+
+	bool OpenAll()
+	{
+		for (auto& session : sessions)
+		{
+			session->layer.BeginOpen();
+		}
+
+		for (auto& session : sessions)
+		{
+			if (!ProceedUntil(std::bind(&MockUpperLayer::IsOnline, &session->upper)))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool CloseAll()
+	{
+		for (auto& session : sessions)
+		{
+			session->layer.BeginClose();
+		}
+
+		for (auto& session : sessions)
+		{
+			if (!ProceedUntilFalse(std::bind(&MockUpperLayer::IsOnline, &session->upper)))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	testlib::MockLogHandler log;
+	std::shared_ptr<DatagramSocket> socket;
+	std::vector<std::unique_ptr<UDPSession>> sessions;
+};
+
+TEST_CASE(SUITE("RoutesDatagramsBySender"))
+{
+	UDPTestObject t(2);
+	REQUIRE(t.OpenAll());
+
+	auto port = t.socket->GetLocalPort();
+	REQUIRE(port != 0);
+
+	t.sessions[1]->PeerSend(port, "03 04 05");
+	t.sessions[0]->PeerSend(port, "01 02");
+
+	REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &t.sessions[0]->upper, 2)));
+	REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &t.sessions[1]->upper, 3)));
+	REQUIRE(t.sessions[0]->upper.BufferEqualsHex("01 02"));
+	REQUIRE(t.sessions[1]->upper.BufferEqualsHex("03 04 05"));
+	REQUIRE(t.socket->GetStatistics().numRx == 2);
+}
+
+TEST_CASE(SUITE("WritesAreSentToThePeer"))
+{
+	UDPTestObject t(2);
+	REQUIRE(t.OpenAll());
+
+	// the buffer must outlive the write
+	HexSequence bytes("0A 0B 0C");
+	t.sessions[1]->upper.SendDown(bytes.ToRSlice());
+	REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::CountersEqual, &t.sessions[1]->upper, 1, 0)));
+
+	auto& session = *t.sessions[1];
+	REQUIRE(session.PeerReceive() == 3);
+	REQUIRE(ToHex(RSlice(session.received, 3)) == "0A 0B 0C");
+	REQUIRE(t.sessions[0]->PeerReceive() == 0);
+	REQUIRE(t.socket->GetStatistics().numTx == 1);
+}
+
+TEST_CASE(SUITE("DatagramsFromUnknownSendersAreCounted"))
+{
+	UDPTestObject t(2);
+	t.sessions.front()->layer.BeginOpen();
+	REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::IsOnline, &t.sessions.front()->upper)));
+
+	// the second session is not open, so its peer is unknown
+	t.sessions.back()->PeerSend(t.socket->GetLocalPort(), "01");
+	REQUIRE(t.ProceedUntil([&t]()
+	{
+		return t.socket->GetStatistics().numUnrouted == 1;
+	}));
+	REQUIRE(t.sessions.front()->upper.IsBufferEmpty());
+}
+
+TEST_CASE(SUITE("SecondSessionForTheSamePeerFailsToOpen"))
+{
+	UDPTestObject t(1);
+	REQUIRE(t.OpenAll());
+
+	auto& first = *t.sessions.front();
+	PhysicalLayerUDP duplicate(t.log.root, t.GetService(), t.socket, "127.0.0.1", first.peer.local_endpoint().port());
+	LowerLayerToPhysAdapter adapter(t.log.GetLogger(), &duplicate);
+	MockUpperLayer upper;
+	adapter.SetUpperLayer(upper);
+	upper.SetLowerLayer(adapter);
+
+	duplicate.BeginOpen();
+	REQUIRE(t.ProceedUntil(std::bind(&LowerLayerToPhysAdapter::OpenFailureEquals, &adapter, 1)));
+	REQUIRE(first.upper.IsOnline());
+}
+
+TEST_CASE(SUITE("SocketIsClosedWithTheLastSession"))
+{
+	UDPTestObject t(2);
+
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		REQUIRE(t.OpenAll());
+		REQUIRE(t.socket->GetLocalPort() != 0);
+
+		t.sessions[0]->PeerSend(t.socket->GetLocalPort(), "01 02");
+		REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &t.sessions[0]->upper, 2)));
+		t.sessions[0]->upper.ClearBuffer();
+
+		REQUIRE(t.CloseAll());
+		REQUIRE(t.socket->GetLocalPort() == 0);
+	}
+}
+
+TEST_CASE(SUITE("DatagramsWaitingTogetherAreReceivedInOneCall"))
+{
+	UDPSettings settings;
+	settings.maxBatch = 32;
+	UDPTestObject t(20, settings);
+	REQUIRE(t.OpenAll());
+
+	// every datagram is already waiting when the socket is next polled
+	auto port = t.socket->GetLocalPort();
+	for (auto& session : t.sessions)
+	{
+		session->PeerSend(port, "C0 C1 C2 C3");
+	}
+
+	for (auto& session : t.sessions)
+	{
+		REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &session->upper, 4)));
+	}
+
+	auto stats = t.socket->GetStatistics();
+	REQUIRE(stats.numRx == 20);
+	REQUIRE(stats.numReceiveCalls == 1);
+}
+
+TEST_CASE(SUITE("DatagramsAreQueuedUntilRead"))
+{
+	UDPSettings settings;
+	settings.maxQueuedDatagrams = 2;
+	UDPTestObject t(0, settings);
+	UDPSession session(t.log, t.GetService(), t.socket, false);
+
+	session.layer.BeginOpen();
+	REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::IsOnline, &session.upper)));
+
+	auto port = t.socket->GetLocalPort();
+	session.PeerSend(port, "01");
+	session.PeerSend(port, "02 03");
+	session.PeerSend(port, "04");
+	REQUIRE(t.ProceedUntil([&t]()
+	{
+		return t.socket->GetStatistics().numRx == 3;
+	}));
+	REQUIRE(t.socket->GetStatistics().numDropped == 1);
+
+	// each read returns one datagram
+	session.adapter.StartRead();
+	REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &session.upper, 1)));
+	session.adapter.StartRead();
+	REQUIRE(t.ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &session.upper, 3)));
+	REQUIRE(session.upper.BufferEqualsHex("01 02 03"));
+}
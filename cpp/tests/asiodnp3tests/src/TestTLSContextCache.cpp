@@ -0,0 +1,193 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <catch.hpp>
+
+#ifdef OPENDNP3_USE_TLS
+
+#include <asiopal/tls/TLSContextCache.h>
+
+#include "mocks/TLSTestObject.h"
+
+#include <system_error>
+
+using namespace opendnp3;
+using namespace asiopal;
+
+#define SUITE(name) "TLSContextCacheSuite - " name
+
+namespace
+{
+
+void TestServerReloadForgetsSessions(bool useSessionTickets, uint16_t port)
+{
+	TLSTestFiles files("tls-context-cache");
+	auto config = files.GetConfig();
+	config.useSessionTickets = useSessionTickets;
+
+	// separate caches, so the client still offers its session after the server reloads
+	TLSContextCache clientCache;
+	TLSContextCache serverCache;
+	TLSTestObject t(clientCache, serverCache, config, port);
+
+	REQUIRE(t.Connect());
+	REQUIRE(t.Disconnect());
+
+	REQUIRE(serverCache.Reload());
+
+	REQUIRE(t.Connect());
+	REQUIRE(serverCache.GetSessionStatistics().numFullHandshakes == 2);
+	REQUIRE(serverCache.GetSessionStatistics().numResumedHandshakes == 0);
+	REQUIRE(t.Disconnect());
+}
+
+}
+
+TEST_CASE(SUITE("Identical configurations share a context"))
+{
+	TLSTestFiles files("tls-context-cache");
+	TLSContextCache cache;
+
+	auto first = cache.Get(files.GetConfig(), false);
+	auto second = cache.Get(files.GetConfig(), false);
+
+	REQUIRE(first == second);
+	REQUIRE(cache.NumContexts() == 1);
+}
+
+TEST_CASE(SUITE("Contexts are keyed by role and configuration"))
+{
+	TLSTestFiles files("tls-context-cache");
+	TLSTestFiles other("tls-context-cache-other");
+	TLSContextCache cache;
+
+	auto client = cache.Get(files.GetConfig(), false);
+	auto server = cache.Get(files.GetConfig(), true);
+	auto otherFiles = cache.Get(other.GetConfig(), false);
+
+	auto config = files.GetConfig();
+	config.useSessionTickets = false;
+	auto otherOptions = cache.Get(config, false);
+
+	REQUIRE(client != server);
+	REQUIRE(client != otherFiles);
+	REQUIRE(client != otherOptions);
+	REQUIRE(server->server);
+	REQUIRE_FALSE(client->server);
+	REQUIRE(cache.NumContexts() == 4);
+}
+
+TEST_CASE(SUITE("A context lives as long as the last user"))
+{
+	TLSTestFiles files("tls-context-cache");
+	TLSContextCache cache;
+
+	auto first = cache.Get(files.GetConfig(), false);
+	auto second = cache.Get(files.GetConfig(), false);
+	std::weak_ptr<TLSContext> weak = first;
+
+	first.reset();
+	REQUIRE(cache.NumContexts() == 1);
+	REQUIRE_FALSE(weak.expired());
+
+	second.reset();
+	REQUIRE(cache.NumContexts() == 0);
+	REQUIRE(weak.expired());
+
+	auto rebuilt = cache.Get(files.GetConfig(), false);
+	REQUIRE(cache.NumContexts() == 1);
+}
+
+TEST_CASE(SUITE("Getting a context for files that can't be loaded throws"))
+{
+	TLSTestFiles files("tls-context-cache");
+	files.Corrupt();
+	TLSContextCache cache;
+
+	REQUIRE_THROWS_AS(cache.Get(files.GetConfig(), false), const std::system_error&);
+	REQUIRE(cache.NumContexts() == 0);
+}
+
+TEST_CASE(SUITE("Reload replaces the context of every user"))
+{
+	TLSTestFiles files("tls-context-cache");
+	TLSContextCache cache;
+
+	auto context = cache.Get(files.GetConfig(), false);
+	auto before = context->Get();
+
+	files.Generate();
+	REQUIRE(cache.Reload());
+	REQUIRE(context->Get() != before);
+}
+
+TEST_CASE(SUITE("A failed reload keeps the current context"))
+{
+	TLSTestFiles files("tls-context-cache");
+	TLSTestFiles other("tls-context-cache-other");
+	TLSContextCache cache;
+
+	auto broken = cache.Get(files.GetConfig(), false);
+	auto working = cache.Get(other.GetConfig(), false);
+	auto brokenBefore = broken->Get();
+	auto workingBefore = working->Get();
+
+	files.Corrupt();
+	REQUIRE_FALSE(cache.Reload());
+
+	// the other contexts still reload
+	REQUIRE(broken->Get() == brokenBefore);
+	REQUIRE(working->Get() != workingBefore);
+
+	files.Generate();
+	REQUIRE(cache.Reload());
+	REQUIRE(broken->Get() != brokenBefore);
+}
+
+TEST_CASE(SUITE("Reload forgets the cached sessions"))
+{
+	TLSTestFiles files("tls-context-cache");
+	TLSContextCache cache;
+	TLSTestObject t(cache, files.GetConfig(), 50012);
+
+	REQUIRE(t.Connect());
+	REQUIRE(t.Disconnect());
+	REQUIRE(cache.GetSessionStatistics().numCachedSessions > 0);
+
+	REQUIRE(cache.Reload());
+	REQUIRE(cache.GetSessionStatistics().numCachedSessions == 0);
+
+	REQUIRE(t.Connect());
+	REQUIRE(cache.GetSessionStatistics().numFullHandshakes == 4);
+	REQUIRE(cache.GetSessionStatistics().numResumedHandshakes == 0);
+	REQUIRE(t.Disconnect());
+}
+
+TEST_CASE(SUITE("Reloading a server rotates its ticket keys"))
+{
+	TestServerReloadForgetsSessions(true, 50013);
+}
+
+TEST_CASE(SUITE("Reloading a server forgets its session IDs"))
+{
+	TestServerReloadForgetsSessions(false, 50014);
+}
+
+#endif
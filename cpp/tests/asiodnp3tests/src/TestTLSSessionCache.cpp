@@ -0,0 +1,225 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <catch.hpp>
+
+#ifdef OPENDNP3_USE_TLS
+
+#include <asiopal/tls/TLSSessionCache.h>
+
+#include "mocks/TLSTestObject.h"
+
+#include <ctime>
+
+using namespace opendnp3;
+using namespace asiopal;
+
+#define SUITE(name) "TLSSessionCacheSuite - " name
+
+namespace
+{
+
+SSL_SESSION* NewSession(uint8_t id, long ageSeconds = 0, long timeoutSeconds = 3600)
+{
+	auto session = SSL_SESSION_new();
+	SSL_SESSION_set1_id(session, &id, 1);
+	SSL_SESSION_set_time(session, static_cast<long>(std::time(nullptr)) - ageSeconds);
+	SSL_SESSION_set_timeout(session, timeoutSeconds);
+	return session;
+}
+
+bool IsCached(TLSSessionCache& cache, const std::string& key)
+{
+	auto session = cache.Find(key);
+	SSL_SESSION_free(session);
+	return session != nullptr;
+}
+
+void TestResumption(bool useSessionTickets, uint16_t port)
+{
+	TLSTestFiles files("tls-session-cache");
+	auto config = files.GetConfig();
+	config.useSessionTickets = useSessionTickets;
+
+	TLSContextCache cache;
+	TLSTestObject t(cache, config, port);
+
+	// both sides record every handshake
+	REQUIRE(t.Connect());
+	REQUIRE(cache.GetSessionStatistics().numFullHandshakes == 2);
+	REQUIRE(cache.GetSessionStatistics().numResumedHandshakes == 0);
+	REQUIRE(t.Disconnect());
+
+	REQUIRE(t.Connect());
+	REQUIRE(cache.GetSessionStatistics().numFullHandshakes == 2);
+	REQUIRE(cache.GetSessionStatistics().numResumedHandshakes == 2);
+	REQUIRE(t.Disconnect());
+}
+
+}
+
+TEST_CASE(SUITE("Find returns a new reference to the stored session"))
+{
+	TLSSessionCache cache;
+	auto session = NewSession(1);
+	cache.Store("a", session);
+
+	auto found = cache.Find("a");
+	REQUIRE(found == session);
+	SSL_SESSION_free(found);
+
+	REQUIRE(cache.Find("b") == nullptr);
+	REQUIRE(cache.GetStatistics().numCachedSessions == 1);
+}
+
+TEST_CASE(SUITE("Store replaces the session under the same key"))
+{
+	TLSSessionCache cache;
+	cache.Store("a", NewSession(1));
+	auto replacement = NewSession(2);
+	cache.Store("a", replacement);
+
+	auto found = cache.Find("a");
+	REQUIRE(found == replacement);
+	SSL_SESSION_free(found);
+	REQUIRE(cache.GetStatistics().numCachedSessions == 1);
+}
+
+TEST_CASE(SUITE("A full cache evicts the least recently used session"))
+{
+	TLSSessionCache cache(2);
+	cache.Store("a", NewSession(1));
+	cache.Store("b", NewSession(2));
+
+	// using a makes b the least recently used
+	REQUIRE(IsCached(cache, "a"));
+	cache.Store("c", NewSession(3));
+
+	REQUIRE(cache.GetStatistics().numCachedSessions == 2);
+	REQUIRE_FALSE(IsCached(cache, "b"));
+	REQUIRE(IsCached(cache, "a"));
+	REQUIRE(IsCached(cache, "c"));
+
+	// now a is the least recently used
+	cache.Store("d", NewSession(4));
+	REQUIRE_FALSE(IsCached(cache, "a"));
+	REQUIRE(IsCached(cache, "c"));
+	REQUIRE(IsCached(cache, "d"));
+}
+
+TEST_CASE(SUITE("Expired sessions are dropped when found"))
+{
+	TLSSessionCache cache;
+	cache.Store("expired", NewSession(1, 100, 10));
+	cache.Store("current", NewSession(2, 100, 1000));
+	REQUIRE(cache.GetStatistics().numCachedSessions == 2);
+
+	REQUIRE(cache.Find("expired") == nullptr);
+	REQUIRE(cache.GetStatistics().numCachedSessions == 1);
+	REQUIRE(IsCached(cache, "current"));
+}
+
+TEST_CASE(SUITE("A cache with no capacity stores nothing"))
+{
+	TLSSessionCache cache(0);
+	cache.Store("a", NewSession(1));
+
+	REQUIRE(cache.GetStatistics().numCachedSessions == 0);
+	REQUIRE(cache.Find("a") == nullptr);
+}
+
+TEST_CASE(SUITE("Server contexts store, find, and remove session IDs in the cache"))
+{
+	TLSConfig config("", "", "");
+	config.useSessionTickets = false;
+
+	TLSSessionCache cache;
+	asio::ssl::context context(asio::ssl::context_base::sslv23_server);
+	cache.ConfigureServer(config, context);
+
+	auto ctx = context.native_handle();
+	auto ssl = SSL_new(ctx);
+
+	auto session = NewSession(7);
+	SSL_SESSION_up_ref(session);
+	REQUIRE(SSL_CTX_sess_get_new_cb(ctx)(ssl, session) == 1);
+	REQUIRE(cache.GetStatistics().numCachedSessions == 1);
+
+	const unsigned char id = 7;
+	int copy = 1;
+	auto found = SSL_CTX_sess_get_get_cb(ctx)(ssl, &id, 1, &copy);
+	REQUIRE(found == session);
+	REQUIRE(copy == 0);
+	SSL_SESSION_free(found);
+
+	const unsigned char unknown = 8;
+	REQUIRE(SSL_CTX_sess_get_get_cb(ctx)(ssl, &unknown, 1, &copy) == nullptr);
+
+	SSL_CTX_remove_session(ctx, session);
+	REQUIRE(cache.GetStatistics().numCachedSessions == 0);
+
+	SSL_SESSION_free(session);
+	SSL_free(ssl);
+}
+
+TEST_CASE(SUITE("Invalidate forgets the sessions of every context configured before it"))
+{
+	TLSConfig config("", "", "");
+	config.useSessionTickets = false;
+
+	TLSSessionCache cache;
+	asio::ssl::context stale(asio::ssl::context_base::sslv23_server);
+	cache.ConfigureServer(config, stale);
+
+	auto ssl = SSL_new(stale.native_handle());
+	REQUIRE(SSL_CTX_sess_get_new_cb(stale.native_handle())(ssl, NewSession(1)) == 1);
+	cache.Store("a", NewSession(2));
+	REQUIRE(cache.GetStatistics().numCachedSessions == 2);
+
+	cache.Invalidate();
+	REQUIRE(cache.GetStatistics().numCachedSessions == 0);
+
+	// OpenSSL keeps ownership of sessions the callback refuses
+	auto refused = NewSession(3);
+	REQUIRE(SSL_CTX_sess_get_new_cb(stale.native_handle())(ssl, refused) == 0);
+	SSL_SESSION_free(refused);
+	REQUIRE(cache.GetStatistics().numCachedSessions == 0);
+	SSL_free(ssl);
+
+	asio::ssl::context current(asio::ssl::context_base::sslv23_server);
+	cache.ConfigureServer(config, current);
+
+	ssl = SSL_new(current.native_handle());
+	REQUIRE(SSL_CTX_sess_get_new_cb(current.native_handle())(ssl, NewSession(4)) == 1);
+	REQUIRE(cache.GetStatistics().numCachedSessions == 1);
+	SSL_free(ssl);
+}
+
+TEST_CASE(SUITE("Reconnecting resumes the session from a ticket"))
+{
+	TestResumption(true, 50010);
+}
+
+TEST_CASE(SUITE("Reconnecting resumes the session from its ID"))
+{
+	TestResumption(false, 50011);
+}
+
+#endif
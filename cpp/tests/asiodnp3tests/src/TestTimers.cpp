@@ -24,6 +24,7 @@
 
 #include <asiopal/ASIOExecutor.h>
 #include <asiopal/IOServiceThreadPool.h>
+#include <asiopal/SingleThreadService.h>
 
 #include <opendnp3/LogLevels.h>
 
@@ -33,6 +34,8 @@
 #include <functional>
 #include <chrono>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 using namespace std;
 using namespace std::chrono;
@@ -174,4 +177,41 @@ TEST_CASE(SUITE("MultipleOutstanding"))
 	REQUIRE(1 ==  mth2.GetCount());
 }
 
+TEST_CASE(SUITE("StrandFreeExecutorRunsTimersAndPostsInOrder"))
+{
+	asio::io_service service;
+	SingleThreadService::Mark(service, std::this_thread::get_id());
+	ASIOExecutor exe(service);
+
+	REQUIRE(exe.strand.IsStrandFree());
+	REQUIRE(exe.strand.running_in_this_thread());
+
+	std::vector<int> order;
+	auto first = [&order]()
+	{
+		order.push_back(1);
+	};
+	auto second = [&order]()
+	{
+		order.push_back(2);
+	};
+	auto third = [&order]()
+	{
+		order.push_back(3);
+	};
+
+	exe.PostLambda(first);
+	exe.PostLambda(second);
+	exe.Start(TimeDuration::Milliseconds(1), Action0::Bind(third));
+
+	REQUIRE(3 == service.run());
+	REQUIRE((order == std::vector<int>({ 1, 2, 3 })));
+}
 
+TEST_CASE(SUITE("ExecutorUsesStrandOnUnmarkedService"))
+{
+	asio::io_service service;
+	ASIOExecutor exe(service);
+	REQUIRE_FALSE(exe.strand.IsStrandFree());
+	REQUIRE_FALSE(exe.strand.running_in_this_thread());
+}
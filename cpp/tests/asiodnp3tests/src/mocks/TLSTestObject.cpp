@@ -0,0 +1,183 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include "TLSTestObject.h"
+
+#ifdef OPENDNP3_USE_TLS
+
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+
+using namespace asiopal;
+
+namespace opendnp3
+{
+
+TLSTestFiles::TLSTestFiles(const std::string& name) :
+	certFilePath(name + "-cert.pem"),
+	keyFilePath(name + "-key.pem")
+{
+	this->Generate();
+}
+
+TLSTestFiles::~TLSTestFiles()
+{
+	std::remove(certFilePath.c_str());
+	std::remove(keyFilePath.c_str());
+}
+
+TLSConfig TLSTestFiles::GetConfig() const
+{
+	return TLSConfig(certFilePath, certFilePath, keyFilePath);
+}
+
+void TLSTestFiles::Generate()
+{
+	EVP_PKEY* key = nullptr;
+	auto keyContext = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+	EVP_PKEY_keygen_init(keyContext);
+	EVP_PKEY_CTX_set_ec_paramgen_curve_nid(keyContext, NID_X9_62_prime256v1);
+	EVP_PKEY_keygen(keyContext, &key);
+	EVP_PKEY_CTX_free(keyContext);
+
+	if (!key)
+	{
+		throw std::runtime_error("unable to generate a test key");
+	}
+
+	auto cert = X509_new();
+	X509_set_version(cert, 2);
+	ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+	X509_gmtime_adj(X509_getm_notBefore(cert), -3600);
+	X509_gmtime_adj(X509_getm_notAfter(cert), 24 * 3600);
+	X509_set_pubkey(cert, key);
+
+	auto subject = X509_get_subject_name(cert);
+	X509_NAME_add_entry_by_txt(subject, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("opendnp3 test"), -1, -1, 0);
+	X509_set_issuer_name(cert, subject);
+	X509_sign(cert, key, EVP_sha256());
+
+	auto certFile = BIO_new_file(certFilePath.c_str(), "w");
+	auto keyFile = BIO_new_file(keyFilePath.c_str(), "w");
+	const bool written = certFile && keyFile && PEM_write_bio_X509(certFile, cert) && PEM_write_bio_PrivateKey(keyFile, key, nullptr, nullptr, 0, nullptr, nullptr);
+	BIO_free(certFile);
+	BIO_free(keyFile);
+
+	X509_free(cert);
+	EVP_PKEY_free(key);
+
+	if (!written)
+	{
+		throw std::runtime_error("unable to write the test certificate");
+	}
+}
+
+void TLSTestFiles::Corrupt()
+{
+	std::ofstream file(certFilePath, std::ios::trunc);
+	file << "not a certificate";
+}
+
+TLSTestObject::TLSTestObject(TLSContextCache& cache, const TLSConfig& config, uint16_t port) :
+	TLSTestObject(cache, cache, config, port)
+{
+
+}
+
+TLSTestObject::TLSTestObject(TLSContextCache& clientCache, TLSContextCache& serverCache, const TLSConfig& config, uint16_t port) :
+	TestObjectASIO(),
+	log(),
+	serverService(),
+	client(log.root, this->GetService(), "127.0.0.1", "127.0.0.1", port, clientCache.Get(config, false)),
+	server(log.root, serverService, "127.0.0.1", port, serverCache.Get(config, true)),
+	clientAdapter(log.GetLogger(), &client, true),
+	serverAdapter(log.GetLogger(), &server, true),
+	serverWork(new asio::io_service::work(serverService))
+{
+	clientAdapter.SetUpperLayer(clientUpper);
+	serverAdapter.SetUpperLayer(serverUpper);
+
+	clientUpper.SetLowerLayer(clientAdapter);
+	serverUpper.SetLowerLayer(serverAdapter);
+
+	serverThread = std::thread([this]()
+	{
+		serverService.run();
+	});
+}
+
+TLSTestObject::~TLSTestObject()
+{
+	serverWork.reset();
+	serverService.stop();
+	serverThread.join();
+}
+
+bool TLSTestObject::Connect()
+{
+	this->OnServer([this]()
+	{
+		server.BeginOpen();
+	});
+	client.BeginOpen();
+	if (!(this->ProceedUntil(std::bind(&MockUpperLayer::IsOnline, &serverUpper)) &&
+	        this->ProceedUntil(std::bind(&MockUpperLayer::IsOnline, &clientUpper))))
+	{
+		return false;
+	}
+
+	// TLS 1.3 servers send their session tickets after the handshake, so wait until the client has read past them
+	static const uint8_t PING[] = { 0xC0 };
+	clientUpper.ClearBuffer();
+	this->OnServer([this]()
+	{
+		serverUpper.SendDown(openpal::RSlice(PING, sizeof(PING)));
+	});
+	return this->ProceedUntil(std::bind(&MockUpperLayer::SizeEquals, &clientUpper, sizeof(PING)));
+}
+
+bool TLSTestObject::Disconnect()
+{
+	client.BeginClose();
+	return this->ProceedUntilFalse(std::bind(&MockUpperLayer::IsOnline, &serverUpper)) &&
+	       this->ProceedUntilFalse(std::bind(&MockUpperLayer::IsOnline, &clientUpper));
+}
+
+void TLSTestObject::OnServer(const std::function<void ()>& action)
+{
+	std::promise<void> done;
+	serverService.post([&]()
+	{
+		action();
+		done.set_value();
+	});
+	done.get_future().wait();
+}
+
+}
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef __TLS_TEST_OBJECT_H_
+#define __TLS_TEST_OBJECT_H_
+
+#ifdef OPENDNP3_USE_TLS
+
+#include "TestObjectASIO.h"
+
+#include <dnp3mocks/MockUpperLayer.h>
+#include <dnp3mocks/LowerLayerToPhysAdapter.h>
+
+#include <testlib/MockLogHandler.h>
+
+#include <asiopal/tls/PhysicalLayerTLSClient.h>
+#include <asiopal/tls/PhysicalLayerTLSServer.h>
+#include <asiopal/tls/TLSContextCache.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace opendnp3
+{
+
+/**
+* A self-signed certificate and its private key, written to files that are removed on destruction
+*/
+class TLSTestFiles
+{
+public:
+	TLSTestFiles(const std::string& name);
+	~TLSTestFiles();
+
+	/// Presents this certificate, and only trusts peers that present it too
+	asiopal::TLSConfig GetConfig() const;
+
+	/// Replace the files with a new key and certificate
+	void Generate();
+
+	/// Overwrite the certificate with something that can't be loaded
+	void Corrupt();
+
+	const std::string certFilePath;
+	const std::string keyFilePath;
+};
+
+/**
+* A TLS client and server on the loopback interface whose contexts come from a TLSContextCache.
+*
+* The layers shut TLS down synchronously, waiting for the peer to answer, so the server runs on
+* its own thread while the test drives the client.
+*/
+class TLSTestObject : public TestObjectASIO
+{
+public:
+	TLSTestObject(asiopal::TLSContextCache& cache, const asiopal::TLSConfig& config, uint16_t port);
+	TLSTestObject(asiopal::TLSContextCache& clientCache, asiopal::TLSContextCache& serverCache, const asiopal::TLSConfig& config, uint16_t port);
+	~TLSTestObject();
+
+	/// Open both sides and wait until the client has read everything the server sent during the handshake
+	bool Connect();
+
+	bool Disconnect();
+
+	testlib::MockLogHandler log;
+
+	asio::io_service serverService;
+
+	asiopal::PhysicalLayerTLSClient client;
+	asiopal::PhysicalLayerTLSServer server;
+
+	LowerLayerToPhysAdapter clientAdapter;
+	LowerLayerToPhysAdapter serverAdapter;
+
+	MockUpperLayer clientUpper;
+	MockUpperLayer serverUpper;
+
+private:
+
+	// run an action on the server's thread and wait for it to complete
+	void OnServer(const std::function<void ()>& action);
+
+	std::unique_ptr<asio::io_service::work> serverWork;
+	std::thread serverThread;
+};
+
+}
+
+#endif
+
+#endif
@@ -48,9 +48,50 @@ class MockCommandHandler final : public SimpleCommandHandler
 {
 public:
 
-	MockCommandHandler(CommandStatus status = CommandStatus::SUCCESS) : SimpleCommandHandler(status)
+	MockCommandHandler(CommandStatus status = CommandStatus::SUCCESS) : SimpleCommandHandler(status), async(false)
 	{}
 
+	/// When async, operates are recorded as usual but their results are left to the test to complete via 'tokens'
+	void SetAsync(bool async_)
+	{
+		async = async_;
+	}
+
+	virtual bool IsAsync() override
+	{
+		return async;
+	}
+
+	virtual void BeginOperate(const ControlRelayOutputBlock& command, uint16_t index, OperateType opType, const OperateToken& token) override
+	{
+		this->Operate(command, index, opType);
+		tokens.push_back(token);
+	}
+
+	virtual void BeginOperate(const AnalogOutputInt16& command, uint16_t index, OperateType opType, const OperateToken& token) override
+	{
+		this->Operate(command, index, opType);
+		tokens.push_back(token);
+	}
+
+	virtual void BeginOperate(const AnalogOutputInt32& command, uint16_t index, OperateType opType, const OperateToken& token) override
+	{
+		this->Operate(command, index, opType);
+		tokens.push_back(token);
+	}
+
+	virtual void BeginOperate(const AnalogOutputFloat32& command, uint16_t index, OperateType opType, const OperateToken& token) override
+	{
+		this->Operate(command, index, opType);
+		tokens.push_back(token);
+	}
+
+	virtual void BeginOperate(const AnalogOutputDouble64& command, uint16_t index, OperateType opType, const OperateToken& token) override
+	{
+		this->Operate(command, index, opType);
+		tokens.push_back(token);
+	}
+
 	void SetResponse(CommandStatus status_)
 	{
 		status = status_;
@@ -106,6 +147,12 @@ public:
 	std::vector<Operation<AnalogOutputFloat32>> aoFloat32Ops;
 	std::vector<Operation<AnalogOutputDouble64>> aoDouble64Ops;
 
+	std::vector<OperateToken> tokens;
+
+private:
+
+	bool async;
+
 };
 
 }
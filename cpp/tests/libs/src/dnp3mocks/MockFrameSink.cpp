@@ -25,7 +25,7 @@ using namespace openpal;
 namespace opendnp3
 {
 
-MockFrameSink::MockFrameSink() : m_num_frames(0), mLowerOnline(false)
+MockFrameSink::MockFrameSink() : m_num_frames(0), m_num_tx_results(0), mLowerOnline(false)
 {}
 
 bool MockFrameSink::OnLowerLayerUp()
@@ -63,6 +63,7 @@ bool MockFrameSink::CheckLastWithDFC(LinkFunction func, bool isMaster, bool aIsR
 
 bool MockFrameSink::OnTransmitResult(bool success)
 {
+	++m_num_tx_results;
 	return true;
 }
 
@@ -59,6 +59,9 @@ public:
 	size_t m_num_frames;
 	LinkHeaderFields m_last_header;
 
+	// Number of transmit results received
+	size_t m_num_tx_results;
+
 	bool mLowerOnline;
 
 	// Add a function to execute the next time a frame is received
@@ -0,0 +1,65 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+std::atomic<bool> countAllocations(false);
+std::atomic<uint32_t> numAllocations(0);
+}
+
+void* operator new(std::size_t size)
+{
+	if (countAllocations)
+	{
+		++numAllocations;
+	}
+
+	auto pMemory = std::malloc(size ? size : 1);
+	if (!pMemory)
+	{
+		throw std::bad_alloc();
+	}
+	return pMemory;
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+namespace testlib
+{
+
+uint32_t CountAllocations(const std::function<void ()>& action)
+{
+	numAllocations = 0;
+	countAllocations = true;
+	action();
+	countAllocations = false;
+	return numAllocations;
+}
+
+}
@@ -0,0 +1,41 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#ifndef TESTLIB_ALLOCATION_COUNTER_H
+#define TESTLIB_ALLOCATION_COUNTER_H
+
+#include <cstdint>
+#include <functional>
+
+namespace testlib
+{
+
+/**
+	Run an action and count the calls it makes to the global operator new.
+
+	Using this links in replacements of the global operator new and delete for the whole
+	test binary. They forward to malloc and free and only count while an action runs.
+	Allocations made by other threads in the meantime are counted as well.
+*/
+uint32_t CountAllocations(const std::function<void ()>& action);
+
+}
+
+#endif
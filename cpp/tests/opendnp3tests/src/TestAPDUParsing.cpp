@@ -32,6 +32,7 @@
 #include <opendnp3/LogLevels.h>
 #include <opendnp3/app/parsing/APDUParser.h>
 #include <opendnp3/app/parsing/APDUHeaderParser.h>
+#include <opendnp3/app/parsing/HeaderIndex.h>
 #include <opendnp3/app/ControlRelayOutputBlock.h>
 #include <opendnp3/app/Indexed.h>
 
@@ -267,8 +268,37 @@ TEST_CASE(SUITE("ParserDoesNotAllowEmptyOctetStrings"))
 
 TEST_CASE(SUITE("Group1Var2CountWithIndexUInt8"))
 {
+	auto validator = [](MockApduHeaderHandler & mock)
+	{
+		// the mock collects all index prefixed binaries together
+		REQUIRE(1 == mock.eventBinaries.size());
+		Indexed<Binary> value(Binary(true), 9);
+		REQUIRE((value == mock.eventBinaries[0]));
+	};
+
 	// 1 byte count, 1 byte index, index == 09, value = 0x81
-	TestSimple("01 02 17 01 09 81", ParseResult::INVALID_OBJECT_QUALIFIER, 0);
+	TestComplex("01 02 17 01 09 81", ParseResult::OK, 1, validator);
+}
+
+TEST_CASE(SUITE("Group1Var1CountWithIndexIsRejected"))
+{
+	// packed bitfields can't be index prefixed
+	TestSimple("01 01 17 01 09 01", ParseResult::INVALID_OBJECT_QUALIFIER, 0);
+}
+
+TEST_CASE(SUITE("Group30Var1CountWithIndexUInt16"))
+{
+	auto validator = [](MockApduHeaderHandler & mock)
+	{
+		REQUIRE(2 == mock.eventAnalogs.size());
+		REQUIRE(mock.eventAnalogs[0].index == 0x0102);
+		REQUIRE(mock.eventAnalogs[0].value.value == 4);
+		REQUIRE(mock.eventAnalogs[1].index == 0x0300);
+		REQUIRE(mock.eventAnalogs[1].value.value == 5);
+	};
+
+	// 2 byte count, 2 byte index
+	TestComplex("1E 01 28 02 00 02 01 01 04 00 00 00 00 03 01 05 00 00 00", ParseResult::OK, 1, validator);
 }
 
 TEST_CASE(SUITE("Group2Var1CountWithAllIndexSizes"))
@@ -467,4 +497,42 @@ TEST_CASE(SUITE("Group43Var3CountWithAllIndexSizes"))
 	TestComplex("2B 03 28 01 00 09 00 01 32 00 00 00 88 6E D0 92 4A 01", ParseResult::OK, 1, validator);
 }
 
+TEST_CASE(SUITE("InvalidHeaderAfterValidHeadersDeliversNothing"))
+{
+	// two valid g1v2 headers, then (2,2) with unknown qualifier 0xAB
+	TestSimple("01 02 00 01 01 81 01 02 00 02 03 81 81 02 02 AB", ParseResult::UNKNOWN_QUALIFIER, 0);
+}
+
+std::string RepeatBinaryHeaders(uint32_t count)
+{
+	std::string hex;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		// g1v2, 1 byte start/stop i -> i, one value
+		uint8_t index = static_cast<uint8_t>(i);
+		hex += "01 02 00 " + ToHex(&index, 1) + " " + ToHex(&index, 1) + " 81 ";
+	}
+	return hex;
+}
+
+TEST_CASE(SUITE("HeadersBeyondIndexCapacityAreDeliveredInOrder"))
+{
+	const uint32_t NUM_HEADERS = HeaderIndex::MAX_HEADERS + 8;
 
+	TestComplex(RepeatBinaryHeaders(NUM_HEADERS), ParseResult::OK, NUM_HEADERS, [&](MockApduHeaderHandler & mock)
+	{
+		REQUIRE(NUM_HEADERS == mock.staticBinaries.size());
+		for (uint32_t i = 0; i < NUM_HEADERS; ++i)
+		{
+			REQUIRE(i == mock.records[i].headerIndex);
+			REQUIRE(i == mock.staticBinaries[i].index);
+		}
+	});
+}
+
+TEST_CASE(SUITE("InvalidHeaderBeyondIndexCapacityDeliversNothing"))
+{
+	const uint32_t NUM_HEADERS = HeaderIndex::MAX_HEADERS + 8;
+
+	TestSimple(RepeatBinaryHeaders(NUM_HEADERS) + "02 02 AB", ParseResult::UNKNOWN_QUALIFIER, 0);
+}
@@ -0,0 +1,140 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <catch.hpp>
+
+#include "mocks/MockAPDUHeaderHandler.h"
+
+#include <testlib/HexConversions.h>
+
+#include <openpal/serialization/Serialization.h>
+
+#include <opendnp3/app/BitfieldRangeWriteIterator.h>
+#include <opendnp3/app/parsing/APDUParser.h>
+#include <opendnp3/app/parsing/BitfieldCollection.h>
+
+#include <vector>
+
+using namespace std;
+using namespace openpal;
+using namespace opendnp3;
+using namespace testlib;
+
+#define SUITE(name) "BitfieldsTestSuite - " name
+
+// deterministic pattern that isn't periodic in 8 or 64
+bool PatternBit(uint32_t i)
+{
+	return ((i % 3) == 0) || ((i % 7) == 2);
+}
+
+// g1v1 object header with 2-byte start/stop followed by the bitfield
+vector<uint8_t> WriteBinaries(uint16_t start, uint32_t count)
+{
+	vector<uint8_t> buffer(3 + 4 + (count + 7) / 8 + 16, 0xFF);
+	buffer[0] = 0x01;
+	buffer[1] = 0x01;
+	buffer[2] = 0x01;
+
+	WSlice position(buffer.data() + 3, static_cast<uint32_t>(buffer.size() - 3));
+	{
+		BitfieldRangeWriteIterator<UInt16> iter(start, position);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			REQUIRE(iter.Write(PatternBit(i)));
+		}
+	}
+
+	buffer.resize(buffer.size() - position.Size());
+	return buffer;
+}
+
+TEST_CASE(SUITE("Writer packs values least significant bit first"))
+{
+	auto buffer = WriteBinaries(3, 10);
+	REQUIRE(ToHex(buffer.data(), buffer.size(), true) == "01 01 01 03 00 0C 00 4D 02");
+}
+
+TEST_CASE(SUITE("Writer and parser round trip across word boundaries"))
+{
+	for (uint32_t count = 1; count <= 200; ++count)
+	{
+		auto buffer = WriteBinaries(5, count);
+		REQUIRE(buffer.size() == 7 + (count + 7) / 8);
+
+		MockApduHeaderHandler handler;
+		REQUIRE(APDUParser::Parse(RSlice(buffer.data(), static_cast<uint32_t>(buffer.size())), handler, nullptr) == ParseResult::OK);
+		REQUIRE(handler.staticBinaries.size() == count);
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			REQUIRE(handler.staticBinaries[i].index == 5 + i);
+			REQUIRE(handler.staticBinaries[i].value.value == PatternBit(i));
+		}
+	}
+}
+
+TEST_CASE(SUITE("Writer stops at the end of the buffer"))
+{
+	uint8_t bytes[6] = { 0 };
+	WSlice position(bytes, 6);
+	{
+		BitfieldRangeWriteIterator<UInt16> iter(0, position);
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			REQUIRE(iter.Write(true));
+		}
+		REQUIRE_FALSE(iter.Write(true));
+	}
+	REQUIRE(ToHex(bytes, 6, true) == "00 00 0F 00 FF FF");
+	REQUIRE(position.Size() == 0);
+}
+
+TEST_CASE(SUITE("Double bit collection decodes across word boundaries"))
+{
+	const uint32_t COUNT = 70;
+
+	// each byte holds the states 0, 1, 2, 3 in order
+	vector<uint8_t> buffer((COUNT + 3) / 4, 0xE4);
+	BitfieldCollection<DoubleBitBinary, 2> collection(RSlice(buffer.data(), static_cast<uint32_t>(buffer.size())), 10, COUNT);
+
+	REQUIRE(collection.Count() == COUNT);
+
+	vector<Indexed<DoubleBitBinary>> visited;
+	collection.ForeachItem([&](const Indexed<DoubleBitBinary>& item)
+	{
+		visited.push_back(item);
+	});
+
+	REQUIRE(visited.size() == COUNT);
+	for (uint32_t i = 0; i < COUNT; ++i)
+	{
+		REQUIRE(visited[i].index == 10 + i);
+		REQUIRE(visited[i].value.value == DoubleBitFromType(static_cast<uint8_t>(i % 4)));
+	}
+
+	Indexed<DoubleBitBinary> values[COUNT];
+	REQUIRE(collection.ReadInto(values, 33) == 33);
+	REQUIRE(values[32].index == 42);
+	REQUIRE(values[32].value.value == DoubleBit::INTERMEDIATE);
+	REQUIRE(collection.ReadInto(values, 100) == COUNT);
+	REQUIRE(values[COUNT - 1].index == 10 + COUNT - 1);
+	REQUIRE(values[COUNT - 1].value.value == DoubleBit::DETERMINED_OFF);
+}
@@ -21,6 +21,9 @@
 #include <catch.hpp>
 
 #include <opendnp3/app/parsing/Collections.h>
+#include <opendnp3/app/parsing/BufferedCollection.h>
+
+#include <openpal/serialization/Serialization.h>
 
 #include <vector>
 
@@ -48,4 +51,76 @@ TEST_CASE(SUITE("Map integers to booleans"))
 	REQUIRE(items[2]);
 	REQUIRE(items[3]);
 
-}
\ No newline at end of file
+}
+
+TEST_CASE(SUITE("ReadInto copies an array collection up to the limit"))
+{
+	int values[4] = { 1, 2, 3, 4 };
+	ArrayCollection<int> collection(values, 4);
+
+	int output[4] = { 0, 0, 0, 0 };
+	REQUIRE(collection.ReadInto(output, 3) == 3);
+	REQUIRE(output[0] == 1);
+	REQUIRE(output[2] == 3);
+	REQUIRE(output[3] == 0);
+
+	REQUIRE(collection.ReadInto(output, 10) == 4);
+	REQUIRE(output[3] == 4);
+}
+
+TEST_CASE(SUITE("ReadInto decodes a buffered collection"))
+{
+	uint8_t bytes[4] = { 0x01, 0x00, 0xFF, 0x00 };
+	openpal::RSlice buffer(bytes, 4);
+
+	auto read = [](openpal::RSlice & buffer, uint32_t pos) -> uint16_t
+	{
+		return openpal::UInt16::ReadBuffer(buffer);
+	};
+
+	auto collection = CreateBufferedCollection<uint16_t>(buffer, 2, read);
+
+	uint16_t output[3] = { 0, 0, 0 };
+	REQUIRE(collection.ReadInto(output, 3) == 2);
+	REQUIRE(output[0] == 1);
+	REQUIRE(output[1] == 255);
+	REQUIRE(output[2] == 0);
+
+	REQUIRE(collection.ReadInto(output, 1) == 1);
+}
+
+TEST_CASE(SUITE("ReadInto on a mapped collection applies the transform"))
+{
+	int values[4] = { 1, 2, 3, 4 };
+	ArrayCollection<int> collectionInt(values, 4);
+	auto greaterThanTwo = [](const int & x) -> bool { return x > 2; };
+	auto collectionBool = Map<int, bool>(collectionInt, greaterThanTwo);
+
+	bool output[4] = { true, true, false, false };
+	REQUIRE(collectionBool.ReadInto(output, 4) == 4);
+	REQUIRE_FALSE(output[0]);
+	REQUIRE_FALSE(output[1]);
+	REQUIRE(output[2]);
+	REQUIRE(output[3]);
+}
+
+TEST_CASE(SUITE("ReadInto on a same-type mapped collection decodes in bulk and transforms in place"))
+{
+	uint8_t bytes[6] = { 0x01, 0x00, 0x02, 0x00, 0x03, 0x00 };
+	openpal::RSlice buffer(bytes, 6);
+
+	auto read = [](openpal::RSlice & buffer, uint32_t pos) -> uint16_t
+	{
+		return openpal::UInt16::ReadBuffer(buffer);
+	};
+
+	auto collection = CreateBufferedCollection<uint16_t>(buffer, 3, read);
+	auto addOffset = [](const uint16_t& x) -> uint16_t { return x + 100; };
+	auto adjusted = Map<uint16_t, uint16_t>(collection, addOffset);
+
+	uint16_t output[3] = { 0, 0, 0 };
+	REQUIRE(adjusted.ReadInto(output, 2) == 2);
+	REQUIRE(output[0] == 101);
+	REQUIRE(output[1] == 102);
+	REQUIRE(output[2] == 0);
+}
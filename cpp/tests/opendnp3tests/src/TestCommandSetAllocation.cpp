@@ -0,0 +1,173 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <catch.hpp>
+
+#include <opendnp3/master/CommandSet.h>
+#include <opendnp3/master/CommandSetOps.h>
+#include <opendnp3/master/CommandTask.h>
+#include <opendnp3/app/APDURequest.h>
+
+#include <openpal/container/StaticBuffer.h>
+
+#include <testlib/AllocationCounter.h>
+#include <testlib/MockLogHandler.h>
+
+#include <memory>
+
+using namespace opendnp3;
+using namespace openpal;
+using namespace testlib;
+
+namespace
+{
+class NullApplication final : public IMasterApplication
+{
+	virtual UTCTimestamp Now() override
+	{
+		return UTCTimestamp();
+	}
+};
+}
+
+#define SUITE(name) "CommandSetAllocationTestSuite - " name
+
+TEST_CASE(SUITE("Building and moving a small command set allocates one header block"))
+{
+	ControlRelayOutputBlock crob(ControlCode::PULSE_ON);
+	AnalogOutputDouble64 ao(3.14);
+
+	auto count = CountAllocations([&]()
+	{
+		CommandSet commands;
+		commands.Add<ControlRelayOutputBlock>({ WithIndex(crob, 1), WithIndex(crob, 2), WithIndex(crob, 3), WithIndex(crob, 4) });
+		commands.Add<AnalogOutputDouble64>({ WithIndex(ao, 5) });
+
+		CommandSet moved(std::move(commands));
+		CommandSet again(std::move(moved));
+	});
+
+	REQUIRE(count == 1);
+}
+
+TEST_CASE(SUITE("Header references remain valid after the set is moved"))
+{
+	ControlRelayOutputBlock crob(ControlCode::PULSE_ON);
+	AnalogOutputInt16 ao(7);
+
+	CommandSet commands;
+	auto& crobs = commands.StartHeader<ControlRelayOutputBlock>();
+	auto& aos = commands.StartHeader<AnalogOutputInt16>();
+
+	CommandSet moved(std::move(commands));
+	crobs.Add(crob, 1).Add(crob, 2);
+	aos.Add(ao, 3);
+
+	std::vector<CommandPointResult> results;
+	CommandCallbackT callback = [&results](const ICommandTaskResult & result)
+	{
+		result.ForeachItem([&results](const CommandPointResult & item)
+		{
+			results.push_back(item);
+		});
+	};
+
+	CommandSetOps::InvokeCallback(moved, TaskCompletion::SUCCESS, callback);
+
+	REQUIRE(results.size() == 3);
+	REQUIRE(results[0].headerIndex == 0);
+	REQUIRE(results[0].index == 1);
+	REQUIRE(results[1].headerIndex == 0);
+	REQUIRE(results[1].index == 2);
+	REQUIRE(results[2].headerIndex == 1);
+	REQUIRE(results[2].index == 3);
+}
+
+TEST_CASE(SUITE("A direct operate allocates only the task and the header block"))
+{
+	testlib::MockLogHandler log(0); // formatting log messages would allocate
+	auto logger = log.GetLogger();
+	NullApplication app;
+	StaticBuffer<2048> buffer;
+	ControlRelayOutputBlock crob(ControlCode::PULSE_ON);
+
+	uint32_t numCallbacks = 0;
+	bool built = false;
+	auto result = IMasterTask::ResponseResult::ERROR_BAD_RESPONSE;
+
+	CommandCallbackT callback = [&numCallbacks](const ICommandTaskResult & result)
+	{
+		++numCallbacks;
+	};
+
+	auto count = CountAllocations([&]()
+	{
+		std::unique_ptr<IMasterTask> task(CommandTask::FDirectOperate(CommandSet({ WithIndex(crob, 1), WithIndex(crob, 2) }), app, callback, TaskConfig::Default(), logger));
+		task->OnStart();
+
+		APDURequest request(buffer.GetWSlice());
+		built = task->BuildRequest(request, 0);
+
+		// the outstation echoes the objects of a successful DIRECT_OPERATE
+		auto objects = request.ToRSlice().Skip(APDU_REQUEST_HEADER_SIZE);
+		APDUResponseHeader response(AppControlField(true, true, false, false, 0), IINField::Empty());
+		result = task->OnResponse(response, objects, MonotonicTimestamp(0));
+	});
+
+	REQUIRE(built);
+	REQUIRE(result == IMasterTask::ResponseResult::OK_FINAL);
+	REQUIRE(numCallbacks == 1);
+	REQUIRE(count == 2);
+}
+
+TEST_CASE(SUITE("Sets larger than the inline capacity keep every header and command"))
+{
+	ControlRelayOutputBlock crob(ControlCode::LATCH_ON);
+
+	CommandSet commands;
+	for (uint16_t header = 0; header < 6; ++header)
+	{
+		auto& collection = commands.StartHeader<ControlRelayOutputBlock>();
+		for (uint16_t i = 0; i < 6; ++i)
+		{
+			collection.Add(crob, header * 6 + i);
+		}
+	}
+
+	CommandSet moved(std::move(commands));
+
+	std::vector<CommandPointResult> results;
+	CommandCallbackT callback = [&results](const ICommandTaskResult & result)
+	{
+		result.ForeachItem([&results](const CommandPointResult & item)
+		{
+			results.push_back(item);
+		});
+	};
+
+	CommandSetOps::InvokeCallback(moved, TaskCompletion::SUCCESS, callback);
+
+	REQUIRE(results.size() == 36);
+	for (uint32_t i = 0; i < results.size(); ++i)
+	{
+		REQUIRE(results[i].headerIndex == i / 6);
+		REQUIRE(results[i].index == i);
+	}
+}
@@ -0,0 +1,156 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <catch.hpp>
+
+#include <opendnp3/app/AppConstants.h>
+#include <opendnp3/app/FragmentBuffer.h>
+#include <opendnp3/app/FragmentBufferPool.h>
+#include <opendnp3/app/TxBuffer.h>
+
+#include <testlib/BufferHelpers.h>
+#include <testlib/HexConversions.h>
+
+using namespace openpal;
+using namespace opendnp3;
+using namespace testlib;
+
+#define SUITE(name) "FragmentBufferTestSuite - " name
+
+TEST_CASE(SUITE("PoolRoundsUpToPowerOfTwoClasses"))
+{
+	REQUIRE(FragmentBufferPool::BlockSize(1) == 2048);
+	REQUIRE(FragmentBufferPool::BlockSize(4097) == 8192);
+	REQUIRE(FragmentBufferPool::BlockSize(65536) == 65536);
+	REQUIRE(FragmentBufferPool::BlockSize(65537) == 65537);
+}
+
+TEST_CASE(SUITE("PoolReusesReleasedBlocks"))
+{
+	auto leased = FragmentBufferPool::NumLeased();
+
+	auto block = FragmentBufferPool::Lease(65536);
+	REQUIRE(FragmentBufferPool::NumLeased() == leased + 1);
+	FragmentBufferPool::Release(block, 65536);
+	REQUIRE(FragmentBufferPool::NumLeased() == leased);
+
+	REQUIRE(FragmentBufferPool::Lease(65536) == block);
+	FragmentBufferPool::Release(block, 65536);
+}
+
+TEST_CASE(SUITE("DefaultSizedBufferNeverLeases"))
+{
+	FragmentBuffer buffer(DEFAULT_MAX_APDU_SIZE);
+	REQUIRE(buffer.Capacity() == DEFAULT_MAX_APDU_SIZE);
+	REQUIRE_FALSE(buffer.CanGrow());
+	REQUIRE_FALSE(buffer.Grow(0));
+	REQUIRE_FALSE(buffer.IsLeased());
+}
+
+TEST_CASE(SUITE("LargeBufferLeasesOnlyWhenGrown"))
+{
+	auto leased = FragmentBufferPool::NumLeased();
+
+	{
+		FragmentBuffer buffer(65536);
+		REQUIRE(buffer.Capacity() == DEFAULT_MAX_APDU_SIZE);
+		REQUIRE(FragmentBufferPool::NumLeased() == leased);
+
+		HexSequence hex("01 02 03");
+		auto dest = buffer.GetWSlice();
+		hex.ToRSlice().CopyTo(dest);
+
+		REQUIRE(buffer.Grow(3));
+		REQUIRE(buffer.Capacity() == 65536);
+		REQUIRE(FragmentBufferPool::NumLeased() == leased + 1);
+		REQUIRE(ToHex(buffer.ToRSlice().Take(3)) == "01 02 03");
+
+		REQUIRE(buffer.Shrink(2));
+		REQUIRE(FragmentBufferPool::NumLeased() == leased);
+		REQUIRE(ToHex(buffer.ToRSlice().Take(2)) == "01 02");
+
+		REQUIRE(buffer.Grow(0));
+	}
+
+	// the destructor returns the lease
+	REQUIRE(FragmentBufferPool::NumLeased() == leased);
+}
+
+TEST_CASE(SUITE("ShrinkKeepsLeaseIfContentsDontFit"))
+{
+	FragmentBuffer buffer(65536);
+	REQUIRE(buffer.Grow(0));
+	REQUIRE_FALSE(buffer.Shrink(DEFAULT_MAX_APDU_SIZE + 1));
+	REQUIRE(buffer.IsLeased());
+	REQUIRE(buffer.Shrink(0));
+}
+
+TEST_CASE(SUITE("PoolAllBufferHoldsNothingWhileIdle"))
+{
+	auto leased = FragmentBufferPool::NumLeased();
+
+	FragmentBuffer buffer(DEFAULT_MAX_APDU_SIZE, true);
+	REQUIRE(buffer.Capacity() == 0);
+	REQUIRE(buffer.CanGrow());
+
+	REQUIRE(buffer.Grow(0));
+	REQUIRE(buffer.Capacity() == DEFAULT_MAX_APDU_SIZE);
+	REQUIRE(FragmentBufferPool::NumLeased() == leased + 1);
+
+	REQUIRE_FALSE(buffer.Shrink(1));
+	REQUIRE(buffer.Shrink(0));
+	REQUIRE(buffer.Capacity() == 0);
+	REQUIRE(FragmentBufferPool::NumLeased() == leased);
+}
+
+TEST_CASE(SUITE("PoolAllTxBufferLeasesOnStart"))
+{
+	auto leased = FragmentBufferPool::NumLeased();
+
+	TxBuffer tx(DEFAULT_MAX_APDU_SIZE, true);
+	auto response = tx.Start();
+	REQUIRE(response.Remaining() == DEFAULT_MAX_APDU_SIZE - 4);
+	REQUIRE(FragmentBufferPool::NumLeased() == leased + 1);
+
+	tx.Trim(false);
+	REQUIRE(FragmentBufferPool::NumLeased() == leased);
+}
+
+TEST_CASE(SUITE("TxBufferGrowContinuesPartialResponse"))
+{
+	TxBuffer tx(65536);
+	auto response = tx.Start();
+	response.SetFunction(FunctionCode::RESPONSE);
+	response.SetControl(AppControlField(true, true, false, false, 0));
+	auto writer = response.GetWriter();
+	REQUIRE(writer.WriteHeader(GroupVariationID(60, 1), QualifierCode::ALL_OBJECTS));
+	REQUIRE(response.Remaining() == DEFAULT_MAX_APDU_SIZE - 7);
+
+	response = tx.Grow(response);
+	REQUIRE(response.Remaining() == 65536 - 7);
+	writer = response.GetWriter();
+	REQUIRE(writer.WriteHeader(GroupVariationID(60, 2), QualifierCode::ALL_OBJECTS));
+
+	REQUIRE(ToHex(response.ToRSlice()) == "C0 81 00 00 3C 01 06 3C 02 06");
+
+	tx.Record(response.ToRSlice());
+	tx.Trim(true);
+	REQUIRE(ToHex(tx.GetLastResponse()) == "C0 81 00 00 3C 01 06 3C 02 06");
+}
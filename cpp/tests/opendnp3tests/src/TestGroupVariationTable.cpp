@@ -0,0 +1,81 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <catch.hpp>
+
+#include <opendnp3/app/GroupVariationRecord.h>
+#include <opendnp3/objects/Group12.h>
+#include <opendnp3/objects/Group30.h>
+#include <opendnp3/objects/Group50.h>
+
+using namespace opendnp3;
+
+#define SUITE(name) "GroupVariationTableTestSuite - " name
+
+TEST_CASE(SUITE("Table agrees with the enumeration for every group and variation"))
+{
+	for (uint32_t group = 0; group < 256; ++group)
+	{
+		for (uint32_t variation = 0; variation < 256; ++variation)
+		{
+			auto expected = GroupVariationFromType(GroupVariationRecord::GetGroupVar(group, variation));
+			if (expected == GroupVariation::UNKNOWN && group >= 110 && group <= 113)
+			{
+				expected = GroupVariationFromType(GroupVariationRecord::GetGroupVar(group, 0));
+			}
+
+			REQUIRE(LookupGroupVariation(group, variation).enumeration == expected);
+		}
+	}
+}
+
+TEST_CASE(SUITE("Types are assigned per group with variation specific exceptions"))
+{
+	REQUIRE(GroupVariationRecord::GetType(1, 2) == GroupVariationType::STATIC);
+	REQUIRE(GroupVariationRecord::GetType(2, 1) == GroupVariationType::EVENT);
+	REQUIRE(GroupVariationRecord::GetType(12, 1) == GroupVariationType::OTHER);
+	REQUIRE(GroupVariationRecord::GetType(50, 1) == GroupVariationType::OTHER);
+	REQUIRE(GroupVariationRecord::GetType(50, 4) == GroupVariationType::STATIC);
+	REQUIRE(GroupVariationRecord::GetType(60, 1) == GroupVariationType::STATIC);
+	REQUIRE(GroupVariationRecord::GetType(60, 3) == GroupVariationType::EVENT);
+	REQUIRE(GroupVariationRecord::GetType(60, 200) == GroupVariationType::EVENT);
+	REQUIRE(GroupVariationRecord::GetType(110, 10) == GroupVariationType::STATIC);
+	REQUIRE(GroupVariationRecord::GetType(113, 10) == GroupVariationType::OTHER);
+	REQUIRE(GroupVariationRecord::GetType(30, 99) == GroupVariationType::STATIC);
+	REQUIRE(GroupVariationRecord::GetType(255, 255) == GroupVariationType::OTHER);
+}
+
+TEST_CASE(SUITE("Octet string variations resolve to variation zero"))
+{
+	auto record = GroupVariationRecord::GetRecord(111, 7);
+	REQUIRE(record.enumeration == GroupVariation::Group111Var0);
+	REQUIRE(record.type == GroupVariationType::EVENT);
+	REQUIRE(record.variation == 7);
+}
+
+TEST_CASE(SUITE("Fixed sizes match the object serializers"))
+{
+	REQUIRE(LookupGroupVariation(12, 1).size == Group12Var1::Size());
+	REQUIRE(LookupGroupVariation(30, 1).size == Group30Var1::Size());
+	REQUIRE(LookupGroupVariation(30, 6).size == Group30Var6::Size());
+	REQUIRE(LookupGroupVariation(50, 4).size == Group50Var4::Size());
+	REQUIRE(LookupGroupVariation(1, 1).size == 0);
+	REQUIRE(LookupGroupVariation(120, 1).size == 0);
+}
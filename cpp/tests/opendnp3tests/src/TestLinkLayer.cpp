@@ -21,6 +21,8 @@
 #include <catch.hpp>
 
 #include <opendnp3/ErrorCodes.h>
+#include <opendnp3/app/FragmentBufferPool.h>
+#include <opendnp3/link/LinkLayerConstants.h>
 
 #include <openpal/util/ToHex.h>
 
@@ -248,6 +250,50 @@ TEST_CASE(SUITE("SendUnconfirmed"))
 }
 
 
+TEST_CASE(SUITE("SendUnconfirmedMultiFrameInOneTransmission"))
+{
+	LinkLayerTest t;
+	t.link.OnLowerLayerUp();
+	auto leased = FragmentBufferPool::NumLeased();
+
+	BufferSegment segments(10, IncrementHex(0, 30));
+	t.link.Send(segments);
+	REQUIRE(t.NumTotalWrites() == 1);
+	REQUIRE(FragmentBufferPool::NumLeased() == leased + 1);
+
+	auto expected = LinkHex::UnconfirmedUserData(true, 1024, 1, IncrementHex(0, 10)) + " " +
+	                LinkHex::UnconfirmedUserData(true, 1024, 1, IncrementHex(10, 10)) + " " +
+	                LinkHex::UnconfirmedUserData(true, 1024, 1, IncrementHex(20, 10));
+	REQUIRE(t.PopLastWriteAsHex() == expected);
+
+	t.link.OnTransmitResult(true);
+	REQUIRE(t.exe.RunMany() > 0);
+	REQUIRE(t.upper.GetState().successCnt == 1);
+	REQUIRE(t.NumTotalWrites() == 1);
+	REQUIRE(FragmentBufferPool::NumLeased() == leased);
+}
+
+TEST_CASE(SUITE("SendUnconfirmedSplitsBatchesAtMaxSize"))
+{
+	LinkLayerTest t;
+	t.link.OnLowerLayerUp();
+
+	// 7 full frames fill a batch
+	BufferSegment segments(250, IncrementHex(0, 8 * 250));
+	t.link.Send(segments);
+	REQUIRE(t.NumTotalWrites() == 1);
+	REQUIRE(t.PopLastWriteAsHex().size() == (3 * LPDU_MAX_BATCH_SIZE - 1));
+	t.link.OnTransmitResult(true);
+
+	REQUIRE(t.NumTotalWrites() == 2);
+	REQUIRE(t.PopLastWriteAsHex() == LinkHex::UnconfirmedUserData(true, 1024, 1, IncrementHex(static_cast<uint8_t>(7 * 250), 250)));
+	t.link.OnTransmitResult(true);
+
+	REQUIRE(t.exe.RunMany() > 0);
+	REQUIRE(t.upper.GetState().successCnt == 1);
+	REQUIRE(t.NumTotalWrites() == 2);
+}
+
 TEST_CASE(SUITE("CloseBehavior"))
 {
 	LinkLayerTest t;
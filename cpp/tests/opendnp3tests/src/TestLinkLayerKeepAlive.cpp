@@ -166,3 +166,70 @@ TEST_CASE(SUITE("KeepAliveIsPeriodicOnSuccess"))
 
 
 
+TEST_CASE(SUITE("SharedSchedulerSweepsSessionsDueInTheSameWindowTogether"))
+{
+	LinkConfig config(true, false);
+	config.KeepAliveTimeout = TimeDuration::Seconds(5);
+	LinkLayerTest t(config);
+
+	LinkKeepAliveScheduler keepAlives(t.exe, TimeDuration::Seconds(1));
+	t.link.SetKeepAliveScheduler(keepAlives);
+
+	// a second session on the same executor
+	LinkConfig config2(config);
+	config2.RemoteAddr = 2;
+	MockLinkListener listener2;
+	MockTransportLayer upper2;
+	LinkLayer link2(t.log.root.GetLogger(), t.exe, upper2, listener2, config2);
+	upper2.SetLinkLayer(link2);
+	link2.SetRouter(t);
+	link2.SetKeepAliveScheduler(keepAlives);
+
+	// both fall due between 5 and 6 seconds
+	t.exe.AdvanceTime(TimeDuration::Milliseconds(200));
+	t.link.OnLowerLayerUp();
+	t.exe.AdvanceTime(TimeDuration::Milliseconds(300));
+	link2.OnLowerLayerUp();
+
+	REQUIRE(keepAlives.NumSessions() == 2);
+	REQUIRE(t.exe.NumPendingTimers() == 1);
+
+	REQUIRE(t.exe.AdvanceToNextTimer());
+	REQUIRE(t.exe.RunMany() > 0);
+
+	REQUIRE(keepAlives.NumSweeps() == 1);
+	REQUIRE(t.listener.numKeepAliveTransmissions == 1);
+	REQUIRE(listener2.numKeepAliveTransmissions == 1);
+	REQUIRE(t.NumTotalWrites() == 2);
+
+	t.link.OnLowerLayerDown();
+	REQUIRE(keepAlives.NumSessions() == 1);
+	link2.OnLowerLayerDown();
+	REQUIRE(keepAlives.NumSessions() == 0);
+	REQUIRE(t.exe.NumPendingTimers() == 0);
+}
+
+TEST_CASE(SUITE("SharedSchedulerSkipsSessionsWithRecentTraffic"))
+{
+	LinkConfig config(true, false);
+	config.KeepAliveTimeout = TimeDuration::Seconds(5);
+	LinkLayerTest t(config);
+
+	LinkKeepAliveScheduler keepAlives(t.exe, TimeDuration::Seconds(1));
+	t.link.SetKeepAliveScheduler(keepAlives);
+
+	t.link.OnLowerLayerUp();
+	t.exe.AdvanceTime(TimeDuration::Seconds(3));
+	t.OnFrame(LinkFunction::PRI_UNCONFIRMED_USER_DATA, false, false, false, 1, 1024, RSlice::Empty());
+
+	// the first sweep finds the session quiet for only 2 seconds and waits for the rest
+	REQUIRE(t.exe.AdvanceToNextTimer());
+	REQUIRE(t.exe.RunMany() > 0);
+	REQUIRE(keepAlives.NumSweeps() == 1);
+	REQUIRE(t.listener.numKeepAliveTransmissions == 0);
+	REQUIRE(t.exe.NumPendingTimers() == 1);
+
+	REQUIRE(t.exe.AdvanceToNextTimer());
+	REQUIRE(t.exe.RunMany() > 0);
+	REQUIRE(t.listener.numKeepAliveTransmissions == 1);
+}
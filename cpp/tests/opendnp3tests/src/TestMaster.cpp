@@ -30,6 +30,7 @@
 
 #include <opendnp3/app/APDUResponse.h>
 #include <opendnp3/app/APDUBuilders.h>
+#include <opendnp3/app/FragmentBufferPool.h>
 
 using namespace openpal;
 using namespace opendnp3;
@@ -77,6 +78,23 @@ TEST_CASE(SUITE("SolicitedResponseWithData"))
 	REQUIRE((Binary(true, 0x01) == t.meas.binarySOE[2].meas));
 }
 
+TEST_CASE(SUITE("PoolAllFragmentBuffersReleasesTxAfterSend"))
+{
+	MasterParams params;
+	params.disableUnsolOnStartup = false;
+	params.poolAllFragmentBuffers = true;
+	MasterTestObject t(params);
+	auto leased = FragmentBufferPool::NumLeased();
+	t.context.OnLowerLayerUp();
+
+	t.exe.RunMany();
+
+	REQUIRE(t.lower.PopWriteAsHex() == hex::IntegrityPoll(0));
+	REQUIRE(FragmentBufferPool::NumLeased() == leased + 1);
+	t.context.OnSendResult(true);
+	REQUIRE(FragmentBufferPool::NumLeased() == leased);
+}
+
 TEST_CASE(SUITE("UnsolDisableEnableOnStartup"))
 {
 	MasterParams params;
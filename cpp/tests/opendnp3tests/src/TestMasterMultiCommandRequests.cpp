@@ -142,3 +142,128 @@ TEST_CASE(SUITE("SelectAndOperateTwoCROBSOneAO"))
 	        ));
 }
 
+
+std::string CROBHeader(uint8_t index)
+{
+	// Group 12 Var1, 2 byte count/index, count = 1, pulse on, time on/off = 100, CommandStatus::SUCCESS
+	return "0C 01 28 01 00 " + testlib::ByteToHex(index) + " 00 01 01 64 00 00 00 64 00 00 00 00";
+}
+
+TEST_CASE(SUITE("DirectOperatesWaitingToStartAreCoalescedIntoOneRequest"))
+{
+	// Group 41 Var2 - index 8, value 0x1234
+	std::string aostr = "29 02 28 01 00 08 00 34 12 00";
+
+	auto params = NoStartupTasks();
+	params.coalesceDirectOperate = true;
+	MasterTestObject t(params);
+	t.context.OnLowerLayerUp();
+
+	ControlRelayOutputBlock crob(ControlCode::PULSE_ON);
+	AnalogOutputInt16 ao(0x1234);
+
+	CommandCallbackQueue queue1;
+	CommandCallbackQueue queue2;
+	CommandCallbackQueue queue3;
+
+	t.context.DirectOperate(CommandSet({ WithIndex(crob, 1) }), queue1.Callback(), TaskConfig::Default());
+	REQUIRE(t.lower.PopWriteAsHex() == "C0 05 " + CROBHeader(1));
+	t.context.OnSendResult(true);
+
+	// these can't start until the first completes
+	t.context.DirectOperate(CommandSet({ WithIndex(crob, 2) }), queue2.Callback(), TaskConfig::Default());
+	t.context.DirectOperate(CommandSet({ WithIndex(ao, 8) }), queue3.Callback(), TaskConfig::Default());
+	REQUIRE(t.lower.PopWriteAsHex() == "");
+
+	t.SendToMaster("C0 81 00 00 " + CROBHeader(1));
+	t.exe.RunMany();
+
+	std::string coalesced = CROBHeader(2) + " " + aostr;
+	REQUIRE(t.lower.PopWriteAsHex() == "C1 05 " + coalesced);
+	t.context.OnSendResult(true);
+	t.SendToMaster("C1 81 00 00 " + coalesced);
+	t.exe.RunMany();
+
+	REQUIRE(t.lower.PopWriteAsHex() == "");
+
+	REQUIRE(queue1.PopOnlyEqualValue(TaskCompletion::SUCCESS, CommandPointResult(0, 1, CommandPointState::SUCCESS, CommandStatus::SUCCESS)));
+	REQUIRE(queue2.PopOnlyEqualValue(TaskCompletion::SUCCESS, CommandPointResult(0, 2, CommandPointState::SUCCESS, CommandStatus::SUCCESS)));
+	REQUIRE(queue3.PopOnlyEqualValue(TaskCompletion::SUCCESS, CommandPointResult(0, 8, CommandPointState::SUCCESS, CommandStatus::SUCCESS)));
+}
+
+TEST_CASE(SUITE("DirectOperatesAreNotCoalescedAcrossASelectAndOperate"))
+{
+	auto params = NoStartupTasks();
+	params.coalesceDirectOperate = true;
+	MasterTestObject t(params);
+	t.context.OnLowerLayerUp();
+
+	ControlRelayOutputBlock crob(ControlCode::PULSE_ON);
+
+	CommandCallbackQueue queue;
+
+	t.context.DirectOperate(CommandSet({ WithIndex(crob, 1) }), queue.Callback(), TaskConfig::Default());
+	REQUIRE(t.lower.PopWriteAsHex() == "C0 05 " + CROBHeader(1));
+	t.context.OnSendResult(true);
+
+	// queued behind the first, the last direct operate must not overtake the select and operate
+	t.context.DirectOperate(CommandSet({ WithIndex(crob, 2) }), queue.Callback(), TaskConfig::Default());
+	t.context.SelectAndOperate(CommandSet({ WithIndex(crob, 3) }), queue.Callback(), TaskConfig::Default());
+	t.context.DirectOperate(CommandSet({ WithIndex(crob, 4) }), queue.Callback(), TaskConfig::Default());
+	REQUIRE(t.lower.PopWriteAsHex() == "");
+
+	t.SendToMaster("C0 81 00 00 " + CROBHeader(1));
+	t.exe.RunMany();
+
+	REQUIRE(t.lower.PopWriteAsHex() == "C1 05 " + CROBHeader(2));
+	t.context.OnSendResult(true);
+	t.SendToMaster("C1 81 00 00 " + CROBHeader(2));
+	t.exe.RunMany();
+
+	REQUIRE(t.lower.PopWriteAsHex() == "C2 03 " + CROBHeader(3));
+	t.context.OnSendResult(true);
+	t.SendToMaster("C2 81 00 00 " + CROBHeader(3));
+	t.exe.RunMany();
+
+	REQUIRE(t.lower.PopWriteAsHex() == "C3 04 " + CROBHeader(3));
+	t.context.OnSendResult(true);
+	t.SendToMaster("C3 81 00 00 " + CROBHeader(3));
+	t.exe.RunMany();
+
+	REQUIRE(t.lower.PopWriteAsHex() == "C4 05 " + CROBHeader(4));
+	t.context.OnSendResult(true);
+	t.SendToMaster("C4 81 00 00 " + CROBHeader(4));
+	t.exe.RunMany();
+
+	REQUIRE(t.lower.PopWriteAsHex() == "");
+	REQUIRE(queue.values.size() == 4);
+}
+
+TEST_CASE(SUITE("CoalescingRespectsMaxControlsPerRequest"))
+{
+	auto params = NoStartupTasks();
+	params.coalesceDirectOperate = true;
+	params.maxControlsPerRequest = 1;
+	MasterTestObject t(params);
+	t.context.OnLowerLayerUp();
+
+	ControlRelayOutputBlock crob(ControlCode::PULSE_ON);
+
+	CommandCallbackQueue queue;
+
+	t.context.DirectOperate(CommandSet({ WithIndex(crob, 1) }), queue.Callback(), TaskConfig::Default());
+	t.context.DirectOperate(CommandSet({ WithIndex(crob, 2) }), queue.Callback(), TaskConfig::Default());
+	t.context.DirectOperate(CommandSet({ WithIndex(crob, 3) }), queue.Callback(), TaskConfig::Default());
+
+	for (uint8_t i = 1; i <= 3; ++i)
+	{
+		auto seq = testlib::ByteToHex(static_cast<uint8_t>(0xC0 + i - 1));
+		REQUIRE(t.lower.PopWriteAsHex() == seq + " 05 " + CROBHeader(i));
+		t.context.OnSendResult(true);
+		t.SendToMaster(seq + " 81 00 00 " + CROBHeader(i));
+		t.exe.RunMany();
+	}
+
+	REQUIRE(t.lower.PopWriteAsHex() == "");
+	REQUIRE(queue.values.size() == 3);
+}
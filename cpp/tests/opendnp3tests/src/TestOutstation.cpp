@@ -26,6 +26,8 @@
 #include <testlib/HexConversions.h>
 
 #include <opendnp3/ErrorCodes.h>
+#include <opendnp3/app/AppConstants.h>
+#include <opendnp3/app/FragmentBufferPool.h>
 
 using namespace std;
 using namespace opendnp3;
@@ -315,6 +317,81 @@ TEST_CASE(SUITE("ReadClass0MultiFragAnalog"))
 	REQUIRE(t.lower.PopWriteAsHex() == "");
 }
 
+uint32_t NumBytesInHex(const std::string& hex)
+{
+	return static_cast<uint32_t>((hex.size() + 1) / 3);
+}
+
+TEST_CASE(SUITE("ReadClass0LargeFragmentUsesPooledBuffer"))
+{
+	OutstationConfig config;
+	config.params.maxTxFragSize = 4096;
+	OutstationTestObject t(config, DatabaseTemplate::AnalogOnly(600));
+	auto leased = FragmentBufferPool::NumLeased();
+	t.LowerLayerUp();
+
+	t.SendToOutstation("C0 01 3C 01 06"); // Read class 0
+
+	// 600 x (30,1) doesn't fit the default size, but goes out in a single FIR/FIN fragment.
+	// The points written after the buffer grew get a second range header.
+	auto response = t.lower.PopWriteAsHex();
+	REQUIRE(response.substr(0, 32) == "C0 81 80 00 1E 01 01 00 00 96 01");
+	REQUIRE(NumBytesInHex(response) == (4 + 2 * 7 + 600 * 5));
+	REQUIRE(FragmentBufferPool::NumLeased() == leased + 1);
+
+	// the large buffer goes back to the pool once the transmission completes
+	t.OnSendResult(true);
+	REQUIRE(FragmentBufferPool::NumLeased() == leased);
+
+	// small responses never lease
+	t.SendToOutstation("C1 01 3C 02 06"); // Read class 1
+	REQUIRE(t.lower.PopWriteAsHex() == "C1 81 80 00");
+	REQUIRE(FragmentBufferPool::NumLeased() == leased);
+}
+
+TEST_CASE(SUITE("ReadClass0LargerThanMaxFragmentStillMultiFrags"))
+{
+	OutstationConfig config;
+	config.params.maxTxFragSize = 4096;
+	OutstationTestObject t(config, DatabaseTemplate::AnalogOnly(1000));
+	auto leased = FragmentBufferPool::NumLeased();
+	t.LowerLayerUp();
+
+	t.SendToOutstation("C0 01 3C 01 06"); // Read class 0
+
+	auto first = t.lower.PopWriteAsHex();
+	REQUIRE(first.substr(0, 2) == "A0");
+	REQUIRE(NumBytesInHex(first) <= 4096);
+	REQUIRE(NumBytesInHex(first) > DEFAULT_MAX_APDU_SIZE);
+	t.OnSendResult(true);
+
+	// the lease is held between fragments
+	REQUIRE(FragmentBufferPool::NumLeased() == leased + 1);
+	t.SendToOutstation("C0 00");
+
+	auto second = t.lower.PopWriteAsHex();
+	REQUIRE(second.substr(0, 2) == "41");
+	REQUIRE((NumBytesInHex(first) + NumBytesInHex(second)) == (2 * 4 + 3 * 7 + 1000 * 5));
+	t.OnSendResult(true);
+	REQUIRE(FragmentBufferPool::NumLeased() == leased);
+}
+
+TEST_CASE(SUITE("PoolAllFragmentBuffersHoldsNothingWhileIdle"))
+{
+	OutstationConfig config;
+	config.params.poolAllFragmentBuffers = true;
+	OutstationTestObject t(config, DatabaseTemplate::AnalogOnly(1));
+	auto leased = FragmentBufferPool::NumLeased();
+	t.LowerLayerUp();
+
+	t.SendToOutstation("C0 01 3C 01 06"); // Read class 0
+	REQUIRE(t.lower.PopWriteAsHex() == "C0 81 80 00 1E 01 00 00 00 02 00 00 00 00");
+	REQUIRE(FragmentBufferPool::NumLeased() == leased + 1);
+
+	t.OnSendResult(true);
+	REQUIRE(FragmentBufferPool::NumLeased() == leased);
+}
+
 TEST_CASE(SUITE("ReadFuncNotSupported"))
 {
 	OutstationConfig config;
@@ -481,10 +558,11 @@ TEST_CASE(SUITE("ContiguousIndexesInDiscontiguousModeRangeScan"))
 	REQUIRE(t.lower.PopWriteAsHex() == "C0 81 80 00 01 02 00 00 01 02 02");
 }
 
-std::string QueryDiscontiguousBinary(const std::string& request)
+std::string QueryDiscontiguousBinary(const std::string& request, bool planStaticQualifiers = false)
 {
 	OutstationConfig config;
 	config.params.indexMode = IndexMode::Discontiguous;
+	config.params.planStaticQualifiers = planStaticQualifiers;
 
 	OutstationTestObject t(config, DatabaseTemplate::BinaryOnly(3));
 
@@ -542,6 +620,41 @@ TEST_CASE(SUITE("ReadDiscontiguousPastUpperBound"))
 	REQUIRE(QueryDiscontiguousBinary("C0 01 01 02 00 05 06") == "C0 81 80 04 01 02 00 05 05 02");
 }
 
+TEST_CASE(SUITE("ReadDiscontiguousClass0WithPlannedQualifiers"))
+{
+	// one count and index prefixed header is smaller than two range headers
+	REQUIRE(QueryDiscontiguousBinary("C0 01 3C 01 06", true) == "C0 81 80 00 01 02 17 03 02 81 04 01 05 02");
+}
+
+TEST_CASE(SUITE("ReadDiscontiguousPartialSelectionWithPlannedQualifiers"))
+{
+	// read 01 var 2, [02 : 02]; read 01 var 2, [05 : 05]
+	REQUIRE(QueryDiscontiguousBinary("C0 01 01 02 00 02 02 01 02 00 05 05", true) == "C0 81 80 00 01 02 17 02 02 81 05 02");
+}
+
+TEST_CASE(SUITE("PlannedQualifiersKeepRangesForLongRuns"))
+{
+	OutstationConfig config;
+	config.params.indexMode = IndexMode::Discontiguous;
+	config.params.planStaticQualifiers = true;
+	OutstationTestObject t(config, DatabaseTemplate::AnalogOnly(8));
+
+	auto view = t.context.GetConfigView();
+	for (uint16_t i = 0; i < 7; ++i)
+	{
+		view.analogs[i].vIndex = i;
+	}
+	view.analogs[7].vIndex = 20;
+
+	t.LowerLayerUp();
+
+	t.SendToOutstation(hex::IntegrityPoll(0));
+
+	std::string run = "1E 01 00 00 06 02 00 00 00 00 02 00 00 00 00 02 00 00 00 00 02 00 00 00 00 02 00 00 00 00 02 00 00 00 00 02 00 00 00 00";
+	std::string single = "1E 01 00 14 14 02 00 00 00 00";
+	REQUIRE(t.lower.PopWriteAsHex() == "C0 81 80 00 " + run + " " + single);
+}
+
 TEST_CASE(SUITE("ReadDiscontiguousAllDataWithMultipleRanges"))
 {
 	// read 01 var 2, [02 : 02]; read 01 var 2, [04 : 05]
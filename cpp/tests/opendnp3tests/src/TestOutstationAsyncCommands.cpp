@@ -0,0 +1,197 @@
+/*
+ * Licensed to Green Energy Corp (www.greenenergycorp.com) under one or
+ * more contributor license agreements. See the NOTICE file distributed
+ * with this work for additional information regarding copyright ownership.
+ * Green Energy Corp licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except in
+ * compliance with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * This project was forked on 01/01/2013 by Automatak, LLC and modifications
+ * may have been made to this file. Automatak, LLC licenses these modifications
+ * to you under the terms of the License.
+ */
+#include <catch.hpp>
+
+#include "mocks/OutstationTestObject.h"
+
+using namespace std;
+using namespace opendnp3;
+using namespace openpal;
+
+#define SUITE(name) "OutstationAsyncCommandsTestSuite - " name
+
+TEST_CASE(SUITE("DirectOperateResponseWaitsForCompletion"))
+{
+	OutstationConfig config;
+	OutstationTestObject t(config);
+	t.cmdHandler.SetAsync(true);
+	t.LowerLayerUp();
+
+	// Direct operate group 12 Var 1, count = 1, index = 3
+	t.SendToOutstation("C1 05 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+	REQUIRE(t.lower.PopWriteAsHex() == "");
+	REQUIRE(t.cmdHandler.tokens.size() == 1);
+	REQUIRE(t.cmdHandler.crobOps.size() == 1);
+	REQUIRE(t.cmdHandler.crobOps[0].opType == OperateType::DirectOperate);
+	REQUIRE(t.cmdHandler.numStart == 1);
+	REQUIRE(t.cmdHandler.numEnd == 1);
+
+	t.CompleteOperate(0, CommandStatus::SUCCESS);
+	REQUIRE(t.lower.PopWriteAsHex() == "C1 81 80 00 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+}
+
+TEST_CASE(SUITE("EachCommandEchoesItsOwnResult"))
+{
+	OutstationConfig config;
+	OutstationTestObject t(config);
+	t.cmdHandler.SetAsync(true);
+	t.LowerLayerUp();
+
+	// Direct operate group 12 Var 1, count = 2, index = 3 & 4
+	t.SendToOutstation("C1 05 0C 01 17 02 03 01 01 01 00 00 00 01 00 00 00 00 04 01 01 01 00 00 00 01 00 00 00 00");
+	REQUIRE(t.cmdHandler.tokens.size() == 2);
+
+	t.CompleteOperate(1, CommandStatus::HARDWARE_ERROR);
+	REQUIRE(t.lower.PopWriteAsHex() == "");
+
+	// completing a token twice has no effect
+	t.CompleteOperate(1, CommandStatus::SUCCESS);
+	REQUIRE(t.lower.PopWriteAsHex() == "");
+
+	t.CompleteOperate(0, CommandStatus::SUCCESS);
+	REQUIRE(t.lower.PopWriteAsHex() == "C1 81 80 00 0C 01 17 02 03 01 01 01 00 00 00 01 00 00 00 00 04 01 01 01 00 00 00 01 00 00 00 06"); // 0x06 == HARDWARE_ERROR
+}
+
+TEST_CASE(SUITE("OutstandingCommandsTimeOut"))
+{
+	OutstationConfig config;
+	config.params.asyncOperateTimeout = TimeDuration::Seconds(2);
+	OutstationTestObject t(config);
+	t.cmdHandler.SetAsync(true);
+	t.LowerLayerUp();
+
+	t.SendToOutstation("C1 05 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+	REQUIRE(t.lower.PopWriteAsHex() == "");
+
+	t.AdvanceTime(TimeDuration::Milliseconds(1999));
+	REQUIRE(t.lower.PopWriteAsHex() == "");
+
+	t.AdvanceTime(TimeDuration::Milliseconds(1));
+	REQUIRE(t.lower.PopWriteAsHex() == "C1 81 80 00 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 01"); // 0x01 == TIMEOUT
+	t.OnSendResult(true);
+
+	// a late completion is ignored
+	t.CompleteOperate(0, CommandStatus::SUCCESS);
+	REQUIRE(t.lower.PopWriteAsHex() == "");
+}
+
+TEST_CASE(SUITE("RequestsDuringOperateAreDeferred"))
+{
+	OutstationConfig config;
+	OutstationTestObject t(config);
+	t.cmdHandler.SetAsync(true);
+	t.LowerLayerUp();
+
+	t.SendToOutstation("C1 05 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+
+	// class 0 read
+	t.SendToOutstation("C2 01 3C 01 06");
+	REQUIRE(t.lower.PopWriteAsHex() == "");
+
+	t.CompleteOperate(0, CommandStatus::SUCCESS);
+	REQUIRE(t.lower.PopWriteAsHex() == "C1 81 80 00 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+
+	t.OnSendResult(true);
+	REQUIRE(t.lower.PopWriteAsHex() == "C2 81 80 00");
+}
+
+TEST_CASE(SUITE("SelectBeforeOperateIsAsynchronous"))
+{
+	OutstationConfig config;
+	OutstationTestObject t(config);
+	t.cmdHandler.SetAsync(true);
+	t.LowerLayerUp();
+
+	// the select is answered synchronously
+	t.SendToOutstation("C0 03 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+	REQUIRE(t.lower.PopWriteAsHex() == "C0 81 80 00 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+	t.OnSendResult(true);
+	REQUIRE(t.cmdHandler.tokens.empty());
+
+	t.SendToOutstation("C1 04 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+	REQUIRE(t.lower.PopWriteAsHex() == "");
+	REQUIRE(t.cmdHandler.crobOps.size() == 1);
+	REQUIRE(t.cmdHandler.crobOps[0].opType == OperateType::SelectBeforeOperate);
+
+	t.CompleteOperate(0, CommandStatus::SUCCESS);
+	REQUIRE(t.lower.PopWriteAsHex() == "C1 81 80 00 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+}
+
+TEST_CASE(SUITE("OperateWithoutSelectNeverReachesHandler"))
+{
+	OutstationConfig config;
+	OutstationTestObject t(config);
+	t.cmdHandler.SetAsync(true);
+	t.LowerLayerUp();
+
+	t.SendToOutstation("C1 04 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+	REQUIRE(t.lower.PopWriteAsHex() == "C1 81 80 00 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 02"); // 0x02 no select
+	REQUIRE(t.cmdHandler.NumInvocations() == 0);
+}
+
+TEST_CASE(SUITE("LowerLayerDownAbandonsOperate"))
+{
+	OutstationConfig config;
+	OutstationTestObject t(config);
+	t.cmdHandler.SetAsync(true);
+	t.LowerLayerUp();
+
+	t.SendToOutstation("C1 05 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+	t.LowerLayerDown();
+
+	t.CompleteOperate(0, CommandStatus::SUCCESS);
+	REQUIRE(t.lower.PopWriteAsHex() == "");
+
+	t.LowerLayerUp();
+	t.SendToOutstation("C2 05 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+	REQUIRE(t.cmdHandler.tokens.size() == 2);
+	t.CompleteOperate(1, CommandStatus::SUCCESS);
+	REQUIRE(t.lower.PopWriteAsHex() == "C2 81 80 00 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+}
+
+TEST_CASE(SUITE("WakeupPostedBeforeLowerLayerDownIsHarmless"))
+{
+	OutstationConfig config;
+	OutstationTestObject t(config);
+	t.cmdHandler.SetAsync(true);
+	t.LowerLayerUp();
+
+	t.SendToOutstation("C1 05 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+
+	// the completion posts a wakeup that only runs after the operate has been abandoned
+	t.cmdHandler.tokens.at(0).Complete(CommandStatus::SUCCESS);
+	REQUIRE(t.LowerLayerDown() == 1);
+	REQUIRE(t.lower.PopWriteAsHex() == "");
+}
+
+TEST_CASE(SUITE("DirectOperateNoResponseIsDispatchedAsynchronously"))
+{
+	OutstationConfig config;
+	OutstationTestObject t(config);
+	t.cmdHandler.SetAsync(true);
+	t.LowerLayerUp();
+
+	t.SendToOutstation("C1 06 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+	REQUIRE(t.cmdHandler.tokens.size() == 1);
+
+	t.CompleteOperate(0, CommandStatus::SUCCESS);
+	REQUIRE(t.lower.PopWriteAsHex() == "");
+}
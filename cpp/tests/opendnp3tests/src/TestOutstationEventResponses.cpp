@@ -179,15 +179,13 @@ TEST_CASE(SUITE("MultipleClasses"))
 	REQUIRE(t.lower.PopWriteAsHex() == "C4 81 80 00"); // restart only
 }
 
-void TestEventRead(	const std::string& request,
+void TestEventRead(	const OutstationConfig& config,
+                    const std::string& request,
                     const std::string& response,
                     const std::function<void(IDatabase& db)>& loadFun,
-const std::function<void(DatabaseConfigView& db)>& configure = [](DatabaseConfigView& view) {}
+                    const std::function<void(DatabaseConfigView& db)>& configure
                   )
 {
-
-	OutstationConfig config;
-	config.eventBufferConfig = EventBufferConfig::AllTypes(10);
 	OutstationTestObject t(config, DatabaseTemplate::AllTypes(5));
 
 	auto view = t.context.GetConfigView();
@@ -204,6 +202,25 @@ const std::function<void(DatabaseConfigView& db)>& configure = [](DatabaseConfig
 	REQUIRE(t.lower.PopWriteAsHex() ==  response);
 }
 
+void TestEventRead(	const std::string& request,
+                    const std::string& response,
+                    const std::function<void(IDatabase& db)>& loadFun,
+const std::function<void(DatabaseConfigView& db)>& configure = [](DatabaseConfigView& view) {}
+                  )
+{
+	OutstationConfig config;
+	config.eventBufferConfig = EventBufferConfig::AllTypes(10);
+	TestEventRead(config, request, response, loadFun, configure);
+}
+
+void TestPackedEventRead(const std::string& request, const std::string& response, const std::function<void(IDatabase& db)>& loadFun)
+{
+	OutstationConfig config;
+	config.eventBufferConfig = EventBufferConfig::AllTypes(10);
+	config.params.packRelativeTimeEvents = true;
+	TestEventRead(config, request, response, loadFun, [](DatabaseConfigView & view) {});
+}
+
 TEST_CASE(SUITE("Class1"))
 {
 	auto update = [](IDatabase & db)
@@ -389,3 +406,75 @@ TEST_CASE(SUITE("ReadGrp2Var3TwoValuesDifferenceTooBigForCTO"))
 
 
 
+
+TEST_CASE(SUITE("ReadGrp2Var3PackedUsesEarliestTimeAsCTO"))
+{
+	auto update = [](IDatabase & db)
+	{
+		db.Update(Binary(false, 0x01, DNPTime(0x4571)), 3);
+		db.Update(Binary(true, 0x01, DNPTime(0x4570)), 4);
+	};
+
+	auto rsp = "E0 81 80 00 33 01 07 01 70 45 00 00 00 00 02 03 28 02 00 03 00 01 01 00 04 00 81 00 00";
+
+	TestPackedEventRead("C0 01 02 03 06", rsp, update);
+}
+
+TEST_CASE(SUITE("ReadGrp2Var3PackedStartsNewWindowWhenSpreadTooBig"))
+{
+	auto update = [](IDatabase & db)
+	{
+		db.Update(Binary(false, 0x01, DNPTime(0x000000)), 2);
+		db.Update(Binary(true, 0x01, DNPTime(0x010000)), 3);
+		db.Update(Binary(false, 0x01, DNPTime(0x008000)), 4);
+	};
+
+	std::string header = "E0 81 80 00";
+	std::string cto1 = " 33 01 07 01 00 00 00 00 00 00 02 03 28 01 00 02 00 01 00 00";
+	std::string cto2 = " 33 01 07 01 00 80 00 00 00 00 02 03 28 02 00 03 00 81 00 80 04 00 01 00 00";
+
+	auto rsp = header + cto1 + cto2;
+
+	TestPackedEventRead("C0 01 02 03 06", rsp, update);
+}
+
+TEST_CASE(SUITE("ReadGrp2Var3PackedWindowOnlyCoversEventsThatFit"))
+{
+	auto update = [](IDatabase & db)
+	{
+		db.Update(Binary(false, 0x01, DNPTime(0x008000)), 2);
+		db.Update(Binary(true, 0x01, DNPTime(0x000000)), 3);
+	};
+
+	// the fragment only has room for one event, so the earlier time of the second doesn't become the CTO
+	OutstationConfig config;
+	config.eventBufferConfig = EventBufferConfig::AllTypes(10);
+	config.params.packRelativeTimeEvents = true;
+	config.params.maxTxFragSize = 24;
+
+	auto rsp = "A0 81 82 00 33 01 07 01 00 80 00 00 00 00 02 03 28 01 00 02 00 01 00 00";
+
+	TestEventRead(config, "C0 01 02 03 06", rsp, update, [](DatabaseConfigView & view) {});
+}
+
+TEST_CASE(SUITE("ReadGrp2Var3PackedWritesOtherTypesAfterTheWindow"))
+{
+	auto update = [](IDatabase & db)
+	{
+		db.Update(Binary(false, 0x01, DNPTime(0x4571)), 3);
+		db.Update(DoubleBitBinary(DoubleBit::DETERMINED_ON, 0x01, DNPTime(0x4572)), 1);
+		db.Update(Binary(true, 0x01, DNPTime(0x4573)), 4);
+	};
+
+	std::string header = "E0 81 80 00";
+	std::string g2 = " 33 01 07 01 71 45 00 00 00 00 02 03 28 02 00 03 00 01 00 00 04 00 81 02 00";
+	std::string g4 = " 33 01 07 01 72 45 00 00 00 00 04 03 28 01 00 01 00 81 00 00";
+
+	TestPackedEventRead("C0 01 02 03 06 04 03 06", header + g2 + g4, update);
+
+	// without packing, the double bit event splits the binaries into two headers
+	std::string g2first = " 33 01 07 01 71 45 00 00 00 00 02 03 28 01 00 03 00 01 00 00";
+	std::string g2second = " 33 01 07 01 73 45 00 00 00 00 02 03 28 01 00 04 00 81 00 00";
+
+	TestEventRead("C0 01 02 03 06 04 03 06", header + g2first + g4 + g2second, update);
+}
@@ -26,6 +26,7 @@
 #include <dnp3mocks/ProtocolUtil.h>
 
 #include <opendnp3/app/AppConstants.h>
+#include <opendnp3/app/FragmentBufferPool.h>
 #include <opendnp3/transport/TransportConstants.h>
 
 using namespace std;
@@ -166,6 +167,29 @@ TEST_CASE(SUITE("ReceiveLargestPossibleAPDU"))
 	REQUIRE(test.upper.BufferEqualsHex(apdu)); //check that the correct data was written
 }
 
+TEST_CASE(SUITE("ReceiveLargeAPDUInPooledBuffer"))
+{
+	const uint32_t MAX_SIZE = 65536;
+	TransportTestObject test(true, levels::NORMAL, false, MAX_SIZE);
+	auto leased = FragmentBufferPool::NumLeased();
+
+	uint32_t num_packets = CalcMaxPackets(MAX_SIZE, MAX_TPDU_PAYLOAD);
+	uint32_t last_packet_length = CalcLastPacketSize(MAX_SIZE, MAX_TPDU_PAYLOAD);
+
+	vector<string> packets;
+	string apdu = test.GeneratePacketSequence(packets, num_packets, last_packet_length);
+	for (size_t i = 0; i < packets.size(); ++i)
+	{
+		test.link.SendUp(packets[i]);
+		// the default sized buffer is enough until the fragment outgrows it
+		auto expected = (((i + 1) * MAX_TPDU_PAYLOAD) > DEFAULT_MAX_APDU_SIZE && (i + 1) < packets.size()) ? 1u : 0u;
+		REQUIRE(FragmentBufferPool::NumLeased() == leased + expected);
+	}
+
+	REQUIRE(test.log.IsLogErrorFree());
+	REQUIRE(test.upper.BufferEqualsHex(apdu));
+}
+
 TEST_CASE(SUITE("ReceiveBufferOverflow"))
 {
 	TransportTestObject test(true);
@@ -89,5 +89,11 @@ uint32_t OutstationTestObject::AdvanceTime(const openpal::TimeDuration& td)
 	return exe.RunMany();
 }
 
+uint32_t OutstationTestObject::CompleteOperate(size_t i, CommandStatus status)
+{
+	cmdHandler.tokens.at(i).Complete(status);
+	return exe.RunMany();
+}
+
 }
 
@@ -62,6 +62,9 @@ public:
 
 	uint32_t AdvanceTime(const openpal::TimeDuration& td);
 
+	/// Complete one of the command handler's asynchronous operates and run anything it posts
+	uint32_t CompleteOperate(size_t i, CommandStatus status);
+
 	testlib::MockLogHandler log;
 
 	void Transaction(const std::function<void (IDatabase&)>& apply)
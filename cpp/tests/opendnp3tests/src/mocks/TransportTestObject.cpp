@@ -35,10 +35,10 @@ using namespace testlib;
 namespace opendnp3
 {
 
-TransportTestObject::TransportTestObject(bool aOpenOnStart, uint32_t filters, bool aImmediate) :
+TransportTestObject::TransportTestObject(bool aOpenOnStart, uint32_t filters, bool aImmediate, uint32_t maxRxFragSize) :
 	log(),
 	exe(),
-	transport(log.root.GetLogger(), exe, DEFAULT_MAX_APDU_SIZE)
+	transport(log.root.GetLogger(), exe, maxRxFragSize)
 {
 	link.SetUpperLayer(transport);
 	transport.SetLinkLayer(&link);
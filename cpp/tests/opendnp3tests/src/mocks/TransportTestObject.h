@@ -23,6 +23,7 @@
 
 #include <opendnp3/transport/TransportLayer.h>
 #include <opendnp3/LogLevels.h>
+#include <opendnp3/app/AppConstants.h>
 
 #include <vector>
 #include <string>
@@ -39,7 +40,7 @@ namespace opendnp3
 class TransportTestObject
 {
 public:
-	TransportTestObject(bool aOpenOnStart = false, uint32_t filters = levels::NORMAL, bool aImmediate = false);
+	TransportTestObject(bool aOpenOnStart = false, uint32_t filters = levels::NORMAL, bool aImmediate = false, uint32_t maxRxFragSize = DEFAULT_MAX_APDU_SIZE);
 
 	// Generate a complete packet sequence inside the vector and
 	// return the corresponding reassembled APDU
@@ -3,7 +3,7 @@ package com.automatak.render.dnp3
 import java.nio.file.FileSystems
 import com.automatak.render.dnp3.enums.generators.{CSharpEnumGenerator, CppEnumGenerator}
 import com.automatak.render.dnp3.enums.groups.{CSharpEnumGroup, DNPCppEnumGroup}
-import com.automatak.render.dnp3.objects.generators.{AttributeGenerator, GroupVariationFileGenerator}
+import com.automatak.render.dnp3.objects.generators.{AttributeGenerator, GroupVariationFileGenerator, GroupVariationTableGenerator}
 
 object Generate {
 
@@ -20,6 +20,9 @@ object Generate {
     // generate the C++ variation attribute lookups
     AttributeGenerator.writeAttributes("opendnp3", dnp3GenHeaderPath, dnp3GenImplPath)
 
+    // generate the dense group/variation lookup table
+    GroupVariationTableGenerator("opendnp3", dnp3GenImplPath)
+
     // generate the C# enums
     CSharpEnumGenerator(CSharpEnumGroup.enums, "Automatak.DNP3.Interface", csharpGenPath)
 
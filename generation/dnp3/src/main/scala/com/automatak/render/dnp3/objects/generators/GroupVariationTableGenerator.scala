@@ -0,0 +1,141 @@
+package com.automatak.render.dnp3.objects.generators
+
+import java.nio.file.Path
+
+import com.automatak.render._
+import com.automatak.render.cpp._
+import com.automatak.render.LicenseHeader
+import com.automatak.render.cpp.CppIndentation
+import com.automatak.render.dnp3.objects.{FixedSize, ObjectGroup, GroupVariation}
+
+/**
+ * Generates a dense, per-group lookup table that maps a (group, variation) pair to
+ * its enumeration, header type, and fixed object size with a bounds check and two loads
+ */
+object GroupVariationTableGenerator {
+  implicit val indent = CppIndentation()
+
+  // the groups whose unknown variations still resolve to the variation 0 enumeration
+  val variationZeroFallback = Set(110, 111, 112, 113)
+
+  def recordType(group: Int, variation: Int): String = group match {
+    case 1 | 3 | 10 | 20 | 21 | 30 | 40 | 110 | 121 => "STATIC"
+    case 2 | 4 | 11 | 13 | 22 | 23 | 32 | 41 | 42 | 43 | 111 | 122 => "EVENT"
+    case 50 => if(variation == 4) "STATIC" else "OTHER"
+    case 60 => if(variation == 1) "STATIC" else "EVENT"
+    case _ => "OTHER"
+  }
+
+  def fixedSize(gv: GroupVariation): Int = gv match {
+    case fs: FixedSize => fs.size
+    case _ => 0
+  }
+
+  def apply(cppNamespace: String, impl: Path): Unit = {
+
+    val name = "GroupVariationTable"
+    val headerPath = impl.resolve(String.format("%s.h", name))
+    val implPath = impl.resolve(String.format("%s.cpp", name))
+
+    def license = commented(LicenseHeader())
+
+    def unsigned(b: Byte): Int = b & 0xFF
+
+    def entry(enumeration: String, typ: String, size: Int): String = {
+      "{ GroupVariation::%s, GroupVariationType::%s, %d }".format(enumeration, typ, size)
+    }
+
+    def missing(group: Int): String = {
+      val enumeration = if(variationZeroFallback.contains(group)) "Group%dVar0".format(group) else "UNKNOWN"
+      entry(enumeration, recordType(group, -1), 0)
+    }
+
+    def writeHeader() {
+
+      def includes : Iterator[String] = cstdint ++ Iterator(include(quoted("opendnp3/gen/GroupVariation.h")))
+
+      def typeEnum : Iterator[String] = Iterator(
+        "/**",
+        "  How a group/variation is classified when dispatching object headers",
+        "*/",
+        "enum class GroupVariationType : uint8_t"
+      ) ++ bracketSemiColon {
+        Iterator("STATIC,", "EVENT,", "OTHER")
+      }
+
+      def entryStruct : Iterator[String] = Iterator(
+        "/**",
+        "  Enumeration, type, and fixed object size (0 if not fixed) of a group/variation",
+        "*/",
+        "struct GroupVariationEntry"
+      ) ++ bracketSemiColon {
+        Iterator("GroupVariation enumeration;", "GroupVariationType type;", "uint16_t size;")
+      }
+
+      def rowStruct : Iterator[String] = Iterator(
+        "/**",
+        "  The entries of a single group, indexed by variation, and the entry for any variation beyond them",
+        "*/",
+        "struct GroupVariationRow"
+      ) ++ bracketSemiColon {
+        Iterator("const GroupVariationEntry* entries;", "uint16_t count;", "GroupVariationEntry other;")
+      }
+
+      def lookup : Iterator[String] = Iterator(
+        "extern const GroupVariationRow GroupVariationTable[256];",
+        "",
+        "inline const GroupVariationEntry& LookupGroupVariation(uint8_t group, uint8_t variation)"
+      ) ++ bracket {
+        Iterator(
+          "const GroupVariationRow& row = GroupVariationTable[group];",
+          "return (variation < row.count) ? row.entries[variation] : row.other;"
+        )
+      }
+
+      def lines = license ++ space ++ includeGuards(name)(includes ++ space ++ namespace(cppNamespace)(
+        typeEnum ++ space ++ entryStruct ++ space ++ rowStruct ++ space ++ lookup
+      ))
+
+      writeTo(headerPath)(lines)
+      println("Wrote: " + headerPath)
+    }
+
+    def writeImpl() {
+
+      val groups = ObjectGroup.all.map(og => (unsigned(og.group), og)).toMap
+
+      def entries(og: ObjectGroup) : Iterator[String] = {
+        val group = unsigned(og.group)
+        val byVariation = og.objects.map(gv => (unsigned(gv.variation), gv)).toMap
+        val count = byVariation.keys.max + 1
+        def row(v: Int) : String = byVariation.get(v) match {
+          case Some(gv) => entry(gv.name, recordType(group, v), fixedSize(gv))
+          case None => missing(group)
+        }
+        Iterator("const GroupVariationEntry %sEntries[] =".format(og.name)) ++ bracketSemiColon {
+          commaDelimited((0 until count).map(row).iterator)
+        } ++ space
+      }
+
+      def row(group: Int) : String = groups.get(group) match {
+        case Some(og) => "{ %sEntries, %d, %s }".format(og.name, og.objects.map(gv => unsigned(gv.variation)).max + 1, missing(group))
+        case None => "{ nullptr, 0, %s }".format(missing(group))
+      }
+
+      def table : Iterator[String] = Iterator("const GroupVariationRow GroupVariationTable[256] =") ++ bracketSemiColon {
+        commaDelimited((0 until 256).map(row).iterator)
+      }
+
+      def lines = license ++ space ++ Iterator(include(quoted("opendnp3/gen/GroupVariationTable.h"))) ++ space ++ namespace(cppNamespace) {
+        ObjectGroup.all.iterator.flatMap(entries) ++ table
+      }
+
+      writeTo(implPath)(lines)
+      println("Wrote: " + implPath)
+    }
+
+    writeHeader()
+    writeImpl()
+  }
+
+}